@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <Logging.h>
+#include <Perf.h>
 #include <Utf8.h>
 
 #include <cstdlib>
@@ -148,6 +149,7 @@ const uint8_t* FontDecompressor::getBitmap(const EpdFontData* fontData, const Ep
       if (slot.glyphs[mid].glyphIndex == glyphIndex) {
         if (slot.glyphs[mid].bufferOffset != UINT32_MAX) {
           stats.cacheHits++;
+          PERF_COUNT(GlyphCacheHits, 1);
           stats.getBitmapTimeUs += micros() - tStart;
           return &slot.buffer[slot.glyphs[mid].bufferOffset];
         }
@@ -172,6 +174,7 @@ const uint8_t* FontDecompressor::getBitmap(const EpdFontData* fontData, const Ep
   // Check if hot group already has this group decompressed — if not, decompress it
   if (!(!hotGroup.empty() && hotGroupFont == fontData && hotGroupIndex == groupIndex)) {
     stats.cacheMisses++;
+    PERF_COUNT(GlyphCacheMisses, 1);
     const EpdFontGroup& group = fontData->groups[groupIndex];
 
     hotGroup.resize(group.uncompressedSize);
@@ -197,6 +200,7 @@ const uint8_t* FontDecompressor::getBitmap(const EpdFontData* fontData, const Ep
     stats.hotGroupBytes = group.uncompressedSize;
   } else {
     stats.cacheHits++;
+    PERF_COUNT(GlyphCacheHits, 1);
   }
 
   // Compact just the requested glyph from byte-aligned data into scratch buffer
@@ -1,10 +1,12 @@
 #include "Epub.h"
 
 #include <FsHelpers.h>
+#include <HalDisplay.h>
 #include <HalStorage.h>
 #include <JpegToBmpConverter.h>
 #include <Logging.h>
 #include <PngToBmpConverter.h>
+#include <Serialization.h>
 #include <ZipFile.h>
 
 #include "Epub/parsers/ContainerParser.h"
@@ -328,9 +330,8 @@ void Epub::parseCssFiles() const {
   if (!cssParser->saveToCache()) {
     LOG_ERR("EBP", "Failed to save CSS rules to cache");
   }
-  cssParser->clear();
-
   LOG_DBG("EBP", "Loaded %zu CSS style rules from %zu files", cssParser->ruleCount(), cssFiles.size());
+  cssParser->clear();
 }
 
 // load in the meta data for the epub file
@@ -358,6 +359,8 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
         // Invalidate section caches so they are rebuilt with the new CSS
         Storage.removeDir((cachePath + "/sections").c_str());
       }
+      // Rules are range-read from the cache while a section is built; don't hold the file open in between
+      cssParser->clear();
     }
     LOG_DBG("EBP", "Loaded ePub: %s", filepath.c_str());
     return true;
@@ -492,6 +495,37 @@ const std::string& Epub::getCachePath() const { return cachePath; }
 
 const std::string& Epub::getPath() const { return filepath; }
 
+Epub::ChapterParser Epub::getChapterParser() const {
+  if (!chapterParserLoaded) {
+    chapterParserLoaded = true;
+    const auto parserPath = cachePath + "/parser.bin";
+    FsFile f;
+    if (Storage.exists(parserPath.c_str()) && Storage.openFileForRead("EPB", parserPath, f)) {
+      serialization::readPod(f, chapterParser);
+      f.close();
+    }
+    if (chapterParser > static_cast<uint8_t>(ChapterParser::Expat)) {
+      chapterParser = static_cast<uint8_t>(ChapterParser::Expat);
+    }
+  }
+  return static_cast<ChapterParser>(chapterParser);
+}
+
+bool Epub::setChapterParser(const ChapterParser parser) {
+  chapterParser = static_cast<uint8_t>(parser);
+  chapterParserLoaded = true;
+
+  setupCacheDir();
+  FsFile f;
+  if (!Storage.openFileForWrite("EPB", cachePath + "/parser.bin", f)) {
+    LOG_ERR("EPB", "Could not save chapter parser choice");
+    return false;
+  }
+  serialization::writePod(f, chapterParser);
+  f.close();
+  return true;
+}
+
 const std::string& Epub::getTitle() const {
   static std::string blank;
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
@@ -525,191 +559,118 @@ std::string Epub::getCoverBmpPath(bool cropped) const {
 }
 
 bool Epub::generateCoverBmp(bool cropped) const {
-  // Already generated, return true
-  if (Storage.exists(getCoverBmpPath(cropped).c_str())) {
-    return true;
-  }
-
-  if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
-    LOG_ERR("EBP", "Cannot generate cover BMP, cache not loaded");
-    return false;
-  }
-
-  const auto coverImageHref = bookMetadataCache->coreMetadata.coverItemHref;
-  if (coverImageHref.empty()) {
-    LOG_ERR("EBP", "No known cover image");
-    return false;
-  }
+  CoverImageRequest request;
+  request.cover = !cropped;
+  request.croppedCover = cropped;
+  return generateCoverImages(request);
+}
 
-  if (FsHelpers::hasJpgExtension(coverImageHref)) {
-    LOG_DBG("EBP", "Generating BMP from JPG cover image (%s mode)", cropped ? "cropped" : "fit");
-    const auto coverJpgTempPath = getCachePath() + "/.cover.jpg";
+std::string Epub::getThumbBmpPath() const { return cachePath + "/thumb_[HEIGHT].bmp"; }
+std::string Epub::getThumbBmpPath(int height) const { return cachePath + "/thumb_" + std::to_string(height) + ".bmp"; }
 
-    FsFile coverJpg;
-    if (!Storage.openFileForWrite("EBP", coverJpgTempPath, coverJpg)) {
-      return false;
-    }
-    readItemContentsToStream(coverImageHref, coverJpg, 1024);
-    // Explicitly close() file before reopening for reading
-    coverJpg.close();
+bool Epub::generateThumbBmp(int height) const {
+  CoverImageRequest request;
+  request.thumbHeights.push_back(height);
+  return generateCoverImages(request);
+}
 
-    if (!Storage.openFileForRead("EBP", coverJpgTempPath, coverJpg)) {
-      return false;
-    }
+bool Epub::generateCoverImages(const CoverImageRequest& request) const {
+  constexpr int MAX_COVER_OUTPUTS = 8;
+  std::string paths[MAX_COVER_OUTPUTS];
+  BmpTarget targets[MAX_COVER_OUTPUTS];
+  int outputCount = 0;
 
-    FsFile coverBmp;
-    if (!Storage.openFileForWrite("EBP", getCoverBmpPath(cropped), coverBmp)) {
-      return false;
-    }
-    const bool success = JpegToBmpConverter::jpegFileToBmpStream(coverJpg, coverBmp, cropped);
-    // Explicitly close() files before calling Storage.remove()
-    coverJpg.close();
-    coverBmp.close();
-    Storage.remove(coverJpgTempPath.c_str());
-
-    if (!success) {
-      LOG_ERR("EBP", "Failed to generate BMP from cover image");
-      Storage.remove(getCoverBmpPath(cropped).c_str());
+  // Queue every requested variant that is not on disk yet
+  const auto addOutput = [&](std::string path, const BmpTarget& target) {
+    if (outputCount == MAX_COVER_OUTPUTS || Storage.exists(path.c_str())) {
+      return;
     }
-    LOG_DBG("EBP", "Generated BMP from JPG cover image, success: %s", success ? "yes" : "no");
-    return success;
+    paths[outputCount] = std::move(path);
+    targets[outputCount] = target;
+    outputCount++;
+  };
+  // Sleep covers use the display dimensions swapped for portrait cover sizing
+  if (request.cover) {
+    addOutput(getCoverBmpPath(false), {nullptr, display.getDisplayHeight(), display.getDisplayWidth(), false, false});
   }
-
-  if (FsHelpers::hasPngExtension(coverImageHref)) {
-    LOG_DBG("EBP", "Generating BMP from PNG cover image (%s mode)", cropped ? "cropped" : "fit");
-    const auto coverPngTempPath = getCachePath() + "/.cover.png";
-
-    FsFile coverPng;
-    if (!Storage.openFileForWrite("EBP", coverPngTempPath, coverPng)) {
-      return false;
-    }
-    readItemContentsToStream(coverImageHref, coverPng, 1024);
-    // Explicitly close() file before reopening for reading
-    coverPng.close();
-
-    if (!Storage.openFileForRead("EBP", coverPngTempPath, coverPng)) {
-      return false;
-    }
-
-    FsFile coverBmp;
-    if (!Storage.openFileForWrite("EBP", getCoverBmpPath(cropped), coverBmp)) {
-      return false;
-    }
-    const bool success = PngToBmpConverter::pngFileToBmpStream(coverPng, coverBmp, cropped);
-    // Explicitly close() files before calling Storage.remove()
-    coverPng.close();
-    coverBmp.close();
-    Storage.remove(coverPngTempPath.c_str());
-
-    if (!success) {
-      LOG_ERR("EBP", "Failed to generate BMP from PNG cover image");
-      Storage.remove(getCoverBmpPath(cropped).c_str());
-    }
-    LOG_DBG("EBP", "Generated BMP from PNG cover image, success: %s", success ? "yes" : "no");
-    return success;
+  if (request.croppedCover) {
+    addOutput(getCoverBmpPath(true), {nullptr, display.getDisplayHeight(), display.getDisplayWidth(), false, true});
+  }
+  for (const int height : request.thumbHeights) {
+    // 1-bit thumbnails for fast home screen rendering (no gray passes needed)
+    addOutput(getThumbBmpPath(height), {nullptr, static_cast<int>(height * 0.6), height, true, true});
   }
 
-  LOG_ERR("EBP", "Cover image is not a supported format, skipping");
-  return false;
-}
-
-std::string Epub::getThumbBmpPath() const { return cachePath + "/thumb_[HEIGHT].bmp"; }
-std::string Epub::getThumbBmpPath(int height) const { return cachePath + "/thumb_" + std::to_string(height) + ".bmp"; }
-
-bool Epub::generateThumbBmp(int height) const {
   // Already generated, return true
-  if (Storage.exists(getThumbBmpPath(height).c_str())) {
+  if (outputCount == 0) {
     return true;
   }
 
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
-    LOG_ERR("EBP", "Cannot generate thumb BMP, cache not loaded");
+    LOG_ERR("EBP", "Cannot generate cover images, cache not loaded");
     return false;
   }
 
   const auto coverImageHref = bookMetadataCache->coreMetadata.coverItemHref;
-  if (coverImageHref.empty()) {
-    LOG_DBG("EBP", "No known cover image for thumbnail");
-  } else if (FsHelpers::hasJpgExtension(coverImageHref)) {
-    LOG_DBG("EBP", "Generating thumb BMP from JPG cover image");
-    const auto coverJpgTempPath = getCachePath() + "/.cover.jpg";
-
-    FsFile coverJpg;
-    if (!Storage.openFileForWrite("EBP", coverJpgTempPath, coverJpg)) {
-      return false;
+  const bool isJpg = FsHelpers::hasJpgExtension(coverImageHref);
+  const bool isPng = FsHelpers::hasPngExtension(coverImageHref);
+  if (coverImageHref.empty() || (!isJpg && !isPng)) {
+    if (coverImageHref.empty()) {
+      LOG_DBG("EBP", "No known cover image");
+    } else {
+      LOG_ERR("EBP", "Cover image is not a supported format, skipping");
     }
-    readItemContentsToStream(coverImageHref, coverJpg, 1024);
-    // Explicitly close() file before reopening for reading
-    coverJpg.close();
-
-    if (!Storage.openFileForRead("EBP", coverJpgTempPath, coverJpg)) {
-      return false;
+    // Write empty thumb files to avoid generation attempts in the future
+    for (int i = 0; i < outputCount; i++) {
+      FsFile placeholder;
+      if (targets[i].oneBit && Storage.openFileForWrite("EBP", paths[i], placeholder)) {
+        placeholder.close();
+      }
     }
+    return false;
+  }
 
-    FsFile thumbBmp;
-    if (!Storage.openFileForWrite("EBP", getThumbBmpPath(height), thumbBmp)) {
-      return false;
-    }
-    // Use smaller target size for Continue Reading card (half of screen: 240x400)
-    // Generate 1-bit BMP for fast home screen rendering (no gray passes needed)
-    int THUMB_TARGET_WIDTH = height * 0.6;
-    int THUMB_TARGET_HEIGHT = height;
-    const bool success = JpegToBmpConverter::jpegFileTo1BitBmpStreamWithSize(coverJpg, thumbBmp, THUMB_TARGET_WIDTH,
-                                                                             THUMB_TARGET_HEIGHT);
-    // Explicitly close() files before calling Storage.remove()
-    coverJpg.close();
-    thumbBmp.close();
-    Storage.remove(coverJpgTempPath.c_str());
-
-    if (!success) {
-      LOG_ERR("EBP", "Failed to generate thumb BMP from JPG cover image");
-      Storage.remove(getThumbBmpPath(height).c_str());
-    }
-    LOG_DBG("EBP", "Generated thumb BMP from JPG cover image, success: %s", success ? "yes" : "no");
-    return success;
-  } else if (FsHelpers::hasPngExtension(coverImageHref)) {
-    LOG_DBG("EBP", "Generating thumb BMP from PNG cover image");
-    const auto coverPngTempPath = getCachePath() + "/.cover.png";
-
-    FsFile coverPng;
-    if (!Storage.openFileForWrite("EBP", coverPngTempPath, coverPng)) {
-      return false;
-    }
-    readItemContentsToStream(coverImageHref, coverPng, 1024);
-    // Explicitly close() file before reopening for reading
-    coverPng.close();
+  LOG_DBG("EBP", "Generating %d cover image(s) from %s cover", outputCount, isJpg ? "JPG" : "PNG");
+  const auto coverTempPath = getCachePath() + (isJpg ? "/.cover.jpg" : "/.cover.png");
 
-    if (!Storage.openFileForRead("EBP", coverPngTempPath, coverPng)) {
-      return false;
-    }
+  FsFile coverImage;
+  if (!Storage.openFileForWrite("EBP", coverTempPath, coverImage)) {
+    return false;
+  }
+  readItemContentsToStream(coverImageHref, coverImage, 1024);
+  // Explicitly close() file before reopening for reading
+  coverImage.close();
 
-    FsFile thumbBmp;
-    if (!Storage.openFileForWrite("EBP", getThumbBmpPath(height), thumbBmp)) {
-      return false;
-    }
-    int THUMB_TARGET_WIDTH = height * 0.6;
-    int THUMB_TARGET_HEIGHT = height;
-    const bool success =
-        PngToBmpConverter::pngFileTo1BitBmpStreamWithSize(coverPng, thumbBmp, THUMB_TARGET_WIDTH, THUMB_TARGET_HEIGHT);
-    // Explicitly close() files before calling Storage.remove()
-    coverPng.close();
-    thumbBmp.close();
-    Storage.remove(coverPngTempPath.c_str());
-
-    if (!success) {
-      LOG_ERR("EBP", "Failed to generate thumb BMP from PNG cover image");
-      Storage.remove(getThumbBmpPath(height).c_str());
-    }
-    LOG_DBG("EBP", "Generated thumb BMP from PNG cover image, success: %s", success ? "yes" : "no");
-    return success;
-  } else {
-    LOG_ERR("EBP", "Cover image is not a supported format, skipping thumbnail");
+  if (!Storage.openFileForRead("EBP", coverTempPath, coverImage)) {
+    return false;
+  }
+
+  FsFile outputs[MAX_COVER_OUTPUTS];
+  bool success = true;
+  for (int i = 0; i < outputCount && success; i++) {
+    success = Storage.openFileForWrite("EBP", paths[i], outputs[i]);
+    targets[i].out = &outputs[i];
+  }
+  if (success) {
+    success = isJpg ? JpegToBmpConverter::jpegFileToBmpStreams(coverImage, targets, outputCount)
+                    : PngToBmpConverter::pngFileToBmpStreams(coverImage, targets, outputCount);
   }
 
-  // Write an empty bmp file to avoid generation attempts in the future
-  FsFile thumbBmp;
-  Storage.openFileForWrite("EBP", getThumbBmpPath(height), thumbBmp);
-  return false;
+  // Explicitly close() files before calling Storage.remove()
+  coverImage.close();
+  for (int i = 0; i < outputCount; i++) {
+    outputs[i].close();
+  }
+  Storage.remove(coverTempPath.c_str());
+
+  if (!success) {
+    LOG_ERR("EBP", "Failed to generate cover images");
+    for (int i = 0; i < outputCount; i++) {
+      Storage.remove(paths[i].c_str());
+    }
+  }
+  LOG_DBG("EBP", "Generated %d cover image(s), success: %s", outputCount, success ? "yes" : "no");
+  return success;
 }
 
 uint8_t* Epub::readItemContentsToBytes(const std::string& itemHref, size_t* size, const bool trailingNullByte) const {
@@ -739,6 +700,16 @@ bool Epub::readItemContentsToStream(const std::string& itemHref, Print& out, con
   return ZipFile(filepath).readFileToStream(path.c_str(), out, chunkSize);
 }
 
+bool Epub::readItemPrefixToStream(const std::string& itemHref, Print& out, const size_t chunkSize) const {
+  if (itemHref.empty()) {
+    LOG_DBG("EBP", "Failed to read item, empty href");
+    return false;
+  }
+
+  const std::string path = FsHelpers::normalisePath(itemHref);
+  return ZipFile(filepath).readFilePrefixToStream(path.c_str(), out, chunkSize);
+}
+
 bool Epub::getItemSize(const std::string& itemHref, size_t* size) const {
   const std::string path = FsHelpers::normalisePath(itemHref);
   return ZipFile(filepath).getInflatedFileSize(path.c_str(), size);
@@ -13,6 +13,19 @@
 class ZipFile;
 
 class Epub {
+ public:
+  // Which parser builds chapter sections. Expat is the default. The pull tokenizer is faster and tolerates sloppy
+  // markup, but is opt-in per book until the sections it builds are shown to match expat's.
+  enum class ChapterParser : uint8_t { PullTokenizer = 0, Expat = 1 };
+
+  // Cover variants built together by generateCoverImages(). Missing ones are produced from a single decode.
+  struct CoverImageRequest {
+    bool cover = false;         // sleep screen cover, fit
+    bool croppedCover = false;  // sleep screen cover, cropped
+    std::vector<int> thumbHeights;
+  };
+
+ private:
   // the ncx file (EPUB 2)
   std::string tocNcxItem;
   // the nav file (EPUB 3)
@@ -29,6 +42,9 @@ class Epub {
   std::unique_ptr<CssParser> cssParser;
   // CSS files
   std::vector<std::string> cssFiles;
+  // Chapter parser preference, read lazily from the cache dir
+  mutable uint8_t chapterParser = static_cast<uint8_t>(ChapterParser::Expat);
+  mutable bool chapterParserLoaded = false;
 
   bool findContentOpfFile(std::string* contentOpfFile) const;
   bool parseContentOpf(BookMetadataCache::BookMetadata& bookMetadata);
@@ -56,9 +72,12 @@ class Epub {
   std::string getThumbBmpPath() const;
   std::string getThumbBmpPath(int height) const;
   bool generateThumbBmp(int height) const;
+  bool generateCoverImages(const CoverImageRequest& request) const;
   uint8_t* readItemContentsToBytes(const std::string& itemHref, size_t* size = nullptr,
                                    bool trailingNullByte = false) const;
   bool readItemContentsToStream(const std::string& itemHref, Print& out, size_t chunkSize) const;
+  // Streams only as much of the item as `out` accepts (see ZipFile::readFilePrefixToStream)
+  bool readItemPrefixToStream(const std::string& itemHref, Print& out, size_t chunkSize) const;
   bool getItemSize(const std::string& itemHref, size_t* size) const;
   BookMetadataCache::SpineEntry getSpineItem(int spineIndex) const;
   BookMetadataCache::TocEntry getTocItem(int tocIndex) const;
@@ -72,5 +91,7 @@ class Epub {
   size_t getBookSize() const;
   float calculateProgress(int currentSpineIndex, float currentSpineRead) const;
   CssParser* getCssParser() const { return cssParser.get(); }
+  ChapterParser getChapterParser() const;
+  bool setChapterParser(ChapterParser parser);
   int resolveHrefToSpineIndex(const std::string& href) const;
 };
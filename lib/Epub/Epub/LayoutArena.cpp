@@ -0,0 +1,95 @@
+#include "LayoutArena.h"
+
+#include <new>
+
+LayoutArena::~LayoutArena() {
+  // Everything allocated from the arena must be gone by now; the chunks are released regardless
+  for (Chunk* list : {current, retired, spare}) {
+    while (list) {
+      Chunk* next = list->next;
+      ::operator delete(list);
+      list = next;
+    }
+  }
+}
+
+bool LayoutArena::contains(const Chunk* chunk, const void* p) {
+  const auto* base = reinterpret_cast<const uint8_t*>(chunk);
+  const auto* ptr = static_cast<const uint8_t*>(p);
+  return ptr >= base + HEADER_SIZE && ptr < base + CHUNK_SIZE;
+}
+
+LayoutArena::Chunk* LayoutArena::takeChunk() {
+  Chunk* chunk = spare;
+  if (chunk) {
+    spare = nullptr;
+  } else {
+    chunk = static_cast<Chunk*>(::operator new(CHUNK_SIZE));
+    chunks++;
+    if (chunks > peakChunks) peakChunks = chunks;
+  }
+  chunk->next = nullptr;
+  chunk->used = HEADER_SIZE;
+  chunk->live = 0;
+  return chunk;
+}
+
+void LayoutArena::releaseChunk(Chunk* chunk) {
+  if (!spare) {
+    chunk->next = nullptr;
+    spare = chunk;
+    return;
+  }
+  ::operator delete(chunk);
+  chunks--;
+}
+
+void* LayoutArena::do_allocate(const size_t bytes, const size_t alignment) {
+  if (bytes > MAX_BLOCK_SIZE || alignment > BLOCK_ALIGN) {
+    return ::operator new(bytes);
+  }
+
+  const auto fit = [bytes, alignment](const Chunk* chunk) -> uintptr_t {
+    const auto base = reinterpret_cast<uintptr_t>(chunk);
+    const uintptr_t start = (base + chunk->used + alignment - 1) & ~(alignment - 1);
+    return start + bytes <= base + CHUNK_SIZE ? start : 0;
+  };
+
+  uintptr_t start = current ? fit(current) : 0;
+  if (start == 0) {
+    // A full chunk is retired until its last block comes back
+    if (current) {
+      current->next = retired;
+      retired = current;
+    }
+    current = takeChunk();
+    start = fit(current);
+  }
+  current->used = static_cast<uint16_t>(start + bytes - reinterpret_cast<uintptr_t>(current));
+  current->live++;
+  return reinterpret_cast<void*>(start);
+}
+
+void LayoutArena::do_deallocate(void* p, const size_t bytes, const size_t alignment) {
+  if (bytes > MAX_BLOCK_SIZE || alignment > BLOCK_ALIGN) {
+    ::operator delete(p);
+    return;
+  }
+
+  if (current && contains(current, p)) {
+    if (--current->live == 0) {
+      current->used = HEADER_SIZE;
+    }
+    return;
+  }
+
+  Chunk** link = &retired;
+  while (*link && !contains(*link, p)) {
+    link = &(*link)->next;
+  }
+  Chunk* chunk = *link;
+  if (chunk && --chunk->live == 0) {
+    *link = chunk->next;
+    releaseChunk(chunk);
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Bump allocator for the short-lived objects of section building: paragraph words, laid out lines and page elements.
+//
+// Layout used to allocate and free thousands of small blocks per chapter, interleaved with longer-lived allocations,
+// which leaves the heap split into pieces too small for the 32 KB inflate ring buffer. The arena carves these blocks
+// out of a few CHUNK_SIZE chunks instead. Each chunk counts its live allocations and a chunk whose count drops to zero
+// is rewound or recycled. Freeing a block from the current chunk is a decrement; a block from an older chunk first
+// walks the list of retired chunks that still hold live blocks. That list only holds the pages not yet serialized, so
+// it stays a handful of chunks long. Once a page is serialized and dropped, the chunks it used are free again, even
+// while the next page has already started in a newer chunk.
+//
+// Blocks larger than MAX_BLOCK_SIZE (the word list of a long paragraph) are passed on to the heap, and so are the Page
+// objects themselves and their element lists: only the lines and their contents come from the arena. Like the standard
+// containers it serves, the arena aborts when the heap is exhausted.
+class LayoutArena final : public std::pmr::memory_resource {
+ public:
+  static constexpr size_t CHUNK_SIZE = 4096;
+  static constexpr size_t MAX_BLOCK_SIZE = 512;
+
+  LayoutArena() = default;
+  ~LayoutArena() override;
+  LayoutArena(const LayoutArena&) = delete;
+  LayoutArena& operator=(const LayoutArena&) = delete;
+
+  // Chunks held right now (in use and spare) and the most held at once
+  size_t chunkCount() const { return chunks; }
+  size_t peakChunkCount() const { return peakChunks; }
+
+ private:
+  struct Chunk {
+    Chunk* next;
+    uint16_t used;  // bump offset from the chunk start, including this header
+    uint16_t live;  // blocks handed out and not yet returned
+  };
+  static constexpr size_t BLOCK_ALIGN = alignof(std::max_align_t);
+  static constexpr size_t HEADER_SIZE = (sizeof(Chunk) + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+
+  Chunk* current = nullptr;  // chunk being bumped
+  Chunk* retired = nullptr;  // full chunks that still have live blocks, newest first
+  Chunk* spare = nullptr;    // one emptied chunk kept for reuse
+  size_t chunks = 0;
+  size_t peakChunks = 0;
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  Chunk* takeChunk();
+  void releaseChunk(Chunk* chunk);
+  static bool contains(const Chunk* chunk, const void* p);
+};
@@ -0,0 +1,76 @@
+#include "PackBits.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace PackBits {
+
+namespace {
+constexpr size_t MAX_RECORD = 128;
+
+size_t runLength(const uint8_t* src, const size_t remaining) {
+  const size_t limit = std::min(remaining, MAX_RECORD);
+  size_t run = 1;
+  while (run < limit && src[run] == src[0]) {
+    run++;
+  }
+  return run;
+}
+}  // namespace
+
+size_t encode(const uint8_t* src, const size_t length, uint8_t* dst) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < length) {
+    const size_t run = runLength(src + in, length - in);
+    if (run >= 3) {
+      dst[out++] = static_cast<uint8_t>(257 - run);
+      dst[out++] = src[in];
+      in += run;
+      continue;
+    }
+
+    // Literal record: extend until the next run worth encoding or the record limit
+    const size_t start = in;
+    in += run;
+    while (in < length && in - start < MAX_RECORD) {
+      const size_t next = runLength(src + in, length - in);
+      if (next >= 3) break;
+      in = std::min(in + next, start + MAX_RECORD);
+    }
+    const size_t literal = in - start;
+    dst[out++] = static_cast<uint8_t>(literal - 1);
+    memcpy(dst + out, src + start, literal);
+    out += literal;
+  }
+  return out;
+}
+
+bool Decoder::feed(const uint8_t* data, const size_t length) {
+  size_t in = 0;
+  while (in < length) {
+    if (literalLeft > 0) {
+      const size_t count = std::min<size_t>(literalLeft, length - in);
+      if (count > outSize - written) return false;
+      memcpy(out + written, data + in, count);
+      written += count;
+      in += count;
+      literalLeft -= count;
+    } else if (repeatCount > 0) {
+      if (repeatCount > outSize - written) return false;
+      memset(out + written, data[in++], repeatCount);
+      written += repeatCount;
+      repeatCount = 0;
+    } else {
+      const uint8_t header = data[in++];
+      if (header < 128) {
+        literalLeft = header + 1;
+      } else if (header > 128) {
+        repeatCount = 257 - header;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace PackBits
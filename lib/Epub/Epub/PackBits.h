@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// PackBits run-length coding (as in TIFF/MacPaint), used for cached page bitmaps.
+//
+// A record starts with a header byte n: 0..127 copies the next n + 1 bytes, 129..255 repeats the next byte 257 - n
+// times, and 128 is skipped. Rendered text pages are mostly long runs of white, which collapse to two bytes per 128.
+namespace PackBits {
+
+// Largest encoding of `length` bytes: one header per 128 literal bytes
+constexpr size_t maxEncodedSize(const size_t length) { return length + (length + 127) / 128; }
+
+// Encodes `length` bytes of `src` into `dst`, which must hold maxEncodedSize(length) bytes. Returns the encoded size.
+size_t encode(const uint8_t* src, size_t length, uint8_t* dst);
+
+// Incremental decoder: encoded data can be fed in pieces of any size, split anywhere.
+class Decoder {
+ public:
+  Decoder(uint8_t* out, const size_t outSize) : out(out), outSize(outSize) {}
+
+  // Returns false if the data would write past the end of the output
+  bool feed(const uint8_t* data, size_t length);
+  bool done() const { return written == outSize; }
+
+ private:
+  uint8_t* out;
+  size_t outSize;
+  size_t written = 0;
+  uint8_t literalLeft = 0;  // literal bytes still to copy from the current record
+  uint8_t repeatCount = 0;  // repeat record waiting for its byte
+};
+
+}  // namespace PackBits
@@ -0,0 +1,150 @@
+#include "PageImagePrefetcher.h"
+
+#include <Arduino.h>
+#include <GfxRenderer.h>
+#include <HalStorage.h>
+#include <Logging.h>
+
+#include "Section.h"
+
+namespace {
+constexpr uint32_t PREFETCH_STACK_SIZE = 8192;  // same as the render task, the decoders run on it
+constexpr unsigned long PREFETCH_START_DELAY_MS = 600;
+constexpr unsigned long PREFETCH_POLL_MS = 20;
+// Heap floor: keep enough for the foreground (section builds, CSS, fonts) on top of what one decode needs
+constexpr size_t PREFETCH_MIN_FREE_HEAP = 96 * 1024;
+constexpr size_t PREFETCH_MAX_ALLOC_HEADROOM = 16 * 1024;
+}  // namespace
+
+PageImagePrefetcher::PageImagePrefetcher(GfxRenderer& renderer)
+    : renderer(renderer), jobMutex(xSemaphoreCreateMutex()) {}
+
+PageImagePrefetcher::~PageImagePrefetcher() {
+  if (!jobMutex) {
+    return;
+  }
+  xSemaphoreTake(jobMutex, portMAX_DELAY);
+  stopLocked();
+  xSemaphoreGive(jobMutex);
+  if (worker) {
+    shutdownRequested = true;
+    xTaskNotifyGive(worker);
+    while (!workerExited) {
+      delay(1);
+    }
+  }
+  vSemaphoreDelete(jobMutex);
+}
+
+void PageImagePrefetcher::start(std::shared_ptr<Epub> epub, std::vector<Item> items) {
+  if (!jobMutex) {
+    return;
+  }
+  xSemaphoreTake(jobMutex, portMAX_DELAY);
+  stopLocked();
+  if (items.empty()) {
+    xSemaphoreGive(jobMutex);
+    return;
+  }
+  if (!worker &&
+      xTaskCreate(&taskTrampoline, "ImagePrefetch", PREFETCH_STACK_SIZE, this, tskIDLE_PRIORITY, &worker) != pdPASS) {
+    LOG_ERR("IMP", "Failed to create image prefetch task");
+    worker = nullptr;
+    xSemaphoreGive(jobMutex);
+    return;
+  }
+  pendingEpub = std::move(epub);
+  pendingItems = std::move(items);
+  xSemaphoreGive(jobMutex);
+  xTaskNotifyGive(worker);
+}
+
+void PageImagePrefetcher::cancel() {
+  if (!jobMutex) {
+    return;
+  }
+  xSemaphoreTake(jobMutex, portMAX_DELAY);
+  stopLocked();
+  xSemaphoreGive(jobMutex);
+}
+
+void PageImagePrefetcher::stopLocked() {
+  pendingItems.clear();
+  pendingEpub.reset();
+  if (!busy) {
+    return;
+  }
+  // The worker only takes jobMutex to pick up a job, so it can finish while we hold it
+  abortRequested = true;
+  while (busy) {
+    delay(1);
+  }
+  abortRequested = false;
+}
+
+void PageImagePrefetcher::taskTrampoline(void* param) {
+  static_cast<PageImagePrefetcher*>(param)->workerLoop();
+  vTaskDelete(nullptr);
+}
+
+void PageImagePrefetcher::workerLoop() {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (shutdownRequested) {
+      // Nothing may touch `this` after this point: the destructor returns and the owner goes away
+      workerExited = true;
+      return;
+    }
+
+    xSemaphoreTake(jobMutex, portMAX_DELAY);
+    std::shared_ptr<Epub> epub = std::move(pendingEpub);
+    std::vector<Item> items = std::move(pendingItems);
+    pendingEpub.reset();
+    pendingItems.clear();
+    busy = !items.empty();
+    xSemaphoreGive(jobMutex);
+
+    if (items.empty()) {
+      continue;
+    }
+    run(*epub, items);
+    // Let go of the book before reporting idle, so cancel() returning means the worker holds no reference
+    items.clear();
+    epub.reset();
+    busy = false;
+  }
+}
+
+bool PageImagePrefetcher::waitIdle() const {
+  // Let the page that was just rendered finish refreshing before competing for the SD card
+  for (unsigned long waited = 0; waited < PREFETCH_START_DELAY_MS; waited += PREFETCH_POLL_MS) {
+    if (abortRequested) return false;
+    delay(PREFETCH_POLL_MS);
+  }
+  return !abortRequested;
+}
+
+void PageImagePrefetcher::run(const Epub& epub, const std::vector<Item>& items) {
+  if (!waitIdle()) {
+    return;
+  }
+
+  for (const auto& item : items) {
+    if (abortRequested) return;
+    if (Storage.exists(item.image.getPixelCachePath().c_str())) continue;
+
+    const size_t cacheBytes = static_cast<size_t>((item.image.getWidth() + 3) / 4) * item.image.getHeight();
+    if (ESP.getFreeHeap() < PREFETCH_MIN_FREE_HEAP ||
+        ESP.getMaxAllocHeap() < cacheBytes + PREFETCH_MAX_ALLOC_HEADROOM) {
+      LOG_DBG("IMP", "Low heap (%u free, %u max block), stopping prefetch", ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+      return;
+    }
+
+    if (!Section::extractImage(epub, item.image, &abortRequested)) continue;
+
+    const unsigned long start = millis();
+    if (item.image.renderToCache(renderer, item.x, item.y, &abortRequested)) {
+      LOG_DBG("IMP", "Prefetched %s in %lu ms", item.image.getImagePath().c_str(), millis() - start);
+    }
+  }
+}
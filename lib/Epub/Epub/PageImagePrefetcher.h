@@ -0,0 +1,57 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Epub.h"
+#include "blocks/ImageBlock.h"
+
+class GfxRenderer;
+
+// Decodes the images of upcoming pages into their pixel caches while the reader sits idle, so an illustrated page
+// shows up as fast as a cached one on first display.
+//
+// The work runs in one lowest-priority worker task that never draws; it is created on the first start() and sleeps on
+// a task notification between jobs. It gives up when the heap runs low, and cancel() stops it within one decoder
+// callback. start() and cancel() may be called from any task (the render task and the main loop both do); the pending
+// job is guarded by a mutex. Call cancel() before rendering or before the section/book goes away.
+class PageImagePrefetcher {
+ public:
+  struct Item {
+    ImageBlock image;
+    int16_t x;  // screen position the page will render the image at (the dither pattern depends on it)
+    int16_t y;
+  };
+
+  explicit PageImagePrefetcher(GfxRenderer& renderer);
+  ~PageImagePrefetcher();
+  PageImagePrefetcher(const PageImagePrefetcher&) = delete;
+  PageImagePrefetcher& operator=(const PageImagePrefetcher&) = delete;
+
+  // Replaces any pending work with `items` (nearest page first) and wakes the worker, which waits a short idle delay.
+  void start(std::shared_ptr<Epub> epub, std::vector<Item> items);
+  // Stops the current job and blocks until the worker is idle. Any half-written cache file is discarded by the decoder.
+  void cancel();
+
+ private:
+  GfxRenderer& renderer;
+  SemaphoreHandle_t jobMutex = nullptr;  // guards pendingEpub/pendingItems and serializes cancel()
+  TaskHandle_t worker = nullptr;
+  // The next job, handed over to the worker under jobMutex
+  std::shared_ptr<Epub> pendingEpub;
+  std::vector<Item> pendingItems;
+  std::atomic<bool> abortRequested{false};
+  std::atomic<bool> busy{false};  // set under jobMutex when the worker takes a job, cleared once it let go of it
+  std::atomic<bool> shutdownRequested{false};
+  std::atomic<bool> workerExited{false};
+
+  static void taskTrampoline(void* param);
+  void workerLoop();
+  void stopLocked();
+  void run(const Epub& epub, const std::vector<Item>& items);
+  bool waitIdle() const;
+};
@@ -0,0 +1,201 @@
+#include "PageRasterCache.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+#include "PackBits.h"
+
+namespace {
+constexpr uint8_t RASTER_FILE_VERSION = 1;
+constexpr uint32_t HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint32_t);
+// Planes are encoded in pieces of this size so the encode buffer stays small
+constexpr size_t ENCODE_CHUNK = 2048;
+}  // namespace
+
+bool PageRasterCache::open(const std::string& path, const uint32_t key, const uint16_t pageCount,
+                           const uint32_t bufferSize) {
+  close();
+  if (pageCount == 0 || PackBits::maxEncodedSize(bufferSize) > UINT16_MAX) {
+    return false;
+  }
+
+  entries.assign(pageCount, Entry{});
+  const size_t tableSize = pageCount * sizeof(Entry);
+  FsFile file;
+  if (Storage.openFileForRead("PRC", path, file)) {
+    uint8_t version = 0;
+    uint32_t fileKey = 0;
+    uint16_t filePageCount = 0;
+    uint32_t fileBufferSize = 0;
+    if (file.size() >= HEADER_SIZE + tableSize) {
+      serialization::readPod(file, version);
+      serialization::readPod(file, fileKey);
+      serialization::readPod(file, filePageCount);
+      serialization::readPod(file, fileBufferSize);
+    }
+    const bool valid = version == RASTER_FILE_VERSION && fileKey == key && filePageCount == pageCount &&
+                       fileBufferSize == bufferSize &&
+                       file.read(entries.data(), tableSize) == static_cast<int>(tableSize);
+    file.close();
+    if (valid) {
+      filePath = path;
+      this->bufferSize = bufferSize;
+      return true;
+    }
+    LOG_DBG("PRC", "Raster cache is stale, starting over");
+    entries.assign(pageCount, Entry{});
+  }
+
+  if (!Storage.openFileForWrite("PRC", path, file)) {
+    entries.clear();
+    return false;
+  }
+  serialization::writePod(file, RASTER_FILE_VERSION);
+  serialization::writePod(file, key);
+  serialization::writePod(file, pageCount);
+  serialization::writePod(file, bufferSize);
+  const bool ok = file.write(entries.data(), tableSize) == tableSize;
+  file.close();
+  if (!ok) {
+    LOG_ERR("PRC", "Failed to create raster cache");
+    Storage.remove(path.c_str());
+    entries.clear();
+    return false;
+  }
+  filePath = path;
+  this->bufferSize = bufferSize;
+  return true;
+}
+
+void PageRasterCache::close() {
+  filePath.clear();
+  entries.clear();
+  entries.shrink_to_fit();
+  pendingPage = -1;
+}
+
+bool PageRasterCache::hasPage(const uint16_t page, const bool withGray) const {
+  if (page >= entries.size()) return false;
+  const Entry& entry = entries[page];
+  if (entry.offset == 0 || entry.offset == SKIPPED || entry.size[BW] == 0) return false;
+  return !withGray || (entry.size[GRAY_LSB] > 0 && entry.size[GRAY_MSB] > 0);
+}
+
+int PageRasterCache::nextPageToFill(const uint16_t from) const {
+  const size_t count = entries.size();
+  for (size_t i = 0; i < count; i++) {
+    const size_t page = (from + i) % count;
+    if (entries[page].offset == 0) return static_cast<int>(page);
+  }
+  return -1;
+}
+
+bool PageRasterCache::skipPage(const uint16_t page) {
+  if (page >= entries.size()) return false;
+  Entry entry{};
+  entry.offset = SKIPPED;
+  if (!writeEntry(page, entry)) return false;
+  entries[page] = entry;
+  return true;
+}
+
+bool PageRasterCache::dropPage(const uint16_t page) {
+  if (page >= entries.size()) return false;
+  const Entry entry{};
+  if (!writeEntry(page, entry)) return false;
+  entries[page] = entry;
+  return true;
+}
+
+bool PageRasterCache::readPlane(const uint16_t page, const Plane plane, uint8_t* frame) const {
+  if (!hasPage(page, false) || entries[page].size[plane] == 0) {
+    return false;
+  }
+  const Entry& entry = entries[page];
+  uint32_t offset = entry.offset;
+  for (uint8_t i = 0; i < plane; i++) {
+    offset += entry.size[i];
+  }
+
+  FsFile file;
+  if (!Storage.openFileForRead("PRC", filePath, file)) {
+    return false;
+  }
+  bool ok = file.seek(offset);
+  PackBits::Decoder decoder(frame, bufferSize);
+  uint8_t chunk[512];
+  size_t left = entry.size[plane];
+  while (ok && left > 0) {
+    const size_t length = std::min(left, sizeof(chunk));
+    ok = file.read(chunk, length) == static_cast<int>(length) && decoder.feed(chunk, length);
+    left -= length;
+  }
+  file.close();
+  if (!ok || !decoder.done()) {
+    LOG_ERR("PRC", "Failed to read plane %u of page %u", plane, page);
+    return false;
+  }
+  return true;
+}
+
+bool PageRasterCache::appendPlane(const uint16_t page, const Plane plane, const uint8_t* frame) {
+  if (page >= entries.size()) return false;
+  if (plane == BW) {
+    pending = Entry{};
+    pendingPage = page;
+  } else if (pendingPage != page || pending.size[plane - 1] == 0) {
+    return false;
+  }
+
+  std::unique_ptr<uint8_t[]> encoded(new (std::nothrow) uint8_t[PackBits::maxEncodedSize(ENCODE_CHUNK)]);
+  FsFile file = Storage.open(filePath.c_str(), O_RDWR);
+  if (!encoded || !file) {
+    pendingPage = -1;
+    return false;
+  }
+  const size_t end = file.size();
+  bool ok = file.seek(end);
+  size_t total = 0;
+  for (size_t offset = 0; ok && offset < bufferSize; offset += ENCODE_CHUNK) {
+    const size_t length = PackBits::encode(frame + offset, std::min(ENCODE_CHUNK, bufferSize - offset), encoded.get());
+    ok = file.write(encoded.get(), length) == length;
+    total += length;
+  }
+  file.close();
+  if (!ok || total > UINT16_MAX) {
+    LOG_ERR("PRC", "Failed to store plane %u of page %u", plane, page);
+    pendingPage = -1;
+    return false;
+  }
+
+  if (plane == BW) {
+    pending.offset = end;
+  }
+  pending.size[plane] = static_cast<uint16_t>(total);
+  return true;
+}
+
+bool PageRasterCache::commitPage(const uint16_t page) {
+  if (pendingPage != page || !writeEntry(page, pending)) {
+    pendingPage = -1;
+    return false;
+  }
+  entries[page] = pending;
+  pendingPage = -1;
+  return true;
+}
+
+bool PageRasterCache::writeEntry(const uint16_t page, const Entry& entry) {
+  FsFile file = Storage.open(filePath.c_str(), O_RDWR);
+  if (!file) {
+    return false;
+  }
+  const bool ok = file.seek(HEADER_SIZE + page * sizeof(Entry)) && file.write(&entry, sizeof(Entry)) == sizeof(Entry);
+  file.close();
+  return ok;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pre-rendered pages of one section, stored next to the section file as PackBits-compressed frame buffer planes.
+//
+// Each cached page holds its black/white plane and, when anti-aliasing is on, the two grayscale planes, exactly as
+// the renderer leaves them in the frame buffer (physical panel orientation, status bar not included). Showing a
+// cached page is then a read and a decode per plane instead of deserializing, prewarming and rasterizing the page
+// three times.
+//
+// The file starts with the caller's key (a hash of everything that affects the pixels), the page count and the frame
+// size; a mismatch on any of them starts the cache over. A table of one entry per page follows, then the plane data in
+// the order pages were filled. Pages are added one at a time with appendPlane() and commitPage(), so an interrupted
+// fill only loses the page in progress.
+class PageRasterCache {
+ public:
+  enum Plane : uint8_t { BW, GRAY_LSB, GRAY_MSB, PLANE_COUNT };
+
+  // Opens the cache at `path`, starting a new one when it is missing or was made for another key or layout
+  bool open(const std::string& path, uint32_t key, uint16_t pageCount, uint32_t bufferSize);
+  void close();
+  bool isOpen() const { return !filePath.empty(); }
+
+  // True when `page` is cached with all the planes needed (BW, plus the gray planes if `withGray`)
+  bool hasPage(uint16_t page, bool withGray) const;
+  // First page at or after `from`, wrapping around, that is neither cached nor skipped; -1 when the cache is complete
+  int nextPageToFill(uint16_t from) const;
+  // Records that `page` is not cached (e.g. it has images) so nextPageToFill() passes over it
+  bool skipPage(uint16_t page);
+  // Forgets a cached page whose planes could not be read back, so it is filled again
+  bool dropPage(uint16_t page);
+
+  // Decodes one plane of a cached page into `frame` (bufferSize bytes)
+  bool readPlane(uint16_t page, Plane plane, uint8_t* frame) const;
+  // Page fill: append the BW plane and optionally both gray planes, in order, then commit the page
+  bool appendPlane(uint16_t page, Plane plane, const uint8_t* frame);
+  bool commitPage(uint16_t page);
+
+ private:
+#pragma pack(push, 1)
+  struct Entry {
+    uint32_t offset;  // 0 = not cached, SKIPPED = never cached
+    uint16_t size[PLANE_COUNT];
+  };
+#pragma pack(pop)
+  static constexpr uint32_t SKIPPED = UINT32_MAX;
+
+  std::string filePath;
+  uint32_t bufferSize = 0;
+  std::vector<Entry> entries;
+  Entry pending{};  // page being filled
+  int pendingPage = -1;
+
+  bool writeEntry(uint16_t page, const Entry& entry);
+};
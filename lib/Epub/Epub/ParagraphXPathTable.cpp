@@ -0,0 +1,277 @@
+#include "ParagraphXPathTable.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+constexpr uint8_t TABLE_FILE_VERSION = 1;
+constexpr size_t MAX_PATH_DEPTH = UINT8_MAX;
+
+const char* localName(const char* name) {
+  const char* local = strrchr(name, ':');
+  return local ? local + 1 : name;
+}
+}  // namespace
+
+void ParagraphXPathTable::startElement(const char* rawName) {
+  const char* name = localName(rawName);
+  if (!insideBody) {
+    if (strcmp(name, "body") == 0) {
+      insideBody = true;
+      bodyDepth = depth;
+      siblings.emplace_back();
+    }
+    depth++;
+    return;
+  }
+
+  uint16_t index = 1;
+  auto& children = siblings.back();
+  bool seen = false;
+  for (auto& child : children) {
+    if (child.name == name) {
+      index = ++child.count;
+      seen = true;
+      break;
+    }
+  }
+  if (!seen) {
+    children.push_back({name, 1});
+  }
+  path.push_back({name, index});
+  siblings.emplace_back();
+  depth++;
+}
+
+void ParagraphXPathTable::endElement(const char* rawName) {
+  depth--;
+  if (!insideBody) {
+    return;
+  }
+
+  if (depth == bodyDepth && strcmp(localName(rawName), "body") == 0) {
+    insideBody = false;
+    path.clear();
+    siblings.clear();
+    paragraphDepth = 0;
+    return;
+  }
+
+  if (!path.empty()) {
+    path.pop_back();
+  }
+  if (!siblings.empty()) {
+    siblings.pop_back();
+  }
+  if (path.size() < paragraphDepth) {
+    paragraphDepth = 0;
+  }
+}
+
+void ParagraphXPathTable::addParagraph() {
+  const size_t length = std::min(path.size(), MAX_PATH_DEPTH);
+  size_t kept = 0;
+  while (kept < length && kept < lastParagraphPath.size() && lastParagraphPath[kept].name == path[kept].name &&
+         lastParagraphPath[kept].index == path[kept].index) {
+    kept++;
+  }
+
+  encodedPaths.push_back(static_cast<uint8_t>(kept));
+  encodedPaths.push_back(static_cast<uint8_t>(length - kept));
+  for (size_t i = kept; i < length; i++) {
+    const auto& segment = path[i];
+    const size_t nameLength = std::min(segment.name.size(), static_cast<size_t>(UINT8_MAX));
+    encodedPaths.push_back(static_cast<uint8_t>(nameLength));
+    encodedPaths.insert(encodedPaths.end(), segment.name.begin(), segment.name.begin() + nameLength);
+    encodedPaths.push_back(static_cast<uint8_t>(segment.index & 0xFF));
+    encodedPaths.push_back(static_cast<uint8_t>(segment.index >> 8));
+  }
+
+  lastParagraphPath.assign(path.begin(), path.begin() + length);
+  paragraphDepth = insideBody ? path.size() : 0;
+  paragraphCount++;
+}
+
+void ParagraphXPathTable::setPageStart(const uint16_t page, const TextPosition position) {
+  if (page >= pageStarts.size()) {
+    pageStarts.resize(page + 1);
+  }
+  pageStarts[page] = position;
+}
+
+bool ParagraphXPathTable::write(const std::string& filePath, const uint16_t pageCount) const {
+  FsFile file;
+  if (!Storage.openFileForWrite("PXT", filePath, file)) {
+    return false;
+  }
+
+  serialization::writePod(file, TABLE_FILE_VERSION);
+  serialization::writePod(file, pageCount);
+  serialization::writePod(file, paragraphCount);
+  serialization::writePod(file, static_cast<uint32_t>(encodedPaths.size()));
+  bool ok = true;
+  for (uint16_t page = 0; page < pageCount; page++) {
+    const TextPosition position = page < pageStarts.size() ? pageStarts[page] : TextPosition{};
+    ok = file.write(reinterpret_cast<const uint8_t*>(&position), sizeof(position)) == sizeof(position) && ok;
+  }
+  ok = ok && file.write(encodedPaths.data(), encodedPaths.size()) == encodedPaths.size();
+  file.close();
+  if (!ok) {
+    LOG_ERR("PXT", "Failed to write paragraph table");
+    Storage.remove(filePath.c_str());
+  }
+  return ok;
+}
+
+bool ParagraphXPathTable::load(const std::string& filePath) {
+  pageStarts.clear();
+  encodedPaths.clear();
+  paragraphCount = 0;
+
+  FsFile file;
+  if (!Storage.openFileForRead("PXT", filePath, file)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  uint16_t pageCount = 0;
+  uint16_t paragraphs = 0;
+  uint32_t pathsSize = 0;
+  serialization::readPod(file, version);
+  serialization::readPod(file, pageCount);
+  serialization::readPod(file, paragraphs);
+  serialization::readPod(file, pathsSize);
+  const size_t pagesSize = pageCount * sizeof(TextPosition);
+  const size_t headerSize = sizeof(version) + sizeof(pageCount) + sizeof(paragraphs) + sizeof(pathsSize);
+  if (version != TABLE_FILE_VERSION || file.size() != headerSize + pagesSize + pathsSize) {
+    file.close();
+    LOG_DBG("PXT", "Paragraph table is stale or incomplete");
+    return false;
+  }
+
+  pageStarts.resize(pageCount);
+  encodedPaths.resize(pathsSize);
+  const bool ok = file.read(pageStarts.data(), pagesSize) == static_cast<int>(pagesSize) &&
+                  file.read(encodedPaths.data(), pathsSize) == static_cast<int>(pathsSize);
+  file.close();
+  if (!ok) {
+    pageStarts.clear();
+    encodedPaths.clear();
+    return false;
+  }
+  paragraphCount = paragraphs;
+  return true;
+}
+
+ParagraphXPathTable::TextPosition ParagraphXPathTable::getPageStart(const uint16_t page) const {
+  return page < pageStarts.size() ? pageStarts[page] : TextPosition{};
+}
+
+uint16_t ParagraphXPathTable::findPage(const TextPosition position) const {
+  uint16_t result = 0;
+  for (size_t page = 0; page < pageStarts.size(); page++) {
+    const TextPosition& start = pageStarts[page];
+    if (start.paragraph == 0) {
+      continue;
+    }
+    if (start.paragraph > position.paragraph ||
+        (start.paragraph == position.paragraph && start.offset > position.offset)) {
+      break;
+    }
+    result = static_cast<uint16_t>(page);
+  }
+  return result;
+}
+
+template <typename Fn>
+void ParagraphXPathTable::forEachPath(Fn&& fn) const {
+  std::vector<Segment> current;
+  size_t pos = 0;
+  const size_t size = encodedPaths.size();
+  for (uint16_t paragraph = 1; paragraph <= paragraphCount && pos + 2 <= size; paragraph++) {
+    const uint8_t kept = encodedPaths[pos];
+    const uint8_t added = encodedPaths[pos + 1];
+    pos += 2;
+    if (kept > current.size()) {
+      return;
+    }
+    current.resize(kept);
+    for (uint8_t i = 0; i < added; i++) {
+      if (pos >= size || pos + 1 + encodedPaths[pos] + 2 > size) {
+        return;
+      }
+      const uint8_t nameLength = encodedPaths[pos++];
+      Segment segment;
+      segment.name.assign(reinterpret_cast<const char*>(encodedPaths.data() + pos), nameLength);
+      pos += nameLength;
+      segment.index = static_cast<uint16_t>(encodedPaths[pos] | (encodedPaths[pos + 1] << 8));
+      pos += 2;
+      current.push_back(std::move(segment));
+    }
+    if (!fn(paragraph, current)) {
+      return;
+    }
+  }
+}
+
+std::string ParagraphXPathTable::getParagraphPath(const uint16_t paragraph) const {
+  std::string result;
+  if (paragraph == 0) {
+    return result;
+  }
+  forEachPath([&](const uint16_t index, const std::vector<Segment>& segments) {
+    if (index < paragraph) {
+      return true;
+    }
+    for (const auto& segment : segments) {
+      result += "/" + segment.name + "[" + std::to_string(segment.index) + "]";
+    }
+    return false;
+  });
+  return result;
+}
+
+uint16_t ParagraphXPathTable::findParagraph(const std::string& elementPath) const {
+  // Split "/div[2]/p[4]/span" into segments; an index that is left out is the first sibling
+  std::vector<Segment> target;
+  size_t pos = 0;
+  while (pos < elementPath.size() && elementPath[pos] == '/') {
+    const size_t end = std::min(elementPath.find('/', pos + 1), elementPath.size());
+    const size_t bracket = elementPath.find('[', pos + 1);
+    Segment segment;
+    segment.index = 1;
+    if (bracket < end) {
+      segment.name = elementPath.substr(pos + 1, bracket - pos - 1);
+      segment.index = static_cast<uint16_t>(strtoul(elementPath.c_str() + bracket + 1, nullptr, 10));
+    } else {
+      segment.name = elementPath.substr(pos + 1, end - pos - 1);
+    }
+    if (segment.name.empty() || segment.name.find('(') != std::string::npos) {
+      break;  // text() or another non-element step
+    }
+    target.push_back(std::move(segment));
+    pos = end;
+  }
+
+  uint16_t result = 0;
+  size_t resultDepth = 0;
+  forEachPath([&](const uint16_t paragraph, const std::vector<Segment>& segments) {
+    if (segments.empty() || segments.size() > target.size() || segments.size() <= resultDepth) {
+      return true;
+    }
+    for (size_t i = 0; i < segments.size(); i++) {
+      if (segments[i].index != target[i].index || segments[i].name != target[i].name) {
+        return true;
+      }
+    }
+    result = paragraph;
+    resultDepth = segments.size();
+    return resultDepth < target.size();
+  });
+  return result;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Element path of every paragraph of a section and the text position every page starts at, recorded while the section
+// is built so KOReader progress sync can map pages to XPaths and back without parsing the chapter again.
+//
+// Paragraphs are numbered like ChapterHtmlSlimParser's paragraph LUT (1-based, one per <p>) and their paths follow
+// ChapterXPathResolver: every element inside <body> counts towards its parent's per-name sibling index, hidden or not.
+// Each path is stored as a delta against the previous paragraph's (segments kept plus segments added), which for
+// typical chapters is a handful of bytes per paragraph.
+//
+// The table lives next to the section file and is rewritten whenever the section is.
+class ParagraphXPathTable {
+ public:
+  // Where a page's first line starts: a codepoint offset into `paragraph`, or AFTER_PARAGRAPH for text that follows
+  // it outside of any paragraph (headings, list items...). Paragraph 0 marks pages that do not start with text.
+  struct TextPosition {
+    uint16_t paragraph = 0;
+    uint16_t offset = 0;
+  };
+  static constexpr uint16_t AFTER_PARAGRAPH = UINT16_MAX;
+
+  // Recording, driven by the chapter parser for every element it sees, including skipped ones
+  void startElement(const char* name);
+  void endElement(const char* name);
+  // The element just started is the next paragraph
+  void addParagraph();
+  bool insideParagraph() const { return paragraphDepth > 0; }
+  void setPageStart(uint16_t page, TextPosition position);
+  bool write(const std::string& path, uint16_t pageCount) const;
+
+  // Lookups on a written table
+  bool load(const std::string& path);
+  uint16_t getPageCount() const { return static_cast<uint16_t>(pageStarts.size()); }
+  uint16_t getParagraphCount() const { return paragraphCount; }
+  TextPosition getPageStart(uint16_t page) const;
+  // Last page starting at or before `position`
+  uint16_t findPage(TextPosition position) const;
+  // Path of a paragraph below <body>, e.g. "/div[2]/p[4]"; empty when there is no such paragraph
+  std::string getParagraphPath(uint16_t paragraph) const;
+  // Paragraph whose path is the longest prefix of `elementPath` (a missing [N] counts as [1]); 0 when none matches
+  uint16_t findParagraph(const std::string& elementPath) const;
+
+ private:
+  struct Segment {
+    std::string name;
+    uint16_t index;
+  };
+  struct NameCounter {
+    std::string name;
+    uint16_t count;
+  };
+
+  // Recording state
+  bool insideBody = false;
+  int depth = 0;
+  int bodyDepth = -1;
+  size_t paragraphDepth = 0;  // path length of the open paragraph, 0 outside one
+  std::vector<Segment> path;
+  std::vector<std::vector<NameCounter>> siblings;  // per open element (and <body>), its children seen so far
+  std::vector<Segment> lastParagraphPath;
+
+  // Encoded paragraph paths and page starts, recorded or loaded
+  std::vector<uint8_t> encodedPaths;
+  uint16_t paragraphCount = 0;
+  std::vector<TextPosition> pageStarts;
+
+  // Calls fn(paragraph, path) for each paragraph in order until it returns false
+  template <typename Fn>
+  void forEachPath(Fn&& fn) const;
+};
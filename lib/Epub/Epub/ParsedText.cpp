@@ -20,7 +20,7 @@ constexpr char SOFT_HYPHEN_UTF8[] = "\xC2\xAD";
 constexpr size_t SOFT_HYPHEN_BYTES = 2;
 
 // Returns the first rendered codepoint of a word (skipping leading soft hyphens).
-uint32_t firstCodepoint(const std::string& word) {
+uint32_t firstCodepoint(const std::pmr::string& word) {
   const auto* ptr = reinterpret_cast<const unsigned char*>(word.c_str());
   while (true) {
     const uint32_t cp = utf8NextCodepoint(&ptr);
@@ -30,7 +30,7 @@ uint32_t firstCodepoint(const std::string& word) {
 }
 
 // Returns the last codepoint of a word by scanning backward for the start of the last UTF-8 sequence.
-uint32_t lastCodepoint(const std::string& word) {
+uint32_t lastCodepoint(const std::pmr::string& word) {
   if (word.empty()) return 0;
   // UTF-8 continuation bytes start with 10xxxxxx; scan backward to find the leading byte.
   size_t i = word.size() - 1;
@@ -41,12 +41,12 @@ uint32_t lastCodepoint(const std::string& word) {
   return utf8NextCodepoint(&ptr);
 }
 
-bool containsSoftHyphen(const std::string& word) { return word.find(SOFT_HYPHEN_UTF8) != std::string::npos; }
+bool containsSoftHyphen(const std::pmr::string& word) { return word.find(SOFT_HYPHEN_UTF8) != std::pmr::string::npos; }
 
 // Removes every soft hyphen in-place so rendered glyphs match measured widths.
-void stripSoftHyphensInPlace(std::string& word) {
+void stripSoftHyphensInPlace(std::pmr::string& word) {
   size_t pos = 0;
-  while ((pos = word.find(SOFT_HYPHEN_UTF8, pos)) != std::string::npos) {
+  while ((pos = word.find(SOFT_HYPHEN_UTF8, pos)) != std::pmr::string::npos) {
     word.erase(pos, SOFT_HYPHEN_BYTES);
   }
 }
@@ -54,7 +54,7 @@ void stripSoftHyphensInPlace(std::string& word) {
 // Returns the advance width for a word while ignoring soft hyphen glyphs and optionally appending a visible hyphen.
 // Uses advance width (sum of glyph advances + kerning) rather than bounding box width so that italic glyph overhangs
 // don't inflate inter-word spacing.
-uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::string& word,
+uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::pmr::string& word,
                           const EpdFontFamily::Style style, const bool appendHyphen = false) {
   if (word.size() == 1 && word[0] == ' ' && !appendHyphen) {
     return renderer.getSpaceWidth(fontId, style);
@@ -64,7 +64,7 @@ uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const s
     return renderer.getTextAdvanceX(fontId, word.c_str(), style);
   }
 
-  std::string sanitized = word;
+  std::pmr::string sanitized(word, word.get_allocator());
   if (hasSoftHyphen) {
     stripSoftHyphensInPlace(sanitized);
   }
@@ -76,11 +76,11 @@ uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const s
 
 }  // namespace
 
-void ParsedText::addWord(std::string word, const EpdFontFamily::Style fontStyle, const bool underline,
+void ParsedText::addWord(const std::string_view word, const EpdFontFamily::Style fontStyle, const bool underline,
                          const bool attachToPrevious) {
   if (word.empty()) return;
 
-  words.push_back(std::move(word));
+  words.emplace_back(word);
   EpdFontFamily::Style combinedStyle = fontStyle;
   if (underline) {
     combinedStyle = static_cast<EpdFontFamily::Style>(combinedStyle | EpdFontFamily::UNDERLINE);
@@ -103,13 +103,10 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
   const int pageWidth = viewportWidth;
   auto wordWidths = calculateWordWidths(renderer, fontId);
 
-  std::vector<size_t> lineBreakIndices;
-  if (hyphenationEnabled) {
-    // Use greedy layout that can split words mid-loop when a hyphenated prefix fits.
-    lineBreakIndices = computeHyphenatedLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
-  } else {
-    lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
-  }
+  // Hyphenation uses a greedy layout that can split words mid-loop when a hyphenated prefix fits.
+  const BreakList lineBreakIndices =
+      hyphenationEnabled ? computeHyphenatedLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues)
+                         : computeLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
   const size_t lineCount = includeLastLine ? lineBreakIndices.size() : lineBreakIndices.size() - 1;
 
   for (size_t i = 0; i < lineCount; ++i) {
@@ -125,8 +122,8 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
   }
 }
 
-std::vector<uint16_t> ParsedText::calculateWordWidths(const GfxRenderer& renderer, const int fontId) {
-  std::vector<uint16_t> wordWidths;
+ParsedText::WidthList ParsedText::calculateWordWidths(const GfxRenderer& renderer, const int fontId) {
+  WidthList wordWidths(arena);
   wordWidths.reserve(words.size());
 
   for (size_t i = 0; i < words.size(); ++i) {
@@ -136,10 +133,11 @@ std::vector<uint16_t> ParsedText::calculateWordWidths(const GfxRenderer& rendere
   return wordWidths;
 }
 
-std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, const int fontId, const int pageWidth,
-                                                  std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec) {
+ParsedText::BreakList ParsedText::computeLineBreaks(const GfxRenderer& renderer, const int fontId,
+                                                   const int pageWidth, WidthList& wordWidths,
+                                                   std::pmr::vector<bool>& continuesVec) {
   if (words.empty()) {
-    return {};
+    return BreakList(arena);
   }
 
   // Calculate first line indent (only for left/justified text).
@@ -166,9 +164,9 @@ std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, c
   const size_t totalWordCount = words.size();
 
   // DP table to store the minimum badness (cost) of lines starting at index i
-  std::vector<int> dp(totalWordCount);
+  std::pmr::vector<int> dp(totalWordCount, arena);
   // 'ans[i]' stores the index 'j' of the *last word* in the optimal line starting at 'i'
-  std::vector<size_t> ans(totalWordCount);
+  std::pmr::vector<size_t> ans(totalWordCount, arena);
 
   // Base Case
   dp[totalWordCount - 1] = 0;
@@ -237,7 +235,7 @@ std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, c
   }
 
   // Stores the index of the word that starts the next line (last_word_index + 1)
-  std::vector<size_t> lineBreakIndices;
+  BreakList lineBreakIndices(arena);
   size_t currentWordIndex = 0;
 
   while (currentWordIndex < totalWordCount) {
@@ -271,9 +269,9 @@ void ParsedText::applyParagraphIndent() {
 }
 
 // Builds break indices while opportunistically splitting the word that would overflow the current line.
-std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& renderer, const int fontId,
-                                                            const int pageWidth, std::vector<uint16_t>& wordWidths,
-                                                            std::vector<bool>& continuesVec) {
+ParsedText::BreakList ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& renderer, const int fontId,
+                                                             const int pageWidth, WidthList& wordWidths,
+                                                             std::pmr::vector<bool>& continuesVec) {
   // Calculate first line indent (only for left/justified text).
   // Positive text-indent (paragraph indent) is suppressed when extraParagraphSpacing is on.
   // Negative text-indent (hanging indent, e.g. margin-left:3em; text-indent:-1em) always applies —
@@ -284,7 +282,7 @@ std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& r
           ? blockStyle.textIndent
           : 0;
 
-  std::vector<size_t> lineBreakIndices;
+  BreakList lineBreakIndices(arena);
   size_t currentIndex = 0;
   bool isFirstLine = true;
 
@@ -352,19 +350,28 @@ std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& r
 // Splits words[wordIndex] into prefix (adding a hyphen only when needed) and remainder when a legal breakpoint fits the
 // available width.
 bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availableWidth, const GfxRenderer& renderer,
-                                      const int fontId, std::vector<uint16_t>& wordWidths,
-                                      const bool allowFallbackBreaks) {
+                                      const int fontId, WidthList& wordWidths, const bool allowFallbackBreaks) {
   // Guard against invalid indices or zero available width before attempting to split.
   if (availableWidth <= 0 || wordIndex >= words.size()) {
     return false;
   }
 
-  const std::string& word = words[wordIndex];
+  const std::pmr::string& word = words[wordIndex];
   const auto style = wordStyles[wordIndex];
 
-  // Collect candidate breakpoints (byte offsets and hyphen requirements).
-  auto breakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
-  if (breakInfos.empty()) {
+  // Collect candidate breakpoints (byte offsets and hyphen requirements) into stack storage; only words with more
+  // candidates than fit (long fallback splits) take the allocating path.
+  constexpr size_t MAX_INLINE_BREAKS = 48;
+  Hyphenator::BreakInfo inlineBreaks[MAX_INLINE_BREAKS];
+  std::vector<Hyphenator::BreakInfo> overflowBreaks;
+  const Hyphenator::BreakInfo* breakInfos = inlineBreaks;
+  size_t breakCount = Hyphenator::breakOffsets(word, allowFallbackBreaks, inlineBreaks, MAX_INLINE_BREAKS);
+  if (breakCount > MAX_INLINE_BREAKS) {
+    overflowBreaks = Hyphenator::breakOffsets(std::string(word.data(), word.size()), allowFallbackBreaks);
+    breakInfos = overflowBreaks.data();
+    breakCount = overflowBreaks.size();
+  }
+  if (breakCount == 0) {
     return false;
   }
 
@@ -373,14 +380,16 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   bool chosenNeedsHyphen = true;
 
   // Iterate over each legal breakpoint and retain the widest prefix that still fits.
-  for (const auto& info : breakInfos) {
+  for (size_t i = 0; i < breakCount; ++i) {
+    const auto& info = breakInfos[i];
     const size_t offset = info.byteOffset;
     if (offset == 0 || offset >= word.size()) {
       continue;
     }
 
     const bool needsHyphen = info.requiresInsertedHyphen;
-    const int prefixWidth = measureWordWidth(renderer, fontId, word.substr(0, offset), style, needsHyphen);
+    const int prefixWidth =
+        measureWordWidth(renderer, fontId, std::pmr::string(word, 0, offset, arena), style, needsHyphen);
     if (prefixWidth > availableWidth || prefixWidth <= chosenWidth) {
       continue;  // Skip if too wide or not an improvement
     }
@@ -396,14 +405,15 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   }
 
   // Split the word at the selected breakpoint and append a hyphen if required.
-  std::string remainder = word.substr(chosenOffset);
+  std::pmr::string remainder(word, chosenOffset, std::pmr::string::npos, arena);
   words[wordIndex].resize(chosenOffset);
   if (chosenNeedsHyphen) {
     words[wordIndex].push_back('-');
   }
 
   // Insert the remainder word (with matching style and continuation flag) directly after the prefix.
-  words.insert(words.begin() + wordIndex + 1, remainder);
+  const uint16_t remainderWidth = measureWordWidth(renderer, fontId, remainder, style);
+  words.insert(words.begin() + wordIndex + 1, std::move(remainder));
   wordStyles.insert(wordStyles.begin() + wordIndex + 1, style);
 
   // Continuation flag handling after splitting a word into prefix + remainder.
@@ -430,13 +440,12 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
 
   // Update cached widths to reflect the new prefix/remainder pairing.
   wordWidths[wordIndex] = static_cast<uint16_t>(chosenWidth);
-  const uint16_t remainderWidth = measureWordWidth(renderer, fontId, remainder, style);
   wordWidths.insert(wordWidths.begin() + wordIndex + 1, remainderWidth);
   return true;
 }
 
-void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const std::vector<uint16_t>& wordWidths,
-                             const std::vector<bool>& continuesVec, const std::vector<size_t>& lineBreakIndices,
+void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const WidthList& wordWidths,
+                             const std::pmr::vector<bool>& continuesVec, const BreakList& lineBreakIndices,
                              const std::function<void(std::shared_ptr<TextBlock>)>& processLine,
                              const GfxRenderer& renderer, const int fontId) {
   const size_t lineBreak = lineBreakIndices[breakIndex];
@@ -497,7 +506,7 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
 
   // Pre-calculate X positions for words
   // Continuation words attach to the previous word with no space before them
-  std::vector<int16_t> lineXPos;
+  std::pmr::vector<int16_t> lineXPos(arena);
   lineXPos.reserve(lineWordCount);
 
   for (size_t wordIdx = 0; wordIdx < lineWordCount; wordIdx++) {
@@ -526,9 +535,10 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
   }
 
   // Build line data by moving from the original vectors using index range
-  std::vector<std::string> lineWords(std::make_move_iterator(words.begin() + lastBreakAt),
-                                     std::make_move_iterator(words.begin() + lineBreak));
-  std::vector<EpdFontFamily::Style> lineWordStyles(wordStyles.begin() + lastBreakAt, wordStyles.begin() + lineBreak);
+  std::pmr::vector<std::pmr::string> lineWords(std::make_move_iterator(words.begin() + lastBreakAt),
+                                               std::make_move_iterator(words.begin() + lineBreak), arena);
+  std::pmr::vector<EpdFontFamily::Style> lineWordStyles(wordStyles.begin() + lastBreakAt,
+                                                        wordStyles.begin() + lineBreak, arena);
 
   for (auto& word : lineWords) {
     if (containsSoftHyphen(word)) {
@@ -536,6 +546,6 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
     }
   }
 
-  processLine(
-      std::make_shared<TextBlock>(std::move(lineWords), std::move(lineXPos), std::move(lineWordStyles), blockStyle));
+  processLine(std::allocate_shared<TextBlock>(std::pmr::polymorphic_allocator<TextBlock>(arena), std::move(lineWords),
+                                              std::move(lineXPos), std::move(lineWordStyles), blockStyle));
 }
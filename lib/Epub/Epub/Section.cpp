@@ -2,18 +2,21 @@
 
 #include <HalStorage.h>
 #include <Logging.h>
+#include <Perf.h>
 #include <Serialization.h>
 
 #include "Epub/css/CssParser.h"
 #include "Page.h"
+#include "ParagraphXPathTable.h"
 #include "hyphenation/Hyphenator.h"
 #include "parsers/ChapterHtmlSlimParser.h"
 
 namespace {
-constexpr uint8_t SECTION_FILE_VERSION = 21;
+constexpr uint8_t SECTION_FILE_VERSION = 24;
 constexpr uint32_t HEADER_SIZE = sizeof(uint8_t) + sizeof(int) + sizeof(float) + sizeof(bool) + sizeof(uint8_t) +
                                  sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) + sizeof(bool) +
-                                 sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint32_t);
+                                 sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t) +
+                                 sizeof(uint32_t);
 
 struct PageLutEntry {
   uint32_t fileOffset;
@@ -46,11 +49,12 @@ void Section::writeSectionFileHeader(const int fontId, const float lineCompressi
     LOG_DBG("SCT", "File not open for writing header");
     return;
   }
+  const auto chapterParser = static_cast<uint8_t>(epub->getChapterParser());
   static_assert(HEADER_SIZE == sizeof(SECTION_FILE_VERSION) + sizeof(fontId) + sizeof(lineCompression) +
                                    sizeof(extraParagraphSpacing) + sizeof(paragraphAlignment) + sizeof(viewportWidth) +
                                    sizeof(viewportHeight) + sizeof(pageCount) + sizeof(hyphenationEnabled) +
-                                   sizeof(embeddedStyle) + sizeof(imageRendering) + sizeof(uint32_t) +
-                                   sizeof(uint32_t) + sizeof(uint32_t),
+                                   sizeof(embeddedStyle) + sizeof(imageRendering) + sizeof(chapterParser) +
+                                   sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint32_t),
                 "Header size mismatch");
   serialization::writePod(file, SECTION_FILE_VERSION);
   serialization::writePod(file, fontId);
@@ -62,6 +66,7 @@ void Section::writeSectionFileHeader(const int fontId, const float lineCompressi
   serialization::writePod(file, hyphenationEnabled);
   serialization::writePod(file, embeddedStyle);
   serialization::writePod(file, imageRendering);
+  serialization::writePod(file, chapterParser);
   serialization::writePod(file, pageCount);  // Placeholder for page count (will be initially 0, patched later)
   serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for LUT offset (patched later)
   serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for anchor map offset (patched later)
@@ -96,6 +101,7 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
     bool fileHyphenationEnabled;
     bool fileEmbeddedStyle;
     uint8_t fileImageRendering;
+    uint8_t fileChapterParser;
     serialization::readPod(file, fileFontId);
     serialization::readPod(file, fileLineCompression);
     serialization::readPod(file, fileExtraParagraphSpacing);
@@ -105,12 +111,14 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
     serialization::readPod(file, fileHyphenationEnabled);
     serialization::readPod(file, fileEmbeddedStyle);
     serialization::readPod(file, fileImageRendering);
+    serialization::readPod(file, fileChapterParser);
 
     if (fontId != fileFontId || lineCompression != fileLineCompression ||
         extraParagraphSpacing != fileExtraParagraphSpacing || paragraphAlignment != fileParagraphAlignment ||
         viewportWidth != fileViewportWidth || viewportHeight != fileViewportHeight ||
         hyphenationEnabled != fileHyphenationEnabled || embeddedStyle != fileEmbeddedStyle ||
-        imageRendering != fileImageRendering) {
+        imageRendering != fileImageRendering ||
+        static_cast<uint8_t>(epub->getChapterParser()) != fileChapterParser) {
       // Explicit close() required: member variable persists beyond function scope
       file.close();
       LOG_ERR("SCT", "Deserialization failed: Parameters do not match");
@@ -128,6 +136,7 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
 
 // Your updated class method (assuming you are using the 'SD' object, which is a wrapper for a specific filesystem)
 bool Section::clearCache() const {
+  removeSidecarFiles();
   if (!Storage.exists(filePath.c_str())) {
     LOG_DBG("SCT", "Cache does not exist, no action needed");
     return true;
@@ -142,10 +151,45 @@ bool Section::clearCache() const {
   return true;
 }
 
+std::string Section::getRasterCachePath() const {
+  return epub->getCachePath() + "/sections/" + std::to_string(spineIndex) + ".pages";
+}
+
+std::string Section::getXPathTablePath(const Epub& epub, const int spineIndex) {
+  return epub.getCachePath() + "/sections/" + std::to_string(spineIndex) + ".xpath";
+}
+
+std::optional<uint16_t> Section::readPageCount(const Epub& epub, const int spineIndex) {
+  FsFile f;
+  if (!Storage.openFileForRead("SCT", epub.getCachePath() + "/sections/" + std::to_string(spineIndex) + ".bin", f)) {
+    return std::nullopt;
+  }
+
+  uint8_t version = 0;
+  serialization::readPod(f, version);
+  uint16_t count = 0;
+  f.seek(HEADER_SIZE - sizeof(uint32_t) * 3 - sizeof(count));
+  serialization::readPod(f, count);
+  // The count is patched in last, so 0 also means a build that did not finish
+  if (version != SECTION_FILE_VERSION || count == 0) {
+    return std::nullopt;
+  }
+  return count;
+}
+
+void Section::removeSidecarFiles() const {
+  for (const std::string& path : {getRasterCachePath(), getXPathTablePath(*epub, spineIndex)}) {
+    if (Storage.exists(path.c_str())) {
+      Storage.remove(path.c_str());
+    }
+  }
+}
+
 bool Section::createSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                                 const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                                 const uint16_t viewportHeight, const bool hyphenationEnabled, const bool embeddedStyle,
                                 const uint8_t imageRendering, const std::function<void()>& popupFn) {
+  PERF_SCOPE(Layout);
   const auto localPath = epub->getSpineItem(spineIndex).href;
   const auto tmpHtmlPath = epub->getCachePath() + "/.tmp_" + std::to_string(spineIndex) + ".html";
 
@@ -192,6 +236,8 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
 
   LOG_DBG("SCT", "Streamed temp HTML to %s (%d bytes)", tmpHtmlPath.c_str(), fileSize);
 
+  // Pre-rendered pages and the paragraph table of the previous layout no longer match
+  removeSidecarFiles();
   if (!Storage.openFileForWrite("SCT", filePath, file)) {
     return false;
   }
@@ -202,7 +248,7 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   // Derive the content base directory and image cache path prefix for the parser
   size_t lastSlash = localPath.find_last_of('/');
   std::string contentBase = (lastSlash != std::string::npos) ? localPath.substr(0, lastSlash + 1) : "";
-  std::string imageBasePath = epub->getCachePath() + "/img_" + std::to_string(spineIndex) + "_";
+  std::string imageBasePath = epub->getCachePath() + "/img_";
 
   CssParser* cssParser = nullptr;
   if (embeddedStyle) {
@@ -220,9 +266,18 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
       [this, &lut](std::unique_ptr<Page> page, const uint16_t paragraphIndex) {
         lut.push_back({this->onPageComplete(std::move(page)), paragraphIndex});
       },
-      embeddedStyle, contentBase, imageBasePath, imageRendering, popupFn, cssParser);
+      embeddedStyle, contentBase, imageBasePath, imageRendering, popupFn, cssParser,
+      epub->getChapterParser() == Epub::ChapterParser::PullTokenizer);
   Hyphenator::setPreferredLanguage(epub->getLanguage());
-  success = visitor.parseAndBuildPages();
+  {
+    // Memoize break points for the duration of this section build
+    const Hyphenator::MemoScope hyphenationMemo(hyphenationEnabled);
+    success = visitor.parseAndBuildPages();
+    if (hyphenationMemo.lookups() > 0) {
+      LOG_DBG("SCT", "Hyphenation memo: %u of %u lookups served", static_cast<unsigned>(hyphenationMemo.hits()),
+              static_cast<unsigned>(hyphenationMemo.lookups()));
+    }
+  }
 
   Storage.remove(tmpHtmlPath.c_str());
   if (!success) {
@@ -278,31 +333,96 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   serialization::writePod(file, paragraphLutOffset);
   // Explicit close() required: member variable persists beyond function scope
   file.close();
+
+  // Without the table KOReader sync falls back to parsing the chapter, so a failure here is not fatal
+  if (!visitor.getXPathTable().write(getXPathTablePath(*epub, spineIndex), pageCount)) {
+    LOG_ERR("SCT", "Failed to write paragraph XPath table");
+  }
   if (cssParser) {
     cssParser->clear();
   }
   return true;
 }
 
+std::unique_ptr<Page> Section::readPage(FsFile& sectionFile, const int pageIndex) const {
+  sectionFile.seek(HEADER_SIZE - sizeof(uint32_t) * 3);
+  uint32_t lutOffset;
+  serialization::readPod(sectionFile, lutOffset);
+  sectionFile.seek(lutOffset + sizeof(uint32_t) * pageIndex);
+  uint32_t pagePos;
+  serialization::readPod(sectionFile, pagePos);
+  sectionFile.seek(pagePos);
+
+  return Page::deserialize(sectionFile);
+}
+
 std::unique_ptr<Page> Section::loadPageFromSectionFile() {
+  PERF_SCOPE(PageLoad);
   if (!Storage.openFileForRead("SCT", filePath, file)) {
     return nullptr;
   }
 
-  file.seek(HEADER_SIZE - sizeof(uint32_t) * 3);
-  uint32_t lutOffset;
-  serialization::readPod(file, lutOffset);
-  file.seek(lutOffset + sizeof(uint32_t) * currentPage);
-  uint32_t pagePos;
-  serialization::readPod(file, pagePos);
-  file.seek(pagePos);
-
-  auto page = Page::deserialize(file);
+  auto page = readPage(file, currentPage);
   // Explicit close() required: member variable persists beyond function scope
   file.close();
+  if (page) {
+    extractPageImages(*page);
+  }
   return page;
 }
 
+std::unique_ptr<Page> Section::peekPage(const int pageIndex) const {
+  if (pageIndex < 0 || pageIndex >= pageCount) {
+    return nullptr;
+  }
+  FsFile f;
+  if (!Storage.openFileForRead("SCT", filePath, f)) {
+    return nullptr;
+  }
+  return readPage(f, pageIndex);
+}
+
+namespace {
+// Forwards to the image file until the abort flag is raised, which makes the ZIP stream stop early
+class AbortableFileSink final : public Print {
+  FsFile& out;
+  const std::atomic<bool>* abortFlag;
+
+ public:
+  AbortableFileSink(FsFile& out, const std::atomic<bool>* abortFlag) : out(out), abortFlag(abortFlag) {}
+  size_t write(const uint8_t byte) override { return write(&byte, 1); }
+  size_t write(const uint8_t* buffer, const size_t size) override {
+    if (abortFlag && abortFlag->load(std::memory_order_relaxed)) return 0;
+    return out.write(buffer, size);
+  }
+};
+}  // namespace
+
+bool Section::extractImage(const Epub& epub, const ImageBlock& image, const std::atomic<bool>* abortFlag) {
+  if (image.imageExists() || Storage.exists(image.getPixelCachePath().c_str())) return true;
+
+  // First time this image is needed in the book: pull it out of the EPUB once
+  FsFile imageFile;
+  if (!Storage.openFileForWrite("SCT", image.getImagePath(), imageFile)) return false;
+  AbortableFileSink sink(imageFile, abortFlag);
+  const bool extracted = epub.readItemContentsToStream(image.getSourceHref(), sink, 4096);
+  imageFile.close();
+  if (!extracted) {
+    if (!abortFlag || !abortFlag->load(std::memory_order_relaxed)) {
+      LOG_ERR("SCT", "Failed to extract image %s", image.getSourceHref().c_str());
+    }
+    Storage.remove(image.getImagePath().c_str());
+  }
+  return extracted;
+}
+
+void Section::extractPageImages(const Page& page) const {
+  for (const auto& element : page.elements) {
+    if (element->getTag() != TAG_PageImage) continue;
+    extractImage(*epub, static_cast<const PageImage&>(*element).getImageBlock());
+  }
+}
+
 std::optional<uint16_t> Section::getPageForAnchor(const std::string& anchor) const {
   FsFile f;
   if (!Storage.openFileForRead("SCT", filePath, f)) {
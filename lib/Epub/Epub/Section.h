@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -8,6 +9,7 @@
 
 class Page;
 class GfxRenderer;
+class ImageBlock;
 
 class Section {
   std::shared_ptr<Epub> epub;
@@ -20,6 +22,9 @@ class Section {
                               uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
                               bool embeddedStyle, uint8_t imageRendering);
   uint32_t onPageComplete(std::unique_ptr<Page> page);
+  void extractPageImages(const Page& page) const;
+  std::unique_ptr<Page> readPage(FsFile& sectionFile, int pageIndex) const;
+  void removeSidecarFiles() const;
 
  public:
   uint16_t pageCount = 0;
@@ -39,6 +44,17 @@ class Section {
                          uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
                          uint8_t imageRendering, const std::function<void()>& popupFn = nullptr);
   std::unique_ptr<Page> loadPageFromSectionFile();
+  // Pre-rendered pages of this section (see PageRasterCache); removed whenever the section file is rebuilt or cleared
+  std::string getRasterCachePath() const;
+  // Paragraph paths and page start positions of a section (see ParagraphXPathTable), rebuilt with its section file
+  static std::string getXPathTablePath(const Epub& epub, int spineIndex);
+  // Page count in the header of a spine item's section file, without checking its layout parameters; empty when
+  // there is no complete section file of this version
+  static std::optional<uint16_t> readPageCount(const Epub& epub, int spineIndex);
+  // Reads another page of this section without touching currentPage or extracting its images (for look-ahead).
+  std::unique_ptr<Page> peekPage(int pageIndex) const;
+  // Extracts an image block's source from the EPUB unless it or its pixel cache is already on the SD card.
+  static bool extractImage(const Epub& epub, const ImageBlock& image, const std::atomic<bool>* abortFlag = nullptr);
 
   // Look up the page number for an anchor id from the section cache file.
   std::optional<uint16_t> getPageForAnchor(const std::string& anchor) const;
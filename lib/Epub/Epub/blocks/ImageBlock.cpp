@@ -12,22 +12,24 @@
 // - uint16_t height
 // - uint8_t pixels[...] - 2 bits per pixel, packed (4 pixels per byte), row-major order
 
-ImageBlock::ImageBlock(const std::string& imagePath, int16_t width, int16_t height)
-    : imagePath(imagePath), width(width), height(height) {}
+ImageBlock::ImageBlock(const std::string& imagePath, std::string sourceHref, int16_t width, int16_t height)
+    : imagePath(imagePath), sourceHref(std::move(sourceHref)), width(width), height(height) {}
 
 bool ImageBlock::imageExists() const { return Storage.exists(imagePath.c_str()); }
 
-namespace {
-
-std::string getCachePath(const std::string& imagePath) {
-  // Replace extension with .pxc (pixel cache)
+std::string ImageBlock::getPixelCachePath() const {
+  // Replace extension with _<w>x<h>.pxc (pixel cache). The same source image can appear at different sizes across
+  // chapters, so the size is part of the name.
+  const std::string suffix = "_" + std::to_string(width) + "x" + std::to_string(height) + ".pxc";
   size_t dotPos = imagePath.rfind('.');
   if (dotPos != std::string::npos) {
-    return imagePath.substr(0, dotPos) + ".pxc";
+    return imagePath.substr(0, dotPos) + suffix;
   }
-  return imagePath + ".pxc";
+  return imagePath + suffix;
 }
 
+namespace {
+
 bool renderFromCache(GfxRenderer& renderer, const std::string& cachePath, int x, int y, int expectedWidth,
                      int expectedHeight) {
   FsFile cacheFile;
@@ -105,24 +107,40 @@ void ImageBlock::render(GfxRenderer& renderer, const int x, const int y) {
   }
 
   // Try to render from cache first
-  std::string cachePath = getCachePath(imagePath);
+  std::string cachePath = getPixelCachePath();
   if (renderFromCache(renderer, cachePath, x, y, width, height)) {
     return;  // Successfully rendered from cache
   }
 
   // No cache - need to decode the image
+  decode(renderer, x, y, false, nullptr);
+}
+
+bool ImageBlock::renderToCache(GfxRenderer& renderer, const int x, const int y,
+                               const std::atomic<bool>* abortFlag) const {
+  if (x < 0 || y < 0 || x + width > renderer.getScreenWidth() || y + height > renderer.getScreenHeight()) {
+    return false;
+  }
+  if (Storage.exists(getPixelCachePath().c_str())) {
+    return true;
+  }
+  return decode(renderer, x, y, true, abortFlag);
+}
+
+bool ImageBlock::decode(GfxRenderer& renderer, const int x, const int y, const bool cacheOnly,
+                        const std::atomic<bool>* abortFlag) const {
   // Check if image file exists
   FsFile file;
   if (!Storage.openFileForRead("IMG", imagePath, file)) {
     LOG_ERR("IMG", "Image file not found: %s", imagePath.c_str());
-    return;
+    return false;
   }
   size_t fileSize = file.size();
   file.close();
 
   if (fileSize == 0) {
     LOG_ERR("IMG", "Image file is empty: %s", imagePath.c_str());
-    return;
+    return false;
   }
 
   LOG_DBG("IMG", "Decoding and caching: %s", imagePath.c_str());
@@ -136,27 +154,31 @@ void ImageBlock::render(GfxRenderer& renderer, const int x, const int y) {
   config.useDithering = true;
   config.performanceMode = false;
   config.useExactDimensions = true;  // Use pre-calculated dimensions to avoid rounding mismatches
-  config.cachePath = cachePath;      // Enable caching during decode
+  config.cachePath = getPixelCachePath();  // Enable caching during decode
+  config.cacheOnly = cacheOnly;
+  config.abortFlag = abortFlag;
 
   ImageToFramebufferDecoder* decoder = ImageDecoderFactory::getDecoder(imagePath);
   if (!decoder) {
     LOG_ERR("IMG", "No decoder found for image: %s", imagePath.c_str());
-    return;
+    return false;
   }
 
   LOG_DBG("IMG", "Using %s decoder", decoder->getFormatName());
 
   bool success = decoder->decodeToFramebuffer(imagePath, renderer, config);
   if (!success) {
-    LOG_ERR("IMG", "Failed to decode image: %s", imagePath.c_str());
-    return;
+    if (!config.isAborted()) LOG_ERR("IMG", "Failed to decode image: %s", imagePath.c_str());
+    return false;
   }
 
   LOG_DBG("IMG", "Decode successful");
+  return true;
 }
 
 bool ImageBlock::serialize(FsFile& file) {
   serialization::writeString(file, imagePath);
+  serialization::writeString(file, sourceHref);
   serialization::writePod(file, width);
   serialization::writePod(file, height);
   return true;
@@ -164,9 +186,11 @@ bool ImageBlock::serialize(FsFile& file) {
 
 std::unique_ptr<ImageBlock> ImageBlock::deserialize(FsFile& file) {
   std::string path;
+  std::string href;
   serialization::readString(file, path);
+  serialization::readString(file, href);
   int16_t w, h;
   serialization::readPod(file, w);
   serialization::readPod(file, h);
-  return std::unique_ptr<ImageBlock>(new ImageBlock(path, w, h));
+  return std::unique_ptr<ImageBlock>(new ImageBlock(path, std::move(href), w, h));
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <HalStorage.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -8,24 +9,34 @@
 
 class ImageBlock final : public Block {
  public:
-  ImageBlock(const std::string& imagePath, int16_t width, int16_t height);
+  ImageBlock(const std::string& imagePath, std::string sourceHref, int16_t width, int16_t height);
   ~ImageBlock() override = default;
 
   const std::string& getImagePath() const { return imagePath; }
+  // Path of the image inside the EPUB, used to extract imagePath on first render
+  const std::string& getSourceHref() const { return sourceHref; }
   int16_t getWidth() const { return width; }
   int16_t getHeight() const { return height; }
 
   bool imageExists() const;
+  // Decoded pixels at this block's display size; lets the source image stay unextracted once rendered
+  std::string getPixelCachePath() const;
 
   BlockType getType() override { return IMAGE_BLOCK; }
   bool isEmpty() override { return false; }
 
   void render(GfxRenderer& renderer, const int x, const int y);
+  // Decodes the image into its pixel cache without drawing, as it would be rendered at (x, y). Returns false if the
+  // image could not be decoded or abortFlag was raised midway.
+  bool renderToCache(GfxRenderer& renderer, int x, int y, const std::atomic<bool>* abortFlag) const;
   bool serialize(FsFile& file);
   static std::unique_ptr<ImageBlock> deserialize(FsFile& file);
 
  private:
   std::string imagePath;
+  std::string sourceHref;
   int16_t width;
   int16_t height;
+
+  bool decode(GfxRenderer& renderer, int x, int y, bool cacheOnly, const std::atomic<bool>* abortFlag) const;
 };
@@ -18,7 +18,7 @@ void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int
     renderer.drawText(fontId, wordX, y, words[i].c_str(), true, currentStyle);
 
     if ((currentStyle & EpdFontFamily::UNDERLINE) != 0) {
-      const std::string& w = words[i];
+      const std::pmr::string& w = words[i];
       const int fullWordWidth = renderer.getTextWidth(fontId, w.c_str(), currentStyle);
       // y is the top of the text line; add ascender to reach baseline, then offset 2px below
       const int underlineY = y + renderer.getFontAscenderSize(fontId) + 2;
@@ -50,7 +50,10 @@ bool TextBlock::serialize(FsFile& file) const {
 
   // Word data
   serialization::writePod(file, static_cast<uint16_t>(words.size()));
-  for (const auto& w : words) serialization::writeString(file, w);
+  for (const auto& w : words) {
+    serialization::writePod(file, static_cast<uint32_t>(w.size()));
+    file.write(reinterpret_cast<const uint8_t*>(w.data()), w.size());
+  }
   for (auto x : wordXpos) serialization::writePod(file, x);
   for (auto s : wordStyles) serialization::writePod(file, s);
 
@@ -73,9 +76,9 @@ bool TextBlock::serialize(FsFile& file) const {
 
 std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
   uint16_t wc;
-  std::vector<std::string> words;
-  std::vector<int16_t> wordXpos;
-  std::vector<EpdFontFamily::Style> wordStyles;
+  std::pmr::vector<std::pmr::string> words;
+  std::pmr::vector<int16_t> wordXpos;
+  std::pmr::vector<EpdFontFamily::Style> wordStyles;
   BlockStyle blockStyle;
 
   // Word count
@@ -91,7 +94,12 @@ std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
   words.resize(wc);
   wordXpos.resize(wc);
   wordStyles.resize(wc);
-  for (auto& w : words) serialization::readString(file, w);
+  for (auto& w : words) {
+    uint32_t length = 0;
+    serialization::readPod(file, length);
+    w.resize(length);
+    file.read(reinterpret_cast<uint8_t*>(w.data()), length);
+  }
   for (auto& x : wordXpos) serialization::readPod(file, x);
   for (auto& s : wordStyles) serialization::readPod(file, s);
 
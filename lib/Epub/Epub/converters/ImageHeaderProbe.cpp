@@ -0,0 +1,130 @@
+#include "ImageHeaderProbe.h"
+
+#include <cstring>
+
+namespace {
+constexpr uint8_t PNG_SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+constexpr size_t PNG_HEADER_SIZE = 24;  // signature + IHDR length/type + width + height
+constexpr size_t JPEG_FRAME_SIZE = 5;   // precision + height + width
+
+// SOF0..SOF15 carry the frame size; C4 (DHT), C8 (JPG) and CC (DAC) share the range but are not frames
+bool isStartOfFrame(const uint8_t code) {
+  return code >= 0xC0 && code <= 0xCF && code != 0xC4 && code != 0xC8 && code != 0xCC;
+}
+
+// Markers without a length field
+bool isStandaloneMarker(const uint8_t code) { return code == 0x01 || (code >= 0xD0 && code <= 0xD8); }
+}  // namespace
+
+size_t ImageHeaderProbe::write(const uint8_t* buffer, const size_t size) {
+  size_t consumed = 0;
+  while (consumed < size && !isDone()) {
+    if (state == State::JpegSkip) {
+      // Skip segment bodies (EXIF, ICC profiles, embedded thumbnails) in bulk
+      const size_t skip = skipRemaining < size - consumed ? skipRemaining : size - consumed;
+      skipRemaining -= skip;
+      consumed += skip;
+      if (skipRemaining == 0) {
+        state = State::JpegMarker;
+      }
+      continue;
+    }
+    consume(buffer[consumed++]);
+  }
+  return consumed;
+}
+
+void ImageHeaderProbe::consume(const uint8_t byte) {
+  switch (state) {
+    case State::Signature:
+      header[headerLen++] = byte;
+      if (headerLen == 1 && byte != 0xFF && byte != PNG_SIGNATURE[0]) {
+        state = State::Failed;
+      } else if (headerLen == 2) {
+        if (header[0] == 0xFF && header[1] == 0xD8) {
+          state = State::JpegMarker;
+        } else if (header[0] == PNG_SIGNATURE[0] && header[1] == PNG_SIGNATURE[1]) {
+          state = State::PngHeader;
+        } else {
+          state = State::Failed;
+        }
+      }
+      break;
+
+    case State::PngHeader:
+      header[headerLen++] = byte;
+      if (headerLen == PNG_HEADER_SIZE) {
+        if (memcmp(header, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0 || memcmp(header + 12, "IHDR", 4) != 0 ||
+            header[16] != 0 || header[17] != 0 || header[20] != 0 || header[21] != 0) {
+          // Width/height above 65535 are never renderable, treat them like a broken header
+          state = State::Failed;
+          break;
+        }
+        width = static_cast<uint16_t>((header[18] << 8) | header[19]);
+        height = static_cast<uint16_t>((header[22] << 8) | header[23]);
+        state = State::Found;
+      }
+      break;
+
+    case State::JpegMarker:
+      state = byte == 0xFF ? State::JpegCode : State::Failed;
+      break;
+
+    case State::JpegCode:
+      if (byte == 0xFF) {
+        break;  // fill byte
+      }
+      if (isStandaloneMarker(byte)) {
+        state = State::JpegMarker;
+      } else if (byte == 0xD9 || byte == 0xDA) {
+        // End of image or start of scan before any frame header
+        state = State::Failed;
+      } else {
+        isSofSegment = isStartOfFrame(byte);
+        headerLen = 0;
+        state = State::JpegLength;
+      }
+      break;
+
+    case State::JpegLength:
+      header[headerLen++] = byte;
+      if (headerLen == 2) {
+        const uint16_t length = static_cast<uint16_t>((header[0] << 8) | header[1]);
+        if (length < 2 || (isSofSegment && length < 2 + JPEG_FRAME_SIZE)) {
+          state = State::Failed;
+          break;
+        }
+        skipRemaining = length - 2;
+        headerLen = 0;
+        if (isSofSegment) {
+          state = State::JpegFrame;
+        } else {
+          state = skipRemaining > 0 ? State::JpegSkip : State::JpegMarker;
+        }
+      }
+      break;
+
+    case State::JpegFrame:
+      header[headerLen++] = byte;
+      if (headerLen == JPEG_FRAME_SIZE) {
+        height = static_cast<uint16_t>((header[1] << 8) | header[2]);
+        width = static_cast<uint16_t>((header[3] << 8) | header[4]);
+        state = State::Found;
+      }
+      break;
+
+    case State::JpegSkip:
+    case State::Found:
+    case State::Failed:
+      break;
+  }
+}
+
+bool ImageHeaderProbe::getDimensions(ImageDimensions& out) const {
+  if (state != State::Found || width == 0 || height == 0 || width > INT16_MAX || height > INT16_MAX) {
+    return false;
+  }
+  out.width = static_cast<int16_t>(width);
+  out.height = static_cast<int16_t>(height);
+  return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <Print.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ImageToFramebufferDecoder.h"
+
+// Print sink that sniffs the pixel dimensions of a JPEG (SOFn marker) or PNG (IHDR chunk) from the first bytes of the
+// stream. Once the dimensions are known (or the data turns out not to be an image) write() accepts nothing more,
+// which lets ZipFile::readFilePrefixToStream() stop inflating the member right there.
+class ImageHeaderProbe final : public Print {
+ public:
+  size_t write(uint8_t byte) override { return write(&byte, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override;
+
+  bool isDone() const { return state == State::Found || state == State::Failed; }
+  bool getDimensions(ImageDimensions& out) const;
+
+ private:
+  enum class State : uint8_t {
+    Signature,     // first bytes decide between JPEG and PNG
+    PngHeader,     // collecting the IHDR width/height
+    JpegMarker,    // expecting 0xFF
+    JpegCode,      // marker code byte
+    JpegLength,    // two-byte segment length
+    JpegSkip,      // skipping the body of a segment we don't care about
+    JpegFrame,     // collecting the SOFn precision/height/width
+    Found,
+    Failed,
+  };
+
+  State state = State::Signature;
+  uint8_t header[24] = {};
+  size_t headerLen = 0;
+  uint32_t skipRemaining = 0;
+  bool isSofSegment = false;
+  uint16_t width = 0;
+  uint16_t height = 0;
+
+  void consume(uint8_t byte);
+};
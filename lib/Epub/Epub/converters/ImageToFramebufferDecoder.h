@@ -1,6 +1,7 @@
 #pragma once
 #include <HalStorage.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -19,6 +20,10 @@ struct RenderConfig {
   bool performanceMode = false;
   bool useExactDimensions = false;  // If true, use maxWidth/maxHeight as exact output size (no recalculation)
   std::string cachePath;            // If non-empty, decoder will write pixel cache to this path
+  bool cacheOnly = false;           // Only fill the pixel cache, leave the framebuffer untouched (needs cachePath)
+  const std::atomic<bool>* abortFlag = nullptr;  // Decode stops early (and fails) once this becomes true
+
+  bool isAborted() const { return abortFlag && abortFlag->load(std::memory_order_relaxed); }
 };
 
 class ImageToFramebufferDecoder {
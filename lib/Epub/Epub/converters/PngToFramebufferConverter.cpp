@@ -166,6 +166,7 @@ void convertLineToGray(uint8_t* pPixels, uint8_t* grayLine, int width, int pixel
 int pngDrawCallback(PNGDRAW* pDraw) {
   PngContext* ctx = reinterpret_cast<PngContext*>(pDraw->pUser);
   if (!ctx || !ctx->config || !ctx->renderer || !ctx->grayLineBuffer) return 0;
+  if (ctx->config->isAborted()) return 0;  // PNGdec stops with PNG_QUIT_EARLY
 
   int srcY = pDraw->y;
   int srcWidth = ctx->srcWidth;
@@ -196,7 +197,7 @@ int pngDrawCallback(PNGDRAW* pDraw) {
 
   // Pre-compute orientation and render-mode state once per row
   DirectPixelWriter pw;
-  pw.init(*ctx->renderer);
+  pw.init(*ctx->renderer, !ctx->config->cacheOnly);
   pw.beginRow(outY);
 
   DirectCacheWriter cw;
@@ -370,6 +371,12 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
       ctx.caching = false;
     }
   }
+  if (config.cacheOnly && !ctx.caching) {
+    free(ctx.grayLineBuffer);
+    png->close();
+    delete png;
+    return false;
+  }
 
   unsigned long decodeStart = millis();
   rc = png->decode(&ctx, 0);
@@ -378,6 +385,12 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
   free(ctx.grayLineBuffer);
   ctx.grayLineBuffer = nullptr;
 
+  if (rc != PNG_SUCCESS && config.isAborted()) {
+    LOG_DBG("PNG", "Decode aborted: %s", imagePath.c_str());
+    png->close();
+    delete png;
+    return false;
+  }
   if (rc != PNG_SUCCESS) {
     LOG_ERR("PNG", "Decode failed: %d", rc);
     png->close();
@@ -620,11 +620,11 @@ CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string&
   }
   CssStyle result;
   const std::string tag = normalized(tagName);
+  CssStyle rule;
 
   // 1. Apply element-level style (lowest priority)
-  const auto tagIt = rulesBySelector_.find(tag);
-  if (tagIt != rulesBySelector_.end()) {
-    result.applyOver(tagIt->second);
+  if (findRule(tag, rule)) {
+    result.applyOver(rule);
   }
 
   // TODO: Support combinations of classes (e.g. style on .class1.class2)
@@ -635,9 +635,8 @@ CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string&
     for (const auto& cls : classes) {
       std::string classKey = "." + normalized(cls);
 
-      auto classIt = rulesBySelector_.find(classKey);
-      if (classIt != rulesBySelector_.end()) {
-        result.applyOver(classIt->second);
+      if (findRule(classKey, rule)) {
+        result.applyOver(rule);
       }
     }
 
@@ -646,9 +645,8 @@ CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string&
     for (const auto& cls : classes) {
       std::string combinedKey = tag + "." + normalized(cls);
 
-      auto combinedIt = rulesBySelector_.find(combinedKey);
-      if (combinedIt != rulesBySelector_.end()) {
-        result.applyOver(combinedIt->second);
+      if (findRule(combinedKey, rule)) {
+        result.applyOver(rule);
       }
     }
   }
@@ -656,6 +654,19 @@ CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string&
   return result;
 }
 
+bool CssParser::findRule(const std::string& selector, CssStyle& out) const {
+  // Freshly parsed rules (before they are written to the cache) take precedence over the cache file
+  if (!rulesBySelector_.empty()) {
+    const auto it = rulesBySelector_.find(selector);
+    if (it == rulesBySelector_.end()) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+  return findCachedRule(selector, out);
+}
+
 // Inline style parsing (static - doesn't need rule database)
 
 CssStyle CssParser::parseInlineStyle(const std::string& styleValue) { return parseDeclarations(styleValue); }
@@ -671,11 +682,116 @@ void CssParser::deleteCache() const {
   if (hasCache()) Storage.remove((cachePath + rulesCache).c_str());
 }
 
+void CssParser::packStyle(const CssStyle& style, uint8_t* out) {
+  *out++ = static_cast<uint8_t>(style.textAlign);
+  *out++ = static_cast<uint8_t>(style.fontStyle);
+  *out++ = static_cast<uint8_t>(style.fontWeight);
+  *out++ = static_cast<uint8_t>(style.textDecoration);
+
+  // CssLength fields (value + unit)
+  auto packLength = [&out](const CssLength& len) {
+    memcpy(out, &len.value, sizeof(len.value));
+    out += sizeof(len.value);
+    *out++ = static_cast<uint8_t>(len.unit);
+  };
+  packLength(style.textIndent);
+  packLength(style.marginTop);
+  packLength(style.marginBottom);
+  packLength(style.marginLeft);
+  packLength(style.marginRight);
+  packLength(style.paddingTop);
+  packLength(style.paddingBottom);
+  packLength(style.paddingLeft);
+  packLength(style.paddingRight);
+  packLength(style.imageHeight);
+  packLength(style.imageWidth);
+  *out++ = static_cast<uint8_t>(style.display);
+
+  // Defined flags as uint16_t
+  uint16_t definedBits = 0;
+  if (style.defined.textAlign) definedBits |= 1 << 0;
+  if (style.defined.fontStyle) definedBits |= 1 << 1;
+  if (style.defined.fontWeight) definedBits |= 1 << 2;
+  if (style.defined.textDecoration) definedBits |= 1 << 3;
+  if (style.defined.textIndent) definedBits |= 1 << 4;
+  if (style.defined.marginTop) definedBits |= 1 << 5;
+  if (style.defined.marginBottom) definedBits |= 1 << 6;
+  if (style.defined.marginLeft) definedBits |= 1 << 7;
+  if (style.defined.marginRight) definedBits |= 1 << 8;
+  if (style.defined.paddingTop) definedBits |= 1 << 9;
+  if (style.defined.paddingBottom) definedBits |= 1 << 10;
+  if (style.defined.paddingLeft) definedBits |= 1 << 11;
+  if (style.defined.paddingRight) definedBits |= 1 << 12;
+  if (style.defined.imageHeight) definedBits |= 1 << 13;
+  if (style.defined.imageWidth) definedBits |= 1 << 14;
+  if (style.defined.display) definedBits |= 1 << 15;
+  memcpy(out, &definedBits, sizeof(definedBits));
+}
+
+void CssParser::unpackStyle(const uint8_t* in, CssStyle& style) {
+  style.textAlign = static_cast<CssTextAlign>(*in++);
+  style.fontStyle = static_cast<CssFontStyle>(*in++);
+  style.fontWeight = static_cast<CssFontWeight>(*in++);
+  style.textDecoration = static_cast<CssTextDecoration>(*in++);
+
+  auto unpackLength = [&in](CssLength& len) {
+    memcpy(&len.value, in, sizeof(len.value));
+    in += sizeof(len.value);
+    len.unit = static_cast<CssUnit>(*in++);
+  };
+  unpackLength(style.textIndent);
+  unpackLength(style.marginTop);
+  unpackLength(style.marginBottom);
+  unpackLength(style.marginLeft);
+  unpackLength(style.marginRight);
+  unpackLength(style.paddingTop);
+  unpackLength(style.paddingBottom);
+  unpackLength(style.paddingLeft);
+  unpackLength(style.paddingRight);
+  unpackLength(style.imageHeight);
+  unpackLength(style.imageWidth);
+  style.display = static_cast<CssDisplay>(*in++);
+
+  uint16_t definedBits = 0;
+  memcpy(&definedBits, in, sizeof(definedBits));
+  style.defined.textAlign = (definedBits & 1 << 0) != 0;
+  style.defined.fontStyle = (definedBits & 1 << 1) != 0;
+  style.defined.fontWeight = (definedBits & 1 << 2) != 0;
+  style.defined.textDecoration = (definedBits & 1 << 3) != 0;
+  style.defined.textIndent = (definedBits & 1 << 4) != 0;
+  style.defined.marginTop = (definedBits & 1 << 5) != 0;
+  style.defined.marginBottom = (definedBits & 1 << 6) != 0;
+  style.defined.marginLeft = (definedBits & 1 << 7) != 0;
+  style.defined.marginRight = (definedBits & 1 << 8) != 0;
+  style.defined.paddingTop = (definedBits & 1 << 9) != 0;
+  style.defined.paddingBottom = (definedBits & 1 << 10) != 0;
+  style.defined.paddingLeft = (definedBits & 1 << 11) != 0;
+  style.defined.paddingRight = (definedBits & 1 << 12) != 0;
+  style.defined.imageHeight = (definedBits & 1 << 13) != 0;
+  style.defined.imageWidth = (definedBits & 1 << 14) != 0;
+  style.defined.display = (definedBits & 1 << 15) != 0;
+}
+
 bool CssParser::saveToCache() const {
   if (cachePath.empty()) {
     return false;
   }
 
+  // Sort selectors by (hash, bytes) so lookups can binary-search the index straight from the file
+  struct SortEntry {
+    uint32_t hash;
+    const std::string* selector;
+    const CssStyle* style;
+  };
+  std::vector<SortEntry> entries;
+  entries.reserve(rulesBySelector_.size());
+  for (const auto& pair : rulesBySelector_) {
+    entries.push_back({fnvHash(pair.first), &pair.first, &pair.second});
+  }
+  std::sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+    return a.hash < b.hash || (a.hash == b.hash && *a.selector < *b.selector);
+  });
+
   FsFile file;
   if (!Storage.openFileForWrite("CSS", cachePath + rulesCache, file)) {
     return false;
@@ -685,61 +801,36 @@ bool CssParser::saveToCache() const {
   file.write(CssParser::CSS_CACHE_VERSION);
 
   // Write rule count
-  const auto ruleCount = static_cast<uint16_t>(rulesBySelector_.size());
+  const auto ruleCount = static_cast<uint16_t>(entries.size());
   file.write(reinterpret_cast<const uint8_t*>(&ruleCount), sizeof(ruleCount));
 
-  // Write each rule: selector string + CssStyle fields
-  for (const auto& pair : rulesBySelector_) {
-    // Write selector string (length-prefixed)
-    const auto selectorLen = static_cast<uint16_t>(pair.first.size());
-    file.write(reinterpret_cast<const uint8_t*>(&selectorLen), sizeof(selectorLen));
-    file.write(reinterpret_cast<const uint8_t*>(pair.first.data()), selectorLen);
-
-    // Write CssStyle fields (all are POD types)
-    const CssStyle& style = pair.second;
-    file.write(static_cast<uint8_t>(style.textAlign));
-    file.write(static_cast<uint8_t>(style.fontStyle));
-    file.write(static_cast<uint8_t>(style.fontWeight));
-    file.write(static_cast<uint8_t>(style.textDecoration));
-
-    // Write CssLength fields (value + unit)
-    auto writeLength = [&file](const CssLength& len) {
-      file.write(reinterpret_cast<const uint8_t*>(&len.value), sizeof(len.value));
-      file.write(static_cast<uint8_t>(len.unit));
-    };
-
-    writeLength(style.textIndent);
-    writeLength(style.marginTop);
-    writeLength(style.marginBottom);
-    writeLength(style.marginLeft);
-    writeLength(style.marginRight);
-    writeLength(style.paddingTop);
-    writeLength(style.paddingBottom);
-    writeLength(style.paddingLeft);
-    writeLength(style.paddingRight);
-    writeLength(style.imageHeight);
-    writeLength(style.imageWidth);
-    file.write(static_cast<uint8_t>(style.display));
-
-    // Write defined flags as uint16_t
-    uint16_t definedBits = 0;
-    if (style.defined.textAlign) definedBits |= 1 << 0;
-    if (style.defined.fontStyle) definedBits |= 1 << 1;
-    if (style.defined.fontWeight) definedBits |= 1 << 2;
-    if (style.defined.textDecoration) definedBits |= 1 << 3;
-    if (style.defined.textIndent) definedBits |= 1 << 4;
-    if (style.defined.marginTop) definedBits |= 1 << 5;
-    if (style.defined.marginBottom) definedBits |= 1 << 6;
-    if (style.defined.marginLeft) definedBits |= 1 << 7;
-    if (style.defined.marginRight) definedBits |= 1 << 8;
-    if (style.defined.paddingTop) definedBits |= 1 << 9;
-    if (style.defined.paddingBottom) definedBits |= 1 << 10;
-    if (style.defined.paddingLeft) definedBits |= 1 << 11;
-    if (style.defined.paddingRight) definedBits |= 1 << 12;
-    if (style.defined.imageHeight) definedBits |= 1 << 13;
-    if (style.defined.imageWidth) definedBits |= 1 << 14;
-    if (style.defined.display) definedBits |= 1 << 15;
-    file.write(reinterpret_cast<const uint8_t*>(&definedBits), sizeof(definedBits));
+  // Write fence hashes, the part of the index kept in RAM for lookups
+  const uint16_t fences = fenceCountFor(ruleCount);
+  for (uint16_t f = 0; f < fences; f++) {
+    const uint32_t hash = entries[f * FENCE_STRIDE].hash;
+    file.write(reinterpret_cast<const uint8_t*>(&hash), sizeof(hash));
+  }
+
+  // Write selector index; selector strings are appended after the packed style array
+  uint32_t selectorOffset =
+      CACHE_HEADER_SIZE + fences * sizeof(uint32_t) + ruleCount * (INDEX_RECORD_SIZE + PACKED_STYLE_SIZE);
+  for (const auto& entry : entries) {
+    const IndexRecord record = {entry.hash, selectorOffset, static_cast<uint16_t>(entry.selector->size()), 0};
+    static_assert(sizeof(IndexRecord) == INDEX_RECORD_SIZE, "IndexRecord must be tightly packed");
+    file.write(reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+    selectorOffset += record.selectorLen;
+  }
+
+  // Write packed styles
+  uint8_t packed[PACKED_STYLE_SIZE];
+  for (const auto& entry : entries) {
+    packStyle(*entry.style, packed);
+    file.write(packed, sizeof(packed));
+  }
+
+  // Write selector string pool
+  for (const auto& entry : entries) {
+    file.write(reinterpret_cast<const uint8_t*>(entry.selector->data()), entry.selector->size());
   }
 
   LOG_DBG("CSS", "Saved %u rules to cache", ruleCount);
@@ -751,161 +842,193 @@ bool CssParser::loadFromCache() {
     return false;
   }
 
-  FsFile file;
-  if (!Storage.openFileForRead("CSS", cachePath + rulesCache, file)) {
-    return false;
-  }
-
   // Clear existing rules
   clear();
 
+  if (!Storage.openFileForRead("CSS", cachePath + rulesCache, ruleCacheFile)) {
+    return false;
+  }
+
   // Read and verify version
   uint8_t version = 0;
-  if (file.read(&version, 1) != 1 || version != CssParser::CSS_CACHE_VERSION) {
+  if (ruleCacheFile.read(&version, 1) != 1 || version != CssParser::CSS_CACHE_VERSION) {
     LOG_DBG("CSS", "Cache version mismatch (got %u, expected %u), removing stale cache for rebuild", version,
             CssParser::CSS_CACHE_VERSION);
     // Explicitly close() file before calling Storage.remove()
-    file.close();
+    ruleCacheFile.close();
     Storage.remove((cachePath + rulesCache).c_str());
     return false;
   }
 
   // Read rule count
   uint16_t ruleCount = 0;
-  if (file.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount)) {
+  if (ruleCacheFile.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount)) {
+    ruleCacheFile.close();
     return false;
   }
 
   if (ruleCount > MAX_RULES) {
     LOG_DBG("CSS", "Invalid cache rule count (%u > %zu)", ruleCount, MAX_RULES);
-    rulesBySelector_.clear();
+    ruleCacheFile.close();
     return false;
   }
 
-  auto hasRemainingBytes = [&file](const size_t neededBytes) -> bool {
-    return static_cast<size_t>(file.available()) >= neededBytes;
-  };
+  const uint16_t fences = fenceCountFor(ruleCount);
+  const uint32_t fileSize = ruleCacheFile.fileSize();
+  if (fileSize <
+      CACHE_HEADER_SIZE + fences * sizeof(uint32_t) + ruleCount * (INDEX_RECORD_SIZE + PACKED_STYLE_SIZE)) {
+    LOG_DBG("CSS", "Truncated CSS cache (%u bytes for %u rules)", fileSize, ruleCount);
+    ruleCacheFile.close();
+    return false;
+  }
 
-  constexpr size_t CSS_LENGTH_FIELD_COUNT = 11;
-  constexpr size_t CSS_LENGTH_BYTES = sizeof(float) + sizeof(uint8_t);
-  constexpr size_t CSS_FIXED_STYLE_BYTES =
-      4 * sizeof(uint8_t) + (CSS_LENGTH_FIELD_COUNT * CSS_LENGTH_BYTES) + sizeof(uint8_t) + sizeof(uint16_t);
-
-  // Read each rule
-  for (uint16_t i = 0; i < ruleCount; ++i) {
-    // Read selector string
-    uint16_t selectorLen = 0;
-    if (!hasRemainingBytes(sizeof(selectorLen))) {
-      rulesBySelector_.clear();
+  if (ruleCount > 0) {
+    blockData.reset(new (std::nothrow) uint8_t[CACHE_BLOCK_SIZE * CACHE_BLOCK_COUNT]);
+    fenceHashes.reset(new (std::nothrow) uint32_t[fences]);
+    if (!blockData || !fenceHashes) {
+      LOG_ERR("CSS", "Failed to allocate CSS cache read buffers");
+      closeRuleCache();
       return false;
     }
-    if (file.read(&selectorLen, sizeof(selectorLen)) != sizeof(selectorLen)) {
-      rulesBySelector_.clear();
+    const int fenceBytes = fences * sizeof(uint32_t);
+    if (ruleCacheFile.read(fenceHashes.get(), fenceBytes) != fenceBytes) {
+      closeRuleCache();
       return false;
     }
+    std::fill(std::begin(blockIds), std::end(blockIds), UINT32_MAX);
+    std::fill(std::begin(blockLastUse), std::end(blockLastUse), 0);
+    blockClock = 0;
+  }
 
-    if (selectorLen == 0 || selectorLen > MAX_SELECTOR_LENGTH || !hasRemainingBytes(selectorLen)) {
-      LOG_DBG("CSS", "Invalid selector length in cache: %u", selectorLen);
-      rulesBySelector_.clear();
-      return false;
-    }
+  fenceCount = fences;
+  indexOffset = CACHE_HEADER_SIZE + fences * sizeof(uint32_t);
+  cachedRuleCount = ruleCount;
+  cachedFileSize = fileSize;
+  LOG_DBG("CSS", "Opened rule cache with %u rules", ruleCount);
+  return true;
+}
 
-    std::string selector;
-    selector.resize(selectorLen);
-    if (file.read(&selector[0], selectorLen) != selectorLen) {
-      rulesBySelector_.clear();
-      return false;
-    }
+void CssParser::closeRuleCache() {
+  if (ruleCacheFile) {
+    ruleCacheFile.close();
+  }
+  blockData.reset();
+  fenceHashes.reset();
+  fenceCount = 0;
+  indexOffset = 0;
+  cachedRuleCount = 0;
+  cachedFileSize = 0;
+}
 
-    if (!hasRemainingBytes(CSS_FIXED_STYLE_BYTES)) {
-      LOG_DBG("CSS", "Truncated CSS cache while reading style payload");
-      rulesBySelector_.clear();
-      return false;
-    }
+bool CssParser::readCached(uint32_t offset, void* out, size_t len) const {
+  if (!blockData || offset + len > cachedFileSize) {
+    return false;
+  }
 
-    // Read CssStyle fields
-    CssStyle style;
-    uint8_t enumVal;
+  auto* dst = static_cast<uint8_t*>(out);
+  while (len > 0) {
+    const uint32_t blockId = offset / CACHE_BLOCK_SIZE;
+    const size_t blockOffset = offset % CACHE_BLOCK_SIZE;
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
+    size_t slot = CACHE_BLOCK_COUNT;
+    for (size_t i = 0; i < CACHE_BLOCK_COUNT; i++) {
+      if (blockIds[i] == blockId) {
+        slot = i;
+        break;
+      }
     }
-    style.textAlign = static_cast<CssTextAlign>(enumVal);
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
+    if (slot == CACHE_BLOCK_COUNT) {
+      // Replace the least recently used block
+      slot = 0;
+      for (size_t i = 1; i < CACHE_BLOCK_COUNT; i++) {
+        if (blockLastUse[i] < blockLastUse[slot]) {
+          slot = i;
+        }
+      }
+      const uint32_t blockStart = blockId * CACHE_BLOCK_SIZE;
+      const size_t toRead = std::min<size_t>(CACHE_BLOCK_SIZE, cachedFileSize - blockStart);
+      if (!ruleCacheFile.seek(blockStart) ||
+          ruleCacheFile.read(blockData.get() + slot * CACHE_BLOCK_SIZE, toRead) != static_cast<int>(toRead)) {
+        blockIds[slot] = UINT32_MAX;
+        return false;
+      }
+      blockIds[slot] = blockId;
     }
-    style.fontStyle = static_cast<CssFontStyle>(enumVal);
+    blockLastUse[slot] = ++blockClock;
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    style.fontWeight = static_cast<CssFontWeight>(enumVal);
+    const size_t chunk = std::min(len, CACHE_BLOCK_SIZE - blockOffset);
+    memcpy(dst, blockData.get() + slot * CACHE_BLOCK_SIZE + blockOffset, chunk);
+    dst += chunk;
+    offset += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+
+bool CssParser::readIndexRecord(const uint16_t index, IndexRecord& out) const {
+  return readCached(indexOffset + index * INDEX_RECORD_SIZE, &out, sizeof(out));
+}
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
+bool CssParser::selectorEquals(const IndexRecord& record, const std::string_view selector) const {
+  if (record.selectorLen != selector.size()) {
+    return false;
+  }
+
+  char chunk[32];
+  for (size_t pos = 0; pos < selector.size(); pos += sizeof(chunk)) {
+    const size_t len = std::min(sizeof(chunk), selector.size() - pos);
+    if (!readCached(record.selectorOffset + pos, chunk, len) || memcmp(chunk, selector.data() + pos, len) != 0) {
       return false;
     }
-    style.textDecoration = static_cast<CssTextDecoration>(enumVal);
+  }
+  return true;
+}
 
-    // Read CssLength fields
-    auto readLength = [&file](CssLength& len) -> bool {
-      if (file.read(&len.value, sizeof(len.value)) != sizeof(len.value)) {
-        return false;
-      }
-      uint8_t unitVal;
-      if (file.read(&unitVal, 1) != 1) {
-        return false;
-      }
-      len.unit = static_cast<CssUnit>(unitVal);
-      return true;
-    };
-
-    if (!readLength(style.textIndent) || !readLength(style.marginTop) || !readLength(style.marginBottom) ||
-        !readLength(style.marginLeft) || !readLength(style.marginRight) || !readLength(style.paddingTop) ||
-        !readLength(style.paddingBottom) || !readLength(style.paddingLeft) || !readLength(style.paddingRight) ||
-        !readLength(style.imageHeight) || !readLength(style.imageWidth)) {
-      rulesBySelector_.clear();
+bool CssParser::findCachedRule(const std::string_view selector, CssStyle& out) const {
+  if (cachedRuleCount == 0) {
+    return false;
+  }
+
+  const uint32_t hash = fnvHash(selector);
+
+  // The fences narrow the lower bound down to one run: after the last fence below the hash, up to the first one at or
+  // above it
+  const uint32_t* const fences = fenceHashes.get();
+  const auto fence = static_cast<uint16_t>(std::lower_bound(fences, fences + fenceCount, hash) - fences);
+  uint16_t lo = fence > 0 ? static_cast<uint16_t>((fence - 1) * FENCE_STRIDE + 1) : 0;
+  uint16_t hi = fence < fenceCount ? static_cast<uint16_t>(fence * FENCE_STRIDE) : cachedRuleCount;
+
+  // Lower bound on hash within that run
+  IndexRecord record = {};
+  while (lo < hi) {
+    const uint16_t mid = lo + (hi - lo) / 2;
+    if (!readIndexRecord(mid, record)) {
       return false;
     }
+    if (record.selectorHash < hash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
 
-    // Read display value
-    uint8_t displayVal;
-    if (file.read(&displayVal, 1) != 1) {
-      rulesBySelector_.clear();
+  // Walk the (almost always single-entry) run of equal hashes
+  for (uint16_t i = lo; i < cachedRuleCount; i++) {
+    if (!readIndexRecord(i, record) || record.selectorHash != hash) {
       return false;
     }
-    style.display = static_cast<CssDisplay>(displayVal);
+    if (!selectorEquals(record, selector)) {
+      continue;
+    }
 
-    // Read defined flags
-    uint16_t definedBits = 0;
-    if (file.read(&definedBits, sizeof(definedBits)) != sizeof(definedBits)) {
-      rulesBySelector_.clear();
+    uint8_t packed[PACKED_STYLE_SIZE];
+    const uint32_t styleOffset = indexOffset + cachedRuleCount * INDEX_RECORD_SIZE + i * PACKED_STYLE_SIZE;
+    if (!readCached(styleOffset, packed, sizeof(packed))) {
       return false;
     }
-    style.defined.textAlign = (definedBits & 1 << 0) != 0;
-    style.defined.fontStyle = (definedBits & 1 << 1) != 0;
-    style.defined.fontWeight = (definedBits & 1 << 2) != 0;
-    style.defined.textDecoration = (definedBits & 1 << 3) != 0;
-    style.defined.textIndent = (definedBits & 1 << 4) != 0;
-    style.defined.marginTop = (definedBits & 1 << 5) != 0;
-    style.defined.marginBottom = (definedBits & 1 << 6) != 0;
-    style.defined.marginLeft = (definedBits & 1 << 7) != 0;
-    style.defined.marginRight = (definedBits & 1 << 8) != 0;
-    style.defined.paddingTop = (definedBits & 1 << 9) != 0;
-    style.defined.paddingBottom = (definedBits & 1 << 10) != 0;
-    style.defined.paddingLeft = (definedBits & 1 << 11) != 0;
-    style.defined.paddingRight = (definedBits & 1 << 12) != 0;
-    style.defined.imageHeight = (definedBits & 1 << 13) != 0;
-    style.defined.imageWidth = (definedBits & 1 << 14) != 0;
-    style.defined.display = (definedBits & 1 << 15) != 0;
-
-    rulesBySelector_[selector] = style;
-  }
-
-  LOG_DBG("CSS", "Loaded %u rules from cache", ruleCount);
-  return true;
+    unpackStyle(packed, out);
+    return true;
+  }
+  return false;
 }
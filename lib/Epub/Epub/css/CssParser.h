@@ -2,7 +2,9 @@
 
 #include <HalStorage.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -27,14 +29,25 @@
  *   - Pseudo-classes and pseudo-elements
  *   - Media queries (content is skipped)
  *   - @import, @font-face, etc.
+ *
+ * Rule cache layout (CSS_CACHE_VERSION 6+):
+ *   uint8_t  version
+ *   uint16_t ruleCount
+ *   uint32_t fenceHash[ceil(ruleCount / FENCE_STRIDE)]  selectorHash of every FENCE_STRIDE-th index record
+ *   IndexRecord[ruleCount]  sorted by (selectorHash, selector bytes)
+ *   PackedStyle[ruleCount]  same order as the index, fixed PACKED_STYLE_SIZE bytes each
+ *   selector string pool
+ * The fence hashes (the top levels of the index) stay in RAM while the cache is open. A lookup searches them first,
+ * then binary-searches one FENCE_STRIDE run of the index straight from the file through a small LRU block cache, so
+ * the rule map is never rebuilt in RAM while laying out a chapter.
  */
 class CssParser {
  public:
   // Bump when CSS cache format or rules change; section caches are invalidated when this changes
-  static constexpr uint8_t CSS_CACHE_VERSION = 4;
+  static constexpr uint8_t CSS_CACHE_VERSION = 6;
 
   explicit CssParser(std::string cachePath) : cachePath(std::move(cachePath)) {}
-  ~CssParser() = default;
+  ~CssParser() { closeRuleCache(); }
 
   // Non-copyable
   CssParser(const CssParser&) = delete;
@@ -66,19 +79,24 @@ class CssParser {
   [[nodiscard]] static CssStyle parseInlineStyle(const std::string& styleValue);
 
   /**
-   * Check if any rules have been loaded
+   * Check if any rules have been loaded (parsed in RAM or available through the opened cache)
    */
-  [[nodiscard]] bool empty() const { return rulesBySelector_.empty(); }
+  [[nodiscard]] bool empty() const { return ruleCount() == 0; }
 
   /**
    * Get count of loaded rule sets
    */
-  [[nodiscard]] size_t ruleCount() const { return rulesBySelector_.size(); }
+  [[nodiscard]] size_t ruleCount() const {
+    return rulesBySelector_.empty() ? cachedRuleCount : rulesBySelector_.size();
+  }
 
   /**
-   * Clear all loaded rules
+   * Clear all loaded rules and release the rule cache file
    */
-  void clear() { rulesBySelector_.clear(); }
+  void clear() {
+    rulesBySelector_.clear();
+    closeRuleCache();
+  }
 
   /**
    * Check if CSS rules cache file exists
@@ -97,18 +115,69 @@ class CssParser {
   bool saveToCache() const;
 
   /**
-   * Load CSS rules from a cache file.
-   * Clears any existing rules before loading.
-   * @return true if cache was loaded successfully
+   * Open the CSS rules cache file for range-read lookups.
+   * Clears any existing rules. Rules are not loaded into RAM; resolveStyle() queries the file until clear().
+   * @return true if the cache exists and is valid
    */
   bool loadFromCache();
 
  private:
-  // Storage: maps normalized selector -> style properties
+  // Fixed-width selector index record in the cache file
+  struct IndexRecord {
+    uint32_t selectorHash;    // FNV-1a hash of the normalized selector
+    uint32_t selectorOffset;  // absolute file offset of the selector bytes
+    uint16_t selectorLen;
+    uint16_t reserved;
+  };
+  static constexpr size_t CACHE_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t);
+  static constexpr size_t INDEX_RECORD_SIZE = 12;
+  // 4 enums + 11 lengths (float value + uint8_t unit) + display + uint16_t defined bits
+  static constexpr size_t PACKED_STYLE_SIZE = 4 + 11 * (sizeof(float) + sizeof(uint8_t)) + 1 + sizeof(uint16_t);
+
+  // Index records per fence hash: a lookup reads at most this many records, one or two blocks
+  static constexpr size_t FENCE_STRIDE = 16;
+  // Small LRU block cache over the rule cache file, for the index run, selector and style of a lookup
+  static constexpr size_t CACHE_BLOCK_SIZE = 256;
+  static constexpr size_t CACHE_BLOCK_COUNT = 4;
+
+  // Storage: maps normalized selector -> style properties (only populated while parsing stylesheets)
   std::unordered_map<std::string, CssStyle> rulesBySelector_;
 
   std::string cachePath;
 
+  // Opened rule cache state (mutable: lookups through a const parser still fill the block cache)
+  mutable FsFile ruleCacheFile;
+  uint16_t cachedRuleCount = 0;
+  uint32_t cachedFileSize = 0;
+  mutable std::unique_ptr<uint8_t[]> blockData;
+  mutable uint32_t blockIds[CACHE_BLOCK_COUNT] = {};
+  mutable uint32_t blockLastUse[CACHE_BLOCK_COUNT] = {};
+  mutable uint32_t blockClock = 0;
+  std::unique_ptr<uint32_t[]> fenceHashes;
+  uint16_t fenceCount = 0;
+  uint32_t indexOffset = 0;  // file offset of the first IndexRecord
+
+  void closeRuleCache();
+  bool readCached(uint32_t offset, void* out, size_t len) const;
+  static uint16_t fenceCountFor(const uint16_t ruleCount) {
+    return static_cast<uint16_t>((ruleCount + FENCE_STRIDE - 1) / FENCE_STRIDE);
+  }
+  bool readIndexRecord(uint16_t index, IndexRecord& out) const;
+  bool selectorEquals(const IndexRecord& record, std::string_view selector) const;
+  bool findCachedRule(std::string_view selector, CssStyle& out) const;
+  bool findRule(const std::string& selector, CssStyle& out) const;
+
+  static uint32_t fnvHash(std::string_view s) {
+    uint32_t hash = 2166136261u;
+    for (const char c : s) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+  static void packStyle(const CssStyle& style, uint8_t* out);
+  static void unpackStyle(const uint8_t* in, CssStyle& style);
+
   // Internal parsing helpers
   void processRuleBlockWithStyle(const std::string& selectorGroup, const CssStyle& style);
   static CssStyle parseDeclarations(const std::string& declBlock);
@@ -2,13 +2,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <new>
 #include <vector>
 
 #include "HyphenationCommon.h"
 #include "LanguageHyphenator.h"
 #include "LanguageRegistry.h"
 
-const LanguageHyphenator* Hyphenator::cachedHyphenator_ = nullptr;
+thread_local const LanguageHyphenator* Hyphenator::cachedHyphenator_ = nullptr;
+thread_local Hyphenator::MemoScope* Hyphenator::memo_ = nullptr;
 
 namespace {
 
@@ -262,4 +265,111 @@ std::vector<Hyphenator::BreakInfo> Hyphenator::breakOffsets(const std::string& w
   return breaks;
 }
 
+uint32_t Hyphenator::memoHash(const std::string_view word) {
+  uint32_t hash = 2166136261u;
+  for (const char c : word) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool Hyphenator::memoMatches(const MemoEntry& entry, const std::string_view word, const bool includeFallback) {
+  // The language and fallback flag are compared too, so results never leak across them
+  return entry.length == word.size() && entry.hyphenator == cachedHyphenator_ &&
+         entry.includeFallback == includeFallback && memcmp(entry.word, word.data(), word.size()) == 0;
+}
+
+size_t Hyphenator::breakOffsets(const std::string_view word, const bool includeFallback, BreakInfo* out,
+                                const size_t capacity) {
+  if (word.empty()) {
+    return 0;
+  }
+
+  MemoScope* const memo = memo_ != nullptr && memo_->table_ != nullptr ? memo_ : nullptr;
+  const bool memoizable = memo != nullptr && word.size() <= MEMO_MAX_WORD_BYTES;
+  const uint32_t hash = memoizable ? memoHash(word) : 0;
+  const size_t home = hash & (MEMO_CAPACITY - 1);
+
+  if (memoizable) {
+    ++memo->lookups_;
+    for (size_t probe = 0; probe < MEMO_MAX_PROBES; ++probe) {
+      MemoEntry& entry = memo->table_[(home + probe) & (MEMO_CAPACITY - 1)];
+      if (entry.length == 0) {
+        break;
+      }
+      if (entry.hash != hash || !memoMatches(entry, word, includeFallback)) {
+        continue;
+      }
+
+      size_t count = 0;
+      uint32_t mask = entry.breakMask;
+      while (mask != 0) {
+        const auto offset = static_cast<size_t>(__builtin_ctz(mask));
+        if (count < capacity) {
+          out[count] = {offset, ((entry.hyphenMask >> offset) & 1) != 0};
+        }
+        ++count;
+        mask &= mask - 1;
+      }
+      if (entry.uses < UINT8_MAX) {
+        ++entry.uses;
+      }
+      ++memo->hits_;
+      return count;
+    }
+  }
+
+  const auto breaks = breakOffsets(std::string(word), includeFallback);
+
+  if (memoizable) {
+    MemoEntry entry = {cachedHyphenator_, hash, 0, 0, static_cast<uint8_t>(word.size()), includeFallback, 0, {}};
+    memcpy(entry.word, word.data(), word.size());
+    for (const auto& info : breaks) {
+      assert(info.byteOffset < MEMO_MAX_WORD_BYTES);  // offsets lie inside the word
+      entry.breakMask |= 1u << info.byteOffset;
+      if (info.requiresInsertedHyphen) {
+        entry.hyphenMask |= 1u << info.byteOffset;
+      }
+    }
+
+    // Take the first free slot in the probe window. When the window is full, the least used entry makes room only if
+    // it was never hit since it was stored; otherwise it loses a use, so frequent words stay and a stale one ages out
+    // after a few misses.
+    MemoEntry* slot = nullptr;
+    for (size_t probe = 0; probe < MEMO_MAX_PROBES; ++probe) {
+      MemoEntry& candidate = memo->table_[(home + probe) & (MEMO_CAPACITY - 1)];
+      if (candidate.length == 0) {
+        slot = &candidate;
+        break;
+      }
+      if (!slot || candidate.uses < slot->uses) {
+        slot = &candidate;
+      }
+    }
+    if (slot->length == 0 || slot->uses == 0) {
+      *slot = entry;
+    } else {
+      --slot->uses;
+    }
+  }
+
+  const size_t written = std::min(capacity, breaks.size());
+  std::copy_n(breaks.begin(), written, out);
+  return breaks.size();
+}
+
+Hyphenator::MemoScope::MemoScope(const bool enabled) : previous_(memo_) {
+  if (enabled) {
+    // Allocation failure just leaves memoization disabled.
+    table_ = new (std::nothrow) MemoEntry[MEMO_CAPACITY]();
+  }
+  memo_ = this;
+}
+
+Hyphenator::MemoScope::~MemoScope() {
+  memo_ = previous_;
+  delete[] table_;
+}
+
 void Hyphenator::setPreferredLanguage(const std::string& lang) { cachedHyphenator_ = hyphenatorForLanguage(lang); }
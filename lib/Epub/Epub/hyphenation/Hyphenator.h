@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class LanguageHyphenator;
@@ -35,9 +37,64 @@ class Hyphenator {
   //      word from overflowing the page width.
   static std::vector<BreakInfo> breakOffsets(const std::string& word, bool includeFallback);
 
-  // Provide a publication-level language hint (e.g. "en", "en-US", "ru") used to select hyphenation rules.
+  // Same break points as above, written into caller-provided storage in ascending byte-offset order.
+  // Returns the total number of break points; only the first `capacity` are written, so a return value larger
+  // than `capacity` means the caller must retry with more room. Served from the memo table without running the
+  // Liang automaton or allocating when a MemoScope is active and the word was seen before.
+  static size_t breakOffsets(std::string_view word, bool includeFallback, BreakInfo* out, size_t capacity);
+
+ private:
+  struct MemoEntry;
+
+ public:
+  // Enables a bounded memo of break points (keyed by language + word) for the lifetime of the scope, e.g. one section
+  // build. Natural text repeats words heavily and the line breaker may probe the same overflow word more than once,
+  // so repeated lookups become a table probe. The memo belongs to the task that opened the scope, so section builds on
+  // different tasks each use their own; a nested scope on the same task takes over until it closes.
+  class MemoScope {
+   public:
+    explicit MemoScope(bool enabled = true);
+    ~MemoScope();
+    MemoScope(const MemoScope&) = delete;
+    MemoScope& operator=(const MemoScope&) = delete;
+
+    // Memoizable lookups (words up to MEMO_MAX_WORD_BYTES) since the scope opened, and how many were served from it
+    size_t lookups() const { return lookups_; }
+    size_t hits() const { return hits_; }
+
+   private:
+    friend class Hyphenator;
+    MemoEntry* table_ = nullptr;
+    MemoScope* previous_ = nullptr;
+    size_t lookups_ = 0;
+    size_t hits_ = 0;
+  };
+
+  // Provide a publication-level language hint (e.g. "en", "en-US", "ru") used to select hyphenation rules. Applies to
+  // the calling task only.
   static void setPreferredLanguage(const std::string& lang);
 
  private:
-  static const LanguageHyphenator* cachedHyphenator_;
+  // Words longer than this many bytes bypass the memo (entries hold the word and 32-bit byte-offset masks).
+  static constexpr size_t MEMO_MAX_WORD_BYTES = 32;
+  static constexpr size_t MEMO_CAPACITY = 128;  // power of two, 52 bytes per entry on the device
+  static constexpr size_t MEMO_MAX_PROBES = 8;
+
+  struct MemoEntry {
+    // Language the break points were computed for
+    const LanguageHyphenator* hyphenator;
+    uint32_t hash;         // of the word, picks the home slot
+    uint32_t breakMask;    // bit N set = break allowed before byte N
+    uint32_t hyphenMask;   // bit N set = break at byte N requires an inserted hyphen
+    uint8_t length;        // word bytes; 0 = empty slot
+    bool includeFallback;  // fallback splits were included
+    uint8_t uses;          // hits since stored, saturating; a full probe window only gives up unused entries
+    char word[MEMO_MAX_WORD_BYTES];
+  };
+
+  static thread_local const LanguageHyphenator* cachedHyphenator_;
+  static thread_local MemoScope* memo_;
+
+  static uint32_t memoHash(std::string_view word);
+  static bool memoMatches(const MemoEntry& entry, std::string_view word, bool includeFallback);
 };
\ No newline at end of file
@@ -26,6 +26,11 @@
  *       flash memory; no heap allocations besides the stack-local AutomatonState
  *       structs. getAutomaton caches parseAutomaton results per blob pointer so
  *       multiple words hitting the same language only pay the cost once.
+ *     - The generator also emits SerializedHyphenationFastPath: a dense
+ *       256-entry root table and a (first byte x second byte) table for the
+ *       first level. Every starting position resolves its first two
+ *       transitions with two table reads and only decodes nodes that carry
+ *       levels, then continues the regular walk from depth 2.
  *
  * 3.  Pattern application
  *     - We walk the augmented bytes left-to-right. For each starting byte we
@@ -309,6 +314,42 @@ bool transition(const EmbeddedAutomaton& automaton, const AutomatonState& state,
   return false;
 }
 
+// Merge the Liang levels exposed by `state` into `scores` for a match that started at `byteStart`.
+void applyLevels(const AutomatonState& state, const size_t byteStart, const AugmentedWord& augmented,
+                 uint8_t* scores) {
+  if (!state.levels || state.levelsLen == 0) {
+    return;
+  }
+
+  size_t offset = 0;
+  // Each packed byte stores the byte-distance delta and the Liang level digit.
+  for (size_t i = 0; i < state.levelsLen; ++i) {
+    const uint8_t packed = state.levels[i];
+    const size_t dist = static_cast<size_t>(packed / 10);
+    const uint8_t level = static_cast<uint8_t>(packed % 10);
+
+    offset += dist;
+    const size_t splitByte = byteStart + offset;
+    if (splitByte >= augmented.byteLen) {
+      continue;
+    }
+
+    const int32_t boundary = augmented.byteToCharIndex[splitByte];
+    if (boundary < 0) {
+      continue;  // Mid-codepoint byte, wait for the next one.
+    }
+    if (boundary < 2 || boundary + 2 > static_cast<int32_t>(augmented.charCount_)) {
+      continue;  // Skip splits that land in the leading/trailing sentinels.
+    }
+
+    const size_t idx = static_cast<size_t>(boundary);
+    if (idx >= augmented.charCount_) {
+      continue;
+    }
+    scores[idx] = std::max(scores[idx], level);
+  }
+}
+
 // Converts odd score positions back into codepoint indexes, honoring min prefix/suffix constraints.
 // Each break corresponds to scores[breakIndex + 1] because of the leading '.' sentinel.
 // Convert odd score entries into hyphen positions while honoring prefix/suffix limits.
@@ -369,47 +410,54 @@ std::vector<size_t> liangBreakIndexes(const std::vector<CodepointInfo>& cps,
     scores[i] = 0;
   }
 
+  const SerializedHyphenationFastPath* fastPath = automaton.fastPath;
+
   // Walk every starting character position and stream bytes through the trie.
   for (size_t charStart = 0; charStart < augmented.charCount_; ++charStart) {
     const size_t byteStart = augmented.charByteOffsets[charStart];
     AutomatonState state = root;
+    size_t cursor = byteStart;
+
+    if (fastPath) {
+      // Depth 1: dense root table, decode the node only when it carries levels.
+      const uint8_t first = augmented.bytes[byteStart];
+      const uint32_t depth1 = fastPath->rootTable[first];
+      if (depth1 == SerializedHyphenationFastPath::kNoNode) {
+        continue;
+      }
+      if (depth1 & SerializedHyphenationFastPath::kHasLevelsFlag) {
+        applyLevels(decodeState(automaton, depth1 & SerializedHyphenationFastPath::kAddressMask), byteStart,
+                    augmented, scores);
+      }
+      if (byteStart + 1 >= augmented.byteLen) {
+        continue;
+      }
+
+      // Depth 2: (first, second) byte table, then resume the regular walk from there.
+      const uint8_t row = fastPath->level1Rows[first];
+      const uint8_t column = fastPath->level1Columns[augmented.bytes[byteStart + 1]];
+      if (row == SerializedHyphenationFastPath::kNoIndex || column == SerializedHyphenationFastPath::kNoIndex) {
+        continue;
+      }
+      const uint32_t depth2 = fastPath->level1Table[row * fastPath->columnCount + column];
+      if (depth2 == SerializedHyphenationFastPath::kNoNode) {
+        continue;
+      }
+      state = decodeState(automaton, depth2 & SerializedHyphenationFastPath::kAddressMask);
+      if (!state.valid()) {
+        continue;
+      }
+      applyLevels(state, byteStart, augmented, scores);
+      cursor = byteStart + 2;
+    }
 
-    for (size_t cursor = byteStart; cursor < augmented.byteLen; ++cursor) {
+    for (; cursor < augmented.byteLen; ++cursor) {
       AutomatonState next;
       if (!transition(automaton, state, augmented.bytes[cursor], next)) {
         break;  // No more matches for this prefix.
       }
       state = next;
-
-      if (state.levels && state.levelsLen > 0) {
-        size_t offset = 0;
-        // Each packed byte stores the byte-distance delta and the Liang level digit.
-        for (size_t i = 0; i < state.levelsLen; ++i) {
-          const uint8_t packed = state.levels[i];
-          const size_t dist = static_cast<size_t>(packed / 10);
-          const uint8_t level = static_cast<uint8_t>(packed % 10);
-
-          offset += dist;
-          const size_t splitByte = byteStart + offset;
-          if (splitByte >= augmented.byteLen) {
-            continue;
-          }
-
-          const int32_t boundary = augmented.byteToCharIndex[splitByte];
-          if (boundary < 0) {
-            continue;  // Mid-codepoint byte, wait for the next one.
-          }
-          if (boundary < 2 || boundary + 2 > static_cast<int32_t>(augmented.charCount_)) {
-            continue;  // Skip splits that land in the leading/trailing sentinels.
-          }
-
-          const size_t idx = static_cast<size_t>(boundary);
-          if (idx >= augmented.charCount_) {
-            continue;
-          }
-          scores[idx] = std::max(scores[idx], level);
-        }
-      }
+      applyLevels(state, byteStart, augmented, scores);
     }
   }
 
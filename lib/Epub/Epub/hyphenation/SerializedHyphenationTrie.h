@@ -3,9 +3,30 @@
 #include <cstddef>
 #include <cstdint>
 
+// Dense lookup tables for the first two trie levels, emitted next to each serialized trie by
+// generate_hyphenation_trie.py. Every augmented word position starts at the root, so resolving the root and
+// first-level transitions with two table reads (instead of decoding variable-stride nodes) lets the runtime jump
+// straight to depth 2.
+//
+// Node entries hold the blob-relative node address in the low 24 bits; kHasLevelsFlag marks nodes that carry
+// Liang levels and therefore still need decoding. kNoNode marks a missing transition.
+struct SerializedHyphenationFastPath {
+  static constexpr uint32_t kNoNode = 0xFFFFFFFFu;
+  static constexpr uint32_t kHasLevelsFlag = 0x80000000u;
+  static constexpr uint32_t kAddressMask = 0x00FFFFFFu;
+  static constexpr uint8_t kNoIndex = 0xFFu;
+
+  const std::uint32_t* rootTable;     // [256] depth-1 node for each first byte
+  const std::uint8_t* level1Rows;     // [256] row of a first byte in level1Table, or kNoIndex
+  const std::uint8_t* level1Columns;  // [256] column of a second byte in level1Table, or kNoIndex
+  const std::uint32_t* level1Table;   // [rows * columnCount] depth-2 node for each (first, second) byte pair
+  std::uint8_t columnCount;
+};
+
 // Lightweight descriptor that points at a serialized Liang hyphenation trie stored in flash.
 struct SerializedHyphenationPatterns {
   size_t rootOffset;
   const std::uint8_t* data;
   size_t size;
+  const SerializedHyphenationFastPath* fastPath = nullptr;
 };
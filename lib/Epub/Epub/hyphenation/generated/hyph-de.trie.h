@@ -12901,8 +12901,241 @@ alignas(4) constexpr uint8_t de_trie_data[] = {
     0x7F, 0xFF, 0x95,
 };
 
+// Flattened root and first-level transitions (see SerializedHyphenationFastPath).
+alignas(4) constexpr uint32_t de_root_table[256] = {
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00001CC2u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x000050A2u, 0x8000795Cu, 0x000083C3u, 0x80009FA7u, 0x0000E094u, 0x0000F765u, 0x8001113Au,
+    0x000139ABu, 0x000168C0u, 0x80016B33u, 0x00018697u, 0x0001B6AAu, 0x0001CFC5u, 0x0001FC9Cu, 0x0002210Eu,
+    0x0002370Du, 0x8002379Fu, 0x00027116u, 0x0002A5A5u, 0x8002D9BCu, 0x0002FD1Du, 0x800302B7u, 0x80030D15u,
+    0x00031121u, 0x0003152Fu, 0x800324D7u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000062A5u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+};
+
+constexpr uint8_t de_level1_rows[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+constexpr uint8_t de_level1_columns[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1A,
+    0xFF, 0x1B, 0x1C, 0xFF, 0x1D, 0xFF, 0xFF, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0xFF, 0x23, 0xFF, 0x24,
+    0xFF, 0x25, 0xFF, 0x26, 0xFF, 0xFF, 0x27, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x28, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x29, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+alignas(4) constexpr uint32_t de_level1_table[] = {
+    0x000006AFu, 0x0000086Bu, 0x000008ADu, 0x00000A1Fu, 0x00000D34u, 0x00000E31u, 0x00000F31u, 0x0000102Du,
+    0x00001090u, 0x000010B4u, 0x0000110Bu, 0x00001232u, 0x00001368u, 0x00001442u, 0x000014F6u, 0x00001596u,
+    0xFFFFFFFFu, 0x000016D5u, 0x0000186Eu, 0x00001A48u, 0x00001AF9u, 0x00001B29u, 0x00001BEDu, 0x00001BFDu,
+    0x00001C08u, 0x00001CB2u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x000006FDu, 0x00001DDDu, 0x0000203Cu, 0x00002291u, 0x00002405u, 0x000027B6u, 0x0000298Du,
+    0x00002B8Bu, 0x00002D6Bu, 0x00002E8Au, 0x00002EB9u, 0x00002FFAu, 0x000035C2u, 0x00003845u, 0x00003E74u,
+    0x80003EDCu, 0x00003FA7u, 0x00003FD6u, 0x00004563u, 0x0000485Du, 0x00004BA6u, 0x80004F94u, 0x00004FFCu,
+    0x80005012u, 0x80005031u, 0x00005057u, 0x00005092u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00001E11u, 0x000065E9u, 0x800066C5u, 0x800066DDu, 0x800066F6u,
+    0x00006CC5u, 0x80006D2Au, 0x80006D5Au, 0x80006D66u, 0x80006E92u, 0x80006ECEu, 0x80006ED3u, 0x800070AFu,
+    0x800070CEu, 0x800070DAu, 0x00007212u, 0x8000724Eu, 0x80001E1Eu, 0x8000746Bu, 0x800076D4u, 0x8000772Fu,
+    0x000078D1u, 0x80001E1Eu, 0x8000790Cu, 0xFFFFFFFFu, 0x80007931u, 0x80007953u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000667Au, 0x800079FEu, 0xFFFFFFFFu,
+    0x80007A46u, 0x80007A4Fu, 0x00007AD0u, 0x80001D6Cu, 0x80001D14u, 0x00007F5Cu, 0x00007FB5u, 0xFFFFFFFFu,
+    0x800081AAu, 0x80008225u, 0x80008230u, 0xFFFFFFFFu, 0x800082D6u, 0x80002281u, 0x80001E1Eu, 0x80008337u,
+    0x80008359u, 0x8000837Bu, 0x800083A3u, 0x80007034u, 0xFFFFFFFFu, 0x80001E1Eu, 0x800083BAu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00007A35u,
+    0x0000886Eu, 0x80008948u, 0x8000895Fu, 0x800089A3u, 0x0000918Au, 0x800091D7u, 0x80009212u, 0x80009232u,
+    0x00009496u, 0x80001E1Eu, 0x800094D8u, 0x80009517u, 0x80002281u, 0x80009541u, 0x000096C5u, 0x80006358u,
+    0x80001E1Eu, 0x800099EBu, 0x80009CC3u, 0x80009D61u, 0x00009EF4u, 0x80009F31u, 0x80009F60u, 0xFFFFFFFFu,
+    0x00009F8Eu, 0x80001E5Au, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00008941u, 0x8000A1CCu, 0x0000A3DCu, 0x0000A590u, 0x0000A6FDu, 0x8000A918u, 0x8000AAF3u,
+    0x8000AC64u, 0x0000AFAEu, 0x0000B63Bu, 0x0000B68Du, 0x0000B76Bu, 0x0000BE06u, 0x8000C016u, 0x0000C7C2u,
+    0x8000C8C4u, 0x0000C9C5u, 0x0000CA08u, 0x0000D40Bu, 0x0000D8EBu, 0x0000DC1Du, 0x0000DECDu, 0x8000DF3Cu,
+    0x0000DFA0u, 0x0000E00Bu, 0x8000E045u, 0x8000E07Du, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000A227u, 0x8000E37Eu, 0x8000E492u, 0x800066DDu, 0x8000E49Du,
+    0x8000E8E8u, 0x8000EA48u, 0x8000EA98u, 0x8000EAABu, 0x8000EC93u, 0x0000ECDBu, 0x8000ECEAu, 0x0000EE5Eu,
+    0x8000EE9Cu, 0x8000EEA7u, 0x8000EF9Au, 0x80006358u, 0x80001E1Eu, 0x8000F18Bu, 0x8000F3B8u, 0x8000F5E2u,
+    0x8000F713u, 0x80001E1Eu, 0x80001E1Eu, 0xFFFFFFFFu, 0x80001D6Cu, 0x8000F756u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000E46Eu, 0x0000FAD2u, 0x8000FB6Eu,
+    0x80002281u, 0x8000FBF0u, 0x000101E4u, 0x80010240u, 0x80010265u, 0x800102AEu, 0x0001040Du, 0x80001E1Eu,
+    0x8001045Bu, 0x000106DEu, 0x80010728u, 0x00010812u, 0x0001095Eu, 0x8001099Fu, 0x800109AAu, 0x80010C03u,
+    0x80010EFFu, 0x80010F68u, 0x000110E0u, 0x80011111u, 0x80011118u, 0xFFFFFFFFu, 0x00003171u, 0x8001112Fu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000FB5Bu,
+    0x00011704u, 0x80011841u, 0x8001184Fu, 0x8001185Au, 0x00011E37u, 0x80011E8Fu, 0x80011EA9u, 0x80011EDBu,
+    0x000120F9u, 0xFFFFFFFFu, 0x8001214Au, 0x800123F6u, 0x80012566u, 0x800126E4u, 0x0001293Eu, 0x80012993u,
+    0xFFFFFFFFu, 0x80012D2Du, 0x80013143u, 0x80013674u, 0x000138C1u, 0x80001E1Eu, 0x80013941u, 0xFFFFFFFFu,
+    0x0001397Au, 0x800139A0u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00011822u, 0x00013C9Cu, 0x00013E98u, 0x8001402Eu, 0x0001415Du, 0x000146C1u, 0x80014877u,
+    0x00014AB6u, 0x80014B4Du, 0x00014B81u, 0x00014BADu, 0x80014DC7u, 0x0001516Eu, 0x00015338u, 0x000158EFu,
+    0x00015A30u, 0x80015AF2u, 0xFFFFFFFFu, 0x00015CDDu, 0x000161AEu, 0x00016655u, 0x80016696u, 0x800167B5u,
+    0x000167D8u, 0x000167EDu, 0x80001D6Cu, 0x8001689Du, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00013D4Au, 0x8001696Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80001E1Eu,
+    0x00016A1Du, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00016A42u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80002281u, 0xFFFFFFFFu, 0x00016A8Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80016AC0u,
+    0x80016B14u, 0x80001E1Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80016FA7u, 0x8001705Fu,
+    0x80017072u, 0x80017085u, 0x0001758Du, 0x800175E5u, 0x80017607u, 0x80017622u, 0x00017795u, 0x800177D6u,
+    0x80017801u, 0x80017A1Du, 0x80017A4Cu, 0x80017AE8u, 0x80017D47u, 0x80017D97u, 0x8001152Fu, 0x80017F4Fu,
+    0x80018209u, 0x8001844Eu, 0x80018633u, 0x80011111u, 0x80001E1Eu, 0xFFFFFFFFu, 0x0001866Eu, 0x80018690u,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00017053u,
+    0x00018E97u, 0x80019152u, 0x800191FCu, 0x8001943Du, 0x80019C54u, 0x80019D33u, 0x80019DA3u, 0x80019DD9u,
+    0x8001A191u, 0x80001E1Eu, 0x8001A25Bu, 0x8001A5C4u, 0x8001A72Au, 0x8001A782u, 0x8001A9D8u, 0x8001AA70u,
+    0x80001E1Eu, 0x8001AAD2u, 0x8001AE05u, 0x8001B1B2u, 0x0001B4DAu, 0x8001B528u, 0x80001E1Eu, 0x80001E1Eu,
+    0x8001B55Cu, 0x8001B67Bu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00019028u, 0x8001BCEFu, 0x8001BDF9u, 0x8001BE18u, 0x8001BE97u, 0x8001C313u, 0x8001C369u,
+    0x8001C378u, 0x8001C391u, 0x8001C5AEu, 0x8001C5F9u, 0x80006358u, 0x8001C60Eu, 0x8001C7C5u, 0x8001C80Bu,
+    0x8001C984u, 0x8001CABEu, 0x80001E1Eu, 0x8001CAF4u, 0x8001CC46u, 0x8001CDC3u, 0x8001CF49u, 0x80001E1Eu,
+    0x8001CFA4u, 0xFFFFFFFFu, 0x8001CFB2u, 0x80001E5Au, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0001BDBCu, 0x0001D6B0u, 0x8001D88Du, 0x8001D8F1u, 0x8001DB6Eu,
+    0x8001E22Eu, 0x8001E31Eu, 0x8001E52Du, 0x8001E58Fu, 0x8001E871u, 0x800177D6u, 0x8001EADEu, 0x8001EB49u,
+    0x8001EB80u, 0x8001ECD8u, 0x8001EF37u, 0x8001EFA6u, 0x80001E1Eu, 0x8001EFFBu, 0x8001F4EFu, 0x8001F8BEu,
+    0x0001FA7Bu, 0x8001FAD7u, 0x8001FAF9u, 0x80001D6Cu, 0x0001FB12u, 0x8001FC81u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0001D815u, 0x8001FD84u, 0x0001FF6Du,
+    0x000200BEu, 0x000201A8u, 0x000203F7u, 0x00020584u, 0x80020666u, 0x000207EFu, 0x0002086Bu, 0x00020897u,
+    0x8002091Du, 0x00020BFEu, 0x00020DC5u, 0x00021159u, 0x8002121Eu, 0x000213D4u, 0xFFFFFFFFu, 0x000219E1u,
+    0x00021CB9u, 0x00021F4Eu, 0x0002200Fu, 0x0002204Eu, 0x80022075u, 0x000220A4u, 0x000220C5u, 0x000220FDu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0001FE08u,
+    0x8002248Fu, 0x80001E1Eu, 0x80022590u, 0x80022597u, 0x8002283Au, 0x00022A65u, 0x80022AABu, 0x80022B6Fu,
+    0x00022D3Du, 0x80001E1Eu, 0x80022D77u, 0x80022DEFu, 0x80022E0Eu, 0x80022E19u, 0x80022FFCu, 0x80023172u,
+    0xFFFFFFFFu, 0x80023375u, 0x0002341Fu, 0x80023590u, 0x800236C0u, 0x80001E1Eu, 0x800236FBu, 0xFFFFFFFFu,
+    0x80023702u, 0x80001E1Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00022587u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80001E1Eu, 0xFFFFFFFFu, 0x8002378Cu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00024080u, 0x800243A9u, 0x8002445Du, 0x800246B6u,
+    0x8002505Au, 0x80025155u, 0x8002536Fu, 0x80025424u, 0x0002588Cu, 0x80001E1Eu, 0x80025A7Bu, 0x80025B42u,
+    0x80025D3Au, 0x80025F4Cu, 0x0002630Eu, 0x800263A9u, 0x80001E1Eu, 0x800264D9u, 0x80026813u, 0x80026BCCu,
+    0x00026EE3u, 0x80026F42u, 0x80026F64u, 0x80002281u, 0x80026F75u, 0x800270F8u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00024234u, 0x800276F7u, 0x80027873u,
+    0x80027CD0u, 0x80027D28u, 0x800284E6u, 0x80028557u, 0x8002859Fu, 0x80028654u, 0x800289A1u, 0x800177D6u,
+    0x80028B4Cu, 0x80028BFDu, 0x80028C7Au, 0x80028CB3u, 0x80028EC4u, 0x800292C4u, 0x8001152Fu, 0x8002933Cu,
+    0x800296CDu, 0x0002A21Du, 0x8002A44Cu, 0x8002A49Du, 0x8002A4D0u, 0xFFFFFFFFu, 0x8002A4FBu, 0x8002A57Au,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00027822u,
+    0x0002AE9Cu, 0x8002B0A8u, 0x8002B0E5u, 0x8002B10Au, 0x0002BC01u, 0x8002BC6Cu, 0x8002BCCAu, 0x0002BE7Au,
+    0x0002C308u, 0x80001E1Eu, 0x8002C34Au, 0x8002C38Eu, 0x8002C3D9u, 0x8002C404u, 0x0002C7AAu, 0x8002C808u,
+    0x80001E1Eu, 0x8002CD33u, 0x8002D182u, 0x8002D489u, 0x0002D7B8u, 0x8002D802u, 0x8002D830u, 0x80002281u,
+    0x0002D844u, 0x8002D9A1u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x0002B06Bu, 0x8002DB49u, 0x8002DCA0u, 0x8002DE93u, 0x8002DF1Bu, 0x0002E364u, 0x0002E56Fu,
+    0x8002E74Du, 0x0002E7EFu, 0x8002E87Du, 0x000067C7u, 0x0002E92Cu, 0x0002EAF3u, 0x0002ECABu, 0x8002F092u,
+    0x8002F11Eu, 0x0002F1CEu, 0xFFFFFFFFu, 0x0002F581u, 0x0002F942u, 0x8002FC0Du, 0x8002FC5Au, 0x0002FC77u,
+    0xFFFFFFFFu, 0x8002FC8Bu, 0x0002FC9Au, 0x8002FD02u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0002DBB3u, 0x0002FE89u, 0x80001E5Au, 0x80002281u, 0x8002FEBEu,
+    0x0003004Cu, 0x8003008Du, 0x80001E5Au, 0x80002281u, 0x00030157u, 0x80001E1Eu, 0x80006358u, 0x80030191u,
+    0x8003019Cu, 0x80002281u, 0x0003022Bu, 0x80030250u, 0x80001E1Eu, 0x00030261u, 0x8003027Fu, 0x80001E5Au,
+    0x000302B2u, 0x80001E1Eu, 0x80001E1Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80001E1Eu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0003024Du, 0x00030522u, 0x800305D4u,
+    0x80002281u, 0x80001E1Eu, 0x000309C9u, 0x80002281u, 0x80001E1Eu, 0x00030A0Du, 0x00030B24u, 0x80001D11u,
+    0x80002281u, 0x80002281u, 0x80002281u, 0x80030B56u, 0x00030BEEu, 0x80002281u, 0x80001E1Eu, 0x00030BFBu,
+    0x80030C12u, 0x80030C29u, 0x00030CF8u, 0xFFFFFFFFu, 0x80001E1Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80001E1Eu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000305CDu,
+    0x80030DC1u, 0x80001E5Au, 0x80030DFCu, 0x80030E0Fu, 0x80030E48u, 0x80030E77u, 0x80001E5Au, 0x80002281u,
+    0x80030ED7u, 0xFFFFFFFFu, 0x80030F0Au, 0x80030F11u, 0x80030F24u, 0x80002281u, 0x00030F3Au, 0x80030F7Du,
+    0xFFFFFFFFu, 0x80002281u, 0x80030F94u, 0x800310B1u, 0x800310F6u, 0x8003110Du, 0x80001E1Eu, 0xFFFFFFFFu,
+    0x0003111Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00030F57u, 0x000311B0u, 0x00002526u, 0x800311E2u, 0x000311FDu, 0x80031229u, 0x8003124Cu,
+    0x00031258u, 0x80031261u, 0x80006358u, 0xFFFFFFFFu, 0x80031268u, 0x000312E0u, 0x80031321u, 0x8003136Bu,
+    0x000313C1u, 0x8003141Cu, 0xFFFFFFFFu, 0x80031460u, 0x800314BFu, 0x00031501u, 0x8003150Fu, 0x00031519u,
+    0x00031522u, 0x80001D6Cu, 0x80001D6Cu, 0x0003152Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000311D6u, 0x00031707u, 0x800317F5u, 0x80002281u, 0x8003181Eu,
+    0x00031D69u, 0x80031DB2u, 0x80031DDAu, 0x80031DDFu, 0x00031F29u, 0x80001E1Eu, 0x80031F6Au, 0x80031F92u,
+    0x80031FA6u, 0x80031FB6u, 0x00032075u, 0x800320BAu, 0x80001E1Eu, 0x800320C1u, 0x800320E4u, 0x80032181u,
+    0x8003232Bu, 0x80001E1Eu, 0x00032469u, 0xFFFFFFFFu, 0x00032483u, 0x800324BCu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000317E7u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80005CC6u, 0x80002303u, 0x0000577Eu, 0x00005738u, 0x80001EF8u, 0x800057A5u, 0x8000578Au, 0x800057AEu,
+    0x000057AAu, 0x80002303u, 0x80002303u, 0x800057B4u, 0x000057BEu, 0x00005AC1u, 0x0000626Eu, 0xFFFFFFFFu,
+};
+
+constexpr SerializedHyphenationFastPath de_fast_path = {
+    de_root_table,
+    de_level1_rows,
+    de_level1_columns,
+    de_level1_table,
+    42,
+};
+
 constexpr SerializedHyphenationPatterns de_patterns = {
     0x32542u,
     de_trie_data,
     sizeof(de_trie_data),
+    &de_fast_path,
 };
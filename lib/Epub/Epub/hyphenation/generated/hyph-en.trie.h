@@ -1693,8 +1693,182 @@ alignas(4) constexpr uint8_t en_trie_data[] = {
     0xDD, 0xF6, 0x7C, 0xFA, 0x00, 0xFC, 0x31, 0xFD, 0x52, 0xFE, 0x1F, 0xFF, 0x55, 0xFF, 0xDB,
 };
 
+// Flattened root and first-level transitions (see SerializedHyphenationFastPath).
+alignas(4) constexpr uint32_t en_root_table[256] = {
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00000903u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x0000105Fu, 0x00001383u, 0x000017E4u, 0x00001BF5u, 0x00002479u, 0x000026A7u, 0x0000297Eu,
+    0x00002C58u, 0x0000328Du, 0x0000332Au, 0x000033FBu, 0x000038D0u, 0x00003CEBu, 0x000041E1u, 0x00004810u,
+    0x00004C88u, 0x00004D12u, 0x00005378u, 0x000059CAu, 0x00005F69u, 0x000062EDu, 0x0000651Eu, 0x0000663Fu,
+    0x0000670Cu, 0x00006842u, 0x000068C8u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+};
+
+constexpr uint8_t en_level1_rows[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+constexpr uint8_t en_level1_columns[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+alignas(4) constexpr uint32_t en_level1_table[] = {
+    0x000002E6u, 0x00000343u, 0x000003A5u, 0x000003F5u, 0x0000046Eu, 0x000004A1u, 0x000004D5u, 0x00000535u,
+    0x00000577u, 0x00000587u, 0x000008FEu, 0x000005D4u, 0x00000656u, 0x00000688u, 0x000006BEu, 0x0000070Eu,
+    0xFFFFFFFFu, 0x00000779u, 0x000007EAu, 0x00000868u, 0x000008ABu, 0x000008CFu, 0x000008E1u, 0xFFFFFFFFu,
+    0x000002B5u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00000991u, 0x000009EBu, 0x80000A3Au, 0x00000A53u, 0x80000A64u,
+    0x00000A9Du, 0x00000AB6u, 0x80000AD8u, 0x80000AEAu, 0x00000AF1u, 0x00000B50u, 0x00000BBCu, 0x80000CD9u,
+    0x80000949u, 0x00000D55u, 0x00000D6Eu, 0x80000E3Eu, 0x00000EA7u, 0x00000F96u, 0x00000FDDu, 0x00001022u,
+    0x00001033u, 0x00001047u, 0x0000104Au, 0x00001058u, 0x000010F7u, 0x80001123u, 0xFFFFFFFFu, 0x8000112Au,
+    0x0000117Bu, 0x800011A0u, 0xFFFFFFFFu, 0x800011A3u, 0x00001218u, 0x80000AEAu, 0x800009E1u, 0x80001264u,
+    0x8000112Au, 0x80001271u, 0x000012C7u, 0x80000949u, 0xFFFFFFFFu, 0x000012F8u, 0x800012FFu, 0x80001305u,
+    0x00001360u, 0x80000AEAu, 0x80001379u, 0xFFFFFFFFu, 0x0000137Cu, 0xFFFFFFFFu, 0x80001440u, 0xFFFFFFFFu,
+    0x80001475u, 0xFFFFFFFFu, 0x000014C7u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x8000154Eu, 0x800015CBu, 0xFFFFFFFFu,
+    0x800015F8u, 0x80001622u, 0xFFFFFFFFu, 0x8000094Cu, 0x8000168Fu, 0xFFFFFFFFu, 0x80000AEAu, 0x0000171Bu,
+    0x8000172Bu, 0x80001756u, 0x000017C2u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800017E1u, 0x000002B5u,
+    0x80001849u, 0x80000AEAu, 0x8000094Cu, 0x8000187Au, 0x00001977u, 0x8000112Au, 0x000019B4u, 0x800019C1u,
+    0x00001A41u, 0x80000AEAu, 0x80001A72u, 0x00001A93u, 0x80000AEAu, 0x80001AA6u, 0x80001AD6u, 0x80000AEAu,
+    0xFFFFFFFFu, 0x80001B65u, 0x80001B7Au, 0x00001B8Au, 0x80001BC7u, 0x80000AEAu, 0x80000AEAu, 0xFFFFFFFFu,
+    0x80001BECu, 0xFFFFFFFFu, 0x00001CB6u, 0x80001CEAu, 0x00001D70u, 0x00001DCEu, 0x00001DF7u, 0x80001E4Fu,
+    0x00001E7Cu, 0x80001E92u, 0x80001EB2u, 0x80001ED3u, 0x00001EDCu, 0x00001F82u, 0x00001FF7u, 0x00002084u,
+    0x000020CBu, 0x00002133u, 0x8000215Fu, 0x00002238u, 0x00002330u, 0x000023AEu, 0x800023E3u, 0x0000243Au,
+    0x0000245Eu, 0x0000246Bu, 0x0000246Fu, 0xFFFFFFFFu, 0x800024EEu, 0x80001379u, 0xFFFFFFFFu, 0x80000949u,
+    0x00002539u, 0x80002566u, 0xFFFFFFFFu, 0x80000949u, 0x800025E5u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80002621u,
+    0x80000949u, 0x80000949u, 0x80002655u, 0x80001379u, 0xFFFFFFFFu, 0x0000266Eu, 0x800011BAu, 0x8000267Bu,
+    0x8000268Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800017E1u, 0xFFFFFFFFu, 0x8000270Du, 0x800009C7u,
+    0xFFFFFFFFu, 0x800009E1u, 0x00002774u, 0xFFFFFFFFu, 0x80002793u, 0x000027AEu, 0x000027EFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x80002849u, 0x80002854u, 0x00002898u, 0x800028C9u, 0x800009C7u, 0xFFFFFFFFu, 0x8000292Du,
+    0x8000293Fu, 0x00002945u, 0x0000295Fu, 0xFFFFFFFFu, 0x800009C7u, 0xFFFFFFFFu, 0x80002975u, 0xFFFFFFFFu,
+    0x00002A34u, 0x80000AEAu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002ABBu, 0x80000AEAu, 0xFFFFFFFFu, 0x80000AEAu,
+    0x00002B28u, 0xFFFFFFFFu, 0x80000949u, 0x80002B53u, 0x80002B5Cu, 0x80002B69u, 0x00002BD0u, 0x80001379u,
+    0xFFFFFFFFu, 0x80002BECu, 0x80002BF5u, 0x00002C0Du, 0x00002C24u, 0xFFFFFFFFu, 0x80002C38u, 0xFFFFFFFFu,
+    0x00002C51u, 0xFFFFFFFFu, 0x80002CB6u, 0x00002CF4u, 0x00002D61u, 0x80002DBDu, 0x80002DF6u, 0x00002E2Au,
+    0x80002E7Du, 0x800009C7u, 0x80002E9Bu, 0x80002E9Eu, 0x80000949u, 0x00002EDAu, 0x00002F35u, 0x00002FF4u,
+    0x80003044u, 0x80003079u, 0x0000309Fu, 0x800030E7u, 0x00003173u, 0x0000322Eu, 0x80000AEAu, 0x80003273u,
+    0x80001379u, 0x00000C80u, 0x80000949u, 0x00003283u, 0x800032F3u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80003313u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000331Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x00003327u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00003333u, 0x80000AEAu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000335Bu, 0x800009C7u, 0xFFFFFFFFu, 0x800009E1u, 0x800033A1u, 0xFFFFFFFFu,
+    0x800009E1u, 0x800033BDu, 0x80000AEAu, 0x000033C6u, 0x000033D7u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000033E4u,
+    0x800033ECu, 0x8000094Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000AEAu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x0000347Eu, 0x800034A0u, 0x800034B6u, 0x800034DAu, 0x0000358Cu, 0x800035B1u, 0x800035BDu, 0x800011BAu,
+    0x00003654u, 0x80000949u, 0x0000368Eu, 0x800036D1u, 0x800036F7u, 0x80003703u, 0x00003786u, 0x800037C2u,
+    0xFFFFFFFFu, 0x8000112Au, 0x800037D4u, 0x80003814u, 0x00003870u, 0x0000389Fu, 0x800018BAu, 0xFFFFFFFFu,
+    0x800038BBu, 0xFFFFFFFFu, 0x800039ADu, 0x800039E1u, 0x80001379u, 0xFFFFFFFFu, 0x00003A87u, 0x8000112Au,
+    0xFFFFFFFFu, 0x800011A0u, 0x00003B3Du, 0xFFFFFFFFu, 0x80000949u, 0x8000112Au, 0x80003B66u, 0x80003B6Fu,
+    0x80003C22u, 0x80003C8Cu, 0xFFFFFFFFu, 0x800011A3u, 0x80003CB2u, 0x80000949u, 0x80003CD6u, 0xFFFFFFFFu,
+    0x80000949u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80003D95u, 0x80001AA6u, 0x00003DE9u, 0x00003E2Eu,
+    0x00003EB6u, 0x80003EF7u, 0x00003F40u, 0x80003F62u, 0x00003FB5u, 0x80000AEAu, 0x80003FE5u, 0x80003FF4u,
+    0x80004000u, 0x8000400Cu, 0x000040D5u, 0x8000410Au, 0x80000AEAu, 0x80004113u, 0x8000413Du, 0x8000418Cu,
+    0x000041B8u, 0x800019C1u, 0x80001C3Bu, 0xFFFFFFFFu, 0x000041D4u, 0x800041DBu, 0x8000423Bu, 0x00004266u,
+    0x000042B1u, 0x000042F9u, 0x00004313u, 0x0000432Fu, 0x00004370u, 0x80004389u, 0x800043AFu, 0x8000094Cu,
+    0x800043D1u, 0x00004463u, 0x000044EDu, 0x80004579u, 0x800045ABu, 0x000045F0u, 0x80000AEAu, 0x0000469Du,
+    0x00004711u, 0x00004779u, 0x800047A2u, 0x000047DFu, 0x000047EDu, 0x0000480Du, 0x000047FDu, 0xFFFFFFFFu,
+    0x800048E9u, 0x8000112Au, 0xFFFFFFFFu, 0x800009E1u, 0x0000497Cu, 0x80000949u, 0x80000949u, 0x000049E9u,
+    0x00004A57u, 0xFFFFFFFFu, 0x80004A73u, 0x80004AA3u, 0x8000112Au, 0x800011BAu, 0x00004B03u, 0x80004B41u,
+    0xFFFFFFFFu, 0x80004BE7u, 0x80004C0Bu, 0x80004C30u, 0x00004C6Cu, 0xFFFFFFFFu, 0x800009C7u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80004D09u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00004DAAu, 0x80004DFEu, 0x80004E22u, 0x00004E43u,
+    0x00004F3Cu, 0x80004F73u, 0x80004F96u, 0x80004FA8u, 0x00005071u, 0x800009C7u, 0x000050B7u, 0x800050E4u,
+    0x8000510Cu, 0x0000513Eu, 0x000051DAu, 0x80005221u, 0xFFFFFFFFu, 0x8000524Eu, 0x80005292u, 0x000052F9u,
+    0x00005320u, 0x00005359u, 0x80000AEAu, 0xFFFFFFFFu, 0x00005367u, 0x00005375u, 0x8000540Fu, 0x80001379u,
+    0x000054C0u, 0x80001379u, 0x00005585u, 0x800011A3u, 0x800011BAu, 0x800055E3u, 0x00005645u, 0xFFFFFFFFu,
+    0x80005684u, 0x800056A3u, 0x800056D0u, 0x80001C3Bu, 0x8000572Cu, 0x000057BDu, 0x000057E0u, 0x80000AEAu,
+    0x8000583Bu, 0x00005933u, 0x80005974u, 0x80000949u, 0x8000599Bu, 0xFFFFFFFFu, 0x800059B8u, 0xFFFFFFFFu,
+    0x80005AA5u, 0x800018BAu, 0x80005AF1u, 0x8000112Au, 0x00005BABu, 0x800018BAu, 0x8000112Au, 0x00005C5Au,
+    0x00005CF5u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80005D45u, 0x80005D54u, 0x80003703u, 0x80005DA0u, 0x8000112Au,
+    0xFFFFFFFFu, 0x00005EB1u, 0x80005EC7u, 0x80005EE2u, 0x80005F1Cu, 0x80000949u, 0x80005F40u, 0xFFFFFFFFu,
+    0x80005F5Du, 0x80001BB5u, 0x00005FD4u, 0x00006006u, 0x00006014u, 0x0000604Eu, 0x00006073u, 0x0000607Au,
+    0x00006085u, 0xFFFFFFFFu, 0x8000609Cu, 0x8000094Cu, 0x80000949u, 0x000060F6u, 0x0000612Fu, 0x00006168u,
+    0x00006181u, 0x000061ABu, 0xFFFFFFFFu, 0x0000620Eu, 0x80006268u, 0x000062D4u, 0x800062E7u, 0x800019C1u,
+    0xFFFFFFFFu, 0x00001543u, 0xFFFFFFFFu, 0x00000A20u, 0x8000636Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x00006408u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000649Bu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x00006508u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x80000A81u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000A69u, 0xFFFFFFFFu, 0x00006560u, 0x80000AEAu,
+    0x800009C7u, 0xFFFFFFFFu, 0x000065A1u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000002DEu, 0x800065D1u, 0xFFFFFFFFu,
+    0x80000A69u, 0x000065F0u, 0xFFFFFFFFu, 0x00004366u, 0x80006602u, 0x8000094Cu, 0xFFFFFFFFu, 0x0000662Du,
+    0x00006632u, 0x80000949u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800009E1u, 0xFFFFFFFFu,
+    0x8000667Cu, 0xFFFFFFFFu, 0x80006693u, 0xFFFFFFFFu, 0x800066A3u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800066B6u,
+    0x800066C8u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80002111u, 0x800066ECu,
+    0x80006707u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800066F3u, 0x800066F9u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800009E1u,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000672Eu, 0x80000AEAu, 0x8000674Cu, 0x80000AEAu, 0x0000676Du, 0xFFFFFFFFu,
+    0x00000E18u, 0x800011A3u, 0x80000AEAu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000677Au, 0x0000679Bu, 0x000067A5u,
+    0x800067BCu, 0x000067E6u, 0xFFFFFFFFu, 0x000067F6u, 0x0000681Au, 0x0000683Bu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80000AEAu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80006876u, 0x80000949u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80006887u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x8000689Eu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000B40u,
+    0x80000949u, 0xFFFFFFFFu, 0x800068B3u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000002B5u,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x800068BFu,
+};
+
+constexpr SerializedHyphenationFastPath en_fast_path = {
+    en_root_table,
+    en_level1_rows,
+    en_level1_columns,
+    en_level1_table,
+    26,
+};
+
 constexpr SerializedHyphenationPatterns en_patterns = {
     0x68EDu,
     en_trie_data,
     sizeof(en_trie_data),
+    &en_fast_path,
 };
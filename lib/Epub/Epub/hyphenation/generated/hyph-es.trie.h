@@ -862,8 +862,210 @@ alignas(4) constexpr uint8_t es_trie_data[] = {
     0x0C, 0xF6, 0x24, 0xF7, 0x4C, 0xF9, 0x4F, 0xFD, 0x7C, 0xFF, 0xB0, 0xFF, 0xF9,
 };
 
+// Flattened root and first-level transitions (see SerializedHyphenationFastPath).
+alignas(4) constexpr uint32_t es_root_table[256] = {
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00001084u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00002E47u, 0x80000254u, 0x800012E9u, 0x800018BEu, 0x00003274u, 0x8000193Bu, 0x80001ABCu,
+    0x00001C3Au, 0x000034A8u, 0x80001C8Cu, 0x80001CD5u, 0x80001D93u, 0x80001ECEu, 0x80001F5Fu, 0x00002C44u,
+    0x80002219u, 0x8000227Bu, 0x80002324u, 0x80002500u, 0x80002777u, 0x000034F1u, 0x800027D5u, 0x80002821u,
+    0x80002870u, 0x800028BBu, 0x80002904u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002B1Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+};
+
+constexpr uint8_t es_level1_rows[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+constexpr uint8_t es_level1_columns[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1C, 0xFF, 0xFF, 0xFF, 0x1D, 0xFF, 0xFF,
+    0xFF, 0x1E, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x20, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+alignas(4) constexpr uint32_t es_level1_table[] = {
+    0xFFFFFFFFu, 0x80000D45u, 0x800002FDu, 0x80000455u, 0x800004D7u, 0x00000E48u, 0x800004DEu, 0x800004DEu,
+    0x00000CD7u, 0x00001081u, 0x800004DEu, 0x800004DEu, 0x800004DEu, 0x80000548u, 0x800004DEu, 0xFFFFFFFFu,
+    0x800007D2u, 0x800004DEu, 0x80000A46u, 0x80000C16u, 0x80000CB7u, 0xFFFFFFFFu, 0x800004DEu, 0x800004DEu,
+    0x800004DEu, 0x800004DEu, 0x800004DEu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x80000119u, 0x00002C6Cu, 0x00002D94u, 0x00002DEEu, 0x00002DB6u, 0x00002DF8u, 0x00002E0Fu,
+    0x00002DF8u, 0xFFFFFFFFu, 0x00002C7Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002E2Cu, 0x00002CC8u, 0x00002CD6u,
+    0x00002952u, 0x00002E16u, 0xFFFFFFFFu, 0x00002D6Fu, 0x00002CA0u, 0x00002CE6u, 0x00002E1Eu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x00002E44u, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x80000122u, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000012Bu, 0x80000130u, 0x8000011Cu, 0x0000021Bu, 0x8000011Cu, 0x8000011Cu, 0x80000148u, 0x80000130u,
+    0x8000011Cu, 0xFFFFFFFFu, 0x80000135u, 0x8000011Cu, 0x80000148u, 0x8000011Cu, 0x8000013Eu, 0x00000251u,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x00001225u, 0x8000011Cu, 0x80000122u, 0x8000011Cu,
+    0x00001283u, 0x8000012Bu, 0x80000130u, 0x800010F8u, 0x000012CAu, 0x8000011Cu, 0x8000011Cu, 0x80001144u,
+    0x80000130u, 0x800010DAu, 0x00001202u, 0x80000135u, 0x8000011Cu, 0x80001197u, 0x8000011Cu, 0x800010E6u,
+    0x0000123Du, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x800010F2u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000012E6u, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x80000122u,
+    0x8000011Cu, 0x0000189Au, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0x000018BBu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x80000130u, 0x8000011Cu, 0xFFFFFFFFu, 0x80000135u, 0x8000011Cu, 0x80000148u, 0x8000011Cu,
+    0x8000013Eu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x000030BCu, 0xFFFFFFFFu,
+    0x000030F1u, 0x0000307Cu, 0x00003096u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x0000326Fu, 0x00002EBAu, 0x00002EDAu, 0x00002E87u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000305Au,
+    0x00002EA2u, 0x000030FEu, 0x00003102u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00003249u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x000030CFu, 0x80000119u, 0x00001938u,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001909u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001914u,
+    0x8000011Cu, 0x8000011Cu, 0x80000148u, 0x8000011Cu, 0x8000011Cu, 0x0000191Eu, 0x8000011Cu, 0x8000011Cu,
+    0x80000148u, 0x8000011Cu, 0x800010F2u, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u,
+    0x00001A79u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001A9Du, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x00001AADu, 0x8000011Cu, 0x8000011Cu, 0x8000198Cu, 0x8000011Cu, 0x800010F2u, 0x00001A68u, 0x8000011Cu,
+    0x8000011Cu, 0x80001A0Bu, 0x8000011Cu, 0x8000011Cu, 0x00001AB9u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80000119u, 0x00001B4Au, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001B9Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x00001C22u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001C33u,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001B30u, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x0000348Cu, 0x00003461u, 0x0000346Fu, 0x0000332Cu, 0x0000349Du, 0xFFFFFFFFu,
+    0x0000330Du, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00003442u,
+    0x000034A1u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00003353u, 0x00003499u, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00001CD1u, 0x8000011Cu, 0x8000011Cu, 0x80000148u,
+    0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x80000148u, 0x8000011Cu, 0x8000011Cu,
+    0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x80000122u,
+    0x8000011Cu, 0x00001D62u, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0x00001D79u, 0x8000011Cu, 0x8000011Cu,
+    0x80001D1Du, 0x80000130u, 0x8000011Cu, 0x00001D90u, 0x80000135u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000013Eu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x00001E6Eu, 0x8000011Cu,
+    0x80000122u, 0x8000011Cu, 0x00001E1Eu, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0x00001EB0u, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x80000130u, 0x800010F2u, 0x00001EC4u, 0x80000135u, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000013Eu, 0x00001EC1u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x00001F45u,
+    0x8000011Cu, 0x80000122u, 0x8000011Cu, 0x00001F4Fu, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x80000130u, 0x8000011Cu, 0x00001F3Eu, 0x80000135u, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x80001F2Eu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u,
+    0x00002B3Au, 0xFFFFFFFFu, 0x00002BB8u, 0xFFFFFFFFu, 0x00002B35u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x00002C3Fu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002B7Fu, 0x00002BBBu, 0x00002BBFu, 0x00002C04u, 0x00002BC9u,
+    0xFFFFFFFFu, 0x00002BF9u, 0x00002BA4u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002B48u,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80000119u, 0x00002121u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x000020AEu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x0000212Cu, 0x8000011Cu, 0x8000011Cu, 0x80001FDAu, 0x8000011Cu, 0x800010F2u, 0x0000220Fu,
+    0x8000011Cu, 0x8000011Cu, 0x80002030u, 0x80001FBAu, 0x80001FC3u, 0x0000207Fu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x00002274u, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x00002316u, 0x8000011Cu, 0x80000122u, 0x8000011Cu, 0x000022FEu,
+    0x8000012Bu, 0x80000130u, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x800022C3u,
+    0x8000011Cu, 0x00002320u, 0x80000135u, 0x8000011Cu, 0x80000148u, 0x8000011Cu, 0x8000013Eu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x000023E8u, 0x8000011Cu, 0x80000122u, 0x8000011Cu,
+    0x00002426u, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x80000130u, 0x8000011Cu, 0x0000245Fu, 0x80002372u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x800023C8u,
+    0x000024F9u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0x00002758u, 0x8000011Cu, 0x80000122u,
+    0x8000011Cu, 0x0000273Bu, 0x8000012Bu, 0x80000130u, 0x8000011Cu, 0x00002755u, 0x8000011Cu, 0x8000011Cu,
+    0x80002726u, 0x80000130u, 0x8000011Cu, 0x0000275Cu, 0x80000135u, 0x8000011Cu, 0x800026C5u, 0x80002720u,
+    0x8000013Eu, 0x00002764u, 0x8000011Cu, 0x8000011Cu, 0x80002726u, 0x8000011Cu, 0x80002717u, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002774u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x000034D1u, 0xFFFFFFFFu, 0x000034EEu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x000034CEu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x000027CEu,
+    0x8000011Cu, 0x8000011Cu, 0x80000148u, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu,
+    0x80000148u, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u,
+    0x0000281Du, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x80000122u, 0x8000011Cu, 0x00002869u, 0x8000012Bu, 0x80000130u,
+    0x8000011Cu, 0x00001CD1u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x80000130u, 0x8000011Cu, 0xFFFFFFFFu,
+    0x80000135u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000013Eu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x80000122u, 0x8000011Cu, 0xFFFFFFFFu, 0x8000012Bu,
+    0x80000130u, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x80000130u, 0x8000011Cu,
+    0xFFFFFFFFu, 0x80000135u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000013Eu, 0xFFFFFFFFu, 0x8000011Cu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0x80000119u, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu,
+    0x8000011Cu, 0x00002900u, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu,
+    0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0x8000011Cu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu,
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00002AE1u, 0x000029C0u,
+    0x00002A25u, 0x8000294Cu, 0x00002B0Cu, 0xFFFFFFFFu,
+};
+
+constexpr SerializedHyphenationFastPath es_fast_path = {
+    es_root_table,
+    es_level1_rows,
+    es_level1_columns,
+    es_level1_table,
+    33,
+};
+
 constexpr SerializedHyphenationPatterns es_patterns = {
     0x34F8u,
     es_trie_data,
     sizeof(es_trie_data),
+    &es_fast_path,
 };
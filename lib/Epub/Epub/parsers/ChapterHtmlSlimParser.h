@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "../FootnoteEntry.h"
+#include "../LayoutArena.h"
+#include "../ParagraphXPathTable.h"
 #include "../ParsedText.h"
 #include "../blocks/ImageBlock.h"
 #include "../blocks/TextBlock.h"
@@ -37,6 +39,8 @@ class ChapterHtmlSlimParser {
   char partWordBuffer[MAX_WORD_SIZE + 1] = {};
   int partWordBufferIndex = 0;
   bool nextWordContinues = false;  // true when next flushed word attaches to previous (inline element boundary)
+  // Words, lines and page elements; declared before their owners so it outlives them
+  LayoutArena arena;
   std::unique_ptr<ParsedText> currentTextBlock = nullptr;
   std::unique_ptr<Page> currentPage = nullptr;
   int16_t currentPageNextY = 0;
@@ -50,9 +54,9 @@ class ChapterHtmlSlimParser {
   const CssParser* cssParser;
   bool embeddedStyle;
   uint8_t imageRendering;
+  bool usePullTokenizer;
   std::string contentBase;
   std::string imageBasePath;
-  int imageCounter = 0;
 
   // Style tracking (replaces depth-based approach)
   struct StyleStackEntry {
@@ -75,6 +79,12 @@ class ChapterHtmlSlimParser {
   std::vector<std::pair<std::string, uint16_t>> anchorData;
   std::string pendingAnchorId;  // deferred until after previous text block is flushed
   uint16_t xpathParagraphIndex = 0;
+  // Paragraph paths and page start positions for KOReader sync
+  ParagraphXPathTable xpathTable;
+  uint16_t blockParagraphIndex = 0;    // paragraph the current text block belongs to or follows
+  bool blockInParagraph = false;       // whether the current text block is inside that paragraph
+  uint16_t laidOutParagraphIndex = 0;  // paragraph of the last line added to a page
+  uint32_t laidOutCodepoints = 0;      // codepoints of that paragraph already on pages
 
   // Footnote link tracking
   bool insideFootnoteLink = false;
@@ -88,6 +98,8 @@ class ChapterHtmlSlimParser {
   void startNewTextBlock(const BlockStyle& blockStyle);
   void flushPartWordBuffer();
   void makePages();
+  bool parseWithExpat(FsFile& file);
+  bool parseWithPullTokenizer(FsFile& file, bool& unsupportedEncoding);
   // XML callbacks
   static void XMLCALL startElement(void* userData, const XML_Char* name, const XML_Char** atts);
   static void XMLCALL characterData(void* userData, const XML_Char* s, int len);
@@ -102,7 +114,8 @@ class ChapterHtmlSlimParser {
                                  const std::function<void(std::unique_ptr<Page>, uint16_t)>& completePageFn,
                                  const bool embeddedStyle, const std::string& contentBase,
                                  const std::string& imageBasePath, const uint8_t imageRendering = 0,
-                                 const std::function<void()>& popupFn = nullptr, const CssParser* cssParser = nullptr)
+                                 const std::function<void()>& popupFn = nullptr, const CssParser* cssParser = nullptr,
+                                 const bool usePullTokenizer = false)
 
       : epub(epub),
         filepath(filepath),
@@ -119,6 +132,7 @@ class ChapterHtmlSlimParser {
         cssParser(cssParser),
         embeddedStyle(embeddedStyle),
         imageRendering(imageRendering),
+        usePullTokenizer(usePullTokenizer),
         contentBase(contentBase),
         imageBasePath(imageBasePath) {}
 
@@ -126,4 +140,5 @@ class ChapterHtmlSlimParser {
   bool parseAndBuildPages();
   void addLineToPage(std::shared_ptr<TextBlock> line);
   const std::vector<std::pair<std::string, uint16_t>>& getAnchors() const { return anchorData; }
+  const ParagraphXPathTable& getXPathTable() const { return xpathTable; }
 };
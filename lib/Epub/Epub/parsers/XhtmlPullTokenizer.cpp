@@ -0,0 +1,678 @@
+#include "XhtmlPullTokenizer.h"
+
+#include <Utf8.h>
+
+#include <cstring>
+#include <new>
+
+#include "../htmlEntities.h"
+
+namespace {
+// Longest entity reference we try to resolve, including '&' and ';' (e.g. "&thetasym;" or "&#x10FFFF;").
+constexpr size_t MAX_ENTITY_LENGTH = 32;
+
+const char* VOID_TAGS[] = {"area", "base", "br",   "col",   "embed",  "hr",    "img",
+                           "input", "link", "meta", "param", "source", "track", "wbr"};
+constexpr int NUM_VOID_TAGS = sizeof(VOID_TAGS) / sizeof(VOID_TAGS[0]);
+
+bool isSpace(const char c) { return c == ' ' || c == '\r' || c == '\n' || c == '\t'; }
+
+bool isNameStart(const char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || static_cast<uint8_t>(c) >= 0x80;
+}
+
+bool isNameEnd(const char c) { return isSpace(c) || c == '/' || c == '>' || c == '='; }
+
+char asciiLower(const char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+bool equalsIgnoreCase(const char* a, const char* b, const size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (asciiLower(a[i]) != asciiLower(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isVoidTag(const char* name) {
+  for (int i = 0; i < NUM_VOID_TAGS; i++) {
+    if (strcmp(name, VOID_TAGS[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Rewrite "\r\n" and lone "\r" as "\n" in place, like XML end-of-line handling. Returns the new length.
+size_t normalizeNewlines(char* text, const size_t len) {
+  char* cr = static_cast<char*>(memchr(text, '\r', len));
+  if (!cr) {
+    return len;
+  }
+  size_t write = cr - text;
+  for (size_t read = write; read < len; read++) {
+    if (text[read] == '\r') {
+      text[write++] = '\n';
+      if (read + 1 < len && text[read + 1] == '\n') read++;
+    } else {
+      text[write++] = text[read];
+    }
+  }
+  return write;
+}
+
+size_t encodeUtf8(const uint32_t cp, char* out) {
+  if (cp < 0x80) {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xF0 | (cp >> 18));
+  out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  return 4;
+}
+}  // namespace
+
+XhtmlPullTokenizer::~XhtmlPullTokenizer() { delete[] window; }
+
+// Compact the window and read more input behind the existing data. The window only grows when it is already
+// full, which happens only while a single tag or entity is being assembled.
+bool XhtmlPullTokenizer::fill() {
+  if (eof) {
+    return false;
+  }
+  if (pos > 0) {
+    memmove(window, window + pos, end - pos);
+    end -= pos;
+    pos = 0;
+  }
+  if (end == capacity) {
+    if (capacity >= MAX_WINDOW_SIZE) {
+      return false;
+    }
+    const size_t newCapacity = capacity * 2 < MAX_WINDOW_SIZE ? capacity * 2 : MAX_WINDOW_SIZE;
+    char* grown = new (std::nothrow) char[newCapacity];
+    if (!grown) {
+      return false;
+    }
+    memcpy(grown, window, end);
+    delete[] window;
+    window = grown;
+    capacity = newCapacity;
+  }
+
+  const size_t count = reader(window + end, capacity - end);
+  if (count == 0) {
+    eof = true;
+    return false;
+  }
+  end += count;
+  return true;
+}
+
+bool XhtmlPullTokenizer::ensureAvailable(const size_t count) {
+  while (end - pos < count) {
+    if (!fill()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Consume input up to and including `terminator`. Returns false if the input ended first.
+bool XhtmlPullTokenizer::skipPast(const char* terminator) {
+  const size_t termLen = strlen(terminator);
+  while (true) {
+    for (size_t i = pos; i + termLen <= end; i++) {
+      if (memcmp(window + i, terminator, termLen) == 0) {
+        pos = i + termLen;
+        return true;
+      }
+    }
+    // Keep a possible partial terminator at the end of the window.
+    if (end - pos >= termLen) {
+      pos = end - (termLen - 1);
+    }
+    if (!fill()) {
+      pos = end;
+      return false;
+    }
+  }
+}
+
+// Skip <!DOCTYPE ...> and other declarations, including a bracketed internal subset.
+void XhtmlPullTokenizer::skipDeclaration() {
+  int bracketDepth = 0;
+  char quote = 0;
+  while (true) {
+    for (; pos < end; pos++) {
+      const char c = window[pos];
+      if (quote) {
+        if (c == quote) quote = 0;
+      } else if (c == '"' || c == '\'') {
+        quote = c;
+      } else if (c == '[') {
+        bracketDepth++;
+      } else if (c == ']') {
+        bracketDepth--;
+      } else if (c == '>' && bracketDepth <= 0) {
+        pos++;
+        return;
+      }
+    }
+    if (!fill()) {
+      return;
+    }
+  }
+}
+
+// Inspect the byte order mark and XML declaration. Returns false for anything that is not UTF-8.
+bool XhtmlPullTokenizer::checkEncoding() {
+  ensureAvailable(4);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(window + pos);
+  const size_t available = end - pos;
+  if (available >= 2 && ((bytes[0] == 0xFE && bytes[1] == 0xFF) || (bytes[0] == 0xFF && bytes[1] == 0xFE) ||
+                         (bytes[0] == '<' && bytes[1] == 0) || (bytes[0] == 0 && bytes[1] == '<'))) {
+    return false;
+  }
+  if (available >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+    pos += 3;
+  }
+
+  if (!ensureAvailable(5) || memcmp(window + pos, "<?xml", 5) != 0) {
+    return true;
+  }
+  // The declaration is short; look for its end within the first few hundred bytes.
+  ensureAvailable(256);
+  const char* decl = window + pos;
+  const size_t declLen = end - pos;
+  const char* declEnd = static_cast<const char*>(memchr(decl, '>', declLen));
+  const size_t searchLen = declEnd ? static_cast<size_t>(declEnd - decl) : declLen;
+
+  static constexpr char ENCODING[] = "encoding";
+  constexpr size_t ENCODING_LEN = sizeof(ENCODING) - 1;
+  for (size_t i = 0; i + ENCODING_LEN < searchLen; i++) {
+    if (memcmp(decl + i, ENCODING, ENCODING_LEN) != 0) {
+      continue;
+    }
+    size_t j = i + ENCODING_LEN;
+    while (j < searchLen && (isSpace(decl[j]) || decl[j] == '=')) j++;
+    if (j >= searchLen || (decl[j] != '"' && decl[j] != '\'')) {
+      return true;
+    }
+    const char quote = decl[j++];
+    const size_t valueStart = j;
+    while (j < searchLen && decl[j] != quote) j++;
+    const size_t valueLen = j - valueStart;
+    const char* value = decl + valueStart;
+    return (valueLen == 5 && equalsIgnoreCase(value, "utf-8", 5)) ||
+           (valueLen == 4 && equalsIgnoreCase(value, "utf8", 4)) ||
+           (valueLen == 8 && equalsIgnoreCase(value, "us-ascii", 8)) ||
+           (valueLen == 5 && equalsIgnoreCase(value, "ascii", 5));
+  }
+  return true;
+}
+
+// Find the '>' closing the tag that starts before `from`, ignoring '>' inside quoted attribute values.
+size_t XhtmlPullTokenizer::findTagEnd(const size_t from) const {
+  char quote = 0;
+  for (size_t i = from; i < end; i++) {
+    const char c = window[i];
+    if (quote) {
+      if (c == quote) quote = 0;
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+    } else if (c == '>') {
+      return i;
+    }
+  }
+  return end;
+}
+
+// Length of the entity reference at `src` (starting with '&'), or 0 if it is not terminated by ';' in time.
+size_t XhtmlPullTokenizer::findEntityEnd(const char* src, const size_t available) const {
+  const size_t limit = available < MAX_ENTITY_LENGTH ? available : MAX_ENTITY_LENGTH;
+  for (size_t i = 1; i < limit; i++) {
+    const char c = src[i];
+    if (c == ';') {
+      return i > 1 ? i + 1 : 0;
+    }
+    const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '#';
+    if (!valid) {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+// Decode a complete "&...;" reference. Returns the decoded UTF-8 length (0 for unknown references) and points
+// `out` at the decoded bytes.
+size_t XhtmlPullTokenizer::decodeEntity(const char* src, const size_t len, const char** out) {
+  if (src[1] == '#') {
+    uint32_t cp = 0;
+    size_t i = 2;
+    const bool hex = src[i] == 'x' || src[i] == 'X';
+    if (hex) i++;
+    if (i >= len - 1) {
+      return 0;
+    }
+    for (; i < len - 1; i++) {
+      const char c = src[i];
+      uint32_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = c - '0';
+      } else if (hex && asciiLower(c) >= 'a' && asciiLower(c) <= 'f') {
+        digit = asciiLower(c) - 'a' + 10;
+      } else {
+        return 0;
+      }
+      cp = cp * (hex ? 16 : 10) + digit;
+      if (cp > 0x10FFFF) {
+        return 0;
+      }
+    }
+    if (cp == 0 || (cp >= 0xD800 && cp <= 0xDFFF)) {
+      return 0;
+    }
+    const size_t encodedLen = encodeUtf8(cp, entityBuffer);
+    entityBuffer[encodedLen] = '\0';
+    *out = entityBuffer;
+    return encodedLen;
+  }
+
+  // The XML predefined entities first, then the HTML table.
+  const char* value = nullptr;
+  if (len == 5 && memcmp(src, "&amp;", 5) == 0) {
+    value = "&";
+  } else if (len == 4 && memcmp(src, "&lt;", 4) == 0) {
+    value = "<";
+  } else if (len == 4 && memcmp(src, "&gt;", 4) == 0) {
+    value = ">";
+  } else if (len == 6 && memcmp(src, "&quot;", 6) == 0) {
+    value = "\"";
+  } else if (len == 6 && memcmp(src, "&apos;", 6) == 0) {
+    value = "'";
+  } else {
+    value = lookupHtmlEntity(src, len);
+  }
+  if (!value) {
+    return 0;
+  }
+  *out = value;
+  return strlen(value);
+}
+
+// Decode entities and normalize whitespace in place, the way an XML processor reports CDATA attribute values.
+// Returns the new length.
+size_t XhtmlPullTokenizer::decodeAttributeValue(char* value, const size_t len) {
+  size_t write = 0;
+  for (size_t read = 0; read < len;) {
+    const char c = value[read];
+    if (c == '&') {
+      const size_t entityLen = findEntityEnd(value + read, len - read);
+      const char* decoded = nullptr;
+      const size_t decodedLen = entityLen ? decodeEntity(value + read, entityLen, &decoded) : 0;
+      if (decodedLen > 0 && decodedLen <= entityLen) {
+        memmove(value + write, decoded, decodedLen);
+        write += decodedLen;
+        read += entityLen;
+        continue;
+      }
+    } else if (c == '\r' || c == '\n' || c == '\t') {
+      value[write++] = ' ';
+      read += (c == '\r' && read + 1 < len && value[read + 1] == '\n') ? 2 : 1;
+      continue;
+    }
+    value[write++] = value[read++];
+  }
+  return write;
+}
+
+void XhtmlPullTokenizer::pushOpen(const char* name, const size_t len) {
+  openOffsets.push_back(static_cast<uint32_t>(openNames.size()));
+  openNames.append(name, len);
+  openNames.push_back('\0');
+}
+
+// Index of the innermost open element called `name`, preferring an exact match over a case-insensitive one.
+int XhtmlPullTokenizer::findOpen(const char* name, const size_t len) const {
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = static_cast<int>(openOffsets.size()) - 1; i >= 0; i--) {
+      const char* open = openNames.data() + openOffsets[i];
+      const size_t openLen = (i + 1 < static_cast<int>(openOffsets.size()) ? openOffsets[i + 1] : openNames.size()) -
+                             openOffsets[i] - 1;
+      if (openLen != len) {
+        continue;
+      }
+      if (pass == 0 ? memcmp(open, name, len) == 0 : equalsIgnoreCase(open, name, len)) {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+XhtmlPullTokenizer::Token XhtmlPullTokenizer::closeTop() {
+  Token token;
+  token.type = TokenType::EndTag;
+  token.name = openNames.data() + openOffsets.back();
+  popPending = true;
+  if (pendingCloses > 0) {
+    pendingCloses--;
+  }
+  return token;
+}
+
+bool XhtmlPullTokenizer::readStartTag(Token& out) {
+  size_t tagEnd = findTagEnd(pos + 1);
+  while (tagEnd == end) {
+    // Rescan from the start after refilling: the quote state is not carried over.
+    if (!fill()) {
+      if (eof) {
+        pos = end;  // Truncated tag at end of input.
+      } else {
+        droppedTags++;
+        skipPast(">");
+      }
+      return false;
+    }
+    tagEnd = findTagEnd(pos + 1);
+  }
+
+  char* tag = window + pos;
+  const size_t tagLen = tagEnd - pos;
+  const bool selfClosing = tagLen > 1 && tag[tagLen - 1] == '/';
+
+  size_t i = 1;
+  const size_t nameStart = i;
+  while (i < tagLen && !isNameEnd(tag[i])) i++;
+  const size_t nameLen = i - nameStart;
+
+  int attributeCount = 0;
+  while (i < tagLen) {
+    while (i < tagLen && (isSpace(tag[i]) || tag[i] == '/')) i++;
+    if (i >= tagLen) break;
+
+    const size_t attrNameStart = i;
+    while (i < tagLen && !isNameEnd(tag[i])) i++;
+    if (i == attrNameStart) {
+      i++;  // Stray '=' or similar, skip it.
+      continue;
+    }
+    const size_t attrNameEnd = i;
+    while (i < tagLen && isSpace(tag[i])) i++;
+
+    const char* value = "";
+    if (i < tagLen && tag[i] == '=') {
+      i++;
+      while (i < tagLen && isSpace(tag[i])) i++;
+      size_t valueStart = i;
+      size_t valueEnd;
+      if (i < tagLen && (tag[i] == '"' || tag[i] == '\'')) {
+        const char quote = tag[i];
+        valueStart = ++i;
+        while (i < tagLen && tag[i] != quote) i++;
+        valueEnd = i;
+        if (i < tagLen) i++;
+      } else {
+        while (i < tagLen && !isSpace(tag[i])) i++;
+        valueEnd = i;
+        if (i < tagLen) i++;  // Consume the separator before it is overwritten by the terminator.
+        // A trailing '/' of an unquoted value belongs to the self-closing marker.
+        if (selfClosing && valueEnd == tagLen) valueEnd--;
+      }
+      const size_t valueLen = decodeAttributeValue(tag + valueStart, valueEnd - valueStart);
+      tag[valueStart + valueLen] = '\0';
+      value = tag + valueStart;
+    }
+
+    tag[attrNameEnd] = '\0';
+    if (attributeCount < MAX_ATTRIBUTES) {
+      attributes[2 * attributeCount] = tag + attrNameStart;
+      attributes[2 * attributeCount + 1] = value;
+      attributeCount++;
+    }
+  }
+  attributes[2 * attributeCount] = nullptr;
+  tag[nameStart + nameLen] = '\0';
+  pos = tagEnd + 1;
+
+  pushOpen(tag + nameStart, nameLen);
+  if (selfClosing || isVoidTag(tag + nameStart)) {
+    pendingCloses = 1;
+  }
+
+  out.type = TokenType::StartTag;
+  out.name = tag + nameStart;
+  out.attributes = attributes;
+  return true;
+}
+
+bool XhtmlPullTokenizer::readEndTag(Token& out) {
+  size_t tagEnd = findTagEnd(pos + 2);
+  while (tagEnd == end) {
+    if (!fill()) {
+      pos = end;
+      return false;
+    }
+    tagEnd = findTagEnd(pos + 2);
+  }
+
+  const char* name = window + pos + 2;
+  size_t nameLen = 0;
+  while (pos + 2 + nameLen < tagEnd && !isSpace(name[nameLen]) && name[nameLen] != '/') nameLen++;
+  pos = tagEnd + 1;
+
+  const int index = findOpen(name, nameLen);
+  if (index < 0) {
+    return false;  // Stray end tag.
+  }
+  // Close everything opened inside the matching element, then the element itself.
+  pendingCloses = openOffsets.size() - static_cast<size_t>(index);
+  out = closeTop();
+  return true;
+}
+
+bool XhtmlPullTokenizer::readMarkup(Token& out) {
+  ensureAvailable(2);
+  if (end - pos < 2) {
+    pos = end;
+    return false;
+  }
+
+  const char c = window[pos + 1];
+  if (c == '/') {
+    return readEndTag(out);
+  }
+  if (c == '?') {
+    pos += 2;
+    skipPast("?>");
+    return false;
+  }
+  if (c == '!') {
+    ensureAvailable(9);
+    if (end - pos >= 4 && memcmp(window + pos, "<!--", 4) == 0) {
+      pos += 4;
+      skipPast("-->");
+    } else if (end - pos >= 9 && memcmp(window + pos, "<![CDATA[", 9) == 0) {
+      pos += 9;
+      insideCdata = true;
+    } else {
+      skipDeclaration();
+    }
+    return false;
+  }
+  if (isNameStart(c)) {
+    return readStartTag(out);
+  }
+
+  // A '<' that does not start markup is plain text.
+  out.type = TokenType::Text;
+  out.text = window + pos;
+  out.textLength = 1;
+  pos++;
+  return true;
+}
+
+bool XhtmlPullTokenizer::readEntity(Token& out) {
+  ensureAvailable(MAX_ENTITY_LENGTH);
+  const char* src = window + pos;
+  const size_t entityLen = findEntityEnd(src, end - pos);
+  out.type = TokenType::Text;
+  if (entityLen == 0) {
+    // Bare ampersand.
+    out.text = src;
+    out.textLength = 1;
+    pos++;
+    return true;
+  }
+
+  const char* decoded = nullptr;
+  const size_t decodedLen = decodeEntity(src, entityLen, &decoded);
+  if (decodedLen > 0) {
+    out.text = decoded;
+    out.textLength = decodedLen;
+  } else {
+    // Unknown reference: pass the raw "&name;" through.
+    out.text = src;
+    out.textLength = entityLen;
+  }
+  pos += entityLen;
+  return true;
+}
+
+bool XhtmlPullTokenizer::readText(Token& out) {
+  size_t scan = pos;
+  while (true) {
+    while (scan < end && window[scan] != '<' && window[scan] != '&') scan++;
+    if (scan < end || eof) break;
+    // The run reaches the end of the window: pull in more input so text arrives in as few pieces as possible,
+    // but never grow the window for it.
+    if (pos == 0 && end == capacity) break;
+    // fill() compacts the window even when no more input arrives, so rebase the scan position first.
+    const size_t scanned = scan - pos;
+    const bool more = fill();
+    scan = pos + scanned;
+    if (!more) break;
+  }
+
+  size_t len = scan - pos;
+  if (scan == end && !eof) {
+    // Do not split a UTF-8 sequence or a "\r\n" pair across two text tokens.
+    const size_t safeLen = static_cast<size_t>(utf8SafeTruncateBuffer(window + pos, static_cast<int>(len)));
+    if (safeLen > 0) len = safeLen;
+    if (len > 1 && window[pos + len - 1] == '\r') len--;
+  }
+
+  out.type = TokenType::Text;
+  out.text = window + pos;
+  out.textLength = normalizeNewlines(window + pos, len);
+  pos += len;
+  return out.textLength > 0;
+}
+
+bool XhtmlPullTokenizer::readCdata(Token& out) {
+  size_t scan = pos;
+  while (true) {
+    while (scan + 3 <= end && memcmp(window + scan, "]]>", 3) != 0) scan++;
+    if (scan + 3 <= end || eof) break;
+    if (pos == 0 && end == capacity) break;
+    // fill() compacts the window even when no more input arrives, so rebase the scan position first.
+    const size_t scanned = scan - pos;
+    const bool more = fill();
+    scan = pos + scanned;
+    if (!more) break;
+  }
+
+  const bool terminated = scan + 3 <= end;
+  size_t len = terminated ? scan - pos : end - pos;
+  if (!terminated && !eof) {
+    // Window is full of CDATA: report it, keeping a possible partial terminator and UTF-8 sequence.
+    len = static_cast<size_t>(utf8SafeTruncateBuffer(window + pos, static_cast<int>(len - 2)));
+    if (len > 1 && window[pos + len - 1] == '\r') len--;
+  }
+
+  out.type = TokenType::Text;
+  out.text = window + pos;
+  out.textLength = normalizeNewlines(window + pos, len);
+  pos += len;
+  if (terminated) {
+    pos += 3;
+    insideCdata = false;
+  } else if (eof) {
+    insideCdata = false;
+  }
+  return out.textLength > 0;
+}
+
+XhtmlPullTokenizer::Token XhtmlPullTokenizer::next() {
+  if (popPending) {
+    openNames.resize(openOffsets.back());
+    openOffsets.pop_back();
+    popPending = false;
+  }
+
+  if (!started) {
+    started = true;
+    window = new (std::nothrow) char[INITIAL_WINDOW_SIZE];
+    if (!window) {
+      Token token;
+      token.type = TokenType::OutOfMemory;
+      return token;
+    }
+    capacity = INITIAL_WINDOW_SIZE;
+    if (!checkEncoding()) {
+      Token token;
+      token.type = TokenType::UnsupportedEncoding;
+      return token;
+    }
+  }
+
+  if (pendingCloses > 0) {
+    return closeTop();
+  }
+
+  Token token;
+  while (true) {
+    if (pos >= end && !fill()) {
+      if (!openOffsets.empty()) {
+        // Close whatever is still open at end of input.
+        pendingCloses = openOffsets.size();
+        return closeTop();
+      }
+      token.type = TokenType::EndOfInput;
+      return token;
+    }
+
+    bool produced;
+    if (insideCdata) {
+      produced = readCdata(token);
+    } else if (window[pos] == '<') {
+      produced = readMarkup(token);
+    } else if (window[pos] == '&') {
+      produced = readEntity(token);
+    } else {
+      produced = readText(token);
+    }
+    if (!produced) {
+      continue;
+    }
+    // Like an XML processor, ignore character data outside the root element.
+    if (token.type == TokenType::Text && openOffsets.empty()) {
+      continue;
+    }
+    return token;
+  }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Streaming pull tokenizer for EPUB chapter XHTML
+ *
+ * Reads the document through a fixed sliding window and hands out start tag, end tag and text tokens as views
+ * into that window. Names and attribute values are NUL-terminated in place, so a start tag exposes the same
+ * name/value pointer layout expat passes to its element handler. Views stay valid until the next call to next().
+ *
+ * Compared to expat it trades validation for tolerance:
+ *   - HTML and XML entities are decoded on the fly (text and attribute values); unknown ones are passed through
+ *   - End tags are matched against an open element stack: intermediate elements are closed implicitly, stray end
+ *     tags are dropped and anything still open is closed at end of input
+ *   - HTML void elements (br, img, hr, ...) do not need the self-closing slash
+ *   - Unquoted and valueless attributes, bare '&' and '<' in text are accepted
+ *   - Comments, processing instructions and the DOCTYPE are skipped; CDATA sections are reported as text
+ *
+ * Only UTF-8 input is handled. Documents that declare another encoding (or start with a UTF-16 BOM) produce an
+ * UnsupportedEncoding token before any other token, so callers can fall back to expat.
+ */
+class XhtmlPullTokenizer {
+ public:
+  // Fills `buffer` with up to `maxLen` bytes and returns the number of bytes read (0 at end of input).
+  using Reader = std::function<size_t(char* buffer, size_t maxLen)>;
+
+  enum class TokenType : uint8_t { StartTag, EndTag, Text, EndOfInput, UnsupportedEncoding, OutOfMemory };
+
+  struct Token {
+    TokenType type = TokenType::EndOfInput;
+    const char* name = nullptr;         // StartTag/EndTag
+    const char** attributes = nullptr;  // StartTag: name/value pairs followed by nullptr
+    const char* text = nullptr;         // Text (not NUL-terminated)
+    size_t textLength = 0;
+  };
+
+  static constexpr size_t INITIAL_WINDOW_SIZE = 2048;
+  // A single tag (or entity) must fit into the window; it grows up to this size before a tag is dropped.
+  static constexpr size_t MAX_WINDOW_SIZE = 16384;
+  static constexpr int MAX_ATTRIBUTES = 32;
+
+  explicit XhtmlPullTokenizer(Reader reader) : reader(std::move(reader)) {}
+  ~XhtmlPullTokenizer();
+  XhtmlPullTokenizer(const XhtmlPullTokenizer&) = delete;
+  XhtmlPullTokenizer& operator=(const XhtmlPullTokenizer&) = delete;
+
+  Token next();
+
+  // Tags dropped because they did not fit into MAX_WINDOW_SIZE.
+  uint32_t getDroppedTagCount() const { return droppedTags; }
+
+ private:
+  Reader reader;
+  char* window = nullptr;
+  size_t capacity = 0;
+  size_t pos = 0;  // read cursor
+  size_t end = 0;  // end of valid data
+  bool eof = false;
+  bool started = false;
+  uint32_t droppedTags = 0;
+
+  const char* attributes[2 * MAX_ATTRIBUTES + 1] = {};
+  char entityBuffer[5] = {};
+
+  // Open element names packed back-to-back (NUL separated), with their start offsets.
+  std::string openNames;
+  std::vector<uint32_t> openOffsets;
+  // The top element was reported as closed and is popped before producing the next token.
+  bool popPending = false;
+  // Elements still to close synthetically (implicit close, self-closing tag or end of input).
+  size_t pendingCloses = 0;
+  bool insideCdata = false;
+
+  // Each read* helper returns false when it consumed input without producing a token.
+  bool fill();
+  bool ensureAvailable(size_t count);
+  bool skipPast(const char* terminator);
+  void skipDeclaration();
+  bool checkEncoding();
+  bool readMarkup(Token& out);
+  bool readStartTag(Token& out);
+  bool readEndTag(Token& out);
+  bool readText(Token& out);
+  bool readEntity(Token& out);
+  bool readCdata(Token& out);
+  Token closeTop();
+  size_t findTagEnd(size_t from) const;
+  size_t findEntityEnd(const char* src, size_t available) const;
+  void pushOpen(const char* name, size_t len);
+  int findOpen(const char* name, size_t len) const;
+  size_t decodeEntity(const char* src, size_t len, const char** out);
+  size_t decodeAttributeValue(char* value, size_t len);
+};
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "BitmapHelpers.h"
+#include "BmpRowKernels.h"
 
 #pragma pack(push, 1)
 struct BmpHeader {
@@ -92,6 +93,9 @@ class Bitmap {
   bool nativePalette = false;  // true if all palette entries map to native gray levels
   int rowBytes = 0;
   uint8_t paletteLum[256] = {};
+  // Source value (palette index, or luminance above 8 bpp) -> 2-bit level or adjusted gray, see BmpRowKernels
+  uint8_t pixelLut[256] = {};
+  BmpRowKernels::Quantizer quantizer = BmpRowKernels::Quantizer::Direct;
 
   // Dithering state (mutable for const methods)
   mutable int16_t* errorCurRow = nullptr;
@@ -52,6 +52,17 @@ int adjustPixel(int gray) {
 
   return gray;
 }
+
+void buildToneLut(uint8_t lut[256]) {
+  for (int gray = 0; gray < 256; gray++) lut[gray] = static_cast<uint8_t>(adjustPixel(gray));
+}
+
+bool buildQuantizeLut(uint8_t lut[256]) {
+  if (USE_NOISE_DITHERING) return false;
+  for (int gray = 0; gray < 256; gray++) lut[gray] = quantizeSimple(adjustPixel(gray));
+  return true;
+}
+
 // Simple quantization without dithering - divide into 4 levels
 // The thresholds are fine-tuned to the X4 display
 uint8_t quantizeSimple(int gray) {
@@ -94,9 +105,8 @@ uint8_t quantize(int gray, int x, int y) {
 
 // 1-bit noise dithering for fast home screen rendering
 // Uses hash-based noise for consistent dithering that works well at small sizes
+// gray is expected already adjusted (buildToneLut)
 uint8_t quantize1bit(int gray, int x, int y) {
-  gray = adjustPixel(gray);
-
   // Generate noise threshold using integer hash (no regular pattern to alias)
   uint32_t hash = static_cast<uint32_t>(x) * 374761393u + static_cast<uint32_t>(y) * 668265263u;
   hash = (hash ^ (hash >> 13)) * 1274126177u;
@@ -11,6 +11,12 @@ uint8_t quantizeSimple(int gray);
 uint8_t quantize1bit(int gray, int x, int y);
 int adjustPixel(int gray);
 
+// adjustPixel() of every gray value. Built once per image, so pixels are adjusted with a table lookup.
+void buildToneLut(uint8_t lut[256]);
+// quantize() of every gray value after adjustPixel(). False (and lut untouched) when quantize() depends on the pixel
+// position (noise dithering) and has to be called per pixel.
+bool buildQuantizeLut(uint8_t lut[256]);
+
 enum class BmpRowOrder { BottomUp, TopDown };
 
 // Populates a 1-bit BMP header in the provided memory.
@@ -41,10 +47,8 @@ class Atkinson1BitDitherer {
   // EXPLICITLY DELETE THE COPY ASSIGNMENT OPERATOR
   Atkinson1BitDitherer& operator=(const Atkinson1BitDitherer& other) = delete;
 
+  // gray is expected already adjusted (buildToneLut), like for the 2-bit ditherers
   uint8_t processPixel(int gray, int x) {
-    // Apply brightness/contrast/gamma adjustments
-    gray = adjustPixel(gray);
-
     // Add accumulated error
     int adjusted = gray + errorRow0[x + 2];
     if (adjusted < 0) adjusted = 0;
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BitmapHelpers.h"
+
+// Row kernels behind Bitmap::readNextRow: one BMP row in, packed 2bpp out (0 = black, 1 = dark gray, 2 = light gray,
+// 3 = white).
+//
+// A pixel's source value (palette index up to 8 bpp, luminance for 24 and 32 bpp) is looked up in a 256-entry table
+// built once per image. With Direct quantization the table already holds the 2-bit level (palette, tone curve and
+// quantization folded together); otherwise it holds the tone-adjusted gray for the ditherer or quantize(). Each kernel
+// is instantiated per bpp and quantizer, so the pixel loop carries no format or mode dispatch.
+namespace BmpRowKernels {
+
+enum class Quantizer : uint8_t { Direct, Positional, Atkinson, FloydSteinberg };
+
+template <uint16_t Bpp>
+inline uint8_t sourceValue(const uint8_t* row, const int x) {
+  if constexpr (Bpp == 32 || Bpp == 24) {
+    const uint8_t* p = row + x * (Bpp / 8);
+    return (77u * p[2] + 150u * p[1] + 29u * p[0]) >> 8;
+  } else if constexpr (Bpp == 8) {
+    return row[x];
+  } else if constexpr (Bpp == 4) {
+    return (x & 1) ? (row[x >> 1] & 0x0F) : (row[x >> 1] >> 4);
+  } else if constexpr (Bpp == 2) {
+    return (row[x >> 2] >> (6 - ((x & 3) * 2))) & 0x03;
+  } else {
+    return (row[x >> 3] >> (7 - (x & 7))) & 0x01;
+  }
+}
+
+template <uint16_t Bpp, typename Quantize>
+void packRow(const uint8_t* row, uint8_t* out, const int width, const uint8_t* lut, Quantize quantizePixel) {
+  uint8_t packed = 0;
+  for (int x = 0; x < width; x++) {
+    packed = static_cast<uint8_t>((packed << 2) | quantizePixel(lut[sourceValue<Bpp>(row, x)], x));
+    if ((x & 3) == 3) {
+      *out++ = packed;
+      packed = 0;
+    }
+  }
+  // Left-align the pixels of a partial last byte
+  if (width & 3) *out = static_cast<uint8_t>(packed << (2 * (4 - (width & 3))));
+}
+
+template <uint16_t Bpp>
+void convertRow(const uint8_t* row, uint8_t* out, const int width, const int y, const uint8_t* lut,
+                const Quantizer quantizer, AtkinsonDitherer* atkinson, FloydSteinbergDitherer* floydSteinberg) {
+  switch (quantizer) {
+    case Quantizer::Direct:
+      packRow<Bpp>(row, out, width, lut, [](const uint8_t level, int) { return level; });
+      break;
+    case Quantizer::Positional:
+      packRow<Bpp>(row, out, width, lut, [y](const uint8_t gray, const int x) { return quantize(gray, x, y); });
+      break;
+    case Quantizer::Atkinson:
+      packRow<Bpp>(row, out, width, lut,
+                   [atkinson](const uint8_t gray, const int x) { return atkinson->processPixel(gray, x); });
+      atkinson->nextRow();
+      break;
+    case Quantizer::FloydSteinberg:
+      packRow<Bpp>(row, out, width, lut, [floydSteinberg](const uint8_t gray, const int x) {
+        return floydSteinberg->processPixel(gray, x);
+      });
+      floydSteinberg->nextRow();
+      break;
+  }
+}
+
+// False for an unsupported bpp. The ditherer matching `quantizer` must be set.
+inline bool convertRow(const uint16_t bpp, const uint8_t* row, uint8_t* out, const int width, const int y,
+                       const uint8_t* lut, const Quantizer quantizer, AtkinsonDitherer* atkinson,
+                       FloydSteinbergDitherer* floydSteinberg) {
+  switch (bpp) {
+    case 32:
+      convertRow<32>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    case 24:
+      convertRow<24>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    case 8:
+      convertRow<8>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    case 4:
+      convertRow<4>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    case 2:
+      convertRow<2>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    case 1:
+      convertRow<1>(row, out, width, y, lut, quantizer, atkinson, floydSteinberg);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Fills the per-image table and returns the quantizer that goes with it: the ditherer if there is one, else Direct
+// when the levels can be tabled (native palette, or quantize() without noise), else Positional. paletteLum maps
+// palette indices to luminance and is ignored above 8 bpp.
+inline Quantizer buildLut(uint8_t lut[256], const uint16_t bpp, const uint8_t paletteLum[256], const bool nativePalette,
+                          const AtkinsonDitherer* atkinson, const FloydSteinbergDitherer* floydSteinberg) {
+  uint8_t tone[256];
+  buildToneLut(tone);
+  uint8_t levels[256];
+  Quantizer quantizer;
+  if (atkinson) {
+    quantizer = Quantizer::Atkinson;
+  } else if (floydSteinberg) {
+    quantizer = Quantizer::FloydSteinberg;
+  } else if (nativePalette) {
+    quantizer = Quantizer::Direct;
+    for (int gray = 0; gray < 256; gray++) levels[gray] = tone[gray] >> 6;
+  } else {
+    quantizer = buildQuantizeLut(levels) ? Quantizer::Direct : Quantizer::Positional;
+  }
+
+  const uint8_t* table = quantizer == Quantizer::Direct ? levels : tone;
+  for (int value = 0; value < 256; value++) {
+    lut[value] = table[bpp <= 8 ? paletteLum[value] : value];
+  }
+  return quantizer;
+}
+
+}  // namespace BmpRowKernels
@@ -0,0 +1,170 @@
+#include "BwSnapshot.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// Token: kind in the top two bits, word count in the rest; literal tokens are followed by their words
+constexpr uint32_t KIND_SHIFT = 30;
+constexpr uint32_t COUNT_MASK = (1u << KIND_SHIFT) - 1;
+constexpr uint32_t ZERO_RUN = 0;
+constexpr uint32_t ONES_RUN = 1;
+constexpr uint32_t LITERAL = 2;
+// Shorter runs stay in the literal around them: a run token plus the literal token that follows cost two words
+constexpr size_t MIN_RUN = 3;
+}  // namespace
+
+uint32_t* BwSnapshot::reserve(const size_t minWords, size_t& available) {
+  if (current < chunkTotal && CHUNK_WORDS - chunks[current].used < minWords) {
+    current++;
+  }
+  if (current == chunkTotal) {
+    if (chunkTotal == MAX_CHUNKS) {
+      return nullptr;
+    }
+    auto* words = static_cast<uint32_t*>(malloc(CHUNK_SIZE));
+    if (!words) {
+      return nullptr;
+    }
+    chunks[chunkTotal++] = {words, 0};
+  }
+  Chunk& chunk = chunks[current];
+  available = CHUNK_WORDS - chunk.used;
+  return chunk.words + chunk.used;
+}
+
+bool BwSnapshot::emitRun(const uint32_t value, const size_t count) {
+  size_t available = 0;
+  uint32_t* out = reserve(1, available);
+  if (!out) {
+    return false;
+  }
+  *out = ((value == 0 ? ZERO_RUN : ONES_RUN) << KIND_SHIFT) | static_cast<uint32_t>(count);
+  chunks[current].used++;
+  return true;
+}
+
+bool BwSnapshot::emitLiteral(const uint32_t* words, size_t count) {
+  // Split across chunks when needed; every piece carries its own token
+  while (count > 0) {
+    size_t available = 0;
+    uint32_t* out = reserve(2, available);
+    if (!out) {
+      return false;
+    }
+    const size_t piece = count < available - 1 ? count : available - 1;
+    *out = (LITERAL << KIND_SHIFT) | static_cast<uint32_t>(piece);
+    memcpy(out + 1, words, piece * sizeof(uint32_t));
+    chunks[current].used += piece + 1;
+    words += piece;
+    count -= piece;
+  }
+  return true;
+}
+
+bool BwSnapshot::store(const uint8_t* frame, const size_t size) {
+  clear();
+  if (reinterpret_cast<uintptr_t>(frame) % alignof(uint32_t) != 0 || size / sizeof(uint32_t) > COUNT_MASK) {
+    return false;
+  }
+
+  const auto* words = reinterpret_cast<const uint32_t*>(frame);
+  const size_t wordCount = size / sizeof(uint32_t);
+  size_t literalStart = 0;
+  size_t i = 0;
+  while (i < wordCount) {
+    const uint32_t value = words[i];
+    if (value != 0 && value != UINT32_MAX) {
+      i++;
+      continue;
+    }
+    size_t end = i + 1;
+    while (end < wordCount && words[end] == value) end++;
+    if (end - i >= MIN_RUN) {
+      if ((literalStart < i && !emitLiteral(words + literalStart, i - literalStart)) || !emitRun(value, end - i)) {
+        fail();
+        return false;
+      }
+      literalStart = end;
+    }
+    i = end;
+  }
+  if (literalStart < wordCount && !emitLiteral(words + literalStart, wordCount - literalStart)) {
+    fail();
+    return false;
+  }
+
+  tail = 0;
+  memcpy(&tail, frame + wordCount * sizeof(uint32_t), size % sizeof(uint32_t));
+  frameSize = size;
+  stored = true;
+  return true;
+}
+
+bool BwSnapshot::restore(uint8_t* frame) {
+  if (!stored) {
+    return false;
+  }
+
+  auto* out = reinterpret_cast<uint32_t*>(frame);
+  const uint32_t* const outEnd = out + frameSize / sizeof(uint32_t);
+  for (size_t c = 0; c <= current && c < chunkTotal; c++) {
+    const uint32_t* token = chunks[c].words;
+    const uint32_t* const end = token + chunks[c].used;
+    while (token < end) {
+      const uint32_t kind = *token >> KIND_SHIFT;
+      size_t count = *token++ & COUNT_MASK;
+      if (count > static_cast<size_t>(outEnd - out)) {
+        count = outEnd - out;  // cannot happen with tokens from store(); never write past the frame
+      }
+      if (kind == LITERAL) {
+        memcpy(out, token, count * sizeof(uint32_t));
+        token += count;
+      } else {
+        memset(out, kind == ZERO_RUN ? 0x00 : 0xFF, count * sizeof(uint32_t));
+      }
+      out += count;
+    }
+  }
+  memcpy(out, &tail, frameSize % sizeof(uint32_t));
+
+  clear();
+  trim();
+  return true;
+}
+
+void BwSnapshot::clear() {
+  for (size_t c = 0; c < chunkTotal; c++) chunks[c].used = 0;
+  current = 0;
+  frameSize = 0;
+  stored = false;
+}
+
+void BwSnapshot::trim() {
+  while (chunkTotal > RETAINED_CHUNKS) {
+    free(chunks[--chunkTotal].words);
+    chunks[chunkTotal] = {};
+  }
+}
+
+void BwSnapshot::fail() {
+  clear();
+  trim();
+}
+
+void BwSnapshot::release() {
+  clear();
+  while (chunkTotal > 0) {
+    free(chunks[--chunkTotal].words);
+    chunks[chunkTotal] = {};
+  }
+}
+
+size_t BwSnapshot::storedBytes() const {
+  if (!stored) {
+    return 0;
+  }
+  size_t words = 0;
+  for (size_t c = 0; c <= current && c < chunkTotal; c++) words += chunks[c].used;
+  return words * sizeof(uint32_t);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Compressed copy of the BW frame, taken before the grayscale passes overwrite the frame buffer and written back after.
+//
+// The frame is run-length coded a 32-bit word at a time: runs of all-white (0xFF) and all-black (0x00) words become a
+// single token, everything else is copied as literal words. Margins, blank lines, short pages and menus collapse to a
+// few tokens; panel rows cross every text line of a portrait page, so the text block itself stays mostly literal. A
+// full-page image barely compresses and costs a few words more than a plain copy.
+//
+// Tokens go into CHUNK_SIZE chunks allocated separately, so no contiguous block the size of the frame is needed. The
+// first RETAINED_CHUNKS chunks are kept between snapshots, which covers menus and sparse pages without allocating;
+// further chunks are freed on restore. A dense text page still takes about 38 KB (five chunks), so the readers do not
+// snapshot text pages at all and draw them again after the gray passes; the snapshot is kept for image pages, which
+// are costly to redraw.
+class BwSnapshot {
+ public:
+  static constexpr size_t CHUNK_SIZE = 8000;
+  static constexpr size_t MAX_CHUNKS = 8;  // an incompressible 48 KB frame takes 7
+  static constexpr size_t RETAINED_CHUNKS = 1;
+
+  BwSnapshot() = default;
+  ~BwSnapshot() { release(); }
+  BwSnapshot(const BwSnapshot&) = delete;
+  BwSnapshot& operator=(const BwSnapshot&) = delete;
+
+  // Replaces any stored snapshot. False (and nothing stored) if a chunk could not be allocated, the snapshot would
+  // need more than MAX_CHUNKS or the frame is not word aligned.
+  bool store(const uint8_t* frame, size_t size);
+  // Writes the snapshot back into `frame` (the size it was taken from) and drops it. False if nothing was stored.
+  bool restore(uint8_t* frame);
+  // Drops the snapshot, keeping the retained chunks
+  void clear();
+  // Drops the snapshot and frees every chunk
+  void release();
+
+  bool isStored() const { return stored; }
+  size_t storedBytes() const;
+  size_t chunkCount() const { return chunkTotal; }
+
+ private:
+  static constexpr size_t CHUNK_WORDS = CHUNK_SIZE / sizeof(uint32_t);
+
+  struct Chunk {
+    uint32_t* words;
+    size_t used;
+  };
+
+  Chunk chunks[MAX_CHUNKS] = {};
+  size_t chunkTotal = 0;  // allocated chunks
+  size_t current = 0;     // chunk being filled
+  size_t frameSize = 0;
+  uint32_t tail = 0;  // bytes past the last whole word
+  bool stored = false;
+
+  uint32_t* reserve(size_t minWords, size_t& available);
+  bool emitRun(uint32_t value, size_t count);
+  bool emitLiteral(const uint32_t* words, size_t count);
+  void trim();
+  void fail();
+};
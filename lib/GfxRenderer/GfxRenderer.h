@@ -11,6 +11,7 @@ class FontCacheManager;
 #include <vector>
 
 #include "Bitmap.h"
+#include "BwSnapshot.h"
 
 // Color representation: uint8_t mapped to 4x4 Bayer matrix dithering levels
 // 0 = transparent, 1-16 = gray levels (white to black)
@@ -29,8 +30,6 @@ class GfxRenderer {
   };
 
  private:
-  static constexpr size_t BW_BUFFER_CHUNK_SIZE = 8000;  // 8KB chunks to allow for non-contiguous memory
-
   HalDisplay& display;
   RenderMode renderMode;
   Orientation orientation;
@@ -40,7 +39,7 @@ class GfxRenderer {
   uint16_t panelHeight = HalDisplay::DISPLAY_HEIGHT;
   uint16_t panelWidthBytes = HalDisplay::DISPLAY_WIDTH_BYTES;
   uint32_t frameBufferSize = HalDisplay::BUFFER_SIZE;
-  std::vector<uint8_t*> bwBufferChunks;
+  BwSnapshot bwSnapshot;
   std::map<int, EpdFontFamily> fontMap;
 
   // Mutable because drawText() is const but needs to delegate scan-mode
@@ -50,7 +49,6 @@ class GfxRenderer {
 
   void renderChar(const EpdFontFamily& fontFamily, uint32_t cp, int* x, int* y, bool pixelState,
                   EpdFontFamily::Style style) const;
-  void freeBwBufferChunks();
   template <Color color>
   void drawPixelDither(int x, int y) const;
   template <Color color>
@@ -59,7 +57,6 @@ class GfxRenderer {
  public:
   explicit GfxRenderer(HalDisplay& halDisplay)
       : display(halDisplay), renderMode(BW), orientation(Portrait), fadingFix(false) {}
-  ~GfxRenderer() { freeBwBufferChunks(); }
 
   static constexpr int VIEWABLE_MARGIN_TOP = 9;
   static constexpr int VIEWABLE_MARGIN_RIGHT = 3;
@@ -149,13 +146,17 @@ class GfxRenderer {
   void copyGrayscaleMsbBuffers() const;
   void displayGrayBuffer() const;
   bool storeBwBuffer();    // Returns true if buffer was stored successfully
-  void restoreBwBuffer();  // Restore and free the stored buffer
+  bool restoreBwBuffer();  // Restore and drop the stored buffer; false if there was none (redraw the BW frame instead)
   void cleanupGrayscaleWithFrameBuffer() const;
 
   // Font helpers
   const uint8_t* getGlyphBitmap(const EpdFontData* fontData, const EpdGlyph* glyph) const;
 
   // Low level functions
+  // Sends drawing to `buffer` (getBufferSize() bytes, physical layout) instead of the display's frame buffer, for
+  // rendering off-screen; nullptr switches back. Only pixel drawing follows it: clearScreen() and the icon helpers
+  // still write to the display.
+  void setDrawTarget(uint8_t* buffer);
   uint8_t* getFrameBuffer() const;
   size_t getBufferSize() const;
   uint16_t getDisplayWidth() const { return panelWidth; }
@@ -0,0 +1,247 @@
+#include "ScaledBmpWriter.h"
+
+#include <Logging.h>
+#include <Print.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ============================================================================
+// IMAGE PROCESSING OPTIONS - shared by JpegToBmpConverter and PngToBmpConverter
+// ============================================================================
+constexpr bool USE_8BIT_OUTPUT = false;  // true: 8-bit grayscale (no quantization), false: 2-bit (4 levels)
+// Dithering method selection (only one should be true, or all false for simple quantization):
+constexpr bool USE_ATKINSON = true;          // Atkinson dithering (cleaner than F-S, less error diffusion)
+constexpr bool USE_FLOYD_STEINBERG = false;  // Floyd-Steinberg error diffusion (can cause "worm" artifacts)
+// ============================================================================
+
+namespace {
+
+inline void write16(Print& out, const uint16_t value) {
+  out.write(value & 0xFF);
+  out.write((value >> 8) & 0xFF);
+}
+
+inline void write32(Print& out, const uint32_t value) {
+  out.write(value & 0xFF);
+  out.write((value >> 8) & 0xFF);
+  out.write((value >> 16) & 0xFF);
+  out.write((value >> 24) & 0xFF);
+}
+
+// Writes the file and DIB headers plus palette for a top-down BMP with the given bit depth (1, 2 or 8).
+void writeBmpHeader(Print& bmpOut, const int width, const int height, const int bitsPerPixel) {
+  // Each row is padded to a multiple of 4 bytes
+  const int bytesPerRow = (width * bitsPerPixel + 31) / 32 * 4;
+  const uint32_t imageSize = bytesPerRow * height;
+  const uint32_t colors = 1u << bitsPerPixel;
+  const uint32_t paletteSize = colors * 4;
+  const uint32_t pixelOffset = 14 + 40 + paletteSize;
+
+  // BMP File Header (14 bytes)
+  bmpOut.write('B');
+  bmpOut.write('M');
+  write32(bmpOut, pixelOffset + imageSize);  // File size
+  write32(bmpOut, 0);                        // Reserved
+  write32(bmpOut, pixelOffset);              // Offset to pixel data
+
+  // DIB Header (BITMAPINFOHEADER - 40 bytes)
+  write32(bmpOut, 40);
+  write32(bmpOut, static_cast<uint32_t>(width));
+  write32(bmpOut, static_cast<uint32_t>(-height));  // Negative height = top-down bitmap
+  write16(bmpOut, 1);                               // Color planes
+  write16(bmpOut, bitsPerPixel);
+  write32(bmpOut, 0);  // BI_RGB (no compression)
+  write32(bmpOut, imageSize);
+  write32(bmpOut, 2835);  // xPixelsPerMeter (72 DPI)
+  write32(bmpOut, 2835);  // yPixelsPerMeter (72 DPI)
+  write32(bmpOut, colors);
+  write32(bmpOut, colors);
+
+  // Evenly spaced gray palette (BGRA): 1-bit = black/white, 2-bit = 0/85/170/255, 8-bit = 0..255
+  const int step = 255 / static_cast<int>(colors - 1);
+  for (uint32_t i = 0; i < colors; i++) {
+    const auto level = static_cast<uint8_t>(i * step);
+    bmpOut.write(level);
+    bmpOut.write(level);
+    bmpOut.write(level);
+    bmpOut.write(static_cast<uint8_t>(0));
+  }
+}
+
+// Packs outWidth quantized pixels into a 2-bit BMP row; instantiated per quantizer so the loop does not branch on it
+template <typename GrayAt, typename Quantize>
+void pack2Bit(uint8_t* bmpRow, const int outWidth, GrayAt grayAt, Quantize quantizePixel) {
+  for (int x = 0; x < outWidth; x++) {
+    bmpRow[x >> 2] |= quantizePixel(grayAt(x), x) << (6 - ((x & 3) * 2));
+  }
+}
+
+}  // namespace
+
+ScaledBmpWriter::~ScaledBmpWriter() {
+  delete[] rowAccum;
+  delete[] rowCount;
+  delete atkinsonDitherer;
+  delete fsDitherer;
+  delete atkinson1BitDitherer;
+  free(bmpRow);
+}
+
+void ScaledBmpWriter::getOutputSize(const BmpTarget& target, const int imageWidth, const int imageHeight,
+                                    int& outWidth, int& outHeight) {
+  outWidth = imageWidth;
+  outHeight = imageHeight;
+  if (target.maxWidth <= 0 || target.maxHeight <= 0 ||
+      (imageWidth == target.maxWidth && imageHeight == target.maxHeight)) {
+    return;
+  }
+
+  const float scaleToFitWidth = static_cast<float>(target.maxWidth) / imageWidth;
+  const float scaleToFitHeight = static_cast<float>(target.maxHeight) / imageHeight;
+  float scale;
+  if (target.crop) {
+    scale = (scaleToFitWidth > scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+  } else {
+    scale = (scaleToFitWidth < scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+  }
+
+  outWidth = static_cast<int>(imageWidth * scale);
+  outHeight = static_cast<int>(imageHeight * scale);
+  if (outWidth < 1) outWidth = 1;
+  if (outHeight < 1) outHeight = 1;
+}
+
+bool ScaledBmpWriter::begin(const BmpTarget& target, const int imageWidth, const int imageHeight, const int srcWidth,
+                            const int srcHeight) {
+  out = target.out;
+  oneBit = target.oneBit;
+  this->srcWidth = srcWidth;
+  this->srcHeight = srcHeight;
+  getOutputSize(target, imageWidth, imageHeight, outWidth, outHeight);
+
+  needsScaling = srcWidth != outWidth || srcHeight != outHeight;
+  if (needsScaling) {
+    scaleX_fp = (static_cast<uint32_t>(srcWidth) << 16) / outWidth;
+    scaleY_fp = (static_cast<uint32_t>(srcHeight) << 16) / outHeight;
+    LOG_DBG("BMP", "Scaling %dx%d -> %dx%d (target %dx%d)", srcWidth, srcHeight, outWidth, outHeight, target.maxWidth,
+            target.maxHeight);
+  }
+
+  const int bitsPerPixel = oneBit ? 1 : (USE_8BIT_OUTPUT ? 8 : 2);
+  bytesPerRow = (outWidth * bitsPerPixel + 31) / 32 * 4;
+
+  bmpRow = static_cast<uint8_t*>(malloc(bytesPerRow));
+  if (!bmpRow) {
+    LOG_ERR("BMP", "Failed to allocate BMP row buffer");
+    return false;
+  }
+
+  if (needsScaling) {
+    rowAccum = new (std::nothrow) uint32_t[outWidth]();
+    rowCount = new (std::nothrow) uint32_t[outWidth]();
+    if (!rowAccum || !rowCount) {
+      LOG_ERR("BMP", "Failed to allocate scaling buffers");
+      return false;
+    }
+    nextOutY_srcStart = scaleY_fp;
+  }
+
+  if (oneBit) {
+    atkinson1BitDitherer = new (std::nothrow) Atkinson1BitDitherer(outWidth);
+  } else if (!USE_8BIT_OUTPUT) {
+    if (USE_ATKINSON) {
+      atkinsonDitherer = new (std::nothrow) AtkinsonDitherer(outWidth);
+    } else if (USE_FLOYD_STEINBERG) {
+      fsDitherer = new (std::nothrow) FloydSteinbergDitherer(outWidth);
+    }
+  }
+
+  buildToneLut(toneLut);
+
+  writeBmpHeader(*out, outWidth, outHeight, bitsPerPixel);
+  return true;
+}
+
+template <typename GrayAt>
+void ScaledBmpWriter::writeRow(GrayAt grayAt, const int outY) {
+  memset(bmpRow, 0, bytesPerRow);
+  const auto toneAt = [this, &grayAt](const int x) -> uint8_t { return toneLut[grayAt(x)]; };
+
+  if (USE_8BIT_OUTPUT && !oneBit) {
+    for (int x = 0; x < outWidth; x++) {
+      bmpRow[x] = toneAt(x);
+    }
+  } else if (oneBit) {
+    if (atkinson1BitDitherer) {
+      for (int x = 0; x < outWidth; x++) {
+        bmpRow[x >> 3] |= atkinson1BitDitherer->processPixel(toneAt(x), x) << (7 - (x & 7));
+      }
+      atkinson1BitDitherer->nextRow();
+    } else {
+      for (int x = 0; x < outWidth; x++) {
+        bmpRow[x >> 3] |= quantize1bit(toneAt(x), x, outY) << (7 - (x & 7));
+      }
+    }
+  } else if (atkinsonDitherer) {
+    pack2Bit(bmpRow, outWidth, toneAt,
+             [this](const uint8_t gray, const int x) { return atkinsonDitherer->processPixel(gray, x); });
+    atkinsonDitherer->nextRow();
+  } else if (fsDitherer) {
+    pack2Bit(bmpRow, outWidth, toneAt,
+             [this](const uint8_t gray, const int x) { return fsDitherer->processPixel(gray, x); });
+    fsDitherer->nextRow();
+  } else {
+    pack2Bit(bmpRow, outWidth, toneAt, [outY](const uint8_t gray, const int x) { return quantize(gray, x, outY); });
+  }
+
+  out->write(bmpRow, bytesPerRow);
+}
+
+// Flush one scaled output row from Y-axis accumulators and advance currentOutY
+void ScaledBmpWriter::flushScaledRow() {
+  writeRow(
+      [this](const int x) -> uint8_t { return (rowCount[x] > 0) ? (rowAccum[x] / rowCount[x]) : 0; }, currentOutY);
+  currentOutY++;
+}
+
+void ScaledBmpWriter::pushRow(const uint8_t* grayRow) {
+  if (srcY >= srcHeight) return;
+  const int y = srcY++;
+
+  if (!needsScaling) {
+    // 1:1 - outWidth == srcWidth, write directly
+    writeRow([grayRow](const int x) -> uint8_t { return grayRow[x]; }, y);
+    return;
+  }
+
+  // Fixed-point area averaging on X axis
+  for (int outX = 0; outX < outWidth; outX++) {
+    const int srcXStart = (static_cast<uint32_t>(outX) * scaleX_fp) >> 16;
+    const int srcXEnd = (static_cast<uint32_t>(outX + 1) * scaleX_fp) >> 16;
+    int sum = 0;
+    int count = 0;
+    for (int srcX = srcXStart; srcX < srcXEnd && srcX < srcWidth; srcX++) {
+      sum += grayRow[srcX];
+      count++;
+    }
+    if (count == 0 && srcXStart < srcWidth) {
+      sum = grayRow[srcXStart];
+      count = 1;
+    }
+    rowAccum[outX] += sum;
+    rowCount[outX] += count;
+  }
+
+  // Output all rows whose boundaries we've crossed. When upscaling, one source row produces several output rows
+  // and the accumulators are kept until we move on to the next source row.
+  const uint32_t srcY_fp = static_cast<uint32_t>(y + 1) << 16;
+  while (srcY_fp >= nextOutY_srcStart && currentOutY < outHeight) {
+    flushScaledRow();
+    nextOutY_srcStart = static_cast<uint32_t>(currentOutY + 1) * scaleY_fp;
+    if (srcY_fp >= nextOutY_srcStart) continue;
+    memset(rowAccum, 0, outWidth * sizeof(uint32_t));
+    memset(rowCount, 0, outWidth * sizeof(uint32_t));
+  }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BitmapHelpers.h"
+
+class Print;
+
+// One BMP output of an image conversion. The JPEG and PNG converters can feed several of these from a single decode.
+struct BmpTarget {
+  Print* out = nullptr;
+  int maxWidth = 0;  // 0 (or 0 height) keeps the image size
+  int maxHeight = 0;
+  bool oneBit = false;
+  bool crop = true;  // true: cover the target box, false: fit inside it
+};
+
+// Turns a stream of top-down 8-bit grayscale rows into a dithered BMP, area-averaging them to the output size as
+// they arrive. Rows can already be downscaled by the decoder (JPEG DCT scaling); the output size is always derived
+// from the full image size so it does not depend on how the rows were produced.
+class ScaledBmpWriter {
+ public:
+  ScaledBmpWriter() = default;
+  ~ScaledBmpWriter();
+  ScaledBmpWriter(const ScaledBmpWriter&) = delete;
+  ScaledBmpWriter& operator=(const ScaledBmpWriter&) = delete;
+
+  static void getOutputSize(const BmpTarget& target, int imageWidth, int imageHeight, int& outWidth, int& outHeight);
+
+  // Writes the BMP header and allocates row state. srcWidth x srcHeight is the size of the rows passed to pushRow().
+  bool begin(const BmpTarget& target, int imageWidth, int imageHeight, int srcWidth, int srcHeight);
+  // Consumes one source row of srcWidth pixels and writes every output row it completes.
+  void pushRow(const uint8_t* grayRow);
+
+ private:
+  Print* out = nullptr;
+  bool oneBit = false;
+  int srcWidth = 0;
+  int srcHeight = 0;
+  int outWidth = 0;
+  int outHeight = 0;
+  int bytesPerRow = 0;
+  bool needsScaling = false;
+  uint32_t scaleX_fp = 1 << 16;  // source pixels per output pixel, 16.16 fixed-point
+  uint32_t scaleY_fp = 1 << 16;
+  int srcY = 0;
+
+  // Y-axis area averaging accumulators (needsScaling only)
+  int currentOutY = 0;
+  uint32_t nextOutY_srcStart = 0;  // 16.16 fixed-point boundary for the next output row
+  uint32_t* rowAccum = nullptr;
+  uint32_t* rowCount = nullptr;
+
+  uint8_t* bmpRow = nullptr;
+  uint8_t toneLut[256] = {};  // adjustPixel() of every gray value
+
+  AtkinsonDitherer* atkinsonDitherer = nullptr;
+  FloydSteinbergDitherer* fsDitherer = nullptr;
+  Atkinson1BitDitherer* atkinson1BitDitherer = nullptr;
+
+  // Quantizes/dithers outWidth pixels (grayAt(x) -> 0..255) into one packed BMP row and writes it.
+  template <typename GrayAt>
+  void writeRow(GrayAt grayAt, int outY);
+  void flushScaledRow();
+};
@@ -1,5 +1,7 @@
 #include "InflateReader.h"
 
+#include <Perf.h>
+
 #include <cstring>
 #include <type_traits>
 
@@ -56,6 +58,7 @@ bool InflateReader::read(uint8_t* dest, size_t len) {
   decomp.dest_limit = dest + len;
 
   const int res = uzlib_uncompress(&decomp);
+  PERF_COUNT(InflateBytes, decomp.dest - dest);
   if (res < 0) return false;
   return decomp.dest == decomp.dest_limit;
 }
@@ -71,6 +74,7 @@ InflateStatus InflateReader::readAtMost(uint8_t* dest, size_t maxLen, size_t* pr
 
   const int res = uzlib_uncompress(&decomp);
   *produced = static_cast<size_t>(decomp.dest - dest);
+  PERF_COUNT(InflateBytes, *produced);
 
   if (res == TINF_DONE) return InflateStatus::Done;
   if (res < 0) return InflateStatus::Error;
@@ -1,15 +1,16 @@
 #pragma once
 
 #include <HalStorage.h>
+#include <ScaledBmpWriter.h>
 
 class Print;
 class ZipFile;
 
 class JpegToBmpConverter {
-  static bool jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bmpOut, int targetWidth, int targetHeight,
-                                          bool oneBit, bool crop = true);
-
  public:
+  // Decode once and write every target. The decoder downscales in the DCT domain (1/2, 1/4, 1/8) when all targets
+  // are small enough, so thumbnails never pay for a full-resolution decode.
+  static bool jpegFileToBmpStreams(FsFile& jpegFile, const BmpTarget* targets, int targetCount);
   static bool jpegFileToBmpStream(FsFile& jpegFile, Print& bmpOut, bool crop = true);
   // Convert with custom target size (for thumbnails)
   static bool jpegFileToBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
@@ -1,5 +1,7 @@
 #include "ChapterXPathResolver.h"
 
+#include <Epub/ParagraphXPathTable.h>
+#include <Epub/Section.h>
 #include <Logging.h>
 #include <Print.h>
 #include <Utf8.h>
@@ -489,6 +491,16 @@ std::string ChapterXPathResolver::findXPathForParagraph(const std::shared_ptr<Ep
     return "";
   }
 
+  ParagraphXPathTable table;
+  if (table.load(Section::getXPathTablePath(*epub, spineIndex))) {
+    const std::string path = table.getParagraphPath(paragraphIndex);
+    if (!path.empty()) {
+      const std::string xpath = "/body/DocFragment[" + std::to_string(spineIndex + 1) + "]/body" + path;
+      LOG_DBG("KOX", "Paragraph %u in spine %d from table -> %s", paragraphIndex, spineIndex, xpath.c_str());
+      return xpath;
+    }
+  }
+
   const auto href = epub->getSpineItem(spineIndex).href;
   if (href.empty()) {
     return "";
@@ -513,6 +525,38 @@ std::string ChapterXPathResolver::findXPathForParagraph(const std::shared_ptr<Ep
   return "";
 }
 
+std::string ChapterXPathResolver::findXPathForPage(const std::shared_ptr<Epub>& epub, const int spineIndex,
+                                                   const int page, const int pageCount) {
+  if (!epub || spineIndex < 0 || spineIndex >= epub->getSpineItemsCount() || page < 0 || page >= pageCount) {
+    return "";
+  }
+
+  ParagraphXPathTable table;
+  if (!table.load(Section::getXPathTablePath(*epub, spineIndex)) || table.getPageCount() != pageCount) {
+    return "";
+  }
+
+  auto start = table.getPageStart(static_cast<uint16_t>(page));
+  if (start.paragraph == 0) {
+    return "";
+  }
+  if (start.offset == ParagraphXPathTable::AFTER_PARAGRAPH) {
+    // The page starts between paragraphs: point at the one that follows, if any
+    start = {static_cast<uint16_t>(std::min<int>(start.paragraph + 1, table.getParagraphCount())), 0};
+  }
+
+  const std::string path = table.getParagraphPath(start.paragraph);
+  if (path.empty()) {
+    return "";
+  }
+  std::string xpath = "/body/DocFragment[" + std::to_string(spineIndex + 1) + "]/body" + path;
+  if (start.offset > 0) {
+    xpath += "/text()." + std::to_string(start.offset);
+  }
+  LOG_DBG("KOX", "Page %d/%d in spine %d from table -> %s", page, pageCount, spineIndex, xpath.c_str());
+  return xpath;
+}
+
 std::string ChapterXPathResolver::findXPathForProgress(const std::shared_ptr<Epub>& epub, const int spineIndex,
                                                        const float intraSpineProgress) {
   if (!epub || spineIndex < 0 || spineIndex >= epub->getSpineItemsCount()) {
@@ -14,10 +14,22 @@ class ChapterXPathResolver {
    * Returns a KOReader-compatible path like:
    * /body/DocFragment[8]/body/div[2]/section[1]/p[4]
    *
+   * Uses the section's paragraph table when there is one and parses the chapter otherwise.
    * An empty string means parsing failed or the paragraph index was not found.
    */
   static std::string findXPathForParagraph(const std::shared_ptr<Epub>& epub, int spineIndex, uint16_t paragraphIndex);
 
+  /**
+   * Resolve the start of a rendered page to its ancestry path plus text offset, using the paragraph table recorded
+   * when the section was built (no chapter parsing).
+   *
+   * Returns a KOReader-compatible path like:
+   * /body/DocFragment[8]/body/div[2]/section[1]/p[4]/text().96
+   *
+   * An empty string means the section has no table for this page count or the page does not start with text.
+   */
+  static std::string findXPathForPage(const std::shared_ptr<Epub>& epub, int spineIndex, int page, int pageCount);
+
   /**
    * Resolve intra-spine progress to a real XHTML ancestry path plus text offset.
    *
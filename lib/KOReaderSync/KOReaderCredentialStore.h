@@ -27,6 +27,7 @@ class KOReaderCredentialStore {
   std::string password;
   std::string serverUrl;                                            // Custom sync server URL (empty = default)
   DocumentMatchMethod matchMethod = DocumentMatchMethod::FILENAME;  // Default to filename for compatibility
+  bool loaded = false;
 
   // Private constructor for singleton
   KOReaderCredentialStore() = default;
@@ -41,8 +42,11 @@ class KOReaderCredentialStore {
   KOReaderCredentialStore(const KOReaderCredentialStore&) = delete;
   KOReaderCredentialStore& operator=(const KOReaderCredentialStore&) = delete;
 
-  // Get singleton instance
-  static KOReaderCredentialStore& getInstance() { return instance; }
+  // Get singleton instance, loading the credentials on first use (only sync screens need them)
+  static KOReaderCredentialStore& getInstance() {
+    if (!instance.loaded) instance.loadFromFile();
+    return instance;
+  }
 
   // Save/load from SD card
   bool saveToFile() const;
@@ -1,5 +1,7 @@
 #include "ProgressMapper.h"
 
+#include <Epub/ParagraphXPathTable.h>
+#include <Epub/Section.h>
 #include <Logging.h>
 
 #include <algorithm>
@@ -202,10 +204,13 @@ KOReaderPosition ProgressMapper::toKOReader(const std::shared_ptr<Epub>& epub, c
   KOReaderPosition result;
   float intra = (pos.totalPages > 0) ? static_cast<float>(pos.pageNumber) / static_cast<float>(pos.totalPages) : 0.0f;
   result.percentage = epub->calculateProgress(pos.spineIndex, intra);
-  if (pos.hasParagraphIndex && pos.paragraphIndex > 0) {
-    result.xpath = ChapterXPathResolver::findXPathForParagraph(epub, pos.spineIndex, pos.paragraphIndex);
-  } else {
-    result.xpath = ChapterXPathResolver::findXPathForProgress(epub, pos.spineIndex, intra);
+  result.xpath = ChapterXPathResolver::findXPathForPage(epub, pos.spineIndex, pos.pageNumber, pos.totalPages);
+  if (result.xpath.empty()) {
+    if (pos.hasParagraphIndex && pos.paragraphIndex > 0) {
+      result.xpath = ChapterXPathResolver::findXPathForParagraph(epub, pos.spineIndex, pos.paragraphIndex);
+    } else {
+      result.xpath = ChapterXPathResolver::findXPathForProgress(epub, pos.spineIndex, intra);
+    }
   }
   if (result.xpath.empty()) {
     result.xpath = generateXPath(epub, pos.spineIndex, intra);
@@ -236,6 +241,29 @@ CrossPointPosition ProgressMapper::toCrossPoint(const std::shared_ptr<Epub>& epu
 
   if (xpathSpine >= 0 && xpathSpine < spineCount) {
     result.spineIndex = xpathSpine;
+
+    // The section's paragraph table maps the element path and text offset straight to a page, as long as it was
+    // written for the section that is there now (the open one, or the one on the card)
+    const size_t bodyPos = koPos.xpath.find("]/body", koPos.xpath.find("/body/DocFragment["));
+    const int sectionPages = xpathSpine == currentSpineIndex && totalPagesInCurrentSpine > 0
+                                 ? totalPagesInCurrentSpine
+                                 : Section::readPageCount(*epub, xpathSpine).value_or(0);
+    ParagraphXPathTable table;
+    if (bodyPos != std::string::npos && sectionPages > 0 &&
+        table.load(Section::getXPathTablePath(*epub, xpathSpine)) && table.getPageCount() == sectionPages) {
+      const uint16_t paragraph = table.findParagraph(koPos.xpath.substr(bodyPos + strlen("]/body")));
+      if (paragraph > 0) {
+        const auto offset = static_cast<uint16_t>(std::min(xpathChar, ParagraphXPathTable::AFTER_PARAGRAPH - 1));
+        result.paragraphIndex = paragraph;
+        result.hasParagraphIndex = true;
+        result.totalPages = table.getPageCount();
+        result.pageNumber = table.findPage({paragraph, offset});
+        result.hasExactPage = true;
+        LOG_DBG("PM", "<- KO: %s -> paragraph %u -> spine=%d page=%d/%d (table)", koPos.xpath.c_str(), paragraph,
+                result.spineIndex, result.pageNumber, result.totalPages);
+        return result;
+      }
+    }
   } else {
     for (int i = 0; i < spineCount; i++) {
       if (epub->getCumulativeSpineItemSize(i) >= targetBytes) {
@@ -13,6 +13,7 @@ struct CrossPointPosition {
   int totalPages;                  // Total pages in the current spine item
   uint16_t paragraphIndex = 0;     // 1-based synthetic paragraph index from XPath p[N]
   bool hasParagraphIndex = false;  // True when paragraphIndex was resolved from XPath
+  bool hasExactPage = false;       // True when pageNumber came from the section's paragraph table
 };
 
 /**
@@ -29,9 +30,10 @@ struct KOReaderPosition {
  * CrossPoint tracks position as (spineIndex, pageNumber).
  * KOReader uses XPath-like strings + percentage.
  *
- * Since CrossPoint discards HTML structure during parsing, we generate
- * synthetic XPath strings based on spine index, using percentage as the
- * primary sync mechanism.
+ * When the section of the spine item has been built, its paragraph table
+ * (see ParagraphXPathTable) maps pages to XPaths and back directly. Otherwise
+ * the XHTML is parsed again to rebuild the element ancestry, and percentage
+ * remains the primary sync mechanism.
  */
 class ProgressMapper {
  public:
@@ -0,0 +1,272 @@
+#include "OpdsFeedCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr uint8_t FEED_FILE_VERSION = 1;
+constexpr char INDEX_NAME[] = "index";
+// Head of a feed file read before the request: version, URL and room for typical ETag and Last-Modified values
+constexpr size_t VALIDATORS_HEAD_BYTES = 1 + 3 * sizeof(uint16_t) + 256;
+
+uint64_t hashUrl(const std::string& url) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : url) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string nameForKey(const uint64_t key) {
+  char name[20];
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+  return name;
+}
+
+void putU16(std::string& out, const uint16_t value) {
+  out += static_cast<char>(value & 0xFF);
+  out += static_cast<char>(value >> 8);
+}
+
+void putString(std::string& out, const std::string& value) {
+  const size_t length = std::min<size_t>(value.size(), UINT16_MAX);
+  putU16(out, static_cast<uint16_t>(length));
+  out.append(value, 0, length);
+}
+
+class Reader {
+ public:
+  explicit Reader(const std::string& data) : data(data) {}
+
+  bool u8(uint8_t& value) {
+    if (pos + 1 > data.size()) return fail();
+    value = static_cast<uint8_t>(data[pos++]);
+    return true;
+  }
+
+  bool u16(uint16_t& value) {
+    if (pos + 2 > data.size()) return fail();
+    value = static_cast<uint16_t>(static_cast<uint8_t>(data[pos]) | (static_cast<uint8_t>(data[pos + 1]) << 8));
+    pos += 2;
+    return true;
+  }
+
+  bool string(std::string& value) {
+    uint16_t length = 0;
+    if (!u16(length) || pos + length > data.size()) return fail();
+    value.assign(data, pos, length);
+    pos += length;
+    return true;
+  }
+
+  bool atEnd() const { return ok && pos == data.size(); }
+
+ private:
+  const std::string& data;
+  size_t pos = 0;
+  bool ok = true;
+
+  bool fail() {
+    ok = false;
+    return false;
+  }
+};
+
+// Version, URL (to tell hash collisions apart) and validators
+bool readHeader(Reader& reader, const std::string& url, OpdsFeedCache::Validators& validators) {
+  uint8_t version = 0;
+  std::string storedUrl;
+  return reader.u8(version) && version == FEED_FILE_VERSION && reader.string(storedUrl) && storedUrl == url &&
+         reader.string(validators.etag) && reader.string(validators.lastModified);
+}
+}  // namespace
+
+std::string OpdsFeedCache::nameFor(const std::string& url) { return nameForKey(hashUrl(url)); }
+
+// Feed file format (integers little endian, strings as a 16-bit length and their bytes):
+// version, url, etag, lastModified, searchTemplate, nextPageUrl, prevPageUrl, entry count,
+// then per entry: type, title, author, href, id
+std::string OpdsFeedCache::encode(const std::string& url, const Validators& validators, const Feed& feed) {
+  std::string out;
+  out += static_cast<char>(FEED_FILE_VERSION);
+  putString(out, url);
+  putString(out, validators.etag);
+  putString(out, validators.lastModified);
+  putString(out, feed.searchTemplate);
+  putString(out, feed.nextPageUrl);
+  putString(out, feed.prevPageUrl);
+  const size_t count = std::min<size_t>(feed.entries.size(), UINT16_MAX);
+  putU16(out, static_cast<uint16_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    const OpdsEntry& entry = feed.entries[i];
+    out += static_cast<char>(entry.type == OpdsEntryType::BOOK ? 1 : 0);
+    putString(out, entry.title);
+    putString(out, entry.author);
+    putString(out, entry.href);
+    putString(out, entry.id);
+  }
+  return out;
+}
+
+bool OpdsFeedCache::decodeValidators(const std::string& data, const std::string& url, Validators& validators) {
+  Reader reader(data);
+  Validators readValidators;
+  if (!readHeader(reader, url, readValidators)) {
+    return false;
+  }
+  validators = std::move(readValidators);
+  return true;
+}
+
+bool OpdsFeedCache::decode(const std::string& data, const std::string& url, Validators& validators, Feed& feed) {
+  Reader reader(data);
+  Validators readValidators;
+  Feed readFeed;
+  uint16_t count = 0;
+  if (!readHeader(reader, url, readValidators) || !reader.string(readFeed.searchTemplate) ||
+      !reader.string(readFeed.nextPageUrl) || !reader.string(readFeed.prevPageUrl) || !reader.u16(count)) {
+    return false;
+  }
+  readFeed.entries.resize(count);
+  for (auto& entry : readFeed.entries) {
+    uint8_t type = 0;
+    if (!reader.u8(type) || !reader.string(entry.title) || !reader.string(entry.author) ||
+        !reader.string(entry.href) || !reader.string(entry.id)) {
+      return false;
+    }
+    entry.type = type == 1 ? OpdsEntryType::BOOK : OpdsEntryType::NAVIGATION;
+  }
+  if (!reader.atEnd()) {
+    return false;
+  }
+
+  validators = std::move(readValidators);
+  feed = std::move(readFeed);
+  return true;
+}
+
+OpdsFeedCache::Source OpdsFeedCache::fetch(const std::string& url, Transport& transport, Feed& feed,
+                                           const bool preferSession) {
+  const uint64_t key = hashUrl(url);
+  const std::string name = nameForKey(key);
+
+  if (preferSession && isValidated(key)) {
+    Feed cached;
+    if (readCached(name, url, cached)) {
+      touch(key);
+      feed = std::move(cached);
+      return Source::SESSION;
+    }
+  }
+
+  // Without validators the server could not answer 304, so the request is a plain GET
+  Validators cachedValidators;
+  readValidators(name, url, cachedValidators);
+  Validators received;
+  Feed fetched;
+  auto result = transport.get(url, cachedValidators, fetched, received);
+
+  if (result == Transport::Result::NOT_MODIFIED) {
+    Feed cached;
+    if (readCached(name, url, cached)) {
+      markValidated(key);
+      touch(key);
+      feed = std::move(cached);
+      return Source::REVALIDATED;
+    }
+    // The validators were intact but the feed after them is not: download it again
+    store.remove(name);
+    result = transport.get(url, Validators{}, fetched, received);
+  }
+
+  if (result == Transport::Result::OK) {
+    if (store.write(name, encode(url, received, fetched))) {
+      markValidated(key);
+      touch(key);
+    }
+    feed = std::move(fetched);
+    return Source::NETWORK;
+  }
+
+  Feed cached;
+  if (result == Transport::Result::FAILED && readCached(name, url, cached)) {
+    feed = std::move(cached);
+    return Source::STALE;
+  }
+  return Source::NONE;
+}
+
+bool OpdsFeedCache::readValidators(const std::string& name, const std::string& url, Validators& validators) {
+  const size_t length = url.size() + VALIDATORS_HEAD_BYTES;
+  std::string head;
+  if (!store.readHead(name, length, head)) {
+    return false;
+  }
+  if (decodeValidators(head, url, validators)) {
+    return true;
+  }
+  // Validators longer than the head is sized for: read the whole file
+  return head.size() == length && store.read(name, head) && decodeValidators(head, url, validators);
+}
+
+bool OpdsFeedCache::readCached(const std::string& name, const std::string& url, Feed& feed) {
+  std::string data;
+  Validators validators;
+  return store.read(name, data) && decode(data, url, validators, feed);
+}
+
+void OpdsFeedCache::clear() {
+  loadRecent();
+  for (const uint64_t key : recent) {
+    store.remove(nameForKey(key));
+  }
+  recent.clear();
+  validated.clear();
+  store.remove(INDEX_NAME);
+}
+
+// Index file: the cached feeds' URL hashes, least recently used first
+void OpdsFeedCache::loadRecent() {
+  if (recentLoaded) {
+    return;
+  }
+  recentLoaded = true;
+  recent.clear();
+
+  std::string data;
+  if (!store.read(INDEX_NAME, data) || data.size() % sizeof(uint64_t) != 0) {
+    return;
+  }
+  recent.resize(data.size() / sizeof(uint64_t));
+  memcpy(recent.data(), data.data(), data.size());
+}
+
+void OpdsFeedCache::touch(const uint64_t key) {
+  loadRecent();
+  const auto it = std::find(recent.begin(), recent.end(), key);
+  if (it != recent.end()) {
+    if (it + 1 == recent.end()) {
+      return;  // already the most recent one, nothing to write
+    }
+    recent.erase(it);
+  }
+  recent.push_back(key);
+
+  while (recent.size() > MAX_FEEDS) {
+    store.remove(nameForKey(recent.front()));
+    recent.erase(recent.begin());
+  }
+  store.write(INDEX_NAME, std::string(reinterpret_cast<const char*>(recent.data()), recent.size() * sizeof(uint64_t)));
+}
+
+bool OpdsFeedCache::isValidated(const uint64_t key) const {
+  return std::find(validated.begin(), validated.end(), key) != validated.end();
+}
+
+void OpdsFeedCache::markValidated(const uint64_t key) {
+  if (!isValidated(key)) {
+    validated.push_back(key);
+  }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OpdsEntry.h"
+
+// Parsed OPDS feeds kept on the SD card, keyed by URL, so catalog pages are not downloaded and parsed again.
+//
+// Each feed is stored in a compact binary form together with the ETag / Last-Modified the server sent. A feed that
+// was already fetched or revalidated in this browsing session (going back to the page just left) is served straight
+// from the card. Otherwise the cached copy is revalidated with a conditional request, and a 304 Not Modified answer
+// transfers no feed at all. When the server cannot be reached the cached copy is still shown. Only the validators at
+// the head of the file are read before the request; the cached feed is decoded once the answer shows it is needed.
+//
+// The cache holds at most MAX_FEEDS feeds and drops the least recently used one beyond that. It has no platform
+// dependencies: storage and HTTP are supplied by the caller (SD card and HTTPClient on the device, memory and a local
+// server stand-in in the host tests).
+class OpdsFeedCache {
+ public:
+  static constexpr size_t MAX_FEEDS = 48;
+
+  struct Feed {
+    std::vector<OpdsEntry> entries;
+    std::string searchTemplate;
+    std::string nextPageUrl;
+    std::string prevPageUrl;
+  };
+
+  // Response validators; empty when the server sent none
+  struct Validators {
+    std::string etag;
+    std::string lastModified;
+
+    bool empty() const { return etag.empty() && lastModified.empty(); }
+  };
+
+  // Small named files
+  class Store {
+   public:
+    virtual ~Store() = default;
+    virtual bool read(const std::string& name, std::string& data) = 0;
+    // The first `length` bytes, or the whole file if it is shorter
+    virtual bool readHead(const std::string& name, size_t length, std::string& data) = 0;
+    virtual bool write(const std::string& name, const std::string& data) = 0;
+    virtual void remove(const std::string& name) = 0;
+  };
+
+  class Transport {
+   public:
+    enum class Result { OK, NOT_MODIFIED, FAILED };
+
+    virtual ~Transport() = default;
+    // GETs and parses `url`. Non-empty `cached` validators go out as If-None-Match / If-Modified-Since; on OK `feed`
+    // and `received` hold the new feed and its validators.
+    virtual Result get(const std::string& url, const Validators& cached, Feed& feed, Validators& received) = 0;
+  };
+
+  enum class Source {
+    NONE,         // nothing cached and the request failed
+    NETWORK,      // downloaded (first visit or changed on the server)
+    REVALIDATED,  // cached copy confirmed by a 304
+    SESSION,      // cached copy already validated in this session, no request made
+    STALE,        // request failed, cached copy shown instead
+  };
+
+  explicit OpdsFeedCache(Store& store) : store(store) {}
+
+  // Gets the feed at `url` into `feed`. With `preferSession`, a copy validated earlier in this session is used
+  // without asking the server (back navigation); otherwise the server is always asked.
+  Source fetch(const std::string& url, Transport& transport, Feed& feed, bool preferSession);
+  // Forgets every cached feed
+  void clear();
+
+  // Binary form of one cached feed (exposed for the tests)
+  static std::string encode(const std::string& url, const Validators& validators, const Feed& feed);
+  static bool decode(const std::string& data, const std::string& url, Validators& validators, Feed& feed);
+  // Reads only the validators; `data` may end anywhere after them
+  static bool decodeValidators(const std::string& data, const std::string& url, Validators& validators);
+  static std::string nameFor(const std::string& url);
+
+ private:
+  Store& store;
+  std::vector<uint64_t> recent;  // cached feeds by URL hash, least recently used first
+  bool recentLoaded = false;
+  std::vector<uint64_t> validated;  // URL hashes fetched or revalidated in this session
+
+  bool readValidators(const std::string& name, const std::string& url, Validators& validators);
+  bool readCached(const std::string& name, const std::string& url, Feed& feed);
+  void loadRecent();
+  void touch(uint64_t key);
+  bool isValidated(uint64_t key) const;
+  void markValidated(uint64_t key);
+};
@@ -5,24 +5,7 @@
 #include <string>
 #include <vector>
 
-/**
- * Type of OPDS entry.
- */
-enum class OpdsEntryType {
-  NAVIGATION,  // Link to another catalog
-  BOOK         // Downloadable book
-};
-
-/**
- * Represents an entry from an OPDS feed (either a navigation link or a book).
- */
-struct OpdsEntry {
-  OpdsEntryType type = OpdsEntryType::NAVIGATION;
-  std::string title;
-  std::string author;  // Only for books
-  std::string href;    // Navigation URL or epub download URL
-  std::string id;
-};
+#include "OpdsEntry.h"
 
 // Legacy alias for backward compatibility
 using OpdsBook = OpdsEntry;
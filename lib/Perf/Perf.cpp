@@ -0,0 +1,184 @@
+#include "Perf.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Perf::Counter::_COUNT);
+constexpr size_t TIMER_COUNT = static_cast<size_t>(Perf::Timer::_COUNT);
+
+constexpr const char* COUNTER_NAMES[COUNTER_COUNT] = {
+    "sdReadBytes",      "sdReadOps",   "sdWriteBytes", "sdWriteOps",  "inflateBytes", "glyphCacheHits",
+    "glyphCacheMisses", "refreshFast", "refreshHalf",  "refreshFull", "refreshGray",
+};
+constexpr const char* TIMER_NAMES[TIMER_COUNT] = {
+    "layout", "pageLoad", "pagePrewarm", "pageRender", "pageGrayscale", "refresh",
+};
+
+struct AtomicTimer {
+  std::atomic<uint32_t> count{0};
+  std::atomic<uint32_t> totalUs{0};
+  std::atomic<uint32_t> maxUs{0};
+};
+
+uint32_t (*clockUs)() = nullptr;
+std::atomic<uint32_t> counters[COUNTER_COUNT];
+AtomicTimer timers[TIMER_COUNT];
+std::atomic<uint32_t> heapLowWater{UINT32_MAX};
+std::atomic<uint32_t> largestBlockLowWater{UINT32_MAX};
+
+#ifdef ENABLE_PERF
+// Ring of the latest timed events. Writers claim a slot with one atomic increment; a reader racing a writer may see a
+// half-written event, which only affects that one trace entry.
+Perf::Event events[Perf::EVENT_CAPACITY];
+std::atomic<uint32_t> eventTotal{0};
+#endif
+
+void lowerTo(std::atomic<uint32_t>& value, const uint32_t candidate) {
+  uint32_t current = value.load(std::memory_order_relaxed);
+  while (candidate < current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+  }
+}
+
+void raiseTo(std::atomic<uint32_t>& value, const uint32_t candidate) {
+  uint32_t current = value.load(std::memory_order_relaxed);
+  while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+  }
+}
+
+void appendf(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+void appendf(std::string& out, const char* format, ...) {
+  char buffer[96];
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length > 0) out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+}
+}  // namespace
+
+namespace Perf {
+
+void begin(uint32_t (*nowUs)()) { clockUs = nowUs; }
+
+uint32_t now() { return clockUs ? clockUs() : 0; }
+
+void add(const Counter counter, const uint32_t amount) {
+  counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void record(const Timer timer, const uint32_t startUs, const uint32_t durationUs) {
+  if (!clockUs) return;
+  AtomicTimer& stats = timers[static_cast<size_t>(timer)];
+  stats.count.fetch_add(1, std::memory_order_relaxed);
+  stats.totalUs.fetch_add(durationUs, std::memory_order_relaxed);
+  raiseTo(stats.maxUs, durationUs);
+#ifdef ENABLE_PERF
+  const uint32_t slot = eventTotal.fetch_add(1, std::memory_order_relaxed) % EVENT_CAPACITY;
+  events[slot] = Event{startUs, durationUs, timer};
+#else
+  (void)startUs;
+#endif
+}
+
+void sampleHeap(const uint32_t freeBytes, const uint32_t largestFreeBlock) {
+  lowerTo(heapLowWater, freeBytes);
+  lowerTo(largestBlockLowWater, largestFreeBlock);
+}
+
+void reset() {
+  for (auto& counter : counters) counter.store(0, std::memory_order_relaxed);
+  for (auto& timer : timers) {
+    timer.count.store(0, std::memory_order_relaxed);
+    timer.totalUs.store(0, std::memory_order_relaxed);
+    timer.maxUs.store(0, std::memory_order_relaxed);
+  }
+  heapLowWater.store(UINT32_MAX, std::memory_order_relaxed);
+  largestBlockLowWater.store(UINT32_MAX, std::memory_order_relaxed);
+#ifdef ENABLE_PERF
+  eventTotal.store(0, std::memory_order_relaxed);
+#endif
+}
+
+uint32_t get(const Counter counter) { return counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed); }
+
+TimerStats get(const Timer timer) {
+  const AtomicTimer& stats = timers[static_cast<size_t>(timer)];
+  return TimerStats{stats.count.load(std::memory_order_relaxed), stats.totalUs.load(std::memory_order_relaxed),
+                    stats.maxUs.load(std::memory_order_relaxed)};
+}
+
+uint32_t eventCount() {
+#ifdef ENABLE_PERF
+  return eventTotal.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
+}
+
+bool eventAt(const uint32_t index, Event& event) {
+#ifdef ENABLE_PERF
+  if (index >= eventCount() || eventCount() - index > EVENT_CAPACITY) return false;
+  event = events[index % EVENT_CAPACITY];
+  return true;
+#else
+  (void)index;
+  (void)event;
+  return false;
+#endif
+}
+
+const char* name(const Counter counter) {
+  const auto index = static_cast<size_t>(counter);
+  return index < COUNTER_COUNT ? COUNTER_NAMES[index] : "?";
+}
+
+const char* name(const Timer timer) {
+  const auto index = static_cast<size_t>(timer);
+  return index < TIMER_COUNT ? TIMER_NAMES[index] : "?";
+}
+
+std::string toJson() {
+  std::string out;
+  out.reserve(768);
+#ifdef ENABLE_PERF
+  out += "{\"enabled\":true,\"counters\":{";
+#else
+  out += "{\"enabled\":false,\"counters\":{";
+#endif
+  for (size_t i = 0; i < COUNTER_COUNT; i++) {
+    appendf(out, "%s\"%s\":%lu", i > 0 ? "," : "", COUNTER_NAMES[i],
+            static_cast<unsigned long>(counters[i].load(std::memory_order_relaxed)));
+  }
+  out += "},\"timers\":{";
+  for (size_t i = 0; i < TIMER_COUNT; i++) {
+    const TimerStats stats = get(static_cast<Timer>(i));
+    appendf(out, "%s\"%s\":{\"count\":%lu,\"totalUs\":%lu,\"maxUs\":%lu}", i > 0 ? "," : "", TIMER_NAMES[i],
+            static_cast<unsigned long>(stats.count), static_cast<unsigned long>(stats.totalUs),
+            static_cast<unsigned long>(stats.maxUs));
+  }
+  const uint32_t heap = heapLowWater.load(std::memory_order_relaxed);
+  const uint32_t block = largestBlockLowWater.load(std::memory_order_relaxed);
+  appendf(out, "},\"heap\":{\"minFree\":%lu,\"minLargestBlock\":%lu}", heap == UINT32_MAX ? 0ul : heap,
+          block == UINT32_MAX ? 0ul : block);
+  appendf(out, ",\"events\":%lu}", static_cast<unsigned long>(std::min<uint32_t>(eventCount(), EVENT_CAPACITY)));
+  return out;
+}
+
+std::string toChromeTrace() {
+  std::string out;
+  out.reserve(64 + 80 * std::min<uint32_t>(eventCount(), EVENT_CAPACITY));
+  out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  forEachEvent([&out, &first](const Event& event) {
+    appendf(out, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":1}", first ? "" : ",",
+            name(event.timer), static_cast<unsigned long>(event.startUs), static_cast<unsigned long>(event.durationUs));
+    first = false;
+  });
+  out += "]}";
+  return out;
+}
+
+}  // namespace Perf
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Performance counters, timers and a trace of recent timed events, shared by the firmware and the host tests so builds
+// can be compared on the same numbers.
+//
+// Instrumented code uses the PERF_* macros. Without -DENABLE_PERF they compile to nothing; with it a counter costs one
+// relaxed atomic add and a timer two clock reads plus a slot in the event ring. The ESP32-C3 core (RV32IMC) has no
+// atomic instructions, so on the device each atomic add is a libatomic call that briefly masks interrupts. The data is
+// exported as JSON (web server /api/perf, serial CMD:PERF) or as a Chrome trace (chrome://tracing, Perfetto).
+//
+// The library has no platform dependencies: the microsecond clock is supplied through begin().
+namespace Perf {
+
+enum class Counter : uint8_t {
+  SdReadBytes,
+  SdReadOps,
+  SdWriteBytes,
+  SdWriteOps,
+  InflateBytes,
+  GlyphCacheHits,
+  GlyphCacheMisses,
+  RefreshFast,
+  RefreshHalf,
+  RefreshFull,
+  RefreshGray,
+  _COUNT
+};
+
+enum class Timer : uint8_t {
+  Layout,         // building a chapter's section file
+  PageLoad,       // reading a page from the section file
+  PagePrewarm,    // font cache prewarm for a page
+  PageRender,     // drawing the black/white page
+  PageGrayscale,  // anti-aliasing passes
+  Refresh,        // display refresh (any mode)
+  _COUNT
+};
+
+struct TimerStats {
+  uint32_t count;
+  uint32_t totalUs;
+  uint32_t maxUs;
+};
+
+struct Event {
+  uint32_t startUs;
+  uint32_t durationUs;
+  Timer timer;
+};
+
+static constexpr uint16_t EVENT_CAPACITY = 256;
+
+// nowUs: monotonic microsecond clock. Until it is set, timers record nothing.
+void begin(uint32_t (*nowUs)());
+uint32_t now();
+
+void add(Counter counter, uint32_t amount);
+void record(Timer timer, uint32_t startUs, uint32_t durationUs);
+// Tracks the heap low-water mark and the smallest largest-free-block seen
+void sampleHeap(uint32_t freeBytes, uint32_t largestFreeBlock);
+void reset();
+
+uint32_t get(Counter counter);
+TimerStats get(Timer timer);
+// Visits the recorded events, oldest first; at most EVENT_CAPACITY of the most recent ones are kept
+template <typename Visitor>
+void forEachEvent(Visitor&& visit);
+
+const char* name(Counter counter);
+const char* name(Timer timer);
+
+// {"enabled":..,"counters":{..},"timers":{name:{"count","totalUs","maxUs"}},"heap":{..},"events":N}
+std::string toJson();
+// Chrome trace event format: one complete ("X") event per recorded timer event
+std::string toChromeTrace();
+
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const Timer timer) : timer(timer), start(now()) {}
+  ~ScopedTimer() { record(timer, start, now() - start); }
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Timer timer;
+  uint32_t start;
+};
+
+// Implementation detail of forEachEvent
+uint32_t eventCount();
+bool eventAt(uint32_t index, Event& event);
+
+template <typename Visitor>
+void forEachEvent(Visitor&& visit) {
+  const uint32_t total = eventCount();
+  const uint32_t first = total > EVENT_CAPACITY ? total - EVENT_CAPACITY : 0;
+  Event event{};
+  for (uint32_t i = first; i < total; i++) {
+    if (eventAt(i, event)) visit(event);
+  }
+}
+
+}  // namespace Perf
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_PERF
+#define PERF_COUNT(counter, amount) Perf::add(Perf::Counter::counter, static_cast<uint32_t>(amount))
+#define PERF_SCOPE(timer) const Perf::ScopedTimer PERF_CONCAT(perfScope, __LINE__)(Perf::Timer::timer)
+#define PERF_RECORD(timer, startUs, durationUs) Perf::record(Perf::Timer::timer, startUs, durationUs)
+#define PERF_NOW() Perf::now()
+#else
+#define PERF_COUNT(counter, amount) \
+  do {                              \
+  } while (0)
+#define PERF_SCOPE(timer) \
+  do {                    \
+  } while (0)
+#define PERF_RECORD(timer, startUs, durationUs) \
+  do {                                          \
+  } while (0)
+#define PERF_NOW() 0u
+#endif
@@ -1,14 +1,14 @@
 #pragma once
 
 #include <HalStorage.h>
+#include <ScaledBmpWriter.h>
 
 class Print;
 
 class PngToBmpConverter {
-  static bool pngFileToBmpStreamInternal(FsFile& pngFile, Print& bmpOut, int targetWidth, int targetHeight, bool oneBit,
-                                         bool crop = true);
-
  public:
+  // Decode once and write every target from the same scanlines.
+  static bool pngFileToBmpStreams(FsFile& pngFile, const BmpTarget* targets, int targetCount);
   static bool pngFileToBmpStream(FsFile& pngFile, Print& bmpOut, bool crop = true);
   static bool pngFileToBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
   static bool pngFileTo1BitBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
@@ -0,0 +1,281 @@
+#include "ResumableDownload.h"
+
+#include <strings.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+constexpr size_t PREFIX_CHUNK_SIZE = 4096;
+
+// Metadata record: url, validator and total size (0 when unknown), one per line
+std::string encodeMeta(const std::string& url, const std::string& validator, const size_t total) {
+  return url + "\n" + validator + "\n" + std::to_string(total) + "\n";
+}
+
+bool decodeMeta(const std::string& data, const std::string& url, std::string& validator, size_t& total) {
+  const size_t urlEnd = data.find('\n');
+  if (urlEnd == std::string::npos || data.compare(0, urlEnd, url) != 0 || urlEnd != url.size()) {
+    return false;
+  }
+  const size_t validatorEnd = data.find('\n', urlEnd + 1);
+  if (validatorEnd == std::string::npos) {
+    return false;
+  }
+  validator = data.substr(urlEnd + 1, validatorEnd - urlEnd - 1);
+  total = strtoul(data.c_str() + validatorEnd + 1, nullptr, 10);
+  return true;
+}
+
+// "bytes <first>-<last>/<total>"; total is 0 for "*"
+bool parseContentRange(const std::string& value, size_t& first, size_t& total) {
+  const char* text = value.c_str();
+  if (strncmp(text, "bytes ", 6) != 0) {
+    return false;
+  }
+  char* end = nullptr;
+  first = strtoul(text + 6, &end, 10);
+  const char* slash = strchr(end, '/');
+  if (end == text + 6 || *end != '-' || !slash) {
+    return false;
+  }
+  total = slash[1] == '*' ? 0 : strtoul(slash + 1, nullptr, 10);
+  return true;
+}
+
+int base64Value(const char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+' || c == '-') return 62;
+  if (c == '/' || c == '_') return 63;
+  return -1;
+}
+}  // namespace
+
+// Receives each request's response and body, and carries the transfer state from one request to the next
+class ResumableDownload::Receiver final : public Transport::Receiver {
+ public:
+  ResumableDownload& download;
+  const std::string& url;
+  Hasher* hasher;
+  const std::string& callerDigest;
+  std::string expectedDigest;
+  const ProgressCallback& progress;
+
+  size_t offset = 0;  // bytes in the partial file
+  size_t total = 0;   // final size, 0 while unknown
+  std::string validator;
+  bool opened = false;
+  bool hashing = false;  // the hasher has seen the first `offset` bytes
+
+  // Outcome of the latest request
+  bool accepted = false;
+  bool fatal = false;
+  bool fileFailed = false;
+
+  Receiver(ResumableDownload& download, const std::string& url, Hasher* hasher, const std::string& expectedDigest,
+           const ProgressCallback& progress)
+      : download(download),
+        url(url),
+        hasher(hasher),
+        callerDigest(expectedDigest),
+        expectedDigest(expectedDigest),
+        progress(progress) {}
+
+  void startRequest() {
+    accepted = false;
+    fatal = false;
+  }
+
+  // Drops the partial file; the next request asks for the whole file
+  void restart() {
+    offset = 0;
+    hashing = false;
+    expectedDigest = callerDigest;  // a digest the server sent may be of the file it replaced
+    download.stats.bytesResumed = 0;
+    if (opened) {
+      download.part.end();
+      opened = false;
+    }
+  }
+
+  bool onResponse(const Transport::Response& response) override {
+    size_t first = 0;
+    size_t rangeTotal = 0;
+    if (response.status == 206 && offset > 0) {
+      if (!parseContentRange(response.contentRange, first, rangeTotal) || first != offset) {
+        fatal = true;
+        return false;
+      }
+      if (rangeTotal > 0) total = rangeTotal;
+    } else if (response.status == 200) {
+      if (response.contentLength == 0) {
+        fatal = true;  // nothing to download
+        return false;
+      }
+      if (offset > 0) {
+        // Range ignored or If-Range failed: the whole (possibly changed) file follows
+        download.stats.restarts++;
+        restart();
+      }
+      total = response.contentLength > 0 ? static_cast<size_t>(response.contentLength) : 0;
+    } else if (response.status == 416 && offset > 0) {
+      // The partial file does not fit the file on the server any more; start over with the next request
+      restart();
+      validator.clear();
+      return false;
+    } else {
+      // Client errors will not go away by asking again
+      fatal = response.status >= 400 && response.status < 500;
+      return false;
+    }
+
+    if (expectedDigest.empty()) {
+      expectedDigest = parseSha256Digest(response.digest);
+    }
+    // Hash only once there is a digest to check. A kept prefix can only be read back before the partial file is
+    // reopened for writing, so a digest that first shows up on a later request goes unchecked.
+    if (hasher && !hashing && !expectedDigest.empty() && (offset == 0 || !opened)) {
+      hasher->begin();
+      if (offset > 0 && !download.hashPrefix(*hasher, offset)) {
+        restart();  // the next request fetches the whole file
+        return false;
+      }
+      hashing = true;
+    }
+    if (!opened) {
+      validator = response.etag.empty() ? response.lastModified : response.etag;
+      if (!download.part.begin(offset, total) || !download.part.writeMeta(encodeMeta(url, validator, total))) {
+        fileFailed = true;
+        return false;
+      }
+      opened = true;
+    }
+    accepted = true;
+    return true;
+  }
+
+  bool onData(const uint8_t* data, const size_t length) override {
+    if (total > 0 && offset + length > total) {
+      fatal = true;  // more than the server announced
+      return false;
+    }
+    if (!download.part.write(data, length)) {
+      fileFailed = true;
+      return false;
+    }
+    if (hashing) hasher->update(data, length);
+    offset += length;
+    download.stats.bytesReceived += length;
+    if (progress) progress(offset, total);
+    return true;
+  }
+};
+
+bool ResumableDownload::hashPrefix(Hasher& hasher, const size_t length) {
+  auto* buffer = static_cast<uint8_t*>(malloc(PREFIX_CHUNK_SIZE));
+  if (!buffer) {
+    return false;
+  }
+  bool ok = true;
+  for (size_t pos = 0; ok && pos < length; pos += PREFIX_CHUNK_SIZE) {
+    const size_t chunk = length - pos < PREFIX_CHUNK_SIZE ? length - pos : PREFIX_CHUNK_SIZE;
+    ok = part.read(pos, buffer, chunk);
+    if (ok) hasher.update(buffer, chunk);
+  }
+  free(buffer);
+  return ok;
+}
+
+ResumableDownload::Result ResumableDownload::run(const std::string& url, Hasher* hasher,
+                                                 const std::string& expectedDigest, const ProgressCallback& progress) {
+  stats = {};
+  const uint32_t startMs = nowMs();
+  Receiver receiver(*this, url, hasher, expectedDigest, progress);
+
+  // Pick up what an earlier download of this URL left, unless there is no way to tell the file is unchanged
+  std::string meta;
+  if (part.readMeta(meta) && decodeMeta(meta, url, receiver.validator, receiver.total) &&
+      !receiver.validator.empty()) {
+    const size_t kept = part.size();
+    receiver.offset = kept - kept % RESUME_ALIGNMENT;
+    if (receiver.total > 0 && receiver.offset >= receiver.total) {
+      receiver.offset = 0;
+    }
+  }
+  stats.bytesResumed = receiver.offset;
+
+  bool complete = false;
+  uint8_t failures = 0;
+  while (!complete && failures < MAX_ATTEMPTS) {
+    if (failures > 0) {
+      delayMs(RETRY_DELAY_MS << (failures - 1));
+    }
+    stats.attempts++;
+    const uint32_t receivedBefore = stats.bytesReceived;
+    receiver.startRequest();
+    const bool ended = transport.get(url, receiver.offset, receiver.offset > 0 ? receiver.validator : "", receiver);
+
+    if (receiver.fatal || receiver.fileFailed) {
+      break;
+    }
+    if (receiver.accepted) {
+      complete = receiver.total > 0 ? receiver.offset == receiver.total : ended && receiver.offset > 0;
+    }
+    failures = stats.bytesReceived > receivedBefore ? 1 : failures + 1;
+  }
+
+  const bool stored = receiver.opened && part.end();
+  stats.fileSize = receiver.offset;
+  stats.elapsedMs = nowMs() - startMs;
+
+  if (receiver.fileFailed || (receiver.opened && !stored) || (receiver.fatal && receiver.opened)) {
+    part.discard();
+    return receiver.fileFailed || !stored ? Result::FILE_ERROR : Result::HTTP_ERROR;
+  }
+  if (!complete) {
+    return Result::HTTP_ERROR;  // the partial file stays for the next attempt
+  }
+
+  if (receiver.hashing) {
+    if (hasher->finish() != receiver.expectedDigest) {
+      part.discard();
+      return Result::INTEGRITY_ERROR;
+    }
+    stats.verified = true;
+  }
+
+  if (!part.commit()) {
+    part.discard();
+    return Result::FILE_ERROR;
+  }
+  return Result::OK;
+}
+
+std::string ResumableDownload::parseSha256Digest(const std::string& header) {
+  std::string result;
+  size_t pos = 0;
+  while (pos < header.size()) {
+    while (pos < header.size() && (header[pos] == ' ' || header[pos] == ',')) pos++;
+    const size_t end = std::min(header.find(',', pos), header.size());
+    if (end - pos > 8 && strncasecmp(header.c_str() + pos, "sha-256=", 8) == 0) {
+      uint32_t bits = 0;
+      int bitCount = 0;
+      for (size_t i = pos + 8; i < end; i++) {
+        const int value = base64Value(header[i]);
+        if (value < 0) continue;  // padding, the colons of Repr-Digest, whitespace
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bitCount += 6;
+        if (bitCount >= 8) {
+          bitCount -= 8;
+          result += static_cast<char>((bits >> bitCount) & 0xFF);
+        }
+      }
+      return result.size() == 32 ? result : std::string();
+    }
+    pos = end;
+  }
+  return result;
+}
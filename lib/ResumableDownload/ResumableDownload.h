@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Downloads one file into a partial file that survives dropped connections and restarts.
+//
+// Body data is appended to the caller's PartFile. When the connection breaks, the request is repeated with an HTTP
+// Range from the first missing byte, up to MAX_ATTEMPTS times in a row without progress. A later download of the same
+// URL picks up the partial file an earlier one left behind. The server's ETag (else Last-Modified) goes out as
+// If-Range, so a file that changed on the server comes back whole and replaces the partial one instead of being
+// spliced onto it.
+//
+// A partial file from an earlier download is resumed from a multiple of RESUME_ALIGNMENT: its tail is fetched again,
+// so a block torn by a power loss never ends up in the file and the writes that follow stay block aligned.
+//
+// With a Hasher the file is hashed as it streams in and checked against the expected digest: the caller's, or the
+// sha-256 of a Digest / Repr-Digest response header. A kept prefix is read back into the hash only once the server
+// has agreed to resume and there is a digest to check, so a resume without one reads nothing back. A mismatch
+// discards the partial file.
+//
+// The class has no platform dependencies: partial file, HTTP, hashing and clock are supplied by the caller (SD card,
+// HTTPClient and mbedtls on the device, memory and a local server stand-in in the host tests).
+class ResumableDownload {
+ public:
+  static constexpr size_t RESUME_ALIGNMENT = 8 * 1024;
+  static constexpr uint8_t MAX_ATTEMPTS = 5;
+  static constexpr uint32_t RETRY_DELAY_MS = 500;  // doubled after every further failed attempt
+
+  enum class Result { OK, HTTP_ERROR, FILE_ERROR, INTEGRITY_ERROR };
+
+  using ProgressCallback = std::function<void(size_t downloaded, size_t total)>;
+
+  // The partial file and a small metadata record kept next to it
+  class PartFile {
+   public:
+    virtual ~PartFile() = default;
+    // Size of the partial file an earlier download left, 0 if there is none
+    virtual size_t size() = 0;
+    // Reads back part of that file; only called before begin()
+    virtual bool read(size_t offset, uint8_t* data, size_t length) = 0;
+    // Keeps the first `keep` bytes and appends after them. expectedSize > 0 is the final size, when known.
+    virtual bool begin(size_t keep, size_t expectedSize) = 0;
+    virtual bool write(const uint8_t* data, size_t length) = 0;
+    // Stores everything written and closes the file. True if every byte reached it.
+    virtual bool end() = 0;
+    // Moves the finished file to its destination and removes the metadata
+    virtual bool commit() = 0;
+    // Removes the partial file and the metadata
+    virtual void discard() = 0;
+    virtual bool readMeta(std::string& data) = 0;
+    virtual bool writeMeta(const std::string& data) = 0;
+  };
+
+  class Transport {
+   public:
+    struct Response {
+      int status = 0;
+      int64_t contentLength = -1;  // of this response's body, -1 when unknown
+      std::string contentRange;    // e.g. "bytes 8192-9999/10000"
+      std::string etag;
+      std::string lastModified;
+      std::string digest;  // Digest and Repr-Digest header values, comma separated
+    };
+
+    class Receiver {
+     public:
+      virtual ~Receiver() = default;
+      // Called once the headers arrived; false skips the body
+      virtual bool onResponse(const Response& response) = 0;
+      // Body bytes in order; false stops the transfer
+      virtual bool onData(const uint8_t* data, size_t length) = 0;
+    };
+
+    virtual ~Transport() = default;
+    // GETs `url`. from > 0 asks for the bytes from there on (Range), with If-Range: ifRange when that is non-empty.
+    // True if the body was read to its end, false when the request failed, the connection broke or the receiver
+    // stopped it.
+    virtual bool get(const std::string& url, size_t from, const std::string& ifRange, Receiver& receiver) = 0;
+  };
+
+  class Hasher {
+   public:
+    virtual ~Hasher() = default;
+    virtual void begin() = 0;
+    virtual void update(const uint8_t* data, size_t length) = 0;
+    // Raw digest of everything since begin()
+    virtual std::string finish() = 0;
+  };
+
+  struct Stats {
+    uint32_t fileSize = 0;
+    uint32_t bytesReceived = 0;  // body bytes over the network, all attempts together
+    uint32_t bytesResumed = 0;   // kept from an earlier download's partial file
+    uint16_t attempts = 0;       // requests made
+    uint8_t restarts = 0;        // times the server sent the whole file again instead of a range
+    bool verified = false;       // the digest was checked and matched
+    uint32_t elapsedMs = 0;
+
+    uint32_t bytesPerSecond() const {
+      return elapsedMs > 0 ? static_cast<uint32_t>(static_cast<uint64_t>(bytesReceived) * 1000 / elapsedMs) : 0;
+    }
+  };
+
+  // nowMs: monotonic millisecond clock. delayMs: waits between attempts.
+  ResumableDownload(PartFile& part, Transport& transport, uint32_t (*nowMs)(), void (*delayMs)(uint32_t))
+      : part(part), transport(transport), nowMs(nowMs), delayMs(delayMs) {}
+
+  // Downloads `url` into the partial file and commits it. `hasher` (optional) enables the integrity check;
+  // `expectedDigest` (raw bytes, optional) takes precedence over the server's. A failed transfer keeps the partial
+  // file for the next call; corrupt data (digest or size mismatch, write error) discards it.
+  Result run(const std::string& url, Hasher* hasher = nullptr, const std::string& expectedDigest = "",
+             const ProgressCallback& progress = nullptr);
+
+  const Stats& getStats() const { return stats; }
+
+  // Raw sha-256 from "sha-256=<base64>" (Digest) or "sha-256=:<base64>:" (Repr-Digest); empty if there is none
+  static std::string parseSha256Digest(const std::string& header);
+
+ private:
+  class Receiver;
+
+  PartFile& part;
+  Transport& transport;
+  uint32_t (*nowMs)();
+  void (*delayMs)(uint32_t);
+  Stats stats;
+
+  bool hashPrefix(Hasher& hasher, size_t length);
+};
@@ -0,0 +1,190 @@
+#include "TxtPaginator.h"
+
+#include <Logging.h>
+#include <Utf8.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace {
+// Bytes kept buffered past the codepoint being decoded: a UTF-8 sequence plus whatever a ligature run consumes
+constexpr size_t LOOKAHEAD = 32;
+// A line of zero-width text this long is cut so a line always fits in the buffer
+constexpr size_t MAX_LINE_BYTES = TxtPaginator::BUFFER_SIZE - 2 * LOOKAHEAD;
+
+// Ink extent of a run of text, grown one glyph at a time with the same steps as EpdFont::getTextBounds
+struct LineMeasure {
+  int baseX = 0;
+  int minX = 0;
+  int maxX = 0;
+  int lastBaseLeft = 0;
+  int lastBaseWidth = 0;
+  int32_t prevAdvanceFP = 0;
+  uint32_t prevCp = 0;
+
+  void add(const EpdFontFamily& font, const uint32_t cp, const EpdGlyph* glyph, const bool isCombining) {
+    if (!glyph) {
+      if (!isCombining) {
+        baseX += fp4::toPixel(prevAdvanceFP);
+        prevCp = 0;
+        prevAdvanceFP = 0;
+        lastBaseLeft = 0;
+        lastBaseWidth = 0;
+      }
+      return;
+    }
+
+    if (!isCombining && prevCp != 0) {
+      baseX += fp4::toPixel(prevAdvanceFP + font.getKerning(prevCp, cp));
+    }
+    const int glyphX =
+        isCombining ? combiningMark::centerOver(baseX, lastBaseLeft, lastBaseWidth, glyph->left, glyph->width) : baseX;
+    minX = std::min(minX, glyphX + glyph->left);
+    maxX = std::max(maxX, glyphX + glyph->left + glyph->width);
+
+    if (!isCombining) {
+      lastBaseLeft = glyph->left;
+      lastBaseWidth = glyph->width;
+      prevAdvanceFP = glyph->advanceX;
+      prevCp = cp;
+    }
+  }
+
+  int width() const { return maxX - minX; }
+};
+}  // namespace
+
+TxtPaginator::TxtPaginator(const EpdFontFamily& font, const int maxWidth, const size_t fileSize, ReadFn read)
+    : font(font), maxWidth(maxWidth), fileSize(fileSize), read(std::move(read)) {
+  buffer = static_cast<char*>(malloc(BUFFER_SIZE + 1));
+  if (!buffer) {
+    LOG_ERR("TXP", "Failed to allocate %zu bytes", BUFFER_SIZE + 1);
+  }
+}
+
+TxtPaginator::~TxtPaginator() { free(buffer); }
+
+bool TxtPaginator::fill(const size_t keepFrom, const size_t needUntil) {
+  const size_t bufferEnd = bufferOffset + bufferLength;
+  if (needUntil <= bufferEnd || bufferEnd >= fileSize) {
+    return true;
+  }
+
+  // Drop what is before the current line and top the buffer up behind the rest
+  const size_t kept = bufferEnd - keepFrom;
+  memmove(buffer, buffer + (keepFrom - bufferOffset), kept);
+  bufferOffset = keepFrom;
+  bufferLength = kept;
+
+  const size_t length = std::min(BUFFER_SIZE - kept, fileSize - bufferEnd);
+  if (!read(reinterpret_cast<uint8_t*>(buffer + kept), bufferEnd, length)) {
+    buffer[bufferLength] = '\0';
+    return false;
+  }
+  bufferLength += length;
+  buffer[bufferLength] = '\0';
+  return true;
+}
+
+size_t TxtPaginator::layout(const size_t offset, const LineFn& onLine) {
+  if (!buffer || offset >= fileSize) {
+    return std::max(offset, fileSize);
+  }
+
+  bufferOffset = offset;
+  bufferLength = 0;
+  buffer[0] = '\0';
+
+  size_t lineStart = offset;
+  LineMeasure line;  // from lineStart
+  LineMeasure word;  // from just after the last space of the line
+  bool hasBreak = false;
+  size_t breakEnd = 0;
+  size_t breakResume = 0;
+
+  // Hands [lineStart, end) to the caller (unless it is empty) and starts the next line at `next`
+  const auto emit = [&](const size_t end, const size_t next) {
+    const bool more = end == lineStart || onLine(lineStart, buffer + (lineStart - bufferOffset), end - lineStart);
+    lineStart = next;
+    line = LineMeasure{};
+    hasBreak = false;
+    return more;
+  };
+
+  size_t pos = offset;
+  while (pos < fileSize) {
+    if (!fill(lineStart, pos + LOOKAHEAD)) {
+      LOG_ERR("TXP", "Failed to read at offset %zu", bufferOffset + bufferLength);
+      return lineStart;
+    }
+
+    if (pos - lineStart >= MAX_LINE_BYTES) {
+      if (!emit(pos, pos)) return pos;
+    }
+
+    const char* text = buffer + (pos - bufferOffset);
+    if (*text == '\n' || (*text == '\r' && (text[1] == '\n' || pos + 1 == fileSize))) {
+      const size_t next = pos + (*text == '\r' && text[1] == '\n' ? 2 : 1);
+      if (!emit(pos, next)) return next;
+      pos = next;
+      continue;
+    }
+    if (*text == '\0') {
+      // Stray NUL byte: utf8NextCodepoint() would not step over it
+      pos++;
+      continue;
+    }
+
+    const auto* cursor = reinterpret_cast<const unsigned char*>(text);
+    uint32_t cp = utf8NextCodepoint(&cursor);
+    const bool isCombining = utf8IsCombiningMark(cp);
+    if (!isCombining) {
+      const char* rest = reinterpret_cast<const char*>(cursor);
+      cp = font.applyLigatures(cp, rest);
+      cursor = reinterpret_cast<const unsigned char*>(rest);
+    }
+    const size_t next = bufferOffset + (reinterpret_cast<const char*>(cursor) - buffer);
+    const EpdGlyph* glyph = font.getGlyph(cp);
+    const bool hasContent = pos > lineStart;
+
+    if (cp == ' ' && hasContent) {
+      LineMeasure withSpace = line;
+      withSpace.add(font, cp, glyph, false);
+      if (withSpace.width() > maxWidth) {
+        // The space itself does not fit, so it is where this line breaks
+        if (!emit(pos, next)) return next;
+      } else {
+        line = withSpace;
+        word = LineMeasure{};
+        hasBreak = true;
+        breakEnd = pos;
+        breakResume = next;
+      }
+      pos = next;
+      continue;
+    }
+
+    line.add(font, cp, glyph, isCombining);
+    if (hasBreak) {
+      word.add(font, cp, glyph, isCombining);
+    }
+    if (hasContent && line.width() > maxWidth) {
+      if (hasBreak) {
+        // Wrap at the last space; the word after it carries over to the next line
+        if (!emit(breakEnd, breakResume)) return breakResume;
+        line = word;
+      }
+      if (line.width() > maxWidth && pos > lineStart) {
+        // No space to wrap at: cut before this codepoint
+        if (!emit(pos, pos)) return pos;
+        line.add(font, cp, glyph, isCombining);
+      }
+    }
+    pos = next;
+  }
+
+  emit(pos, pos);
+  return pos;
+}
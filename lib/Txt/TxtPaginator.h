@@ -0,0 +1,49 @@
+#pragma once
+
+#include <EpdFontFamily.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Word-wraps a plain text file into visual lines in a single streaming pass.
+//
+// The file is read through one reusable buffer and every codepoint is decoded and measured once: the width of the
+// current line (and of the text after its last space) is accumulated glyph by glyph with the same differential
+// rounding, kerning, ligature and combining-mark rules as EpdFont::getTextDimensions, so the result matches measuring
+// each finished line on its own. Lines break at the last space that fits, or before the first codepoint that does
+// not when there is no space; empty source lines produce no visual line.
+//
+// Layout only depends on where it starts, so any line start it reports can be used to resume later.
+class TxtPaginator {
+ public:
+  static constexpr size_t BUFFER_SIZE = 4096;
+
+  // Reads `length` bytes at `offset` of the file into `buffer`
+  using ReadFn = std::function<bool(uint8_t* buffer, size_t offset, size_t length)>;
+  // Receives one visual line; `text` is only valid during the call. Return false to stop after this line.
+  using LineFn = std::function<bool(size_t start, const char* text, size_t length)>;
+
+  TxtPaginator(const EpdFontFamily& font, int maxWidth, size_t fileSize, ReadFn read);
+  ~TxtPaginator();
+  TxtPaginator(const TxtPaginator&) = delete;
+  TxtPaginator& operator=(const TxtPaginator&) = delete;
+
+  bool isValid() const { return buffer != nullptr; }
+
+  // Lays out lines from `offset` (which must be a line start) until the end of the file or until `onLine` returns
+  // false. Returns the offset at which the next line starts.
+  size_t layout(size_t offset, const LineFn& onLine);
+
+ private:
+  const EpdFontFamily& font;
+  int maxWidth;
+  size_t fileSize;
+  ReadFn read;
+
+  char* buffer = nullptr;   // BUFFER_SIZE bytes plus a terminating NUL
+  size_t bufferOffset = 0;  // file offset of buffer[0]
+  size_t bufferLength = 0;
+
+  bool fill(size_t keepFrom, size_t needUntil);
+};
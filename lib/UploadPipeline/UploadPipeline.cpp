@@ -0,0 +1,180 @@
+#include "UploadPipeline.h"
+
+#include <cstring>
+#include <new>
+
+UploadPipeline::~UploadPipeline() { abort(); }
+
+bool UploadPipeline::begin(Sink& sink, const bool writer) {
+  if (active) {
+    return false;
+  }
+  // One block at a time, so a fragmented heap still yields some; fewer blocks only mean less overlap
+  blockCount = 0;
+  while (writer && blockCount < BLOCK_COUNT) {
+    blocks[blockCount] = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    if (!blocks[blockCount]) {
+      break;
+    }
+    blockCount++;
+  }
+
+  this->sink = &sink;
+  hasWriter = writer;
+  active = true;
+  currentBlock = END_MARKER;
+  for (auto& length : blockLength) length = 0;
+  failed = false;
+  aborted = false;
+  bytesReceived = 0;
+  bytesWritten = 0;
+  blockWrites = 0;
+  writeMs = 0;
+  maxWriteMs = 0;
+  stallMs = 0;
+  elapsedMs = 0;
+  stopped = false;
+  startMs = nowMs();
+
+  for (uint8_t block = 0; block < blockCount; block++) {
+    freeQueue.send(block);
+  }
+  return true;
+}
+
+bool UploadPipeline::store(const uint8_t* data, const size_t length) {
+  const uint32_t writeStart = nowMs();
+  const size_t written = sink->write(data, length);
+  const uint32_t duration = nowMs() - writeStart;
+  writeMs += duration;
+  if (duration > maxWriteMs) maxWriteMs = duration;
+  blockWrites++;
+  bytesWritten += written;
+  return written == length;
+}
+
+uint8_t UploadPipeline::receiveFreeBlock() {
+  uint8_t block;
+  while (!freeQueue.receive(block, WAIT_SLICE_MS)) {
+    if (onWait) onWait();
+  }
+  return block;
+}
+
+bool UploadPipeline::write(const uint8_t* data, size_t length) {
+  if (!active || failed) {
+    return false;
+  }
+
+  if (blockCount == 0) {
+    bytesReceived += length;
+    if (length > 0 && !store(data, length)) {
+      failed = true;
+    }
+    return !failed;
+  }
+
+  while (length > 0) {
+    if (currentBlock == END_MARKER) {
+      // All blocks may be queued for the writer: this wait is the back-pressure
+      const uint32_t waitStart = nowMs();
+      currentBlock = receiveFreeBlock();
+      stallMs += nowMs() - waitStart;
+      if (failed) {
+        return false;
+      }
+    }
+
+    size_t& used = blockLength[currentBlock];
+    const size_t chunk = length < BLOCK_SIZE - used ? length : BLOCK_SIZE - used;
+    memcpy(blocks[currentBlock] + used, data, chunk);
+    used += chunk;
+    data += chunk;
+    length -= chunk;
+    bytesReceived += chunk;
+
+    if (used == BLOCK_SIZE) {
+      filledQueue.send(currentBlock);
+      currentBlock = END_MARKER;
+    }
+  }
+  return true;
+}
+
+void UploadPipeline::stopWriter() {
+  if (hasWriter) {
+    filledQueue.send(END_MARKER);
+    // Blocks keep coming back until the writer has acknowledged the end marker
+    while (receiveFreeBlock() != END_MARKER) {
+    }
+  }
+  elapsedMs = nowMs() - startMs;
+  stopped = true;
+}
+
+bool UploadPipeline::finish() {
+  if (!active) {
+    return false;
+  }
+  if (currentBlock != END_MARKER && blockLength[currentBlock] > 0) {
+    filledQueue.send(currentBlock);
+    currentBlock = END_MARKER;
+  }
+  stopWriter();
+  const bool success = !failed && bytesWritten == bytesReceived;
+  release();
+  return success;
+}
+
+void UploadPipeline::abort() {
+  if (!active) {
+    return;
+  }
+  aborted = true;
+  stopWriter();
+  release();
+}
+
+void UploadPipeline::release() {
+  for (uint8_t block = 0; block < blockCount; block++) {
+    delete[] blocks[block];
+    blocks[block] = nullptr;
+  }
+  blockCount = 0;
+  active = false;
+  sink = nullptr;
+  currentBlock = END_MARKER;
+}
+
+void UploadPipeline::runWriter() {
+  while (true) {
+    uint8_t block;
+    if (!filledQueue.receive(block, WAIT_SLICE_MS)) {
+      continue;
+    }
+    if (block == END_MARKER) {
+      // The producer may free everything as soon as it sees this: touch nothing afterwards
+      freeQueue.send(END_MARKER);
+      return;
+    }
+
+    const size_t length = blockLength[block];
+    if (!failed && !aborted && !store(blocks[block], length)) {
+      failed = true;
+    }
+    blockLength[block] = 0;
+    freeQueue.send(block);
+  }
+}
+
+UploadPipeline::Stats UploadPipeline::getStats() const {
+  Stats stats;
+  stats.bytesReceived = bytesReceived;
+  stats.bytesWritten = bytesWritten;
+  stats.blockWrites = blockWrites;
+  stats.writeMs = writeMs;
+  stats.maxWriteMs = maxWriteMs;
+  stats.stallMs = stallMs;
+  stats.elapsedMs = stopped ? elapsedMs.load() : nowMs() - startMs;
+  return stats;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Moves upload data from the network handler to storage through a small pool of fixed-size blocks.
+//
+// The producer (WebServer / WebSocket callback) copies incoming bytes into the current block and hands full blocks to
+// a writer running on another task, so the network stack keeps receiving while the SD card is busy. When every block
+// is queued the producer waits for the writer (back-pressure: the TCP window fills and the sender slows down).
+//
+// Every write the sink sees is exactly BLOCK_SIZE bytes and starts at a multiple of BLOCK_SIZE, except the last one.
+// With 512-byte sectors and FAT clusters of 8 KB or more, no write straddles a cluster boundary.
+//
+// The blocks are allocated separately, and the pipeline runs with as many as the heap has room for. Without any block
+// (or without a writer task) it writes through: write() hands the data straight to the sink on the producer's task.
+//
+// The class has no platform dependencies: queues, clock and the wait hook are supplied by the caller (FreeRTOS on the
+// device, std::thread in the host tests).
+class UploadPipeline {
+ public:
+  static constexpr size_t BLOCK_SIZE = 8 * 1024;
+  static constexpr uint8_t BLOCK_COUNT = 3;
+  // Queues must hold BLOCK_COUNT + 1 entries (the blocks plus the end marker)
+  static constexpr uint8_t QUEUE_LENGTH = BLOCK_COUNT + 1;
+
+  // Receives full blocks on the writer task. Returns the number of bytes stored.
+  class Sink {
+   public:
+    virtual ~Sink() = default;
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+  };
+
+  // FIFO of block indices shared by the two tasks
+  class BlockQueue {
+   public:
+    virtual ~BlockQueue() = default;
+    virtual bool send(uint8_t block) = 0;
+    virtual bool receive(uint8_t& block, uint32_t timeoutMs) = 0;
+  };
+
+  struct Stats {
+    uint32_t bytesReceived = 0;
+    uint32_t bytesWritten = 0;
+    uint32_t blockWrites = 0;
+    uint32_t writeMs = 0;     // total time spent inside Sink::write
+    uint32_t maxWriteMs = 0;  // slowest single block write
+    uint32_t stallMs = 0;     // time the producer waited for a free block
+    uint32_t elapsedMs = 0;   // since begin(), frozen by finish()/abort()
+
+    uint32_t bytesPerSecond() const {
+      return elapsedMs > 0 ? static_cast<uint32_t>(static_cast<uint64_t>(bytesWritten) * 1000 / elapsedMs) : 0;
+    }
+  };
+
+  // nowMs: monotonic millisecond clock. onWait: called between waiting slices while the producer is blocked (watchdog
+  // feeding, yielding to the network stack).
+  UploadPipeline(BlockQueue& filledQueue, BlockQueue& freeQueue, uint32_t (*nowMs)(), void (*onWait)() = nullptr)
+      : filledQueue(filledQueue), freeQueue(freeQueue), nowMs(nowMs), onWait(onWait) {}
+  ~UploadPipeline();
+  UploadPipeline(const UploadPipeline&) = delete;
+  UploadPipeline& operator=(const UploadPipeline&) = delete;
+
+  // Producer side. begin() allocates the blocks; with `writer` set, the writer side must then run runWriter() until it
+  // returns. Without it the pipeline writes through. False only if the pipeline is already active.
+  bool begin(Sink& sink, bool writer = true);
+  // Copies `length` bytes into the pipeline, waiting for the writer when all blocks are queued. False once the sink
+  // failed.
+  bool write(const uint8_t* data, size_t length);
+  // Hands over the partial last block and waits until the writer has stored everything. True if all bytes reached the
+  // sink. Frees the blocks.
+  bool finish();
+  // Drops queued data and waits for the writer to stop. Frees the blocks.
+  void abort();
+
+  // Writer side: stores blocks until finish() or abort() is signalled.
+  void runWriter();
+
+  bool isActive() const { return active; }
+  bool isWritingThrough() const { return active && blockCount == 0; }
+  Stats getStats() const;
+
+ private:
+  static constexpr uint8_t END_MARKER = 0xFF;
+  static constexpr uint32_t WAIT_SLICE_MS = 100;
+
+  BlockQueue& filledQueue;
+  BlockQueue& freeQueue;
+  uint32_t (*nowMs)();
+  void (*onWait)();
+
+  Sink* sink = nullptr;
+  uint8_t* blocks[BLOCK_COUNT] = {};
+  uint8_t blockCount = 0;  // blocks allocated
+  bool hasWriter = false;
+  bool active = false;
+  size_t blockLength[BLOCK_COUNT] = {};
+  uint8_t currentBlock = END_MARKER;
+  uint32_t startMs = 0;
+
+  std::atomic<bool> failed{false};
+  std::atomic<bool> aborted{false};
+  std::atomic<uint32_t> bytesReceived{0};
+  std::atomic<uint32_t> bytesWritten{0};
+  std::atomic<uint32_t> blockWrites{0};
+  std::atomic<uint32_t> writeMs{0};
+  std::atomic<uint32_t> maxWriteMs{0};
+  std::atomic<uint32_t> stallMs{0};
+  std::atomic<uint32_t> elapsedMs{0};
+  std::atomic<bool> stopped{true};
+
+  uint8_t receiveFreeBlock();
+  bool store(const uint8_t* data, size_t length);
+  void stopWriter();
+  void release();
+};
@@ -0,0 +1,80 @@
+/**
+ * XtcPagePlanes.cpp
+ *
+ * Whole-byte conversion of XTG/XTH page bitmaps into frame buffer planes
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#include "XtcPagePlanes.h"
+
+#include <cstring>
+
+namespace xtc {
+
+namespace {
+// Four bytes at a time; the page buffers come from malloc and the frame buffer is word aligned
+template <typename Combine>
+void combinePlanes(const uint8_t* plane1, const uint8_t* plane2, const size_t size, uint8_t* frame,
+                   Combine combine) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    uint32_t a;
+    uint32_t b;
+    memcpy(&a, plane1 + i, 4);
+    memcpy(&b, plane2 + i, 4);
+    const uint32_t out = combine(a, b);
+    memcpy(frame + i, &out, 4);
+  }
+  for (; i < size; i++) {
+    frame[i] = static_cast<uint8_t>(combine(plane1[i], plane2[i]));
+  }
+}
+}  // namespace
+
+void composeXthPlane(const uint8_t* plane1, const uint8_t* plane2, const size_t size, const PlanePass pass,
+                     uint8_t* frame) {
+  // Pixel value = (bit1 << 1) | bit2: 0 = white, 1 = dark grey, 2 = light grey, 3 = black
+  switch (pass) {
+    case PlanePass::Bw:
+      combinePlanes(plane1, plane2, size, frame, [](const uint32_t a, const uint32_t b) { return ~(a | b); });
+      break;
+    case PlanePass::GrayLsb:
+      combinePlanes(plane1, plane2, size, frame, [](const uint32_t a, const uint32_t b) { return ~a & b; });
+      break;
+    case PlanePass::GrayMsb:
+      combinePlanes(plane1, plane2, size, frame, [](const uint32_t a, const uint32_t b) { return a ^ b; });
+      break;
+  }
+}
+
+uint64_t transpose8x8(uint64_t block) {
+  uint64_t t = (block ^ (block >> 7)) & 0x00AA00AA00AA00AAULL;
+  block ^= t ^ (t << 7);
+  t = (block ^ (block >> 14)) & 0x0000CCCC0000CCCCULL;
+  block ^= t ^ (t << 14);
+  t = (block ^ (block >> 28)) & 0x00000000F0F0F0F0ULL;
+  block ^= t ^ (t << 28);
+  return block;
+}
+
+void transposeXtgPage(const uint8_t* page, const uint16_t width, const uint16_t height, uint8_t* frame) {
+  const size_t rowBytes = width / 8;
+  const size_t frameRowBytes = height / 8;
+  for (size_t blockY = 0; blockY < frameRowBytes; blockY++) {
+    const uint8_t* rows = page + blockY * 8 * rowBytes;
+    for (size_t blockX = 0; blockX < rowBytes; blockX++) {
+      uint64_t block = 0;
+      for (size_t j = 0; j < 8; j++) {
+        block = block << 8 | rows[j * rowBytes + blockX];
+      }
+      block = transpose8x8(block);
+      // Column x of the page lands on frame row width - 1 - x; XTG and the frame both use 1 for white
+      for (size_t i = 0; i < 8; i++) {
+        const size_t x = blockX * 8 + i;
+        frame[(width - 1 - x) * frameRowBytes + blockY] = static_cast<uint8_t>(block >> (56 - 8 * i));
+      }
+    }
+  }
+}
+
+}  // namespace xtc
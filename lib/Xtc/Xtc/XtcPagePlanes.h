@@ -0,0 +1,37 @@
+/**
+ * XtcPagePlanes.h
+ *
+ * Whole-byte conversion of XTG/XTH page bitmaps into frame buffer planes
+ * XTC ebook support for CrossPoint Reader
+ *
+ * In portrait, the panel's physical rows are the page's columns: frame row r holds logical column (width - 1 - r),
+ * top pixel in the MSB of the first byte. XTH stores its planes in exactly that order, so each frame plane is a
+ * byte-wise boolean combination of the two page planes. XTG is row-major and becomes the same layout through an 8x8
+ * bit transpose per block. Both write every byte of the frame, so no clear is needed first.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace xtc {
+
+// Frame buffer contents for the three passes of a 2-bit page
+enum class PlanePass : uint8_t {
+  Bw,       // black wherever the pixel is not white (frame bit 0 = black)
+  GrayLsb,  // bit set for dark grey (XTH value 1)
+  GrayMsb,  // bit set for light and dark grey (XTH values 1 and 2)
+};
+
+// Builds one frame plane from the two XTH bit planes, `size` bytes each (= frame buffer size)
+void composeXthPlane(const uint8_t* plane1, const uint8_t* plane2, size_t size, PlanePass pass, uint8_t* frame);
+
+// Rotates a row-major XTG page into the portrait frame layout. Width and height must be multiples of 8; the frame
+// has `width` rows of height / 8 bytes.
+void transposeXtgPage(const uint8_t* page, uint16_t width, uint16_t height, uint8_t* frame);
+
+// Transposes an 8x8 bit block: byte j of the input (most significant first) is row j, bit 7 is column 0
+uint64_t transpose8x8(uint64_t block);
+
+}  // namespace xtc
@@ -11,6 +11,7 @@
 #include <HalStorage.h>
 #include <Logging.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace xtc {
@@ -22,7 +23,9 @@ XtcParser::XtcParser()
       m_bitDepth(1),
       m_hasChapters(false),
       m_chaptersLoaded(false),
-      m_lastError(XtcError::OK) {
+      m_lastError(XtcError::OK),
+      m_pageWindowStart(0),
+      m_pageWindowCount(0) {
   memset(&m_header, 0, sizeof(m_header));
 }
 
@@ -104,6 +107,8 @@ void XtcParser::close() {
   m_title.clear();
   m_author.clear();
   m_hasChapters = false;
+  m_pageWindowStart = 0;
+  m_pageWindowCount = 0;
   memset(&m_header, 0, sizeof(m_header));
 }
 
@@ -202,23 +207,18 @@ XtcError XtcParser::readFirstPageInfo() {
     return XtcError::CORRUPTED_HEADER;
   }
 
-  // Read only the first entry to get default page dimensions
-  // All other entries are read on-demand via readPageTableEntry()
+  // Load the first window of entries; it holds the default page dimensions
+  // Later entries are read on demand a window at a time via readPageTableEntry()
   // This avoids allocating pageCount * 16 bytes (e.g. 65KB for 4000+ pages)
-  PageTableEntry entry;
-  if (!m_file.seek(m_header.pageTableOffset)) {
-    LOG_DBG("XTC", "Failed to seek to page table at %llu", m_header.pageTableOffset);
-    return XtcError::READ_ERROR;
-  }
-  size_t bytesRead = m_file.read(reinterpret_cast<uint8_t*>(&entry), sizeof(PageTableEntry));
-  if (bytesRead != sizeof(PageTableEntry)) {
-    LOG_DBG("XTC", "Failed to read first page table entry");
-    return XtcError::READ_ERROR;
+  if (m_header.pageCount > 0) {
+    if (!loadPageWindow(0)) {
+      LOG_DBG("XTC", "Failed to read first page table entry");
+      return XtcError::READ_ERROR;
+    }
+    m_defaultWidth = m_pageWindow[0].width;
+    m_defaultHeight = m_pageWindow[0].height;
   }
 
-  m_defaultWidth = entry.width;
-  m_defaultHeight = entry.height;
-
   LOG_DBG("XTC", "Page table validated: %u pages, default %dx%d", m_header.pageCount, m_defaultWidth, m_defaultHeight);
   return XtcError::OK;
 }
@@ -228,30 +228,46 @@ bool XtcParser::readPageTableEntry(uint32_t pageIndex, PageInfo& info) {
     return false;
   }
 
+  if ((m_pageWindowCount == 0 || pageIndex < m_pageWindowStart ||
+       pageIndex >= m_pageWindowStart + m_pageWindowCount) &&
+      !loadPageWindow(pageIndex)) {
+    return false;
+  }
+
+  const PageTableEntry& entry = m_pageWindow[pageIndex - m_pageWindowStart];
+  info.offset = static_cast<uint32_t>(entry.dataOffset);
+  info.size = entry.dataSize;
+  info.width = entry.width;
+  info.height = entry.height;
+  info.bitDepth = m_bitDepth;
+  return true;
+}
+
+bool XtcParser::loadPageWindow(uint32_t pageIndex) {
   if (!ensureFileOpen()) {
     LOG_DBG("XTC", "Failed to reopen file for page table read");
     return false;
   }
 
-  // Seek to the specific page table entry on the SD card
-  const uint64_t entryOffset = m_header.pageTableOffset + static_cast<uint64_t>(pageIndex) * sizeof(PageTableEntry);
+  // Start a little before the requested page so paging backwards stays in the window too
+  const uint32_t start = pageIndex > PAGE_TABLE_WINDOW / 8 ? pageIndex - PAGE_TABLE_WINDOW / 8 : 0;
+  const uint16_t count = static_cast<uint16_t>(std::min<uint32_t>(PAGE_TABLE_WINDOW, m_header.pageCount - start));
+  const uint64_t entryOffset = m_header.pageTableOffset + static_cast<uint64_t>(start) * sizeof(PageTableEntry);
+  m_pageWindowCount = 0;
   if (!m_file.seek(entryOffset)) {
-    LOG_DBG("XTC", "Failed to seek to page table entry %lu at %llu", pageIndex, entryOffset);
+    LOG_DBG("XTC", "Failed to seek to page table entry %lu at %llu", start, entryOffset);
     return false;
   }
 
-  PageTableEntry entry;
-  size_t bytesRead = m_file.read(reinterpret_cast<uint8_t*>(&entry), sizeof(PageTableEntry));
-  if (bytesRead != sizeof(PageTableEntry)) {
-    LOG_DBG("XTC", "Failed to read page table entry %lu", pageIndex);
+  const size_t windowBytes = count * sizeof(PageTableEntry);
+  size_t bytesRead = m_file.read(reinterpret_cast<uint8_t*>(m_pageWindow), windowBytes);
+  if (bytesRead != windowBytes) {
+    LOG_DBG("XTC", "Failed to read page table entries %lu-%lu", start, start + count - 1);
     return false;
   }
 
-  info.offset = static_cast<uint32_t>(entry.dataOffset);
-  info.size = entry.dataSize;
-  info.width = entry.width;
-  info.height = entry.height;
-  info.bitDepth = m_bitDepth;
+  m_pageWindowStart = start;
+  m_pageWindowCount = count;
   return true;
 }
 
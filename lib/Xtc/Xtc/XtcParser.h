@@ -26,9 +26,15 @@ namespace xtc {
  *
  * The source file is kept closed between reads to free heap for rendering.
  * It is reopened on-demand for page table lookups and bitmap data reads.
+ *
+ * A window of up to PAGE_TABLE_WINDOW page table entries is kept in RAM, so
+ * turning pages costs one seek and read for the bitmap only. Books with no
+ * more pages than the window have their whole table resident.
  */
 class XtcParser {
  public:
+  static constexpr uint16_t PAGE_TABLE_WINDOW = 64;  // entries, 16 bytes each
+
   XtcParser();
   ~XtcParser();
 
@@ -97,6 +103,9 @@ class XtcParser {
   bool m_hasChapters;
   bool m_chaptersLoaded;
   XtcError m_lastError;
+  PageTableEntry m_pageWindow[PAGE_TABLE_WINDOW];
+  uint32_t m_pageWindowStart;
+  uint16_t m_pageWindowCount;  // 0 = nothing loaded
 
   // Internal helper functions
   XtcError readHeader();
@@ -105,6 +114,7 @@ class XtcParser {
   XtcError readAuthor();
   XtcError readChapters();
   bool readPageTableEntry(uint32_t pageIndex, PageInfo& info);
+  bool loadPageWindow(uint32_t pageIndex);
 
   // File handle management — reopen on demand, close after use
   bool ensureFileOpen();
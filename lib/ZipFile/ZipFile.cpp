@@ -442,6 +442,14 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
 }
 
 bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t chunkSize) {
+  return streamFile(filename, out, chunkSize, false);
+}
+
+bool ZipFile::readFilePrefixToStream(const char* filename, Print& out, const size_t chunkSize) {
+  return streamFile(filename, out, chunkSize, true);
+}
+
+bool ZipFile::streamFile(const char* filename, Print& out, const size_t chunkSize, const bool stopOnShortWrite) {
   const ScopedOpenClose zip{*this};
   if (!zip) return false;
 
@@ -473,8 +481,9 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
       }
 
       if (out.write(buffer, dataRead) != dataRead) {
-        LOG_ERR("ZIP", "Failed to write all output bytes to stream");
         free(buffer);
+        if (stopOnShortWrite) return true;
+        LOG_ERR("ZIP", "Failed to write all output bytes to stream");
         return false;
       }
       remaining -= dataRead;
@@ -528,7 +537,9 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
 
       if (produced > 0) {
         if (out.write(outputBuffer, produced) != produced) {
-          LOG_ERR("ZIP", "Failed to write all output bytes to stream");
+          // The sink has seen enough: stop inflating the rest of the member
+          success = stopOnShortWrite;
+          if (!success) LOG_ERR("ZIP", "Failed to write all output bytes to stream");
           break;
         }
       }
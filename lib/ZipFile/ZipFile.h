@@ -50,6 +50,7 @@ class ZipFile {
   bool loadFileStatSlim(const char* filename, FileStatSlim* fileStat);
   long getDataOffset(const FileStatSlim& fileStat);
   bool loadZipDetails();
+  bool streamFile(const char* filename, Print& out, size_t chunkSize, bool stopOnShortWrite);
 
  public:
   explicit ZipFile(const std::string& filePath) : filePath(filePath) {}
@@ -69,4 +70,7 @@ class ZipFile {
   // These functions will open and close the zip as needed
   uint8_t* readFileToMemory(const char* filename, size_t* size = nullptr, bool trailingNullByte = false);
   bool readFileToStream(const char* filename, Print& out, size_t chunkSize);
+  // Like readFileToStream, but a short write from `out` means it has all it needs: reading stops there and counts as
+  // success. Used to sniff headers without inflating whole members.
+  bool readFilePrefixToStream(const char* filename, Print& out, size_t chunkSize);
 };
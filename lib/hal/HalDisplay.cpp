@@ -1,5 +1,6 @@
 #include <HalDisplay.h>
 #include <HalGPIO.h>
+#include <Perf.h>
 
 // Global HalDisplay instance
 HalDisplay display;
@@ -55,6 +56,14 @@ void HalDisplay::displayBuffer(HalDisplay::RefreshMode mode, bool turnOffScreen)
     einkDisplay.requestResync(1);
   }
 
+  PERF_SCOPE(Refresh);
+  if (mode == RefreshMode::FULL_REFRESH) {
+    PERF_COUNT(RefreshFull, 1);
+  } else if (mode == RefreshMode::HALF_REFRESH) {
+    PERF_COUNT(RefreshHalf, 1);
+  } else {
+    PERF_COUNT(RefreshFast, 1);
+  }
   einkDisplay.displayBuffer(convertRefreshMode(mode), turnOffScreen);
 }
 
@@ -80,7 +89,11 @@ void HalDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) { einkDisplay
 
 void HalDisplay::cleanupGrayscaleBuffers(const uint8_t* bwBuffer) { einkDisplay.cleanupGrayscaleBuffers(bwBuffer); }
 
-void HalDisplay::displayGrayBuffer(bool turnOffScreen) { einkDisplay.displayGrayBuffer(turnOffScreen); }
+void HalDisplay::displayGrayBuffer(bool turnOffScreen) {
+  PERF_SCOPE(Refresh);
+  PERF_COUNT(RefreshGray, 1);
+  einkDisplay.displayGrayBuffer(turnOffScreen);
+}
 
 uint16_t HalDisplay::getDisplayWidth() const { return einkDisplay.getDisplayWidth(); }
 
@@ -3,6 +3,7 @@
 
 #include <FS.h>  // need to be included before SdFat.h for compatibility with FS.h's File class
 #include <Logging.h>
+#include <Perf.h>
 #include <SDCardManager.h>
 
 #include <cassert>
@@ -142,10 +143,44 @@ bool HalFile::seekCur(int64_t offset) { HAL_FILE_WRAPPED_CALL(seekCur, offset);
 bool HalFile::seekSet(size_t offset) { HAL_FILE_WRAPPED_CALL(seekSet, offset); }
 int HalFile::available() const { HAL_FILE_WRAPPED_CALL(available, ); }
 size_t HalFile::position() const { HAL_FILE_WRAPPED_CALL(position, ); }
-int HalFile::read(void* buf, size_t count) { HAL_FILE_WRAPPED_CALL(read, buf, count); }
-int HalFile::read() { HAL_FILE_WRAPPED_CALL(read, ); }
-size_t HalFile::write(const void* buf, size_t count) { HAL_FILE_WRAPPED_CALL(write, buf, count); }
-size_t HalFile::write(uint8_t b) { HAL_FILE_WRAPPED_CALL(write, b); }
+// The byte counters count what the card actually transferred, so short reads at the end of a file don't inflate them
+int HalFile::read(void* buf, size_t count) {
+  HalStorage::StorageLock lock;
+  assert(impl != nullptr);
+  const int n = impl->file.read(buf, count);
+  PERF_COUNT(SdReadOps, 1);
+  PERF_COUNT(SdReadBytes, n > 0 ? n : 0);
+  return n;
+}
+int HalFile::read() {
+  HalStorage::StorageLock lock;
+  assert(impl != nullptr);
+  const int c = impl->file.read();
+  PERF_COUNT(SdReadOps, 1);
+  PERF_COUNT(SdReadBytes, c >= 0 ? 1 : 0);
+  return c;
+}
+size_t HalFile::write(const void* buf, size_t count) {
+  HalStorage::StorageLock lock;
+  assert(impl != nullptr);
+  const size_t n = impl->file.write(buf, count);
+  PERF_COUNT(SdWriteOps, 1);
+  PERF_COUNT(SdWriteBytes, n);
+  return n;
+}
+size_t HalFile::write(uint8_t b) {
+  HalStorage::StorageLock lock;
+  assert(impl != nullptr);
+  const size_t n = impl->file.write(b);
+  PERF_COUNT(SdWriteOps, 1);
+  PERF_COUNT(SdWriteBytes, n);
+  return n;
+}
+bool HalFile::preAllocate(size_t length) { HAL_FILE_WRAPPED_CALL(preAllocate, length); }
+bool HalFile::truncate(size_t length) { HAL_FILE_WRAPPED_CALL(truncate, length); }
+bool HalFile::getModifyDateTime(uint16_t* date, uint16_t* time) {
+  HAL_FILE_WRAPPED_CALL(getModifyDateTime, date, time);
+}
 bool HalFile::rename(const char* newPath) { HAL_FILE_WRAPPED_CALL(rename, newPath); }
 bool HalFile::isDirectory() const { HAL_FILE_FORWARD_CALL(isDirectory, ); }  // already thread-safe, no need to wrap
 void HalFile::rewindDirectory() { HAL_FILE_WRAPPED_CALL(rewindDirectory, ); }
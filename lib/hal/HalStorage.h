@@ -85,6 +85,12 @@ class HalFile : public Print {
   int read();  // read a single byte
   size_t write(const void* buf, size_t count);
   size_t write(uint8_t b) override;
+  // Reserves contiguous clusters for a file about to be written sequentially (the file must be empty)
+  bool preAllocate(size_t length);
+  // Cuts the file to `length` bytes
+  bool truncate(size_t length);
+  // Last-modified stamp in FAT format (date: bits 15-9 year-1980, 8-5 month, 4-0 day; time: 15-11 h, 10-5 min, 4-0 s/2)
+  bool getModifyDateTime(uint16_t* date, uint16_t* time);
   bool rename(const char* newPath);
   bool isDirectory() const;
   void rewindDirectory();
@@ -1,5 +1,6 @@
 #include "HalSystem.h"
 
+#include <cstring>
 #include <string>
 
 #include "Arduino.h"
@@ -11,9 +12,22 @@
 #include "esp_private/panic_internal.h"
 
 #define MAX_PANIC_STACK_DEPTH 32
+#define MAX_BOOT_PHASES 12
+
+struct BootPhase {
+  char name[12];
+  uint32_t ms;
+};
 
 RTC_NOINIT_ATTR char panicMessage[256];
 RTC_NOINIT_ATTR HalSystem::StackFrame panicStack[MAX_PANIC_STACK_DEPTH];
+RTC_NOINIT_ATTR BootPhase bootPhases[MAX_BOOT_PHASES];
+RTC_NOINIT_ATTR uint32_t bootPhaseCount;
+
+namespace {
+// Phases of the boot that crashed, copied out of RTC memory before this boot records its own
+std::string crashedBootPhases;
+}  // namespace
 
 extern "C" {
 
@@ -77,6 +91,7 @@ void begin() {
   if (!isRebootFromPanic()) {
     clearPanic();
   } else {
+    crashedBootPhases = getBootPhases();
     // Panic reboot: preserve logs and panic info, but clamp logHead in case the
     // panic occurred before begin() ever ran (e.g. in a static constructor).
     // If logHead was out of range, logMessages is also garbage — clear it so
@@ -85,6 +100,7 @@ void begin() {
       clearLastLogs();
     }
   }
+  bootPhaseCount = 0;
 }
 
 void checkPanic() {
@@ -117,6 +133,7 @@ std::string getPanicInfo(bool full) {
 
     info += "CrossPoint version: " CROSSPOINT_VERSION;
     info += "\n\nPanic reason: " + std::string(panicMessage);
+    info += "\n\nBoot phases (ms): " + crashedBootPhases;
     info += "\n\nLast logs:\n" + getLastLogs();
     info += "\n\nStack memory:\n";
 
@@ -140,6 +157,31 @@ std::string getPanicInfo(bool full) {
   }
 }
 
+void markBootPhase(const char* name) {
+  if (bootPhaseCount >= MAX_BOOT_PHASES) return;
+  BootPhase& phase = bootPhases[bootPhaseCount];
+  strncpy(phase.name, name, sizeof(phase.name) - 1);
+  phase.name[sizeof(phase.name) - 1] = '\0';
+  phase.ms = millis();
+  bootPhaseCount++;
+}
+
+std::string getBootPhases() {
+  // RTC memory is garbage after a power-on reset that skipped begin()
+  const uint32_t count = bootPhaseCount <= MAX_BOOT_PHASES ? bootPhaseCount : 0;
+  std::string phases;
+  char buffer[32];
+  for (uint32_t i = 0; i < count; i++) {
+    const BootPhase& phase = bootPhases[i];
+    char name[sizeof(phase.name)];
+    memcpy(name, phase.name, sizeof(name));
+    name[sizeof(name) - 1] = '\0';
+    snprintf(buffer, sizeof(buffer), "%s%s=%lu", i > 0 ? " " : "", name, static_cast<unsigned long>(phase.ms));
+    phases += buffer;
+  }
+  return phases;
+}
+
 bool isRebootFromPanic() {
   const auto resetReason = esp_reset_reason();
   return resetReason == ESP_RST_PANIC || resetReason == ESP_RST_CPU_LOCKUP;
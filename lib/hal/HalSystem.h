@@ -17,4 +17,10 @@ void clearPanic();
 
 std::string getPanicInfo(bool full = false);
 bool isRebootFromPanic();
+
+// Records the end of a boot phase (milliseconds since reset). Kept in RTC memory so a crash report written after a
+// panic reboot shows how far the crashed boot got. Names are cut to 11 characters.
+void markBootPhase(const char* name);
+// "name=ms" pairs recorded so far in this boot
+std::string getBootPhases();
 }  // namespace HalSystem
@@ -31,6 +31,90 @@ def _symbol_from_output(path: pathlib.Path) -> str:
     return name
 
 
+NO_NODE = 0xFFFFFFFF
+HAS_LEVELS_FLAG = 0x80000000
+NO_INDEX = 0xFF
+
+
+def _decode_delta(buf: bytes, stride: int) -> int:
+    # Mirror of decodeDelta() in LiangHyphenation.cpp.
+    if stride == 1:
+        return buf[0] - 256 if buf[0] >= 0x80 else buf[0]
+    if stride == 2:
+        value = (buf[0] << 8) | buf[1]
+        return value - 0x10000 if value >= 0x8000 else value
+    return ((buf[0] << 16) | (buf[1] << 8) | buf[2]) - (1 << 23)
+
+
+def _decode_node(data: bytes, addr: int) -> tuple[bool, dict[int, int]]:
+    # Mirror of decodeState() in LiangHyphenation.cpp: returns (has_levels, {label: child_addr}).
+    header = data[addr]
+    pos = addr + 1
+    has_levels = (header >> 7) != 0
+    stride = ((header >> 5) & 0x03) or 1
+    count = header & 0x1F
+    if count == 31:
+        count = data[pos]
+        pos += 1
+    if has_levels:
+        pos += 2
+    labels = data[pos : pos + count]
+    pos += count
+    children = {}
+    for i, label in enumerate(labels):
+        delta = _decode_delta(data[pos + i * stride : pos + (i + 1) * stride], stride)
+        children[label] = addr + delta
+    return has_levels, children
+
+
+def _table_entry(data: bytes, addr: int) -> int:
+    # Node address with the "has levels" flag folded into the top bit so the runtime can skip decoding
+    # level-less nodes entirely.
+    has_levels, _ = _decode_node(data, addr)
+    return addr | HAS_LEVELS_FLAG if has_levels else addr
+
+
+def _build_fast_path(data: bytes, root: int) -> tuple[list[int], list[int], list[int], list[int], int]:
+    # Flatten the first two trie levels:
+    #   root_table[256]      - depth-1 node for every first byte
+    #   rows[256]            - row of a first byte in level1_table
+    #   columns[256]         - column of a second byte in level1_table
+    #   level1_table[r * c]  - depth-2 node for every (first, second) byte pair
+    # Every root child gets a row; the column alphabet is limited to bytes that actually occur at depth 1,
+    # which keeps the dense table to a few KB per language.
+    _, root_children = _decode_node(data, root)
+    first_bytes = sorted(root_children)
+    level1_children = {b: _decode_node(data, root_children[b])[1] for b in first_bytes}
+    alphabet = sorted({label for children in level1_children.values() for label in children})
+    if len(first_bytes) >= NO_INDEX or len(alphabet) >= NO_INDEX:
+        raise ValueError('Too many distinct trie labels for the level-1 table')
+
+    root_table = [NO_NODE] * 256
+    rows = [NO_INDEX] * 256
+    columns = [NO_INDEX] * 256
+    for row, first in enumerate(first_bytes):
+        root_table[first] = _table_entry(data, root_children[first])
+        rows[first] = row
+    for column, label in enumerate(alphabet):
+        columns[label] = column
+
+    level1_table = [NO_NODE] * (len(first_bytes) * len(alphabet))
+    for row, first in enumerate(first_bytes):
+        for label, child in level1_children[first].items():
+            level1_table[row * len(alphabet) + columns[label]] = _table_entry(data, child)
+    return root_table, rows, columns, level1_table, len(alphabet)
+
+
+def _format_words(values: list[int], per_line: int = 8) -> str:
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = ', '.join(f"0x{v:08X}u" for v in values[i : i + per_line])
+        lines.append(f"    {chunk},")
+    if not lines:
+        lines.append("    0xFFFFFFFFu,")
+    return '\n'.join(lines)
+
+
 def write_header(path: pathlib.Path, blob: bytes, symbol: str) -> None:
     # Emit a constexpr header containing the raw bytes plus a SerializedHyphenationPatterns descriptor.
     # The binary format has:
@@ -50,10 +134,12 @@ def write_header(path: pathlib.Path, blob: bytes, symbol: str) -> None:
     # Remove the 4-byte root address and adjust the offset
     bytes_literal = _format_bytes(blob[4:])
     root_addr_new = root_addr - 4
+    root_table, rows, columns, level1_table, column_count = _build_fast_path(blob[4:], root_addr_new)
 
     path.parent.mkdir(parents=True, exist_ok=True)
     data_symbol = f"{symbol}_trie_data"
     patterns_symbol = f"{symbol}_patterns"
+    fast_path_symbol = f"{symbol}_fast_path"
 
     content = f"""#pragma once
 
@@ -67,10 +153,36 @@ alignas(4) constexpr uint8_t {data_symbol}[] = {{
 {bytes_literal}
 }};
 
+// Flattened root and first-level transitions (see SerializedHyphenationFastPath).
+alignas(4) constexpr uint32_t {symbol}_root_table[256] = {{
+{_format_words(root_table)}
+}};
+
+constexpr uint8_t {symbol}_level1_rows[256] = {{
+{_format_bytes(bytes(rows))}
+}};
+
+constexpr uint8_t {symbol}_level1_columns[256] = {{
+{_format_bytes(bytes(columns))}
+}};
+
+alignas(4) constexpr uint32_t {symbol}_level1_table[] = {{
+{_format_words(level1_table)}
+}};
+
+constexpr SerializedHyphenationFastPath {fast_path_symbol} = {{
+    {symbol}_root_table,
+    {symbol}_level1_rows,
+    {symbol}_level1_columns,
+    {symbol}_level1_table,
+    {column_count},
+}};
+
 constexpr SerializedHyphenationPatterns {patterns_symbol} = {{
     {f"0x{root_addr_new:02X}"}u,
     {data_symbol},
     sizeof({data_symbol}),
+    &{fast_path_symbol},
 }};
 """
     path.write_text(content)
@@ -0,0 +1,182 @@
+#include "BookIngestQueue.h"
+
+#include <Arduino.h>
+#include <Epub.h>
+#include <Epub/Section.h>
+#include <FsHelpers.h>
+#include <GfxRenderer.h>
+#include <HalStorage.h>
+#include <Logging.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "CrossPointSettings.h"
+#include "LibraryCatalog.h"
+#include "activities/RenderLock.h"
+#include "activities/reader/ReaderUtils.h"
+#include "components/UITheme.h"
+
+namespace {
+// One book path per line
+constexpr char INGEST_QUEUE_FILE[] = "/.crosspoint/ingest.txt";
+constexpr size_t MAX_QUEUED_BOOKS = 64;
+}  // namespace
+
+BookIngestQueue BookIngestQueue::instance;
+
+void BookIngestQueue::loadFromFile() {
+  loaded = true;
+  pending.clear();
+  if (!Storage.exists(INGEST_QUEUE_FILE)) {
+    return;
+  }
+
+  const String contents = Storage.readFile(INGEST_QUEUE_FILE);
+  const char* line = contents.c_str();
+  while (*line) {
+    const char* end = strchr(line, '\n');
+    const size_t length = end ? end - line : strlen(line);
+    if (length > 0 && pending.size() < MAX_QUEUED_BOOKS) {
+      pending.emplace_back(line, length);
+    }
+    line += end ? length + 1 : length;
+  }
+  LOG_DBG("ING", "Loaded %d queued books", pending.size());
+}
+
+bool BookIngestQueue::saveToFile() const {
+  if (pending.empty()) {
+    return !Storage.exists(INGEST_QUEUE_FILE) || Storage.remove(INGEST_QUEUE_FILE);
+  }
+
+  Storage.mkdir("/.crosspoint");
+  String contents;
+  for (const auto& path : pending) {
+    contents += path.c_str();
+    contents += '\n';
+  }
+  return Storage.writeFile(INGEST_QUEUE_FILE, contents);
+}
+
+void BookIngestQueue::enqueue(const std::string& path) {
+  if (!FsHelpers::hasEpubExtension(path)) {
+    return;
+  }
+  if (!loaded) {
+    loadFromFile();
+  }
+
+  // A book replaced while it was being prepared starts over from the new file
+  if (current && current->getPath() == path) {
+    current.reset();
+  }
+  if (std::find(pending.begin(), pending.end(), path) != pending.end()) {
+    return;
+  }
+  if (pending.size() >= MAX_QUEUED_BOOKS) {
+    LOG_DBG("ING", "Queue full, not preparing %s", path.c_str());
+    return;
+  }
+
+  pending.push_back(path);
+  saveToFile();
+  LOG_DBG("ING", "Queued %s", path.c_str());
+}
+
+bool BookIngestQueue::hasPending() {
+  if (!loaded) {
+    loadFromFile();
+  }
+  return current || !pending.empty();
+}
+
+bool BookIngestQueue::startNextBook() {
+  while (!pending.empty()) {
+    const std::string path = pending.front();
+    pending.erase(pending.begin());
+    saveToFile();
+
+    if (!Storage.exists(path.c_str())) {
+      LOG_DBG("ING", "Skipping %s, no longer on the card", path.c_str());
+      continue;
+    }
+    current = std::make_shared<Epub>(path, "/.crosspoint");
+    stage = Stage::Load;
+    return true;
+  }
+  return false;
+}
+
+void BookIngestQueue::buildFirstSection(GfxRenderer& renderer) const {
+  // The viewport depends on the reader orientation, which only the render lock may switch. Layout itself reads the
+  // renderer's constant font metrics and goes through the storage mutex, so the chapter is built without the lock and
+  // the render task keeps drawing meanwhile.
+  ReaderUtils::EpubViewport viewport;
+  {
+    RenderLock lock;
+    const auto previousOrientation = renderer.getOrientation();
+    ReaderUtils::applyOrientation(renderer, SETTINGS.orientation);
+    viewport = ReaderUtils::getEpubViewport(renderer, false);
+    renderer.setOrientation(previousOrientation);
+  }
+
+  // Same chapter the reader opens a new book at
+  Section section(current, current->getSpineIndexForTextReference(), renderer);
+  if (!section.loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                               SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewport.width,
+                               viewport.height, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
+                               SETTINGS.imageRendering) &&
+      !section.createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                                 SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewport.width,
+                                 viewport.height, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
+                                 SETTINGS.imageRendering)) {
+    LOG_ERR("ING", "Failed to build first section of %s", current->getPath().c_str());
+  }
+}
+
+bool BookIngestQueue::processStep(GfxRenderer& renderer) {
+  if (!hasPending()) {
+    return false;
+  }
+  if (!current && !startNextBook()) {
+    return false;
+  }
+
+  const unsigned long start = millis();
+  switch (stage) {
+    case Stage::Load:
+      // Same options as opening the book in the reader, so the cached book.bin and CSS are reused as they are
+      if (!current->load(true, SETTINGS.embeddedStyle == 0)) {
+        LOG_ERR("ING", "Failed to load %s", current->getPath().c_str());
+        current.reset();
+        return true;
+      }
+      stage = Stage::Covers;
+      break;
+
+    case Stage::Covers: {
+      Epub::CoverImageRequest request;
+      request.thumbHeights = UITheme::getInstance().getCoverThumbHeights();
+      if (SETTINGS.sleepScreen == CrossPointSettings::SLEEP_SCREEN_MODE::COVER ||
+          SETTINGS.sleepScreen == CrossPointSettings::SLEEP_SCREEN_MODE::COVER_CUSTOM) {
+        const bool cropped = SETTINGS.sleepScreenCoverMode == CrossPointSettings::SLEEP_SCREEN_COVER_MODE::CROP;
+        request.cover = !cropped;
+        request.croppedCover = cropped;
+      }
+      current->generateCoverImages(request);
+      LIBRARY.noteCached(current->getPath(), current->getTitle(), current->getAuthor(),
+                         LibraryCatalog::METADATA | LibraryCatalog::COVER);
+      stage = Stage::FirstSection;
+      break;
+    }
+
+    case Stage::FirstSection:
+      buildFirstSection(renderer);
+      LOG_DBG("ING", "Prepared %s", current->getPath().c_str());
+      current.reset();
+      break;
+  }
+  LOG_DBG("ING", "Stage done in %lu ms", millis() - start);
+  return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+class Epub;
+class GfxRenderer;
+
+// Books that arrived over the network (web upload, WebDAV, OPDS download, Calibre) and have not been prepared yet.
+//
+// Preparing a book builds what its first open would otherwise build: book.bin and the CSS cache, the cover and home
+// screen thumbnails, and the section of the chapter the reader starts at, laid out for the current reader settings.
+// The queue is kept on the SD card so books received just before sleep are still prepared after wake.
+class BookIngestQueue {
+  // Static instance
+  static BookIngestQueue instance;
+
+  enum class Stage : uint8_t { Load, Covers, FirstSection };
+
+  std::vector<std::string> pending;
+  bool loaded = false;
+
+  // Book being prepared, already removed from `pending` (a book that crashes the preparation is not retried)
+  std::shared_ptr<Epub> current;
+  Stage stage = Stage::Load;
+
+  void loadFromFile();
+  bool saveToFile() const;
+  bool startNextBook();
+  void buildFirstSection(GfxRenderer& renderer) const;
+
+ public:
+  // Quiet time (no input, no transfer) before preparation starts, so it never competes with what the user is doing
+  static constexpr unsigned long IDLE_DELAY_MS = 2000;
+
+  static BookIngestQueue& getInstance() { return instance; }
+
+  // Queues a freshly written book. Call after its old caches were cleared. Non-EPUB files are ignored.
+  void enqueue(const std::string& path);
+  bool hasPending();
+
+  // Runs one preparation stage (one heavy operation: parse, cover decode or chapter layout). Returns false when there
+  // was nothing left to do. Must run on the main loop task; takes the render lock only to read the reader viewport.
+  bool processStep(GfxRenderer& renderer);
+};
+
+// Helper macro to access the ingest queue
+#define INGEST_QUEUE BookIngestQueue::getInstance()
@@ -0,0 +1,230 @@
+#include "BootSnapshot.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <ObfuscationUtils.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "CrossPointSettings.h"
+#include "CrossPointState.h"
+
+namespace {
+constexpr char SNAPSHOT_FILE[] = "/.crosspoint/boot.bin";
+constexpr char SNAPSHOT_FILE_TMP[] = "/.crosspoint/boot.tmp";
+constexpr char SETTINGS_FILE_JSON[] = "/.crosspoint/settings.json";
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53425043;  // "CPBS"
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+constexpr uint8_t STATE_VERSION = 1;
+constexpr size_t MAX_PAYLOAD = 2048;
+
+struct Header {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t stateVersion;
+  uint16_t settingsSize;          // sizeof(CrossPointSettings) of the writing firmware
+  uint32_t firmwareHash;          // of CROSSPOINT_VERSION (branch + commit on development builds)
+  uint32_t settingsJsonSize;      // settings.json as last written or read by the device,
+  uint32_t settingsJsonModified;  // FAT date << 16 | FAT time
+  uint32_t payloadLength;         // state, then the settings image
+  uint32_t checksum;              // of the payload
+};
+static_assert(sizeof(Header) == 28, "Header layout is part of the file format");
+
+// The settings image is a plain copy of the object, which is all uint8_t options and fixed char arrays
+static_assert(std::is_trivially_copyable_v<CrossPointSettings>, "Settings image is copied with memcpy");
+constexpr size_t SECRET_OFFSET = offsetof(CrossPointSettings, opdsPassword);
+constexpr size_t SECRET_LENGTH = sizeof(CrossPointSettings::opdsPassword);
+
+// settings.json size and time as the snapshot records them, so state saves don't have to look at the file
+bool jsonStampKnown = false;
+uint32_t jsonSize = 0;
+uint32_t jsonModified = 0;
+
+uint32_t fnv1a(const void* data, const size_t length, uint32_t hash = 2166136261u) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+uint32_t firmwareHash() { return fnv1a(CROSSPOINT_VERSION, sizeof(CROSSPOINT_VERSION) - 1); }
+
+bool statFile(const char* path, uint32_t& size, uint32_t& modified) {
+  FsFile file = Storage.open(path);
+  if (!file) return false;
+  uint16_t date = 0;
+  uint16_t time = 0;
+  file.getModifyDateTime(&date, &time);
+  size = file.size();
+  modified = static_cast<uint32_t>(date) << 16 | time;
+  file.close();
+  return true;
+}
+
+template <typename T>
+void append(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool take(const std::string& in, size_t& pos, T& value) {
+  if (pos + sizeof(T) > in.size()) return false;
+  memcpy(&value, in.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+void appendState(std::string& out, const CrossPointState& state) {
+  const auto pathLength = static_cast<uint16_t>(state.openEpubPath.size());
+  append(out, pathLength);
+  out.append(state.openEpubPath, 0, pathLength);
+  append(out, state.recentSleepImages);
+  append(out, state.recentSleepPos);
+  append(out, state.recentSleepFill);
+  append(out, state.readerActivityLoadCount);
+  append(out, state.lastSleepFromReader);
+}
+
+bool takeState(const std::string& in, size_t& pos, CrossPointState& state) {
+  uint16_t pathLength = 0;
+  if (!take(in, pos, pathLength) || pos + pathLength > in.size()) return false;
+  std::string path = in.substr(pos, pathLength);
+  pos += pathLength;
+
+  uint16_t recentSleepImages[CrossPointState::SLEEP_RECENT_COUNT];
+  uint8_t recentSleepPos = 0;
+  uint8_t recentSleepFill = 0;
+  uint8_t readerActivityLoadCount = 0;
+  bool lastSleepFromReader = false;
+  if (!take(in, pos, recentSleepImages) || !take(in, pos, recentSleepPos) || !take(in, pos, recentSleepFill) ||
+      !take(in, pos, readerActivityLoadCount) || !take(in, pos, lastSleepFromReader)) {
+    return false;
+  }
+
+  state.openEpubPath = std::move(path);
+  memcpy(state.recentSleepImages, recentSleepImages, sizeof(recentSleepImages));
+  state.recentSleepPos = recentSleepPos % CrossPointState::SLEEP_RECENT_COUNT;
+  state.recentSleepFill = std::min<uint8_t>(recentSleepFill, CrossPointState::SLEEP_RECENT_COUNT);
+  state.readerActivityLoadCount = readerActivityLoadCount;
+  state.lastSleepFromReader = lastSleepFromReader;
+  return true;
+}
+
+// The legacy OPDS password is kept XOR-ed with the hardware key, as in the other stores
+void transformSecret(std::string& image) {
+  std::string secret = image.substr(SECRET_OFFSET, SECRET_LENGTH);
+  obfuscation::xorTransform(secret);
+  image.replace(SECRET_OFFSET, SECRET_LENGTH, secret);
+}
+
+bool readSnapshot(const char* path, Header& header, std::string& payload) {
+  FsFile file;
+  if (!Storage.exists(path) || !Storage.openFileForRead("BSN", path, file)) {
+    return false;
+  }
+  if (file.read(&header, sizeof(header)) != static_cast<int>(sizeof(header)) || header.magic != SNAPSHOT_MAGIC ||
+      header.version != SNAPSHOT_VERSION || header.payloadLength > MAX_PAYLOAD) {
+    LOG_ERR("BSN", "Ignoring snapshot with unknown format");
+    file.close();
+    return false;
+  }
+  payload.resize(header.payloadLength);
+  const bool complete = file.read(payload.data(), payload.size()) == static_cast<int>(payload.size());
+  file.close();
+  if (!complete || fnv1a(payload.data(), payload.size()) != header.checksum) {
+    LOG_ERR("BSN", "Ignoring damaged snapshot");
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+void BootSnapshot::load() {
+  Header header{};
+  std::string payload;
+  // A save cut short between removing boot.bin and renaming boot.tmp leaves only the new snapshot
+  const bool found = readSnapshot(SNAPSHOT_FILE, header, payload) || readSnapshot(SNAPSHOT_FILE_TMP, header, payload);
+
+  size_t pos = 0;
+  const bool stateLoaded = found && header.stateVersion == STATE_VERSION && takeState(payload, pos, APP_STATE);
+
+  bool settingsLoaded = false;
+  if (stateLoaded && header.settingsSize == sizeof(CrossPointSettings) && header.firmwareHash == firmwareHash() &&
+      pos + sizeof(CrossPointSettings) == payload.size()) {
+    const bool hasJson = statFile(SETTINGS_FILE_JSON, jsonSize, jsonModified);
+    if (!hasJson || (jsonSize == header.settingsJsonSize && jsonModified == header.settingsJsonModified)) {
+      jsonStampKnown = true;
+      std::string image = payload.substr(pos);
+      transformSecret(image);
+      memcpy(static_cast<void*>(&SETTINGS), image.data(), image.size());
+      settingsLoaded = true;
+    } else {
+      LOG_INF("BSN", "settings.json changed, importing it");
+    }
+  }
+
+  if (!settingsLoaded) {
+    SETTINGS.loadFromFile();
+  }
+  if (!stateLoaded) {
+    APP_STATE.loadFromFile();
+  }
+  if (!settingsLoaded || !stateLoaded) {
+    save();
+  }
+  LOG_DBG("BSN", "Boot state loaded (snapshot: settings %d, state %d)", settingsLoaded, stateLoaded);
+}
+
+bool BootSnapshot::save(const bool settingsJsonWritten) {
+  std::string payload;
+  payload.reserve(64 + APP_STATE.openEpubPath.size() + sizeof(CrossPointSettings));
+  appendState(payload, APP_STATE);
+  std::string image(reinterpret_cast<const char*>(static_cast<const void*>(&SETTINGS)), sizeof(CrossPointSettings));
+  transformSecret(image);
+  payload += image;
+
+  Header header{};
+  header.magic = SNAPSHOT_MAGIC;
+  header.version = SNAPSHOT_VERSION;
+  header.stateVersion = STATE_VERSION;
+  header.settingsSize = sizeof(CrossPointSettings);
+  header.firmwareHash = firmwareHash();
+  if (settingsJsonWritten || !jsonStampKnown) {
+    jsonSize = 0;
+    jsonModified = 0;
+    statFile(SETTINGS_FILE_JSON, jsonSize, jsonModified);
+    jsonStampKnown = true;
+  }
+  header.settingsJsonSize = jsonSize;
+  header.settingsJsonModified = jsonModified;
+  header.payloadLength = payload.size();
+  header.checksum = fnv1a(payload.data(), payload.size());
+
+  // Written beside the old snapshot and renamed over it, so a power loss never leaves boot.bin half written
+  Storage.mkdir("/.crosspoint");
+  FsFile file;
+  if (!Storage.openFileForWrite("BSN", SNAPSHOT_FILE_TMP, file)) {
+    return false;
+  }
+  const bool written = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+                       file.write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()) == payload.size();
+  file.close();
+  if (!written) {
+    LOG_ERR("BSN", "Failed to write snapshot");
+    Storage.remove(SNAPSHOT_FILE_TMP);
+    return false;
+  }
+  Storage.remove(SNAPSHOT_FILE);
+  if (!Storage.rename(SNAPSHOT_FILE_TMP, SNAPSHOT_FILE)) {
+    LOG_ERR("BSN", "Failed to replace snapshot");
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Binary snapshot of what the device needs at boot: CrossPointSettings and CrossPointState in one small file,
+// /.crosspoint/boot.bin, read with a single open instead of parsing settings.json and state.json.
+//
+// settings.json stays the export/import format. It is still written on every settings change, and when its size or
+// modification time no longer matches the one recorded in the snapshot (edited on a computer, restored from a backup)
+// it is parsed again and the snapshot refreshed. The settings image is only reused by the firmware build that wrote it;
+// state is serialized field by field and survives updates.
+namespace BootSnapshot {
+// Loads SETTINGS and APP_STATE, from the snapshot where possible
+void load();
+// Writes the current SETTINGS and APP_STATE. `settingsJsonWritten`: settings.json was just rewritten, record its new
+// size and time so the next boot doesn't import it again.
+bool save(bool settingsJsonWritten = false);
+}  // namespace BootSnapshot
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <string>
 
+#include "BootSnapshot.h"
 #include "fontIds.h"
 
 // Initialize the static instance
@@ -78,7 +79,10 @@ void CrossPointSettings::validateFrontButtonMapping(CrossPointSettings& settings
 
 bool CrossPointSettings::saveToFile() const {
   Storage.mkdir("/.crosspoint");
-  return JsonSettingsIO::saveSettings(*this, SETTINGS_FILE_JSON);
+  // settings.json is the export format; boot reads the binary snapshot
+  const bool saved = JsonSettingsIO::saveSettings(*this, SETTINGS_FILE_JSON);
+  BootSnapshot::save(saved);
+  return saved;
 }
 
 bool CrossPointSettings::loadFromFile() {
@@ -201,6 +201,8 @@ class CrossPointSettings {
   uint8_t showHiddenFiles = 0;
   // Image rendering mode in EPUB reader
   uint8_t imageRendering = IMAGES_DISPLAY;
+  // Keep pre-rendered text pages of the current EPUB chapter on the SD card (0 = off, 1 = on)
+  uint8_t pageRasterCache = 0;
   // Tilt-based page turning (X3 only — requires QMI8658 IMU)
   uint8_t tiltPageTurn = TILT_OFF;
 
@@ -7,11 +7,14 @@
 
 #include <algorithm>
 
+#include "BootSnapshot.h"
+
 namespace {
 constexpr uint8_t STATE_FILE_VERSION = 4;
 constexpr char STATE_FILE_BIN[] = "/.crosspoint/state.bin";
 constexpr char STATE_FILE_JSON[] = "/.crosspoint/state.json";
 constexpr char STATE_FILE_BAK[] = "/.crosspoint/state.bin.bak";
+constexpr char STATE_FILE_JSON_BAK[] = "/.crosspoint/state.json.bak";
 }  // namespace
 
 CrossPointState CrossPointState::instance;
@@ -31,17 +34,19 @@ void CrossPointState::pushRecentSleep(uint16_t idx) {
   if (recentSleepFill < SLEEP_RECENT_COUNT) recentSleepFill++;
 }
 
-bool CrossPointState::saveToFile() const {
-  Storage.mkdir("/.crosspoint");
-  return JsonSettingsIO::saveState(*this, STATE_FILE_JSON);
-}
+// State lives in the boot snapshot (see BootSnapshot.h); state.json and state.bin are only read to migrate
+bool CrossPointState::saveToFile() const { return BootSnapshot::save(); }
 
 bool CrossPointState::loadFromFile() {
   // Try JSON first
   if (Storage.exists(STATE_FILE_JSON)) {
     String json = Storage.readFile(STATE_FILE_JSON);
-    if (!json.isEmpty()) {
-      return JsonSettingsIO::loadState(*this, json.c_str());
+    if (!json.isEmpty() && JsonSettingsIO::loadState(*this, json.c_str())) {
+      if (saveToFile()) {
+        Storage.rename(STATE_FILE_JSON, STATE_FILE_JSON_BAK);
+        LOG_DBG("CPS", "Migrated state.json to boot snapshot");
+      }
+      return true;
     }
   }
 
@@ -50,7 +55,7 @@ bool CrossPointState::loadFromFile() {
     if (loadFromBinaryFile()) {
       if (saveToFile()) {
         Storage.rename(STATE_FILE_BIN, STATE_FILE_BAK);
-        LOG_DBG("CPS", "Migrated state.bin to state.json");
+        LOG_DBG("CPS", "Migrated state.bin to boot snapshot");
         return true;
       } else {
         LOG_ERR("CPS", "Failed to save state during migration");
@@ -0,0 +1,881 @@
+#include "LibraryCatalog.h"
+
+#include <Arduino.h>
+#include <Epub.h>
+#include <FsHelpers.h>
+#include <Logging.h>
+#include <Xtc.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "RecentBooksStore.h"
+#include "activities/RenderLock.h"
+#include "components/UITheme.h"
+#include "util/DirectoryListing.h"
+
+namespace {
+constexpr uint8_t CATALOG_FILE_VERSION = 1;
+constexpr char CATALOG_FILE[] = "/.crosspoint/library.bin";
+constexpr char CATALOG_FILE_TMP[] = "/.crosspoint/library.tmp";
+constexpr char CATALOG_STRINGS_TMP[] = "/.crosspoint/library.str";
+constexpr uint32_t MAX_BOOKS = 8192;
+constexpr int ENTRIES_PER_STEP = 16;
+constexpr uint32_t BATCH = 16;
+constexpr size_t MAX_TEXT_LENGTH = 255;
+constexpr size_t KEY_PREFIX_LENGTH = 7;
+
+// Indexes stored after the records: one per Order, then one by path hash
+constexpr uint8_t HASH_INDEX = LibraryCatalog::ORDER_COUNT;
+constexpr uint8_t INDEX_COUNT = LibraryCatalog::ORDER_COUNT + 1;
+constexpr uint8_t ALL_INDEXES = (1 << INDEX_COUNT) - 1;
+
+// Not walked by the rescan (same list the web file manager hides)
+const char* const SKIPPED_FOLDERS[] = {"System Volume Information", "XTCache"};
+
+uint8_t indexBit(const uint8_t which) { return 1 << which; }
+uint8_t orderBit(const LibraryCatalog::Order order) { return indexBit(static_cast<uint8_t>(order)); }
+
+uint32_t hashPath(const std::string& path) { return static_cast<uint32_t>(std::hash<std::string>{}(path)); }
+
+bool isBookFile(const std::string_view name) {
+  return FsHelpers::hasEpubExtension(name) || FsHelpers::hasXtcExtension(name) || FsHelpers::hasTxtExtension(name) ||
+         FsHelpers::hasMarkdownExtension(name);
+}
+
+// Cuts `text` to MAX_TEXT_LENGTH bytes without splitting a UTF-8 sequence
+std::string_view clampText(std::string_view text) {
+  if (text.size() <= MAX_TEXT_LENGTH) return text;
+  size_t length = MAX_TEXT_LENGTH;
+  while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) length--;
+  return text.substr(0, length);
+}
+
+uint8_t fold(const char c) { return static_cast<uint8_t>(tolower(static_cast<unsigned char>(c))); }
+
+// Case-insensitive byte order (ASCII folding only, UTF-8 sequences compare by code point)
+bool foldedLess(const std::string_view a, const std::string_view b) {
+  const size_t n = std::min(a.size(), b.size());
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t ca = fold(a[i]);
+    const uint8_t cb = fold(b[i]);
+    if (ca != cb) return ca < cb;
+  }
+  return a.size() < b.size();
+}
+
+// Sort key for the text orders: the folded start of the text, so most comparisons never touch the card
+struct TextKey {
+  uint8_t prefix[KEY_PREFIX_LENGTH];
+  uint8_t length;  // of the whole text; 0 sorts last (no author)
+  uint32_t record;
+};
+
+void fillKey(TextKey& key, const std::string_view prefix, const uint8_t length, const uint32_t record) {
+  key.length = length;
+  key.record = record;
+  for (size_t i = 0; i < KEY_PREFIX_LENGTH; i++) {
+    key.prefix[i] = i < prefix.size() ? fold(prefix[i]) : 0;
+  }
+}
+
+std::string fileTitle(const std::string& path) {
+  std::string name = path.substr(path.find_last_of('/') + 1);
+  const auto dot = name.rfind('.');
+  if (dot != std::string::npos && dot > 0) name.resize(dot);
+  return name;
+}
+
+uint8_t toPercent(const float fraction) {
+  const int percent = static_cast<int>(fraction * 100.0f + 0.5f);
+  return static_cast<uint8_t>(std::clamp(percent, 0, 100));
+}
+
+// Reads what the book caches already know about `path` without building anything. Falls back to the file name.
+void probeBook(const std::string& path, std::string& title, std::string& author, uint8_t& progress,
+               uint8_t& cacheState) {
+  const auto thumbHeights = UITheme::getInstance().getCoverThumbHeights();
+
+  if (FsHelpers::hasEpubExtension(path)) {
+    Epub epub(path, "/.crosspoint");
+    if (epub.load(false, true)) {
+      title = epub.getTitle();
+      author = epub.getAuthor();
+      cacheState |= LibraryCatalog::METADATA;
+      if (!thumbHeights.empty() && Storage.exists(epub.getThumbBmpPath(thumbHeights.front()).c_str())) {
+        cacheState |= LibraryCatalog::COVER;
+      }
+
+      FsFile f;
+      uint8_t data[6];
+      if (Storage.exists((epub.getCachePath() + "/progress.bin").c_str()) &&
+          Storage.openFileForRead("LIB", epub.getCachePath() + "/progress.bin", f) && f.read(data, 6) == 6) {
+        const int spineIndex = data[0] + (data[1] << 8);
+        const int page = data[2] + (data[3] << 8);
+        const int pageCount = data[4] + (data[5] << 8);
+        if (spineIndex < epub.getSpineItemsCount() && pageCount > 0 && page < pageCount) {
+          progress = toPercent(epub.calculateProgress(spineIndex, static_cast<float>(page) / pageCount));
+        }
+      }
+    }
+  } else if (FsHelpers::hasXtcExtension(path)) {
+    Xtc xtc(path, "/.crosspoint");
+    if (xtc.load()) {
+      title = xtc.getTitle();
+      author = xtc.getAuthor();
+      cacheState |= LibraryCatalog::METADATA;
+      if (!thumbHeights.empty() && Storage.exists(xtc.getThumbBmpPath(thumbHeights.front()).c_str())) {
+        cacheState |= LibraryCatalog::COVER;
+      }
+
+      FsFile f;
+      uint8_t data[4];
+      if (Storage.exists((xtc.getCachePath() + "/progress.bin").c_str()) &&
+          Storage.openFileForRead("LIB", xtc.getCachePath() + "/progress.bin", f) && f.read(data, 4) == 4) {
+        const uint32_t page = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        if (xtc.getPageCount() > 0) {
+          progress = toPercent(static_cast<float>(page + 1) / xtc.getPageCount());
+        }
+      }
+    }
+  }
+
+  if (title.empty()) {
+    title = fileTitle(path);
+  }
+}
+
+// lastRead for a book the catalog sees for the first time: its place in the recent books list, if any
+uint32_t recentRank(const std::string& path) {
+  const auto& books = RECENT_BOOKS.getBooks();
+  for (size_t i = 0; i < books.size(); i++) {
+    if (books[i].path == path) return books.size() - i;
+  }
+  return 0;
+}
+
+bool copyFile(FsFile& from, FsFile& to) {
+  uint8_t buffer[512];
+  int n;
+  while ((n = from.read(buffer, sizeof(buffer))) > 0) {
+    if (to.write(buffer, n) != static_cast<size_t>(n)) return false;
+  }
+  return n == 0;
+}
+}  // namespace
+
+struct LibraryCatalog::Rescan {
+  std::vector<std::string> pendingDirs;
+  FsFile dir;
+  std::string dirPath;
+
+  FsFile out;      // header placeholder, then the records
+  FsFile strings;  // strings block, appended to `out` at the end
+  uint32_t count = 0;
+  uint32_t stringsLength = 0;
+  uint32_t readCount = 0;
+
+  // Previous catalog, for books that didn't change: (path hash << 32 | record number), sorted
+  FsFile previousFile;
+  std::unique_ptr<uint64_t[]> previous;
+  uint32_t previousCount = 0;
+  uint32_t previousStringsStart = 0;
+
+  uint32_t probed = 0;
+  unsigned long startMs = 0;
+
+  ~Rescan() {
+    for (FsFile* f : {&dir, &out, &strings, &previousFile}) {
+      if (*f) f->close();
+    }
+  }
+};
+
+LibraryCatalog LibraryCatalog::instance;
+
+LibraryCatalog::LibraryCatalog() = default;
+LibraryCatalog::~LibraryCatalog() = default;
+
+// ── File access ──────────────────────────────────────────────────────────────
+
+bool LibraryCatalog::open() {
+  if (file) return true;
+  if (opened) return false;
+  opened = true;
+
+  if (!Storage.exists(CATALOG_FILE)) {
+    return false;
+  }
+  file = Storage.open(CATALOG_FILE, O_RDWR);
+  if (!file) {
+    return false;
+  }
+
+  Header fileHeader{};
+  if (file.read(&fileHeader, sizeof(fileHeader)) != sizeof(fileHeader) ||
+      fileHeader.version != CATALOG_FILE_VERSION ||
+      fileHeader.stringsStart != sizeof(Header) + fileHeader.count * (sizeof(Record) + INDEX_COUNT * 4) ||
+      file.size() < fileHeader.stringsStart) {
+    LOG_ERR("LIB", "Ignoring invalid catalog");
+    file.close();
+    return false;
+  }
+
+  // Opens noted before the catalog existed may have moved the clock already
+  fileHeader.clock = std::max(fileHeader.clock, header.clock);
+  header = fileHeader;
+  return true;
+}
+
+void LibraryCatalog::close() {
+  if (file) file.close();
+  opened = false;
+}
+
+uint32_t LibraryCatalog::indexStart(const uint8_t which) const {
+  return sizeof(Header) + header.count * sizeof(Record) + which * header.count * 4;
+}
+
+bool LibraryCatalog::readRecord(const uint32_t number, Record& record) {
+  return file.seek(sizeof(Header) + number * sizeof(Record)) && file.read(&record, sizeof(record)) == sizeof(record);
+}
+
+bool LibraryCatalog::writeRecord(const uint32_t number, const Record& record) {
+  return file.seek(sizeof(Header) + number * sizeof(Record)) && file.write(&record, sizeof(record)) == sizeof(record);
+}
+
+bool LibraryCatalog::writeHeader() {
+  const bool ok = file.seek(0) && file.write(&header, sizeof(header)) == sizeof(header);
+  file.flush();
+  return ok;
+}
+
+bool LibraryCatalog::readString(const uint32_t offset, const uint32_t length, std::string& out) {
+  out.resize(length);
+  return length == 0 ||
+         (file.seek(header.stringsStart + offset) && file.read(out.data(), length) == static_cast<int>(length));
+}
+
+uint32_t LibraryCatalog::appendString(const std::string_view value) {
+  const uint32_t end = file.size();
+  if (!file.seek(end) || file.write(value.data(), value.size()) != value.size()) {
+    return UINT32_MAX;
+  }
+  return end - header.stringsStart;
+}
+
+uint32_t LibraryCatalog::find(const std::string& path, Record& record) {
+  const uint32_t hash = hashPath(path);
+  std::string candidate;
+  auto matches = [&](const uint32_t number) {
+    return readRecord(number, record) && record.pathHash == hash &&
+           readString(record.pathOffset, record.pathLength, candidate) && candidate == path;
+  };
+
+  if (header.staleIndexes & indexBit(HASH_INDEX)) {
+    for (uint32_t number = 0; number < header.count; number++) {
+      if (matches(number)) return number;
+    }
+    return UINT32_MAX;
+  }
+
+  // Lower bound by hash in the hash index, then every record with that hash
+  const uint32_t start = indexStart(HASH_INDEX);
+  auto recordAt = [&](const uint32_t position, uint32_t& number) {
+    return file.seek(start + position * 4) && file.read(&number, 4) == 4;
+  };
+  uint32_t low = 0, high = header.count, number = 0;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (!recordAt(mid, number) || !readRecord(number, record)) return UINT32_MAX;
+    if (record.pathHash < hash) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  for (uint32_t position = low; position < header.count; position++) {
+    if (!recordAt(position, number) || !readRecord(number, record) || record.pathHash != hash) break;
+    if (matches(number)) return number;
+  }
+  return UINT32_MAX;
+}
+
+void LibraryCatalog::updateText(Record& record, const std::string& title, const std::string& author) {
+  std::string stored;
+  const std::string_view newTitle = clampText(title);
+  if (!newTitle.empty() && readString(record.titleOffset, record.titleLength, stored) && stored != newTitle) {
+    const uint32_t offset = appendString(newTitle);
+    if (offset != UINT32_MAX) {
+      record.titleOffset = offset;
+      record.titleLength = newTitle.size();
+      header.staleIndexes |= orderBit(Order::Title);
+    }
+  }
+  const std::string_view newAuthor = clampText(author);
+  if (readString(record.authorOffset, record.authorLength, stored) && stored != newAuthor) {
+    const uint32_t offset = appendString(newAuthor);
+    if (offset != UINT32_MAX) {
+      record.authorOffset = offset;
+      record.authorLength = newAuthor.size();
+      header.staleIndexes |= orderBit(Order::Author);
+    }
+  }
+}
+
+// ── Sort orders ──────────────────────────────────────────────────────────────
+
+bool LibraryCatalog::sortIndex(const uint8_t which) {
+  const uint32_t n = header.count;
+  const unsigned long start = millis();
+
+  // Writes the sorted record numbers, `recordAt(i)` giving the i-th
+  auto writeIndex = [this, n, which](auto recordAt) {
+    uint32_t chunk[64];
+    if (!file.seek(indexStart(which))) return false;
+    for (uint32_t first = 0; first < n; first += 64) {
+      const uint32_t count = std::min<uint32_t>(64, n - first);
+      for (uint32_t i = 0; i < count; i++) chunk[i] = recordAt(first + i);
+      if (file.write(chunk, count * 4) != count * 4) return false;
+    }
+    return true;
+  };
+
+  Record batch[BATCH];
+  uint32_t readCount = 0;
+
+  if (which == static_cast<uint8_t>(Order::Title) || which == static_cast<uint8_t>(Order::Author)) {
+    const bool byTitle = which == static_cast<uint8_t>(Order::Title);
+    std::unique_ptr<TextKey[]> keys(new (std::nothrow) TextKey[n]);
+    if (!keys) {
+      LOG_ERR("LIB", "Not enough memory to sort %u books", n);
+      return false;
+    }
+
+    // The prefixes come from one pass over the strings of each batch
+    std::string text;
+    for (uint32_t first = 0; first < n; first += BATCH) {
+      const uint32_t count = std::min(BATCH, n - first);
+      if (!file.seek(sizeof(Header) + first * sizeof(Record)) ||
+          file.read(batch, count * sizeof(Record)) != static_cast<int>(count * sizeof(Record))) {
+        return false;
+      }
+      for (uint32_t i = 0; i < count; i++) {
+        const Record& record = batch[i];
+        const uint32_t offset = byTitle ? record.titleOffset : record.authorOffset;
+        const uint8_t length = byTitle ? record.titleLength : record.authorLength;
+        if (!readString(offset, std::min<uint32_t>(length, KEY_PREFIX_LENGTH), text)) return false;
+        fillKey(keys[first + i], text, length, first + i);
+      }
+    }
+
+    // The comparators only look at memory: keys by prefix first, then runs that share a prefix by their whole text
+    const auto byPrefix = [](const TextKey& ka, const TextKey& kb) {
+      // Books without author go last
+      if ((ka.length == 0) != (kb.length == 0)) return kb.length == 0;
+      const int prefix = memcmp(ka.prefix, kb.prefix, KEY_PREFIX_LENGTH);
+      if (prefix != 0) return prefix < 0;
+      if (ka.length != kb.length) return ka.length < kb.length;
+      return ka.record < kb.record;
+    };
+    std::sort(keys.get(), keys.get() + n, byPrefix);
+
+    std::vector<std::pair<std::string, uint32_t>> run;  // whole text, record number
+    Record record{};
+    for (uint32_t first = 0; first < n;) {
+      uint32_t end = first + 1;
+      bool longText = keys[first].length > KEY_PREFIX_LENGTH;
+      while (end < n && (keys[end].length == 0) == (keys[first].length == 0) &&
+             memcmp(keys[end].prefix, keys[first].prefix, KEY_PREFIX_LENGTH) == 0) {
+        longText |= keys[end].length > KEY_PREFIX_LENGTH;
+        end++;
+      }
+      // Texts that fit their prefix are already in order (a shorter one is a prefix of a longer one)
+      if (end - first > 1 && longText) {
+        run.resize(end - first);
+        for (uint32_t i = first; i < end; i++) {
+          auto& [text, number] = run[i - first];
+          number = keys[i].record;
+          if (!readRecord(number, record) ||
+              !readString(byTitle ? record.titleOffset : record.authorOffset, keys[i].length, text)) {
+            LOG_ERR("LIB", "Failed to read sort keys, leaving index %u unsorted", which);
+            return false;
+          }
+        }
+        std::sort(run.begin(), run.end(), [](const auto& a, const auto& b) {
+          if (foldedLess(a.first, b.first)) return true;
+          if (foldedLess(b.first, a.first)) return false;
+          return a.second < b.second;
+        });
+        for (uint32_t i = first; i < end; i++) keys[i].record = run[i - first].second;
+      }
+      first = end;
+    }
+    if (!writeIndex([&keys](const uint32_t i) { return keys[i].record; })) return false;
+  } else {
+    std::unique_ptr<uint64_t[]> keys(new (std::nothrow) uint64_t[n]);
+    if (!keys) {
+      LOG_ERR("LIB", "Not enough memory to sort %u books", n);
+      return false;
+    }
+    for (uint32_t first = 0; first < n; first += BATCH) {
+      const uint32_t count = std::min(BATCH, n - first);
+      if (!file.seek(sizeof(Header) + first * sizeof(Record)) ||
+          file.read(batch, count * sizeof(Record)) != static_cast<int>(count * sizeof(Record))) {
+        return false;
+      }
+      for (uint32_t i = 0; i < count; i++) {
+        // Most recent first, never opened last
+        const uint32_t key = which == HASH_INDEX ? batch[i].pathHash : UINT32_MAX - batch[i].lastRead;
+        keys[first + i] = static_cast<uint64_t>(key) << 32 | (first + i);
+        if (batch[i].lastRead != 0) readCount++;
+      }
+    }
+    std::sort(keys.get(), keys.get() + n);
+    if (!writeIndex([&keys](const uint32_t i) { return static_cast<uint32_t>(keys[i]); })) return false;
+  }
+
+  header.staleIndexes &= ~indexBit(which);
+  if (which == static_cast<uint8_t>(Order::LastRead)) {
+    header.readCount = readCount;
+  }
+  writeHeader();
+  LOG_DBG("LIB", "Sorted index %u of %u books in %lu ms", which, n, millis() - start);
+  return true;
+}
+
+// ── Queries ──────────────────────────────────────────────────────────────────
+
+uint32_t LibraryCatalog::size() { return open() ? header.count : 0; }
+
+uint32_t LibraryCatalog::readCount() {
+  if (!open()) return 0;
+  if (header.staleIndexes & orderBit(Order::LastRead)) sortIndex(static_cast<uint8_t>(Order::LastRead));
+  return header.readCount;
+}
+
+bool LibraryCatalog::read(const Order order, const uint32_t first, const uint32_t maxCount,
+                          const std::function<void(uint32_t, const Book&)>& visit) {
+  if (!open()) return false;
+
+  const uint8_t which = static_cast<uint8_t>(order);
+  if (header.staleIndexes & indexBit(which)) sortIndex(which);
+  // A sort that failed (low memory) leaves the books in scan order
+  const bool indexed = !(header.staleIndexes & indexBit(which));
+
+  const uint32_t end = first + std::min(maxCount, header.count > first ? header.count - first : 0);
+  uint32_t numbers[BATCH];
+  std::string strings;
+  Record record{};
+  for (uint32_t batchStart = first; batchStart < end; batchStart += BATCH) {
+    const uint32_t count = std::min(BATCH, end - batchStart);
+    if (indexed) {
+      if (!file.seek(indexStart(which) + batchStart * 4) ||
+          file.read(numbers, count * 4) != static_cast<int>(count * 4)) {
+        return false;
+      }
+    } else {
+      for (uint32_t i = 0; i < count; i++) numbers[i] = batchStart + i;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      if (!readRecord(numbers[i], record)) return false;
+
+      // Strings written by a rescan are back to back; later updates live at the end of the file
+      const bool contiguous = record.titleOffset == record.pathOffset + record.pathLength &&
+                              record.authorOffset == record.titleOffset + record.titleLength;
+      std::string_view path, title, author;
+      if (contiguous) {
+        if (!readString(record.pathOffset, record.pathLength + record.titleLength + record.authorLength, strings)) {
+          return false;
+        }
+        path = std::string_view(strings).substr(0, record.pathLength);
+        title = std::string_view(strings).substr(record.pathLength, record.titleLength);
+        author = std::string_view(strings).substr(record.pathLength + record.titleLength, record.authorLength);
+      } else {
+        strings.clear();
+        std::string part;
+        if (!readString(record.pathOffset, record.pathLength, part)) return false;
+        strings += part;
+        if (!readString(record.titleOffset, record.titleLength, part)) return false;
+        strings += part;
+        if (!readString(record.authorOffset, record.authorLength, part)) return false;
+        strings += part;
+        path = std::string_view(strings).substr(0, record.pathLength);
+        title = std::string_view(strings).substr(record.pathLength, record.titleLength);
+        author = std::string_view(strings).substr(record.pathLength + record.titleLength);
+      }
+
+      visit(batchStart + i,
+            Book{path, title, author, record.size, record.lastRead, record.progress, record.cacheState});
+    }
+  }
+  return true;
+}
+
+// ── Updates ──────────────────────────────────────────────────────────────────
+
+void LibraryCatalog::noteOpened(const std::string& path, const std::string& title, const std::string& author) {
+  open();
+  Update update;
+  update.path = path;
+  update.hasText = true;
+  update.title = title;
+  update.author = author;
+  update.lastRead = ++header.clock;
+  update.cacheState = METADATA;
+  queueForRescan(update);
+  if (applyUpdate(update)) return;
+
+  pendingOpens.erase(std::remove_if(pendingOpens.begin(), pendingOpens.end(),
+                                    [&path](const PendingOpen& open) { return open.path == path; }),
+                     pendingOpens.end());
+  pendingOpens.push_back({path, update.lastRead});
+  requestRescan();
+}
+
+void LibraryCatalog::noteProgress(const std::string& path, const int percent) {
+  Update update;
+  update.path = path;
+  update.progress = static_cast<int16_t>(std::clamp(percent, 0, 100));
+  queueForRescan(update);
+  applyUpdate(update);
+}
+
+void LibraryCatalog::noteCached(const std::string& path, const std::string& title, const std::string& author,
+                                const uint8_t cacheState) {
+  Update update;
+  update.path = path;
+  update.hasText = true;
+  update.title = title;
+  update.author = author;
+  update.cacheState = cacheState;
+  queueForRescan(update);
+  if (!applyUpdate(update)) {
+    requestRescan();
+  }
+}
+
+bool LibraryCatalog::applyUpdate(const Update& update) {
+  Record record{};
+  const uint32_t number = open() ? find(update.path, record) : UINT32_MAX;
+  if (number == UINT32_MAX) return false;
+
+  if (update.lastRead != 0) {
+    record.lastRead = update.lastRead;
+    header.staleIndexes |= orderBit(Order::LastRead);
+  }
+  if (update.progress >= 0) record.progress = static_cast<uint8_t>(update.progress);
+  record.cacheState |= update.cacheState;
+  if (update.hasText) updateText(record, update.title, update.author);
+  writeRecord(number, record);
+  // Progress alone leaves the header as it is
+  if (update.lastRead != 0 || update.hasText) {
+    writeHeader();
+  } else {
+    file.flush();
+  }
+  return true;
+}
+
+void LibraryCatalog::queueForRescan(const Update& update) {
+  if (!rescan) return;
+  const auto queued = std::find_if(rescanUpdates.begin(), rescanUpdates.end(),
+                                   [&update](const Update& other) { return other.path == update.path; });
+  if (queued == rescanUpdates.end()) {
+    rescanUpdates.push_back(update);
+    return;
+  }
+  if (update.hasText) {
+    queued->hasText = true;
+    queued->title = update.title;
+    queued->author = update.author;
+  }
+  if (update.lastRead != 0) queued->lastRead = update.lastRead;
+  if (update.progress >= 0) queued->progress = update.progress;
+  queued->cacheState |= update.cacheState;
+}
+
+// ── Rescan ───────────────────────────────────────────────────────────────────
+
+bool LibraryCatalog::needsRescan() const {
+  return rescan || rescanRequested || DirectoryListing::changeCount() != scannedChangeCount;
+}
+
+bool LibraryCatalog::rescanStep() {
+  if (!rescan) {
+    if (!needsRescan()) return false;
+    if (!startRescan()) {
+      abortRescan(false);
+      return true;
+    }
+  }
+  if (!walkStep()) {
+    // Card full or failing: don't retry until something changes again
+    abortRescan(false);
+  }
+  return true;
+}
+
+bool LibraryCatalog::startRescan() {
+  scannedChangeCount = DirectoryListing::changeCount();
+  rescanRequested = false;
+
+  rescan.reset(new (std::nothrow) Rescan());
+  if (!rescan) {
+    return false;
+  }
+  auto& state = *rescan;
+  state.startMs = millis();
+
+  Storage.mkdir("/.crosspoint");
+  state.out = Storage.open(CATALOG_FILE_TMP, O_RDWR | O_CREAT | O_TRUNC);
+  if (!state.out || !Storage.openFileForWrite("LIB", CATALOG_STRINGS_TMP, state.strings)) {
+    LOG_ERR("LIB", "Failed to create catalog files");
+    return false;
+  }
+  const Header placeholder{};
+  state.out.write(&placeholder, sizeof(placeholder));
+
+  // Path hashes of the previous catalog, to find books that are already known
+  if (open() && header.count > 0) {
+    state.previousFile = Storage.open(CATALOG_FILE);
+    state.previous.reset(new (std::nothrow) uint64_t[header.count]);
+    Record batch[BATCH];
+    bool ok = state.previousFile && state.previous && state.previousFile.seek(sizeof(Header));
+    for (uint32_t first = 0; ok && first < header.count; first += BATCH) {
+      const uint32_t count = std::min(BATCH, header.count - first);
+      ok = state.previousFile.read(batch, count * sizeof(Record)) == static_cast<int>(count * sizeof(Record));
+      for (uint32_t i = 0; ok && i < count; i++) {
+        state.previous[first + i] = static_cast<uint64_t>(batch[i].pathHash) << 32 | (first + i);
+      }
+    }
+    if (ok) {
+      std::sort(state.previous.get(), state.previous.get() + header.count);
+      state.previousCount = header.count;
+      state.previousStringsStart = header.stringsStart;
+    } else {
+      // Everything gets probed again
+      LOG_ERR("LIB", "Could not load the previous catalog (%u books)", header.count);
+      state.previous.reset();
+      if (state.previousFile) state.previousFile.close();
+    }
+  }
+
+  state.pendingDirs.emplace_back("/");
+  LOG_DBG("LIB", "Rescan started");
+  return true;
+}
+
+bool LibraryCatalog::walkStep() {
+  auto& state = *rescan;
+  char name[500];
+
+  for (int processed = 0; processed < ENTRIES_PER_STEP;) {
+    if (!state.dir) {
+      if (state.pendingDirs.empty()) {
+        return finishRescan();
+      }
+      state.dirPath = std::move(state.pendingDirs.back());
+      state.pendingDirs.pop_back();
+      state.dir = Storage.open(state.dirPath.c_str());
+      if (state.dir && !state.dir.isDirectory()) state.dir.close();
+      continue;
+    }
+
+    FsFile entry = state.dir.openNextFile();
+    if (!entry) {
+      state.dir.close();
+      continue;
+    }
+    processed++;
+
+    entry.getName(name, sizeof(name));
+    if (name[0] == '.' ||
+        std::any_of(std::begin(SKIPPED_FOLDERS), std::end(SKIPPED_FOLDERS),
+                    [&name](const char* skipped) { return strcmp(name, skipped) == 0; })) {
+      continue;
+    }
+
+    std::string path = state.dirPath;
+    if (path.back() != '/') path += '/';
+    path += name;
+
+    if (entry.isDirectory()) {
+      state.pendingDirs.push_back(std::move(path));
+      continue;
+    }
+    if (!isBookFile(name)) {
+      continue;
+    }
+    if (state.count >= MAX_BOOKS) {
+      LOG_ERR("LIB", "Catalog full, skipping %s", path.c_str());
+      continue;
+    }
+
+    uint16_t date = 0, time = 0;
+    entry.getModifyDateTime(&date, &time);
+    const uint32_t size = entry.size();
+    entry.close();
+
+    // Opening a book is the expensive part: one per step
+    bool probed = false;
+    if (!addBook(path, size, static_cast<uint32_t>(date) << 16 | time, probed)) {
+      return false;
+    }
+    if (probed) break;
+  }
+  return true;
+}
+
+bool LibraryCatalog::addBook(const std::string& path, const uint32_t size, const uint32_t modified, bool& probed) {
+  auto& state = *rescan;
+
+  Record record{};
+  record.pathHash = hashPath(path);
+  record.size = size;
+  record.modified = modified;
+
+  std::string title, author;
+  bool known = false;
+  if (state.previous) {
+    const uint64_t* const begin = state.previous.get();
+    const uint64_t* const end = begin + state.previousCount;
+    std::string previousPath;
+    for (auto it = std::lower_bound(begin, end, static_cast<uint64_t>(record.pathHash) << 32);
+         it != end && static_cast<uint32_t>(*it >> 32) == record.pathHash; ++it) {
+      Record previous{};
+      const uint32_t number = static_cast<uint32_t>(*it);
+      auto readPrevious = [&state](const uint32_t offset, const uint32_t length, std::string& out) {
+        out.resize(length);
+        return length == 0 || (state.previousFile.seek(state.previousStringsStart + offset) &&
+                               state.previousFile.read(out.data(), length) == static_cast<int>(length));
+      };
+      if (!state.previousFile.seek(sizeof(Header) + number * sizeof(Record)) ||
+          state.previousFile.read(&previous, sizeof(previous)) != sizeof(previous) ||
+          !readPrevious(previous.pathOffset, previous.pathLength, previousPath) || previousPath != path) {
+        continue;
+      }
+
+      // Reading state survives a changed file, the metadata doesn't
+      record.lastRead = previous.lastRead;
+      record.progress = previous.progress;
+      if (previous.size == size && previous.modified == modified &&
+          readPrevious(previous.titleOffset, previous.titleLength, title) &&
+          readPrevious(previous.authorOffset, previous.authorLength, author)) {
+        record.cacheState = previous.cacheState;
+        known = true;
+      }
+      break;
+    }
+  }
+
+  probed = !known;
+  if (probed) {
+    title.clear();
+    author.clear();
+    probeBook(path, title, author, record.progress, record.cacheState);
+    state.probed++;
+  }
+
+  const auto pending = std::find_if(pendingOpens.begin(), pendingOpens.end(),
+                                    [&path](const PendingOpen& open) { return open.path == path; });
+  if (pending != pendingOpens.end()) {
+    record.lastRead = pending->lastRead;
+    pendingOpens.erase(pending);
+  } else if (record.lastRead == 0) {
+    record.lastRead = recentRank(path);
+  }
+
+  const std::string_view storedTitle = clampText(title);
+  const std::string_view storedAuthor = clampText(author);
+  record.pathOffset = state.stringsLength;
+  record.pathLength = path.size();
+  record.titleOffset = record.pathOffset + record.pathLength;
+  record.titleLength = storedTitle.size();
+  record.authorOffset = record.titleOffset + record.titleLength;
+  record.authorLength = storedAuthor.size();
+
+  if (state.strings.write(path.data(), path.size()) != path.size() ||
+      state.strings.write(storedTitle.data(), storedTitle.size()) != storedTitle.size() ||
+      state.strings.write(storedAuthor.data(), storedAuthor.size()) != storedAuthor.size() ||
+      state.out.write(&record, sizeof(record)) != sizeof(record)) {
+    LOG_ERR("LIB", "Failed to write catalog");
+    return false;
+  }
+  state.stringsLength += path.size() + storedTitle.size() + storedAuthor.size();
+  state.count++;
+  if (record.lastRead != 0) state.readCount++;
+  return true;
+}
+
+bool LibraryCatalog::finishRescan() {
+  auto& state = *rescan;
+  if (state.previousFile) state.previousFile.close();
+  state.previous.reset();
+
+  // Index space (filled by the sorts below), then the strings
+  uint8_t zeros[256] = {};
+  for (uint32_t remaining = state.count * INDEX_COUNT * 4; remaining > 0;) {
+    const uint32_t n = std::min<uint32_t>(remaining, sizeof(zeros));
+    if (state.out.write(zeros, n) != n) return false;
+    remaining -= n;
+  }
+  state.strings.close();
+  if (!Storage.openFileForRead("LIB", CATALOG_STRINGS_TMP, state.strings) || !copyFile(state.strings, state.out)) {
+    return false;
+  }
+  state.strings.close();
+  Storage.remove(CATALOG_STRINGS_TMP);
+
+  Header finalHeader{};
+  finalHeader.version = CATALOG_FILE_VERSION;
+  finalHeader.staleIndexes = ALL_INDEXES;
+  finalHeader.count = state.count;
+  finalHeader.readCount = state.readCount;
+  // Books seeded from the recent list hold the lowest clock values
+  finalHeader.clock = std::max<uint32_t>(header.clock, RECENT_BOOKS.getCount());
+  finalHeader.stringsStart = sizeof(Header) + state.count * (sizeof(Record) + INDEX_COUNT * 4);
+  if (!state.out.seek(0) || state.out.write(&finalHeader, sizeof(finalHeader)) != sizeof(finalHeader)) {
+    return false;
+  }
+  state.out.close();
+
+  {
+    // Screens may be reading the catalog on the render task
+    RenderLock lock;
+    close();
+    Storage.remove(CATALOG_FILE);
+    if (!Storage.rename(CATALOG_FILE_TMP, CATALOG_FILE)) {
+      LOG_ERR("LIB", "Failed to replace catalog");
+      return false;
+    }
+    if (open()) {
+      // The hash index first, so the replayed updates find their books by binary search
+      sortIndex(HASH_INDEX);
+      for (const auto& update : rescanUpdates) {
+        applyUpdate(update);
+      }
+      for (uint8_t which = 0; which < INDEX_COUNT; which++) {
+        if (header.staleIndexes & indexBit(which)) sortIndex(which);
+      }
+    }
+    rescanUpdates.clear();
+  }
+
+  LOG_DBG("LIB", "Rescan done: %u books, %u probed, %lu ms", state.count, state.probed, millis() - state.startMs);
+  rescan.reset();
+  return true;
+}
+
+void LibraryCatalog::abortRescan(const bool retry) {
+  if (!rescan) return;
+  LOG_DBG("LIB", "Rescan stopped");
+  rescan.reset();
+  // They are in the current catalog already, which the next rescan copies
+  rescanUpdates.clear();
+  Storage.remove(CATALOG_FILE_TMP);
+  Storage.remove(CATALOG_STRINGS_TMP);
+  rescanRequested = retry;
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <HalStorage.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Every book on the SD card with its metadata, reading state and sort orders, kept in /.crosspoint/library.bin so
+// screens can sort and page a large library without opening the books.
+//
+// File layout:
+// - Header
+// - Record[count]: one fixed 36-byte record per book, in scan order
+// - uint32_t index[count] for each Order plus one by path hash (record numbers in that order)
+// - strings: paths, titles and authors, referenced by offset from the start of this block. Updates append here.
+//
+// The catalog is rebuilt by an incremental rescan that walks the card but only opens books that are new or whose size
+// or modification time changed; everything else is copied from the previous catalog. The rescan runs in small steps
+// from the main loop while the device is idle.
+class LibraryCatalog {
+ public:
+  enum class Order : uint8_t { Title, Author, LastRead };
+  static constexpr uint8_t ORDER_COUNT = 3;
+
+  enum CacheState : uint8_t {
+    METADATA = 1 << 0,  // book.bin / header read, title and author are the book's own
+    COVER = 1 << 1,     // home screen thumbnail generated
+  };
+
+  struct Book {
+    std::string_view path;  // views are valid during the visit callback only
+    std::string_view title;
+    std::string_view author;
+    uint32_t size;
+    uint32_t lastRead;  // catalog clock at the last open, 0 if never opened
+    uint8_t progress;   // percent
+    uint8_t cacheState;
+  };
+
+  LibraryCatalog();
+  ~LibraryCatalog();
+
+  static LibraryCatalog& getInstance() { return instance; }
+
+  uint32_t size();
+  // Number of books that were opened at least once; they come first in Order::LastRead
+  uint32_t readCount();
+  // Visits books [first, first + maxCount) in `order`. Sorts the order first if updates left it stale.
+  bool read(Order order, uint32_t first, uint32_t maxCount, const std::function<void(uint32_t, const Book&)>& visit);
+
+  // Reader hooks
+  void noteOpened(const std::string& path, const std::string& title, const std::string& author);
+  void noteProgress(const std::string& path, int percent);
+  // Book preparation hook: metadata and cover were just generated
+  void noteCached(const std::string& path, const std::string& title, const std::string& author, uint8_t cacheState);
+
+  // Rescans at the next idle step. Called once per boot and whenever a folder changed.
+  void requestRescan() { rescanRequested = true; }
+  bool needsRescan() const;
+  // Runs one bounded piece of the rescan (a few directory entries, one book probe, or the final sort). Returns false
+  // when there was nothing to do. Main loop task only.
+  bool rescanStep();
+
+ private:
+  static LibraryCatalog instance;
+
+  struct Header {
+    uint8_t version;  // 0 while the file is being written
+    uint8_t staleIndexes;  // bit per index (Order, then path hash) that no longer matches the records
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t readCount;
+    uint32_t clock;  // last lastRead value handed out
+    uint32_t stringsStart;
+    uint32_t reserved2[3];
+  };
+  static_assert(sizeof(Header) == 32, "Header layout is part of the file format");
+
+  struct Record {
+    uint32_t pathHash;  // std::hash of the path, as in the book cache folder names
+    uint32_t size;
+    uint32_t modified;  // FAT date << 16 | FAT time
+    uint32_t lastRead;
+    uint32_t pathOffset;
+    uint32_t titleOffset;
+    uint32_t authorOffset;
+    uint16_t pathLength;
+    uint8_t titleLength;
+    uint8_t authorLength;
+    uint8_t progress;
+    uint8_t cacheState;
+    uint16_t reserved;
+  };
+  static_assert(sizeof(Record) == 36, "Record layout is part of the file format");
+
+  struct Rescan;
+  struct PendingOpen {
+    std::string path;
+    uint32_t lastRead;
+  };
+  // One book's changes from a reader or preparation hook
+  struct Update {
+    std::string path;
+    bool hasText = false;  // title/author below replace the stored ones
+    std::string title;
+    std::string author;
+    uint32_t lastRead = 0;  // 0 = unchanged
+    int16_t progress = -1;  // -1 = unchanged
+    uint8_t cacheState = 0;  // bits to set
+  };
+
+  FsFile file;
+  Header header{};
+  bool opened = false;  // open() was attempted since the last change of file
+  bool rescanRequested = true;
+  uint32_t scannedChangeCount = 0;
+  std::unique_ptr<Rescan> rescan;
+  // Opens of books the catalog doesn't have yet, applied by the next rescan
+  std::vector<PendingOpen> pendingOpens;
+  // Updates made while a rescan runs. They go to the current catalog right away and are applied again to the new one
+  // when it replaces the current one, since the rescan may have copied those books before the update.
+  std::vector<Update> rescanUpdates;
+
+  bool open();
+  void close();
+  uint32_t indexStart(uint8_t which) const;
+  bool readRecord(uint32_t number, Record& record);
+  bool writeRecord(uint32_t number, const Record& record);
+  bool writeHeader();
+  bool readString(uint32_t offset, uint32_t length, std::string& out);
+  uint32_t appendString(std::string_view value);
+  // Record number of `path`, or UINT32_MAX
+  uint32_t find(const std::string& path, Record& record);
+  // Stores a new title/author for `record` if they changed, marking the affected orders stale
+  void updateText(Record& record, const std::string& title, const std::string& author);
+  bool sortIndex(uint8_t which);
+  // Writes `update` to the current catalog; false if the book isn't in it
+  bool applyUpdate(const Update& update);
+  // Remembers `update` for the new catalog if a rescan is running
+  void queueForRescan(const Update& update);
+
+  bool startRescan();
+  bool walkStep();
+  // Appends one book to the new catalog; `probed` tells whether the book itself had to be opened
+  bool addBook(const std::string& path, uint32_t size, uint32_t modified, bool& probed);
+  bool finishRescan();
+  // Drops a running rescan. `retry`: start over at the next idle step instead of waiting for the next change.
+  void abortRescan(bool retry = true);
+};
+
+// Helper macro to access the library catalog
+#define LIBRARY LibraryCatalog::getInstance()
@@ -24,6 +24,7 @@ class OpdsServerStore {
  private:
   static OpdsServerStore instance;
   std::vector<OpdsServer> servers;
+  bool loaded = false;
 
   static constexpr size_t MAX_SERVERS = 8;
 
@@ -36,7 +37,11 @@ class OpdsServerStore {
   OpdsServerStore(const OpdsServerStore&) = delete;
   OpdsServerStore& operator=(const OpdsServerStore&) = delete;
 
-  static OpdsServerStore& getInstance() { return instance; }
+  // Loaded on first use: only network screens need the servers, so boot doesn't read opds.json
+  static OpdsServerStore& getInstance() {
+    if (!instance.loaded) instance.loadFromFile();
+    return instance;
+  }
 
   bool saveToFile() const;
   bool loadFromFile();
@@ -21,14 +21,18 @@ class RecentBooksStore {
   static RecentBooksStore instance;
 
   std::vector<RecentBook> recentBooks;
+  bool loaded = false;
 
   friend bool JsonSettingsIO::loadRecentBooks(RecentBooksStore&, const char*);
 
  public:
   ~RecentBooksStore() = default;
 
-  // Get singleton instance
-  static RecentBooksStore& getInstance() { return instance; }
+  // Get singleton instance, loading the list on first use rather than during boot
+  static RecentBooksStore& getInstance() {
+    if (!instance.loaded) instance.loadFromFile();
+    return instance;
+  }
 
   // Add a book to the recent list (moves to front if already exists)
   void addBook(const std::string& path, const std::string& title, const std::string& author,
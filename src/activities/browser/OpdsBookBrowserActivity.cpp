@@ -2,11 +2,14 @@
 
 #include <Epub.h>
 #include <GfxRenderer.h>
+#include <HTTPClient.h>
+#include <HalStorage.h>
 #include <I18n.h>
 #include <Logging.h>
 #include <OpdsStream.h>
 #include <WiFi.h>
 
+#include "BookIngestQueue.h"
 #include "MappedInputManager.h"
 #include "activities/network/WifiSelectionActivity.h"
 #include "activities/util/KeyboardEntryActivity.h"
@@ -18,7 +21,87 @@
 
 namespace {
 constexpr int PAGE_ITEMS = 23;
-}
+constexpr char FEED_CACHE_DIR[] = "/.crosspoint/opds";
+
+class SdFeedStore final : public OpdsFeedCache::Store {
+ public:
+  bool read(const std::string& name, std::string& data) override {
+    FsFile file;
+    if (!Storage.exists(pathOf(name).c_str()) || !Storage.openFileForRead("OPDS", pathOf(name), file)) {
+      return false;
+    }
+    data.resize(file.size());
+    const bool ok = file.read(data.data(), data.size()) == static_cast<int>(data.size());
+    file.close();
+    return ok;
+  }
+
+  bool readHead(const std::string& name, const size_t length, std::string& data) override {
+    FsFile file;
+    if (!Storage.exists(pathOf(name).c_str()) || !Storage.openFileForRead("OPDS", pathOf(name), file)) {
+      return false;
+    }
+    data.resize(std::min<size_t>(length, file.size()));
+    const bool ok = file.read(data.data(), data.size()) == static_cast<int>(data.size());
+    file.close();
+    return ok;
+  }
+
+  bool write(const std::string& name, const std::string& data) override {
+    Storage.mkdir(FEED_CACHE_DIR);
+    FsFile file;
+    if (!Storage.openFileForWrite("OPDS", pathOf(name), file)) {
+      return false;
+    }
+    const bool ok = file.write(data.data(), data.size()) == data.size();
+    file.close();
+    if (!ok) {
+      Storage.remove(pathOf(name).c_str());
+    }
+    return ok;
+  }
+
+  void remove(const std::string& name) override { Storage.remove(pathOf(name).c_str()); }
+
+ private:
+  static std::string pathOf(const std::string& name) { return std::string(FEED_CACHE_DIR) + "/" + name + ".bin"; }
+};
+
+SdFeedStore feedStore;
+
+class HttpFeedTransport final : public OpdsFeedCache::Transport {
+ public:
+  explicit HttpFeedTransport(const OpdsServer& server) : server(server) {}
+
+  Result get(const std::string& url, const OpdsFeedCache::Validators& cached, OpdsFeedCache::Feed& feed,
+             OpdsFeedCache::Validators& received) override {
+    received = cached;
+    OpdsParser parser;
+    int httpCode;
+    {
+      OpdsParserStream stream{parser};
+      httpCode = HttpDownloader::fetchUrlIfModified(url, stream, received.etag, received.lastModified,
+                                                    server.username, server.password);
+    }
+    if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+      return Result::NOT_MODIFIED;
+    }
+    if (httpCode != HTTP_CODE_OK || !parser) {
+      LOG_ERR("OPDS", "Feed request failed (%d) or did not parse", httpCode);
+      return Result::FAILED;
+    }
+
+    feed.searchTemplate = parser.getSearchTemplate();
+    feed.nextPageUrl = parser.getNextPageUrl();
+    feed.prevPageUrl = parser.getPrevPageUrl();
+    feed.entries = std::move(parser).getEntries();
+    return Result::OK;
+  }
+
+ private:
+  const OpdsServer& server;
+};
+}  // namespace
 
 void OpdsBookBrowserActivity::onEnter() {
   Activity::onEnter();
@@ -33,6 +116,7 @@ void OpdsBookBrowserActivity::onEnter() {
   consumeBack = false;
   errorMessage.clear();
   statusMessage = tr(STR_CHECKING_WIFI);
+  feedCache.reset(new OpdsFeedCache(feedStore));
   requestUpdate();
 
   checkAndConnectWifi();
@@ -43,6 +127,7 @@ void OpdsBookBrowserActivity::onExit() {
   WiFi.mode(WIFI_OFF);
   entries.clear();
   navigationHistory.clear();
+  feedCache.reset();
 }
 
 void OpdsBookBrowserActivity::loop() {
@@ -179,7 +264,7 @@ void OpdsBookBrowserActivity::render(RenderLock&&) {
   renderer.displayBuffer();
 }
 
-void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
+void OpdsBookBrowserActivity::fetchFeed(const std::string& path, const bool preferSession) {
   if (server.url.empty()) {
     state = BrowserState::ERROR;
     errorMessage = tr(STR_NO_SERVER_URL);
@@ -189,34 +274,25 @@ void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
 
   std::string url = (path.find("http") == 0) ? path : UrlUtils::buildUrl(server.url, path);
   LOG_DBG("OPDS", "Fetching: %s", url.c_str());
-  OpdsParser parser;
-  {
-    OpdsParserStream stream{parser};
-    if (!HttpDownloader::fetchUrl(url, stream, server.username, server.password)) {
-      state = BrowserState::ERROR;
-      errorMessage = tr(STR_FETCH_FEED_FAILED);
-      requestUpdate();
-      return;
-    }
-  }
-
-  if (!parser) {
+  HttpFeedTransport transport(server);
+  OpdsFeedCache::Feed feed;
+  const auto source = feedCache->fetch(url, transport, feed, preferSession);
+  if (source == OpdsFeedCache::Source::NONE) {
     state = BrowserState::ERROR;
-    errorMessage = tr(STR_PARSE_FEED_FAILED);
+    errorMessage = tr(STR_FETCH_FEED_FAILED);
     requestUpdate();
     return;
   }
+  LOG_DBG("OPDS", "Feed source: %d", static_cast<int>(source));
 
-  searchTemplate = parser.getSearchTemplate();
-  const auto& nextUrl = parser.getNextPageUrl();
-  const auto& prevUrl = parser.getPrevPageUrl();
-  entries = std::move(parser).getEntries();
+  searchTemplate = std::move(feed.searchTemplate);
+  entries = std::move(feed.entries);
 
-  if (!prevUrl.empty()) {
-    entries.insert(entries.begin(), OpdsEntry{OpdsEntryType::NAVIGATION, tr(STR_PREV_PAGE), "", prevUrl, ""});
+  if (!feed.prevPageUrl.empty()) {
+    entries.insert(entries.begin(), OpdsEntry{OpdsEntryType::NAVIGATION, tr(STR_PREV_PAGE), "", feed.prevPageUrl, ""});
   }
-  if (!nextUrl.empty()) {
-    entries.push_back(OpdsEntry{OpdsEntryType::NAVIGATION, tr(STR_NEXT_PAGE), "", nextUrl, ""});
+  if (!feed.nextPageUrl.empty()) {
+    entries.push_back(OpdsEntry{OpdsEntryType::NAVIGATION, tr(STR_NEXT_PAGE), "", feed.nextPageUrl, ""});
   }
 
   selectorIndex = 0;
@@ -250,7 +326,8 @@ void OpdsBookBrowserActivity::navigateBack() {
     entries.clear();
     selectorIndex = 0;
     requestUpdate();
-    fetchFeed(currentPath);
+    // The page was just shown: take it from the cache without asking the server again
+    fetchFeed(currentPath, true);
   }
 }
 
@@ -278,6 +355,7 @@ void OpdsBookBrowserActivity::downloadBook(const OpdsEntry& book) {
 
   if (result == HttpDownloader::OK) {
     Epub(filename, "/.crosspoint").clearCache();
+    INGEST_QUEUE.enqueue(filename);
     state = BrowserState::BROWSING;
   } else {
     state = BrowserState::ERROR;
@@ -1,6 +1,8 @@
 #pragma once
+#include <OpdsFeedCache.h>
 #include <OpdsParser.h>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,11 +43,12 @@ class OpdsBookBrowserActivity final : public Activity {
   size_t downloadTotal = 0;
 
   OpdsServer server;  // Copied at construction — safe even if the store changes during browsing
+  std::unique_ptr<OpdsFeedCache> feedCache;  // Created per visit, so "validated this session" means this visit
 
   void checkAndConnectWifi();
   void launchWifiSelection();
   void onWifiSelectionComplete(bool connected);
-  void fetchFeed(const std::string& path);
+  void fetchFeed(const std::string& path, bool preferSession = false);
   void navigateToEntry(const OpdsEntry& entry);
   void navigateBack();
   void downloadBook(const OpdsEntry& book);
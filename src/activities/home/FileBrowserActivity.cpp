@@ -18,87 +18,46 @@ namespace {
 constexpr unsigned long GO_HOME_MS = 1000;
 }  // namespace
 
-void sortFileList(std::vector<std::string>& strs) {
-  std::sort(begin(strs), end(strs), [](const std::string& str1, const std::string& str2) {
-    // Directories first
-    bool isDir1 = str1.back() == '/';
-    bool isDir2 = str2.back() == '/';
-    if (isDir1 != isDir2) return isDir1;
-
-    // Start naive natural sort
-    const char* s1 = str1.c_str();
-    const char* s2 = str2.c_str();
-
-    // Iterate while both strings have characters
-    while (*s1 && *s2) {
-      // Check if both are at the start of a number
-      if (isdigit(*s1) && isdigit(*s2)) {
-        // Skip leading zeros and track them
-        const char* start1 = s1;
-        const char* start2 = s2;
-        while (*s1 == '0') s1++;
-        while (*s2 == '0') s2++;
-
-        // Count digits to compare lengths first
-        int len1 = 0, len2 = 0;
-        while (isdigit(s1[len1])) len1++;
-        while (isdigit(s2[len2])) len2++;
-
-        // Different length so return smaller integer value
-        if (len1 != len2) return len1 < len2;
-
-        // Same length so compare digit by digit
-        for (int i = 0; i < len1; i++) {
-          if (s1[i] != s2[i]) return s1[i] < s2[i];
-        }
-
-        // Numbers equal so advance pointers
-        s1 += len1;
-        s2 += len2;
-      } else {
-        // Regular case-insensitive character comparison
-        char c1 = tolower(*s1);
-        char c2 = tolower(*s2);
-        if (c1 != c2) return c1 < c2;
-        s1++;
-        s2++;
-      }
-    }
-
-    // One string is prefix of other
-    return *s1 == '\0' && *s2 != '\0';
-  });
-}
-
 void FileBrowserActivity::loadFiles() {
-  files.clear();
+  RenderLock lock(*this);
+  visible.clear();
+  windowStart = 0;
+  windowNames.clear();
 
-  auto root = Storage.open(basepath.c_str());
-  if (!root || !root.isDirectory()) {
+  if (!listing.open(basepath)) {
     return;
   }
 
-  root.rewindDirectory();
-
-  char name[500];
-  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
-    file.getName(name, sizeof(name));
-    if ((!SETTINGS.showHiddenFiles && name[0] == '.') || strcmp(name, "System Volume Information") == 0) {
-      continue;
-    }
+  const bool showHidden = SETTINGS.showHiddenFiles;
+  visible.reserve(listing.size());
+  listing.readFlags([this, showHidden](const uint32_t index, const uint8_t flags) {
+    if ((!showHidden && (flags & DirectoryListing::HIDDEN)) || (flags & DirectoryListing::SYSTEM)) return;
+    if (flags & (DirectoryListing::DIRECTORY | DirectoryListing::BOOK)) visible.push_back(index);
+  });
+}
 
-    if (file.isDirectory()) {
-      files.emplace_back(std::string(name) + "/");
-    } else {
-      std::string_view filename{name};
-      if (FsHelpers::hasEpubExtension(filename) || FsHelpers::hasXtcExtension(filename) ||
-          FsHelpers::hasTxtExtension(filename) || FsHelpers::hasMarkdownExtension(filename) ||
-          FsHelpers::hasBmpExtension(filename)) {
-        files.emplace_back(filename);
-      }
-    }
+const std::string& FileBrowserActivity::entryAt(const size_t index) {
+  constexpr size_t WINDOW_SIZE = 64;
+
+  if (index < windowStart || index >= windowStart + windowNames.size()) {
+    windowStart = index;
+    windowNames.clear();
+    const size_t windowEnd = std::min(visible.size(), index + WINDOW_SIZE);
+
+    // Read the span of the listing the window covers and keep the visible entries of it
+    const uint32_t first = visible[index];
+    const uint32_t last = visible[windowEnd - 1];
+    size_t next = index;
+    listing.read(first, last - first + 1, [this, &next, windowEnd](const uint32_t i, const DirectoryListing::Entry& e) {
+      if (next >= windowEnd || visible[next] != i) return;
+      windowNames.emplace_back(e.name);
+      if (e.isDirectory()) windowNames.back() += '/';
+      next++;
+    });
+    // A failed read leaves the window short; pad it so callers always get a name
+    windowNames.resize(windowEnd - index);
   }
-  sortFileList(files);
+  return windowNames[index - windowStart];
 }
 
 void FileBrowserActivity::onEnter() {
@@ -129,7 +88,9 @@ void FileBrowserActivity::onEnter() {
 
 void FileBrowserActivity::onExit() {
   Activity::onExit();
-  files.clear();
+  listing.close();
+  visible.clear();
+  windowNames.clear();
 }
 
 void FileBrowserActivity::clearFileMetadata(const std::string& fullPath) {
@@ -162,9 +123,13 @@ void FileBrowserActivity::loop() {
   const int pageItems = UITheme::getNumberOfItemsPerPage(renderer, true, false, true, false, pathReserved);
 
   if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
-    if (files.empty()) return;
+    if (visible.empty()) return;
 
-    const std::string& entry = files[selectorIndex];
+    std::string entry;
+    {
+      RenderLock lock(*this);
+      entry = entryAt(selectorIndex);
+    }
     bool isDirectory = (entry.back() == '/');
 
     if (mappedInput.getHeldTime() >= GO_HOME_MS && !isDirectory) {
@@ -179,12 +144,13 @@ void FileBrowserActivity::loop() {
           clearFileMetadata(fullPath);
           if (Storage.remove(fullPath.c_str())) {
             LOG_DBG("FileBrowser", "Deleted successfully");
+            DirectoryListing::invalidate(basepath);
             loadFiles();
-            if (files.empty()) {
+            if (visible.empty()) {
               selectorIndex = 0;
-            } else if (selectorIndex >= files.size()) {
+            } else if (selectorIndex >= visible.size()) {
               // Move selection to the new "last" item
-              selectorIndex = files.size() - 1;
+              selectorIndex = visible.size() - 1;
             }
 
             requestUpdate(true);
@@ -237,7 +203,7 @@ void FileBrowserActivity::loop() {
     }
   }
 
-  int listSize = static_cast<int>(files.size());
+  int listSize = static_cast<int>(visible.size());
   buttonNavigator.onNextRelease([this, listSize] {
     selectorIndex = ButtonNavigator::nextIndex(static_cast<int>(selectorIndex), listSize);
     requestUpdate();
@@ -294,14 +260,14 @@ void FileBrowserActivity::render(RenderLock&&) {
   const int contentTop = metrics.topPadding + metrics.headerHeight + metrics.verticalSpacing;
   const int contentHeight =
       pageHeight - contentTop - metrics.buttonHintsHeight - metrics.verticalSpacing - pathReserved;
-  if (files.empty()) {
+  if (visible.empty()) {
     renderer.drawText(UI_10_FONT_ID, metrics.contentSidePadding, contentTop + 20, tr(STR_NO_FILES_FOUND));
   } else {
     GUI.drawList(
-        renderer, Rect{0, contentTop, pageWidth, contentHeight}, files.size(), selectorIndex,
-        [this](int index) { return getFileName(files[index]); }, nullptr,
-        [this](int index) { return UITheme::getFileIcon(files[index]); },
-        [this](int index) { return getFileExtension(files[index]); }, false);
+        renderer, Rect{0, contentTop, pageWidth, contentHeight}, visible.size(), selectorIndex,
+        [this](int index) { return getFileName(entryAt(index)); }, nullptr,
+        [this](int index) { return UITheme::getFileIcon(entryAt(index)); },
+        [this](int index) { return getFileExtension(entryAt(index)); }, false);
   }
 
   // Full path display
@@ -333,15 +299,21 @@ void FileBrowserActivity::render(RenderLock&&) {
 
   // Help text
   const auto labels =
-      mappedInput.mapLabels(basepath == "/" ? tr(STR_HOME) : tr(STR_BACK), files.empty() ? "" : tr(STR_OPEN),
-                            files.empty() ? "" : tr(STR_DIR_UP), files.empty() ? "" : tr(STR_DIR_DOWN));
+      mappedInput.mapLabels(basepath == "/" ? tr(STR_HOME) : tr(STR_BACK), visible.empty() ? "" : tr(STR_OPEN),
+                            visible.empty() ? "" : tr(STR_DIR_UP), visible.empty() ? "" : tr(STR_DIR_DOWN));
   GUI.drawButtonHints(renderer, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
 
   renderer.displayBuffer();
 }
 
-size_t FileBrowserActivity::findEntry(const std::string& name) const {
-  for (size_t i = 0; i < files.size(); i++)
-    if (files[i] == name) return i;
-  return 0;
+size_t FileBrowserActivity::findEntry(const std::string& name) {
+  if (name.empty()) return 0;
+  const bool isDirectory = name.back() == '/';
+  const std::string_view bare(name.data(), isDirectory ? name.size() - 1 : name.size());
+
+  RenderLock lock(*this);
+  const uint32_t index = listing.find(bare, isDirectory);
+  const auto it = std::lower_bound(visible.begin(), visible.end(), index);
+  if (it == visible.end() || *it != index) return 0;
+  return it - visible.begin();
 }
@@ -7,6 +7,7 @@
 #include "../Activity.h"
 #include "RecentBooksStore.h"
 #include "util/ButtonNavigator.h"
+#include "util/DirectoryListing.h"
 
 class FileBrowserActivity final : public Activity {
  private:
@@ -19,13 +20,18 @@ class FileBrowserActivity final : public Activity {
 
   bool lockLongPressBack = false;
 
-  // Files state
+  // Files state. Entries stay on the SD card in the cached listing; only the names around the visible page are held in
+  // memory (directories with a trailing '/').
   std::string basepath = "/";
-  std::vector<std::string> files;
+  DirectoryListing listing;
+  std::vector<uint32_t> visible;  // listing indices of the entries the browser shows
+  size_t windowStart = 0;
+  std::vector<std::string> windowNames;
 
   // Data loading
   void loadFiles();
-  size_t findEntry(const std::string& name) const;
+  const std::string& entryAt(size_t index);
+  size_t findEntry(const std::string& name);
 
  public:
   explicit FileBrowserActivity(GfxRenderer& renderer, MappedInputManager& mappedInput, std::string initialPath = "/")
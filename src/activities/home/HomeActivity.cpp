@@ -73,7 +73,17 @@ void HomeActivity::loadRecentCovers(int coverHeight) {
             popupRect = GUI.drawPopup(renderer, tr(STR_LOADING_POPUP));
           }
           GUI.fillPopupProgress(renderer, popupRect, 10 + progress * (90 / recentBooks.size()));
-          bool success = epub.generateThumbBmp(coverHeight);
+          // Decode the cover once for every theme's thumbnail, plus the sleep cover if this is the open book
+          Epub::CoverImageRequest request;
+          request.thumbHeights = UITheme::getInstance().getCoverThumbHeights();
+          if (book.path == APP_STATE.openEpubPath &&
+              (SETTINGS.sleepScreen == CrossPointSettings::SLEEP_SCREEN_MODE::COVER ||
+               SETTINGS.sleepScreen == CrossPointSettings::SLEEP_SCREEN_MODE::COVER_CUSTOM)) {
+            const bool cropped = SETTINGS.sleepScreenCoverMode == CrossPointSettings::SLEEP_SCREEN_COVER_MODE::CROP;
+            request.cover = !cropped;
+            request.croppedCover = cropped;
+          }
+          bool success = epub.generateCoverImages(request);
           if (!success) {
             RECENT_BOOKS.updateBook(book.path, book.title, book.author, "");
             book.coverBmpPath = "";
@@ -6,6 +6,7 @@
 #include <WiFi.h>
 #include <esp_task_wdt.h>
 
+#include "BookIngestQueue.h"
 #include "MappedInputManager.h"
 #include "WifiSelectionActivity.h"
 #include "components/UITheme.h"
@@ -23,6 +24,7 @@ void CalibreConnectActivity::onEnter() {
   connectedIP.clear();
   connectedSSID.clear();
   lastHandleClientTime = 0;
+  lastTransferTime = 0;
   lastProgressReceived = 0;
   lastProgressTotal = 0;
   currentUploadName.clear();
@@ -126,6 +128,15 @@ void CalibreConnectActivity::loop() {
     }
     lastHandleClientTime = millis();
 
+    // Prepare received books in the gaps between transfers
+    if (webServer->isTransferInProgress()) {
+      lastTransferTime = millis();
+    } else if (millis() - lastTransferTime >= BookIngestQueue::IDLE_DELAY_MS && INGEST_QUEUE.hasPending()) {
+      esp_task_wdt_reset();
+      INGEST_QUEUE.processStep(renderer);
+      esp_task_wdt_reset();
+    }
+
     const auto status = webServer->getWsUploadStatus();
     bool changed = false;
     if (status.inProgress) {
@@ -20,6 +20,7 @@ class CalibreConnectActivity final : public Activity {
   std::string connectedIP;
   std::string connectedSSID;
   unsigned long lastHandleClientTime = 0;
+  unsigned long lastTransferTime = 0;  // last loop that saw a file being received
   size_t lastProgressReceived = 0;
   size_t lastProgressTotal = 0;
   std::string currentUploadName;
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 
+#include "BookIngestQueue.h"
 #include "MappedInputManager.h"
 #include "NetworkModeSelectionActivity.h"
 #include "WifiSelectionActivity.h"
@@ -44,6 +45,7 @@ void CrossPointWebServerActivity::onEnter() {
   connectedIP.clear();
   connectedSSID.clear();
   lastHandleClientTime = 0;
+  lastTransferTime = 0;
   requestUpdate();
 
   // Launch network mode selection subactivity
@@ -332,6 +334,15 @@ void CrossPointWebServerActivity::loop() {
         }
       }
       lastHandleClientTime = millis();
+
+      // Prepare received books in the gaps between transfers
+      if (webServer->isTransferInProgress()) {
+        lastTransferTime = millis();
+      } else if (millis() - lastTransferTime >= BookIngestQueue::IDLE_DELAY_MS && INGEST_QUEUE.hasPending()) {
+        esp_task_wdt_reset();
+        INGEST_QUEUE.processStep(renderer);
+        esp_task_wdt_reset();
+      }
     }
 
     // Handle exit on Back button (also check outside loop)
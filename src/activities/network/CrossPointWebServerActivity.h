@@ -43,6 +43,7 @@ class CrossPointWebServerActivity final : public Activity {
 
   // Performance monitoring
   unsigned long lastHandleClientTime = 0;
+  unsigned long lastTransferTime = 0;  // last loop that saw a file being received
 
   void renderServerRunning() const;
 
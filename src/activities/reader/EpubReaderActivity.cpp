@@ -8,6 +8,7 @@
 #include <HalStorage.h>
 #include <I18n.h>
 #include <Logging.h>
+#include <Perf.h>
 #include <esp_system.h>
 
 #include <limits>
@@ -19,6 +20,7 @@
 #include "EpubReaderPercentSelectionActivity.h"
 #include "KOReaderCredentialStore.h"
 #include "KOReaderSyncActivity.h"
+#include "LibraryCatalog.h"
 #include "MappedInputManager.h"
 #include "QrDisplayActivity.h"
 #include "ReaderUtils.h"
@@ -30,6 +32,11 @@
 namespace {
 // pagesPerRefresh now comes from SETTINGS.getRefreshFrequency()
 constexpr unsigned long skipChapterMs = 700;
+// Pages after the current one whose images are decoded into pixel caches while idle
+constexpr int IMAGE_PREFETCH_PAGES = 3;
+// Idle time after a render before pages are pre-rendered, and heap to leave free while doing it
+constexpr unsigned long RASTER_FILL_IDLE_MS = 1500;
+constexpr size_t RASTER_FILL_HEAP_RESERVE = 32 * 1024;
 // pages per minute, first item is 1 to prevent division by zero if accessed
 const std::vector<int> PAGE_TURN_LABELS = {1, 1, 3, 6, 12};
 
@@ -43,6 +50,30 @@ int clampPercent(int percent) {
   return percent;
 }
 
+// Everything besides the section file itself that changes the pixels of a pre-rendered page
+uint32_t rasterCacheKey(const int marginLeft, const int marginTop, const uint16_t viewportWidth,
+                        const uint16_t viewportHeight) {
+  const int32_t values[] = {SETTINGS.getReaderFontId(),
+                            static_cast<int32_t>(SETTINGS.getReaderLineCompression() * 1000),
+                            SETTINGS.extraParagraphSpacing,
+                            SETTINGS.paragraphAlignment,
+                            SETTINGS.hyphenationEnabled,
+                            SETTINGS.embeddedStyle,
+                            SETTINGS.imageRendering,
+                            SETTINGS.orientation,
+                            SETTINGS.textAntiAliasing,
+                            marginLeft,
+                            marginTop,
+                            viewportWidth,
+                            viewportHeight};
+  uint32_t hash = 2166136261u;
+  for (const int32_t value : values) {
+    hash ^= static_cast<uint32_t>(value);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 }  // namespace
 
 void EpubReaderActivity::onEnter() {
@@ -93,6 +124,7 @@ void EpubReaderActivity::onEnter() {
   APP_STATE.openEpubPath = epub->getPath();
   APP_STATE.saveToFile();
   RECENT_BOOKS.addBook(epub->getPath(), epub->getTitle(), epub->getAuthor(), epub->getThumbBmpPath());
+  LIBRARY.noteOpened(epub->getPath(), epub->getTitle(), epub->getAuthor());
 
   // Trigger first update
   requestUpdate();
@@ -104,8 +136,16 @@ void EpubReaderActivity::onExit() {
   // Reset orientation back to portrait for the rest of the UI
   renderer.setOrientation(GfxRenderer::Orientation::Portrait);
 
+  if (epub && epub->getBookSize() > 0 && section && section->pageCount > 0) {
+    const float chapterProgress = static_cast<float>(section->currentPage) / static_cast<float>(section->pageCount);
+    const float bookProgress = epub->calculateProgress(currentSpineIndex, chapterProgress) * 100.0f;
+    LIBRARY.noteProgress(epub->getPath(), static_cast<int>(bookProgress));
+  }
+
   APP_STATE.readerActivityLoadCount = 0;
   APP_STATE.saveToFile();
+  imagePrefetcher.cancel();
+  rasterCache.close();
   section.reset();
   epub.reset();
 }
@@ -117,6 +157,12 @@ void EpubReaderActivity::loop() {
     return;
   }
 
+  // Any input preempts background image decoding so the SD card and CPU are free for the reaction. The prefetcher
+  // guards its own job state, so this does not need the render lock.
+  if (mappedInput.wasAnyPressed() || mappedInput.wasAnyReleased()) {
+    imagePrefetcher.cancel();
+  }
+
   if (automaticPageTurnActive) {
     if (mappedInput.wasReleased(MappedInputManager::Button::Confirm) ||
         mappedInput.wasReleased(MappedInputManager::Button::Back)) {
@@ -155,7 +201,7 @@ void EpubReaderActivity::loop() {
     const int bookProgressPercent = clampPercent(static_cast<int>(bookProgress + 0.5f));
     startActivityForResult(std::make_unique<EpubReaderMenuActivity>(
                                renderer, mappedInput, epub->getTitle(), currentPage, totalPages, bookProgressPercent,
-                               SETTINGS.orientation, !currentPageFootnotes.empty()),
+                               SETTINGS.orientation, !currentPageFootnotes.empty(), epub->getChapterParser()),
                            [this](const ActivityResult& result) {
                              // Always apply orientation change even if the menu was cancelled
                              const auto& menu = std::get<MenuResult>(result.data);
@@ -186,6 +232,7 @@ void EpubReaderActivity::loop() {
 
   auto [prevTriggered, nextTriggered, fromTilt] = ReaderUtils::detectPageTurn(mappedInput);
   if (!prevTriggered && !nextTriggered) {
+    fillRasterCache();
     return;
   }
 
@@ -374,6 +421,23 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
       onGoHome();
       return;
     }
+    case EpubReaderMenuActivity::MenuAction::CHAPTER_PARSER: {
+      {
+        RenderLock lock(*this);
+        const auto parser = epub->getChapterParser() == Epub::ChapterParser::Expat ? Epub::ChapterParser::PullTokenizer
+                                                                                     : Epub::ChapterParser::Expat;
+        epub->setChapterParser(parser);
+        // Section files record the parser they were built with, so every chapter is rebuilt on its next load.
+        if (section) {
+          cachedSpineIndex = currentSpineIndex;
+          cachedChapterTotalPageCount = section->pageCount;
+          nextPageNumber = section->currentPage;
+        }
+        section.reset();
+      }
+      requestUpdate();
+      break;
+    }
     case EpubReaderMenuActivity::MenuAction::DELETE_CACHE: {
       {
         RenderLock lock(*this);
@@ -521,6 +585,8 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   if (!epub) {
     return;
   }
+  // The worker may be decoding an image this render is about to touch
+  imagePrefetcher.cancel();
 
   // edge case handling for sub-zero spine index
   if (currentSpineIndex < 0) {
@@ -541,27 +607,13 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   }
 
   // Apply screen viewable areas and additional padding
-  int orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft;
-  renderer.getOrientedViewableTRBL(&orientedMarginTop, &orientedMarginRight, &orientedMarginBottom,
-                                   &orientedMarginLeft);
-  orientedMarginTop += SETTINGS.screenMargin;
-  orientedMarginLeft += SETTINGS.screenMargin;
-  orientedMarginRight += SETTINGS.screenMargin;
-
-  const uint8_t statusBarHeight = UITheme::getInstance().getStatusBarHeight();
-
-  // reserves space for automatic page turn indicator when no status bar or progress bar only
-  if (automaticPageTurnActive &&
-      (statusBarHeight == 0 || statusBarHeight == UITheme::getInstance().getProgressBarHeight())) {
-    orientedMarginBottom +=
-        std::max(SETTINGS.screenMargin,
-                 static_cast<uint8_t>(statusBarHeight + UITheme::getInstance().getMetrics().statusBarVerticalMargin));
-  } else {
-    orientedMarginBottom += std::max(SETTINGS.screenMargin, statusBarHeight);
-  }
-
-  const uint16_t viewportWidth = renderer.getScreenWidth() - orientedMarginLeft - orientedMarginRight;
-  const uint16_t viewportHeight = renderer.getScreenHeight() - orientedMarginTop - orientedMarginBottom;
+  const auto viewport = ReaderUtils::getEpubViewport(renderer, automaticPageTurnActive);
+  const int orientedMarginTop = viewport.marginTop;
+  const int orientedMarginRight = viewport.marginRight;
+  const int orientedMarginBottom = viewport.marginBottom;
+  const int orientedMarginLeft = viewport.marginLeft;
+  const uint16_t viewportWidth = viewport.width;
+  const uint16_t viewportHeight = viewport.height;
 
   if (!section) {
     const auto filepath = epub->getSpineItem(currentSpineIndex).href;
@@ -635,6 +687,8 @@ void EpubReaderActivity::render(RenderLock&& lock) {
       section->currentPage = newPage;
       pendingPercentJump = false;
     }
+
+    openRasterCache(orientedMarginLeft, orientedMarginTop, viewportWidth, viewportHeight);
   }
 
   renderer.clearScreen();
@@ -678,6 +732,8 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   }
   silentIndexNextChapterIfNeeded(viewportWidth, viewportHeight);
   saveProgress(currentSpineIndex, section->currentPage, section->pageCount);
+  prefetchUpcomingImages(orientedMarginLeft, orientedMarginTop);
+  lastRenderTime = millis();
 
   if (pendingScreenshot) {
     pendingScreenshot = false;
@@ -717,6 +773,26 @@ void EpubReaderActivity::silentIndexNextChapterIfNeeded(const uint16_t viewportW
   }
 }
 
+void EpubReaderActivity::prefetchUpcomingImages(const int orientedMarginLeft, const int orientedMarginTop) {
+  if (!section) {
+    return;
+  }
+
+  std::vector<PageImagePrefetcher::Item> items;
+  const int lastPage = std::min(section->currentPage + IMAGE_PREFETCH_PAGES, section->pageCount - 1);
+  for (int pageIndex = section->currentPage + 1; pageIndex <= lastPage; pageIndex++) {
+    const auto page = section->peekPage(pageIndex);
+    if (!page || !page->hasImages()) continue;
+    for (const auto& element : page->elements) {
+      if (element->getTag() != TAG_PageImage) continue;
+      items.push_back({static_cast<const PageImage&>(*element).getImageBlock(),
+                       static_cast<int16_t>(element->xPos + orientedMarginLeft),
+                       static_cast<int16_t>(element->yPos + orientedMarginTop)});
+    }
+  }
+  imagePrefetcher.start(epub, std::move(items));
+}
+
 void EpubReaderActivity::saveProgress(int spineIndex, int currentPage, int pageCount) {
   FsFile f;
   if (Storage.openFileForWrite("ERS", epub->getCachePath() + "/progress.bin", f)) {
@@ -736,7 +812,13 @@ void EpubReaderActivity::saveProgress(int spineIndex, int currentPage, int pageC
 void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int orientedMarginTop,
                                         const int orientedMarginRight, const int orientedMarginBottom,
                                         const int orientedMarginLeft) {
+  if (rasterCache.hasPage(section->currentPage, SETTINGS.textAntiAliasing) &&
+      renderCachedPage(*page, orientedMarginLeft, orientedMarginTop)) {
+    return;
+  }
+
   const auto t0 = millis();
+  [[maybe_unused]] const uint32_t perfStart = PERF_NOW();
   auto* fcm = renderer.getFontCacheManager();
   fcm->resetStats();
 
@@ -748,6 +830,8 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   const uint32_t heapAfter = esp_get_free_heap_size();
   fcm->logStats("prewarm");
   const auto tPrewarm = millis();
+  [[maybe_unused]] const uint32_t perfPrewarm = PERF_NOW();
+  PERF_RECORD(PagePrewarm, perfStart, perfPrewarm - perfStart);
 
   LOG_DBG("ERS", "Heap: before=%lu after=%lu delta=%ld", heapBefore, heapAfter,
           (int32_t)heapAfter - (int32_t)heapBefore);
@@ -759,6 +843,7 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   renderStatusBar();
   fcm->logStats("bw_render");
   const auto tBwRender = millis();
+  PERF_RECORD(PageRender, perfPrewarm, PERF_NOW() - perfPrewarm);
 
   if (imagePageWithAA) {
     // Double FAST_REFRESH with selective image blanking (pablohc's technique):
@@ -784,13 +869,18 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   }
   const auto tDisplay = millis();
 
-  // Save bw buffer to reset buffer state after grayscale data sync
-  renderer.storeBwBuffer();
+  // Save bw buffer to reset buffer state after grayscale data sync. Only image pages are stored: a dense text page
+  // needs five snapshot chunks, and drawing its text again from the prewarmed font cache is cheaper than that.
+  // Without grayscale the frame stays as it is.
+  if (imagePageWithAA) {
+    renderer.storeBwBuffer();
+  }
   const auto tBwStore = millis();
 
   // grayscale rendering
   // TODO: Only do this if font supports it
   if (SETTINGS.textAntiAliasing) {
+    PERF_SCOPE(PageGrayscale);
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
@@ -810,8 +900,13 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
     renderer.setRenderMode(GfxRenderer::BW);
     fcm->logStats("gray");
 
-    // restore the bw data
-    renderer.restoreBwBuffer();
+    // restore the bw data, or draw it again for a text page or if there was no room to store it
+    if (!renderer.restoreBwBuffer()) {
+      renderer.clearScreen();
+      page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      renderStatusBar();
+      renderer.cleanupGrayscaleWithFrameBuffer();
+    }
     const auto tBwRestore = millis();
 
     const auto tEnd = millis();
@@ -821,8 +916,8 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
             tPrewarm - t0, tBwRender - tPrewarm, tDisplay - tBwRender, tBwStore - tDisplay, tGrayLsb - tBwStore,
             tGrayMsb - tGrayLsb, tGrayDisplay - tGrayMsb, tBwRestore - tGrayDisplay, tEnd - t0);
   } else {
-    // restore the bw data
-    renderer.restoreBwBuffer();
+    // The frame buffer still holds the BW page
+    renderer.cleanupGrayscaleWithFrameBuffer();
     const auto tBwRestore = millis();
 
     const auto tEnd = millis();
@@ -833,6 +928,134 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   }
 }
 
+bool EpubReaderActivity::renderCachedPage(const Page& page, const int orientedMarginLeft, const int orientedMarginTop) {
+  const auto t0 = millis();
+  uint8_t* frame = renderer.getFrameBuffer();
+  if (!rasterCache.readPlane(section->currentPage, PageRasterCache::BW, frame)) {
+    // The page is listed as cached, so its data is corrupt: drop it and let the idle fill store it again
+    rasterCache.dropPage(section->currentPage);
+    renderer.clearScreen();
+    return false;
+  }
+  renderStatusBar();
+  ReaderUtils::displayWithRefreshCycle(renderer, pagesUntilFullRefresh);
+  const auto tDisplay = millis();
+
+  if (SETTINGS.textAntiAliasing) {
+    // A gray plane that can't be read is rendered from the page instead, and the page is dropped from the cache
+    const auto drawGrayPlane = [&](const PageRasterCache::Plane plane, const GfxRenderer::RenderMode mode) {
+      if (rasterCache.readPlane(section->currentPage, plane, frame)) {
+        return;
+      }
+      rasterCache.dropPage(section->currentPage);
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(mode);
+      page.render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      renderer.setRenderMode(GfxRenderer::BW);
+    };
+    drawGrayPlane(PageRasterCache::GRAY_LSB, GfxRenderer::GRAYSCALE_LSB);
+    renderer.copyGrayscaleLsbBuffers();
+    drawGrayPlane(PageRasterCache::GRAY_MSB, GfxRenderer::GRAYSCALE_MSB);
+    renderer.copyGrayscaleMsbBuffers();
+    renderer.displayGrayBuffer();
+
+    // The BW plane is read from the cache again rather than stored in a snapshot around the gray passes
+    if (!rasterCache.readPlane(section->currentPage, PageRasterCache::BW, frame)) {
+      rasterCache.dropPage(section->currentPage);
+      renderer.clearScreen();
+      page.render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+    }
+    renderStatusBar();
+    renderer.cleanupGrayscaleWithFrameBuffer();
+  } else {
+    renderer.cleanupGrayscaleWithFrameBuffer();
+  }
+
+  LOG_DBG("ERS", "Page render (cached): bw=%lums total=%lums", tDisplay - t0, millis() - t0);
+  return true;
+}
+
+void EpubReaderActivity::openRasterCache(const int orientedMarginLeft, const int orientedMarginTop,
+                                         const uint16_t viewportWidth, const uint16_t viewportHeight) {
+  rasterCache.close();
+  if (!SETTINGS.pageRasterCache || section->pageCount == 0) {
+    return;
+  }
+  rasterMarginLeft = orientedMarginLeft;
+  rasterMarginTop = orientedMarginTop;
+  rasterFillPage = -1;
+  rasterCache.open(section->getRasterCachePath(),
+                   rasterCacheKey(orientedMarginLeft, orientedMarginTop, viewportWidth, viewportHeight),
+                   section->pageCount, renderer.getBufferSize());
+}
+
+void EpubReaderActivity::fillRasterCache() {
+  if (!SETTINGS.pageRasterCache || millis() - lastRenderTime < RASTER_FILL_IDLE_MS || RenderLock::peek()) {
+    return;
+  }
+
+  // Rendering draws through the shared renderer, so the render task must not run meanwhile
+  RenderLock lock(*this);
+  if (!section || !rasterCache.isOpen()) {
+    rasterFillPage = -1;
+    return;
+  }
+  if (rasterFillPage < 0) {
+    // Pages ahead of the current one come first
+    rasterFillPage = rasterCache.nextPageToFill((section->currentPage + 1) % section->pageCount);
+    rasterFillPlane = PageRasterCache::BW;
+    if (rasterFillPage < 0) {
+      return;
+    }
+  }
+  const size_t bufferSize = renderer.getBufferSize();
+  if (ESP.getMaxAllocHeap() < bufferSize + RASTER_FILL_HEAP_RESERVE) {
+    return;
+  }
+
+  const auto page = section->peekPage(rasterFillPage);
+  if (!page || page->hasImages()) {
+    // Image pages keep their own rendering path (see renderContents)
+    rasterCache.skipPage(rasterFillPage);
+    rasterFillPage = -1;
+    return;
+  }
+  auto* scratch = static_cast<uint8_t*>(malloc(bufferSize));
+  if (!scratch) {
+    return;
+  }
+
+  // One plane per call; the next loop iteration handles input before the next one
+  const auto start = millis();
+  const auto plane = static_cast<PageRasterCache::Plane>(rasterFillPlane);
+  const GfxRenderer::RenderMode modes[] = {GfxRenderer::BW, GfxRenderer::GRAYSCALE_LSB, GfxRenderer::GRAYSCALE_MSB};
+  memset(scratch, plane == PageRasterCache::BW ? 0xFF : 0x00, bufferSize);
+  renderer.setDrawTarget(scratch);
+  renderer.setRenderMode(modes[plane]);
+  page->render(renderer, SETTINGS.getReaderFontId(), rasterMarginLeft, rasterMarginTop);
+  renderer.setRenderMode(GfxRenderer::BW);
+  renderer.setDrawTarget(nullptr);
+  bool stored = rasterCache.appendPlane(rasterFillPage, plane, scratch);
+  free(scratch);
+
+  const bool lastPlane = plane == PageRasterCache::GRAY_MSB || !SETTINGS.textAntiAliasing;
+  if (stored && lastPlane) {
+    stored = rasterCache.commitPage(rasterFillPage);
+  }
+  if (!stored) {
+    LOG_ERR("ERS", "Failed to pre-render page %d, stopping", rasterFillPage);
+    rasterCache.close();
+    rasterFillPage = -1;
+    return;
+  }
+  LOG_DBG("ERS", "Pre-rendered plane %u of page %d in %lums", plane, rasterFillPage, millis() - start);
+  if (lastPlane) {
+    rasterFillPage = -1;
+  } else {
+    rasterFillPlane++;
+  }
+}
+
 void EpubReaderActivity::renderStatusBar() const {
   // Calculate progress in book
   const int currentPage = section->currentPage + 1;
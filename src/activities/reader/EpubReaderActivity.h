@@ -1,6 +1,8 @@
 #pragma once
 #include <Epub.h>
 #include <Epub/FootnoteEntry.h>
+#include <Epub/PageImagePrefetcher.h>
+#include <Epub/PageRasterCache.h>
 #include <Epub/Section.h>
 
 #include <optional>
@@ -30,6 +32,15 @@ class EpubReaderActivity final : public Activity {
   bool pendingScreenshot = false;
   bool skipNextButtonCheck = false;  // Skip button processing for one frame after subactivity exit
   bool automaticPageTurnActive = false;
+  PageImagePrefetcher imagePrefetcher{renderer};
+  // Pre-rendered pages of the current section, filled one plane per loop iteration while the reader is idle so input
+  // is handled between planes
+  PageRasterCache rasterCache;
+  int rasterMarginLeft = 0;
+  int rasterMarginTop = 0;
+  int rasterFillPage = -1;  // page whose planes are being stored, -1 between pages
+  uint8_t rasterFillPlane = 0;
+  unsigned long lastRenderTime = 0UL;
 
   // Footnote support
   std::vector<FootnoteEntry> currentPageFootnotes;
@@ -43,8 +54,12 @@ class EpubReaderActivity final : public Activity {
 
   void renderContents(std::unique_ptr<Page> page, int orientedMarginTop, int orientedMarginRight,
                       int orientedMarginBottom, int orientedMarginLeft);
+  bool renderCachedPage(const Page& page, int orientedMarginLeft, int orientedMarginTop);
   void renderStatusBar() const;
+  void openRasterCache(int orientedMarginLeft, int orientedMarginTop, uint16_t viewportWidth, uint16_t viewportHeight);
+  void fillRasterCache();
   void silentIndexNextChapterIfNeeded(uint16_t viewportWidth, uint16_t viewportHeight);
+  void prefetchUpcomingImages(int orientedMarginLeft, int orientedMarginTop);
   void saveProgress(int spineIndex, int currentPage, int pageCount);
   // Jump to a percentage of the book (0-100), mapping it to spine and page.
   void jumpToPercent(int percent);
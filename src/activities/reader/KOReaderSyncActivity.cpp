@@ -148,7 +148,7 @@ void KOReaderSyncActivity::performSync() {
 
   // If XPath carried a paragraph index, refine the page using the section cache's
   // per-page paragraph LUT instead of anchor matching.
-  if (remotePosition.hasParagraphIndex) {
+  if (remotePosition.hasParagraphIndex && !remotePosition.hasExactPage) {
     Section tempSection(epub, remotePosition.spineIndex, renderer);
     const auto paragraphPage = tempSection.getPageForParagraphIndex(remotePosition.paragraphIndex);
     if (paragraphPage.has_value()) {
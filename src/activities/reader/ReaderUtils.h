@@ -5,7 +5,11 @@
 #include <HalTiltSensor.h>
 #include <Logging.h>
 
+#include <algorithm>
+
 #include "MappedInputManager.h"
+#include "components/UITheme.h"
+#include "util/WakeFrame.h"
 
 namespace ReaderUtils {
 
@@ -30,6 +34,42 @@ inline void applyOrientation(GfxRenderer& renderer, const uint8_t orientation) {
   }
 }
 
+// Page area of the EPUB reader for the current settings and renderer orientation. Margins cover the panel's
+// non-viewable edges, the screen margin setting and the status bar.
+struct EpubViewport {
+  int marginTop;
+  int marginRight;
+  int marginBottom;
+  int marginLeft;
+  uint16_t width;
+  uint16_t height;
+};
+
+inline EpubViewport getEpubViewport(const GfxRenderer& renderer, const bool automaticPageTurnActive) {
+  EpubViewport viewport;
+  renderer.getOrientedViewableTRBL(&viewport.marginTop, &viewport.marginRight, &viewport.marginBottom,
+                                   &viewport.marginLeft);
+  viewport.marginTop += SETTINGS.screenMargin;
+  viewport.marginLeft += SETTINGS.screenMargin;
+  viewport.marginRight += SETTINGS.screenMargin;
+
+  const uint8_t statusBarHeight = UITheme::getInstance().getStatusBarHeight();
+
+  // reserves space for automatic page turn indicator when no status bar or progress bar only
+  if (automaticPageTurnActive &&
+      (statusBarHeight == 0 || statusBarHeight == UITheme::getInstance().getProgressBarHeight())) {
+    viewport.marginBottom +=
+        std::max(SETTINGS.screenMargin,
+                 static_cast<uint8_t>(statusBarHeight + UITheme::getInstance().getMetrics().statusBarVerticalMargin));
+  } else {
+    viewport.marginBottom += std::max(SETTINGS.screenMargin, statusBarHeight);
+  }
+
+  viewport.width = renderer.getScreenWidth() - viewport.marginLeft - viewport.marginRight;
+  viewport.height = renderer.getScreenHeight() - viewport.marginTop - viewport.marginBottom;
+  return viewport;
+}
+
 struct PageTurnResult {
   bool prev;
   bool next;
@@ -54,7 +94,11 @@ inline PageTurnResult detectPageTurn(const MappedInputManager& input) {
 }
 
 inline void displayWithRefreshCycle(const GfxRenderer& renderer, int& pagesUntilFullRefresh) {
-  if (pagesUntilFullRefresh <= 1) {
+  if (WakeFrame::takeShown()) {
+    // The wake frame already put this page on screen with a half refresh; only the differences need drawing
+    renderer.displayBuffer();
+    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
+  } else if (pagesUntilFullRefresh <= 1) {
     renderer.displayBuffer(HalDisplay::HALF_REFRESH);
     pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
   } else {
@@ -65,15 +109,13 @@ inline void displayWithRefreshCycle(const GfxRenderer& renderer, int& pagesUntil
 
 // Grayscale anti-aliasing pass. Renders content twice (LSB + MSB) to build
 // the grayscale buffer. Only the content callback is re-rendered — status bars
-// and other overlays should be drawn before calling this.
+// and other overlays should be drawn before calling this. Once the grayscale
+// pass is on screen, redrawFn draws the whole BW frame again (content and
+// overlays): for a text page that is cheaper than storing the frame, which
+// would need several BwSnapshot chunks per page turn.
 // Kept as a template to avoid std::function overhead; instantiated once per reader type.
-template <typename RenderFn>
-void renderAntiAliased(GfxRenderer& renderer, RenderFn&& renderFn) {
-  if (!renderer.storeBwBuffer()) {
-    LOG_ERR("READER", "Failed to store BW buffer for anti-aliasing");
-    return;
-  }
-
+template <typename RenderFn, typename RedrawFn>
+void renderAntiAliased(GfxRenderer& renderer, RenderFn&& renderFn, RedrawFn&& redrawFn) {
   renderer.clearScreen(0x00);
   renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
   renderFn();
@@ -87,7 +129,9 @@ void renderAntiAliased(GfxRenderer& renderer, RenderFn&& renderFn) {
   renderer.displayGrayBuffer();
   renderer.setRenderMode(GfxRenderer::BW);
 
-  renderer.restoreBwBuffer();
+  renderer.clearScreen();
+  redrawFn();
+  renderer.cleanupGrayscaleWithFrameBuffer();
 }
 
 }  // namespace ReaderUtils
@@ -5,10 +5,14 @@
 #include <HalStorage.h>
 #include <I18n.h>
 #include <Serialization.h>
-#include <Utf8.h>
+
+#include <algorithm>
+#include <new>
 
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
+#include "EpubReaderPercentSelectionActivity.h"
+#include "LibraryCatalog.h"
 #include "MappedInputManager.h"
 #include "ReaderUtils.h"
 #include "RecentBooksStore.h"
@@ -16,10 +20,17 @@
 #include "fontIds.h"
 
 namespace {
-constexpr size_t CHUNK_SIZE = 8 * 1024;  // 8KB chunk for reading
 // Cache file magic and version
 constexpr uint32_t CACHE_MAGIC = 0x54585449;  // "TXTI"
-constexpr uint8_t CACHE_VERSION = 2;          // Increment when cache format changes
+constexpr uint8_t CACHE_VERSION = 4;          // Increment when cache format changes
+// Each block of this many bytes gets a checkpoint: the first line start at or after the block start
+constexpr size_t CHECKPOINT_SPACING = 16 * 1024;
+// How far a checkpoint search reads for a newline before settling for a word boundary
+constexpr size_t CHECKPOINT_SCAN = 4 * 1024;
+constexpr uint32_t NO_CHECKPOINT = UINT32_MAX;
+// Background pagination runs in short slices once the reader has been idle for a moment
+constexpr unsigned long INDEX_IDLE_MS = 1000;
+constexpr unsigned long INDEX_SLICE_MS = 50;
 }  // namespace
 
 void TxtReaderActivity::onEnter() {
@@ -39,6 +50,7 @@ void TxtReaderActivity::onEnter() {
   APP_STATE.openEpubPath = filePath;
   APP_STATE.saveToFile();
   RECENT_BOOKS.addBook(filePath, fileName, "", "");
+  LIBRARY.noteOpened(filePath, fileName, "");
 
   // Trigger first update
   requestUpdate();
@@ -50,8 +62,20 @@ void TxtReaderActivity::onExit() {
   // Reset orientation back to portrait for the rest of the UI
   renderer.setOrientation(GfxRenderer::Orientation::Portrait);
 
+  if (txt && initialized) {
+    // The background pass may have reached the position (or the end) since the last render
+    updatePageEstimate();
+    LIBRARY.noteProgress(txt->getPath(), static_cast<int>(progressPercent()));
+    // Keep what the background pass got through for next time
+    if (indexDirty) {
+      savePageIndexCache();
+    }
+  }
+
   pageOffsets.clear();
+  checkpoints.clear();
   currentPageLines.clear();
+  paginator.reset();
   APP_STATE.readerActivityLoadCount = 0;
   APP_STATE.saveToFile();
   txt.reset();
@@ -71,17 +95,44 @@ void TxtReaderActivity::loop() {
     return;
   }
 
+  // Confirm jumps to a percentage of the file
+  if (mappedInput.wasReleased(MappedInputManager::Button::Confirm) && initialized) {
+    const int percent = std::min(100, static_cast<int>(progressPercent() + 0.5f));
+    startActivityForResult(std::make_unique<EpubReaderPercentSelectionActivity>(renderer, mappedInput, percent),
+                           [this](const ActivityResult& result) {
+                             if (!result.isCancelled) {
+                               pendingPercent = std::get<PercentResult>(result.data).percent;
+                             }
+                           });
+    return;
+  }
+
   auto [prevTriggered, nextTriggered, fromTilt] = ReaderUtils::detectPageTurn(mappedInput);
   if (!prevTriggered && !nextTriggered) {
+    indexInBackground();
     return;
   }
 
-  if (prevTriggered && currentPage > 0) {
-    currentPage--;
+  if (prevTriggered && currentOffset > 0) {
+    {
+      RenderLock lock(*this);
+      if (currentPage >= 0 && static_cast<size_t>(currentPage) < pageOffsets.size() &&
+          pageOffsets[currentPage] < currentOffset) {
+        // Started within its exact page (after a jump): go back to where that page starts
+        setPosition(pageOffsets[currentPage], currentPage);
+      } else if (currentPage > 0 && static_cast<size_t>(currentPage) <= pageOffsets.size()) {
+        setPosition(pageOffsets[currentPage - 1], currentPage - 1);
+      } else {
+        setPosition(pageStartBefore(currentOffset), -1);
+      }
+    }
     requestUpdate();
   } else if (nextTriggered) {
-    if (currentPage < totalPages - 1) {
-      currentPage++;
+    if (nextPageOffset < txt->getFileSize()) {
+      {
+        RenderLock lock(*this);
+        setPosition(nextPageOffset, currentPage >= 0 ? currentPage + 1 : -1);
+      }
       requestUpdate();
     } else {
       onGoHome();
@@ -117,13 +168,29 @@ void TxtReaderActivity::initializeReader() {
 
   LOG_DBG("TRS", "Viewport: %dx%d, lines per page: %d", viewportWidth, viewportHeight, linesPerPage);
 
-  // Try to load cached page index first
+  const auto& fonts = renderer.getFontMap();
+  const auto fontIt = fonts.find(cachedFontId);
+  if (fontIt != fonts.end()) {
+    Txt* file = txt.get();
+    paginator.reset(new (std::nothrow) TxtPaginator(
+        fontIt->second, viewportWidth, txt->getFileSize(),
+        [file](uint8_t* buffer, const size_t offset, const size_t length) {
+          return file->readContent(buffer, offset, length);
+        }));
+  } else {
+    LOG_ERR("TRS", "Font %d not found", cachedFontId);
+  }
+
+  // Pick up the pagination done in earlier sessions; the rest is filled in while idle (see indexInBackground)
   if (!loadPageIndexCache()) {
-    // Cache not found, build page index
-    buildPageIndex();
-    // Save to cache for next time
-    savePageIndexCache();
+    pageOffsets.assign(1, 0);
+    indexResume = 0;
+    indexLineCount = 0;
+    indexComplete = false;
+    checkpoints.assign(txt->getFileSize() / CHECKPOINT_SPACING + 1, NO_CHECKPOINT);
+    checkpoints[0] = 0;
   }
+  nextCheckpointBlock = (indexResume + CHECKPOINT_SPACING - 1) / CHECKPOINT_SPACING;
 
   // Load saved progress
   loadProgress();
@@ -131,169 +198,226 @@ void TxtReaderActivity::initializeReader() {
   initialized = true;
 }
 
-void TxtReaderActivity::buildPageIndex() {
-  pageOffsets.clear();
-  pageOffsets.push_back(0);  // First page starts at offset 0
+void TxtReaderActivity::extendPageIndex(const unsigned long budgetMs) {
+  if (indexComplete || !paginator || !paginator->isValid()) {
+    return;
+  }
 
-  size_t offset = 0;
-  const size_t fileSize = txt->getFileSize();
+  const unsigned long start = millis();
+  bool stopped = false;
+  indexResume = paginator->layout(indexResume, [&](const size_t lineStart, const char*, size_t) {
+    if (indexLineCount == linesPerPage) {
+      pageOffsets.push_back(lineStart);
+      indexLineCount = 0;
+    }
+    indexLineCount++;
+    // Lines of the exact pass make the best checkpoints: they are where the pages from the start really break
+    for (; nextCheckpointBlock < checkpoints.size() && nextCheckpointBlock * CHECKPOINT_SPACING <= lineStart;
+         nextCheckpointBlock++) {
+      checkpoints[nextCheckpointBlock] = lineStart;
+    }
+    stopped = millis() - start >= budgetMs;
+    return !stopped;
+  });
+  indexDirty = true;
 
-  LOG_DBG("TRS", "Building page index for %zu bytes...", fileSize);
+  if (!stopped && indexResume >= txt->getFileSize()) {
+    indexComplete = true;
+    LOG_DBG("TRS", "Paginated %zu bytes: %zu pages", txt->getFileSize(), pageOffsets.size());
+  }
+  resolveCurrentPage();
+}
 
-  GUI.drawPopup(renderer, tr(STR_INDEXING));
+void TxtReaderActivity::resolveCurrentPage() {
+  if (currentPage >= 0 || pageOffsets.empty() || !(indexComplete || currentOffset < indexResume)) {
+    return;
+  }
+  // The exact page holding the one on screen. The offset stays so the screen does not change under the reader;
+  // loadPageAtOffset() ends this page where the next exact one starts, so page turns line up with the index again.
+  const auto next = std::upper_bound(pageOffsets.begin(), pageOffsets.end(), currentOffset);
+  currentPage = static_cast<int>(next - pageOffsets.begin()) - 1;
+}
 
-  while (offset < fileSize) {
-    std::vector<std::string> tempLines;
-    size_t nextOffset = offset;
+void TxtReaderActivity::indexInBackground() {
+  if (indexComplete || millis() - lastRenderTime < INDEX_IDLE_MS || RenderLock::peek()) {
+    return;
+  }
 
-    if (!loadPageAtOffset(offset, tempLines, nextOffset)) {
-      break;
-    }
+  // The paginator is shared with render(), so the render task must not run meanwhile
+  RenderLock lock(*this);
+  if (!initialized) {
+    return;
+  }
+  extendPageIndex(INDEX_SLICE_MS);
+  if (indexComplete) {
+    savePageIndexCache();
+  }
+}
 
-    if (nextOffset <= offset) {
-      // No progress made, avoid infinite loop
-      break;
-    }
+size_t TxtReaderActivity::checkpoint(const size_t block) {
+  if (block >= checkpoints.size()) {
+    return txt->getFileSize();
+  }
+  if (checkpoints[block] != NO_CHECKPOINT) {
+    return checkpoints[block];
+  }
 
-    offset = nextOffset;
-    if (offset < fileSize) {
-      pageOffsets.push_back(offset);
+  // The first newline from the byte before the block start on; a line always starts right after one
+  const size_t fileSize = txt->getFileSize();
+  const size_t from = block * CHECKPOINT_SPACING - 1;
+  size_t found = fileSize;
+  size_t wordStart = fileSize;
+  size_t charStart = fileSize;
+  uint8_t chunk[512];
+  for (size_t offset = from; offset < fileSize && offset < from + CHECKPOINT_SCAN && found == fileSize;
+       offset += sizeof(chunk)) {
+    const size_t length = std::min(sizeof(chunk), fileSize - offset);
+    if (!txt->readContent(chunk, offset, length)) {
+      break;
     }
-
-    // Yield to other tasks periodically
-    if (pageOffsets.size() % 20 == 0) {
-      vTaskDelay(1);
+    for (size_t i = 0; i < length; i++) {
+      if (chunk[i] == '\n') {
+        found = offset + i + 1;
+        break;
+      }
+      if (chunk[i] == ' ' && wordStart == fileSize) {
+        wordStart = offset + i + 1;
+      }
+      if (charStart == fileSize && offset + i > from && (chunk[i] & 0xC0) != 0x80) {
+        charStart = offset + i;
+      }
     }
   }
+  // A very long line has no newline nearby: start at a word (or at least a character) instead. Pages from there may
+  // not line up with the ones from the start of the file; loadPageAtOffset() lines them up once they are paginated.
+  if (found == fileSize) {
+    found = wordStart != fileSize ? wordStart : charStart;
+  }
 
-  totalPages = pageOffsets.size();
-  LOG_DBG("TRS", "Built page index: %d pages", totalPages);
+  checkpoints[block] = static_cast<uint32_t>(found);
+  indexDirty = true;
+  return found;
 }
 
 bool TxtReaderActivity::loadPageAtOffset(size_t offset, std::vector<std::string>& outLines, size_t& nextOffset) {
   outLines.clear();
-  const size_t fileSize = txt->getFileSize();
-
-  if (offset >= fileSize) {
-    return false;
-  }
-
-  // Read a chunk from file
-  size_t chunkSize = std::min(CHUNK_SIZE, fileSize - offset);
-  auto* buffer = static_cast<uint8_t*>(malloc(chunkSize + 1));
-  if (!buffer) {
-    LOG_ERR("TRS", "Failed to allocate %zu bytes", chunkSize);
+  nextOffset = txt->getFileSize();
+  if (!paginator || !paginator->isValid() || offset >= txt->getFileSize()) {
     return false;
   }
 
-  if (!txt->readContent(buffer, offset, chunkSize)) {
-    free(buffer);
-    return false;
-  }
-  buffer[chunkSize] = '\0';
-
-  // Parse lines from buffer
-  size_t pos = 0;
-
-  while (pos < chunkSize && static_cast<int>(outLines.size()) < linesPerPage) {
-    // Find end of line
-    size_t lineEnd = pos;
-    while (lineEnd < chunkSize && buffer[lineEnd] != '\n') {
-      lineEnd++;
+  // A page that did not start on an exact page start (a checkpoint after a jump) ends at the next one, so the page
+  // after it lines up with the index without repeating or skipping lines
+  size_t limit = txt->getFileSize();
+  if (indexComplete || offset < indexResume) {
+    const auto next = std::upper_bound(pageOffsets.begin(), pageOffsets.end(), offset);
+    if (next != pageOffsets.end()) {
+      limit = *next;
     }
+  }
 
-    // Check if we have a complete line
-    bool lineComplete = (lineEnd < chunkSize) || (offset + lineEnd >= fileSize);
-
-    if (!lineComplete && static_cast<int>(outLines.size()) > 0) {
-      // Incomplete line and we already have some lines, stop here
-      break;
+  // One line more than fits: where it starts is where the next page starts, as in extendPageIndex()
+  paginator->layout(offset, [&](const size_t start, const char* text, const size_t length) {
+    if (static_cast<int>(outLines.size()) == linesPerPage || (!outLines.empty() && start >= limit)) {
+      nextOffset = start;
+      return false;
     }
+    outLines.emplace_back(text, length);
+    return true;
+  });
 
-    // Calculate the actual length of line content in the buffer (excluding newline)
-    size_t lineContentLen = lineEnd - pos;
-
-    // Check for carriage return
-    bool hasCR = (lineContentLen > 0 && buffer[pos + lineContentLen - 1] == '\r');
-    size_t displayLen = hasCR ? lineContentLen - 1 : lineContentLen;
-
-    // Extract line content for display (without CR/LF)
-    std::string line(reinterpret_cast<char*>(buffer + pos), displayLen);
-
-    // Track position within this source line (in bytes from pos)
-    size_t lineBytePos = 0;
-
-    // Word wrap if needed
-    while (!line.empty() && static_cast<int>(outLines.size()) < linesPerPage) {
-      int lineWidth = renderer.getTextWidth(cachedFontId, line.c_str());
+  return !outLines.empty();
+}
 
-      if (lineWidth <= viewportWidth) {
-        outLines.push_back(line);
-        lineBytePos = displayLen;  // Consumed entire display content
-        line.clear();
-        break;
-      }
+void TxtReaderActivity::setPosition(const size_t offset, int page) {
+  if (page < 0 && !pageOffsets.empty() && (indexComplete || offset < indexResume)) {
+    // Paginated already: show the exact page holding `offset`, which a checkpoint may not have started on
+    page = static_cast<int>(std::upper_bound(pageOffsets.begin(), pageOffsets.end(), offset) - pageOffsets.begin()) - 1;
+    currentOffset = pageOffsets[page];
+  } else {
+    currentOffset = offset;
+  }
+  currentPage = page;
+}
 
-      // Find break point
-      size_t breakPos = line.length();
-      while (breakPos > 0 && renderer.getTextWidth(cachedFontId, line.substr(0, breakPos).c_str()) > viewportWidth) {
-        // Try to break at space
-        size_t spacePos = line.rfind(' ', breakPos - 1);
-        if (spacePos != std::string::npos && spacePos > 0) {
-          breakPos = spacePos;
-        } else {
-          // Break at character boundary for UTF-8
-          breakPos--;
-          // Make sure we don't break in the middle of a UTF-8 sequence
-          while (breakPos > 0 && (line[breakPos] & 0xC0) == 0x80) {
-            breakPos--;
-          }
+size_t TxtReaderActivity::pageStartBefore(const size_t offset) {
+  if (offset == 0 || !paginator || !paginator->isValid()) {
+    return 0;
+  }
+
+  // Lay out from the nearest checkpoint before `offset` and keep the last linesPerPage line starts before it,
+  // going back a block at a time while that is not a full page
+  std::vector<size_t> starts(linesPerPage);
+  for (size_t block = (offset - 1) / CHECKPOINT_SPACING;; block--) {
+    const size_t from = checkpoint(block);
+    if (from < offset) {
+      size_t count = 0;
+      paginator->layout(from, [&](const size_t start, const char*, size_t) {
+        if (start >= offset) {
+          return false;
         }
+        starts[count % linesPerPage] = start;
+        count++;
+        return true;
+      });
+      if (count >= static_cast<size_t>(linesPerPage)) {
+        return starts[count % linesPerPage];
       }
-
-      if (breakPos == 0) {
-        breakPos = 1;
-      }
-
-      outLines.push_back(line.substr(0, breakPos));
-
-      // Skip space at break point
-      size_t skipChars = breakPos;
-      if (breakPos < line.length() && line[breakPos] == ' ') {
-        skipChars++;
-      }
-      lineBytePos += skipChars;
-      line = line.substr(skipChars);
     }
-
-    // Determine how much of the source buffer we consumed
-    if (line.empty()) {
-      // Fully consumed this source line, move past the newline
-      pos = lineEnd + 1;
-    } else {
-      // Partially consumed - page is full mid-line
-      // Move pos to where we stopped in the line (NOT past the line)
-      pos = pos + lineBytePos;
-      break;
+    if (block == 0) {
+      return 0;
     }
   }
+}
 
-  // Ensure we make progress even if calculations go wrong
-  if (pos == 0 && !outLines.empty()) {
-    // Fallback: at minimum, consume something to avoid infinite loop
-    pos = 1;
+void TxtReaderActivity::jumpToPercent(const int percent) {
+  const size_t fileSize = txt->getFileSize();
+  const size_t target = fileSize / 100 * percent + fileSize % 100 * percent / 100;
+  if (percent <= 0 || fileSize == 0) {
+    setPosition(0, 0);
+    return;
+  }
+  if (indexComplete || target < indexResume) {
+    setPosition(target, -1);
+    return;
   }
 
-  nextOffset = offset + pos;
+  // Past the paginated part: start at the checkpoint nearest the target and paginate locally from there
+  const size_t block = std::min(target / CHECKPOINT_SPACING, checkpoints.size() - 1);
+  size_t offset = checkpoint(block);
+  if (block + 1 < checkpoints.size() && target - block * CHECKPOINT_SPACING > CHECKPOINT_SPACING / 2) {
+    offset = checkpoint(block + 1);
+  }
+  if (offset >= fileSize) {
+    offset = pageStartBefore(fileSize);
+  }
+  setPosition(offset, -1);
+}
 
-  // Make sure we don't go past the file
-  if (nextOffset > fileSize) {
-    nextOffset = fileSize;
+void TxtReaderActivity::updatePageEstimate() {
+  resolveCurrentPage();
+  if (indexComplete) {
+    totalPages = static_cast<int>(pageOffsets.size());
+    shownPage = std::max(0, std::min(currentPage, totalPages - 1));
+    return;
   }
 
-  free(buffer);
+  // Average page size of the paginated part, or of the page on screen until there is enough of it
+  size_t bytesPerPage = nextPageOffset > currentOffset ? nextPageOffset - currentOffset : 1;
+  if (pageOffsets.size() > 1) {
+    bytesPerPage = std::max<size_t>(1, pageOffsets.back() / (pageOffsets.size() - 1));
+  }
+  const auto estimatedPages = static_cast<int>((txt->getFileSize() + bytesPerPage - 1) / bytesPerPage);
+  shownPage = currentPage >= 0 ? currentPage : static_cast<int>(currentOffset / bytesPerPage);
+  totalPages = std::max({static_cast<int>(pageOffsets.size()), estimatedPages, shownPage + 1});
+}
 
-  return !outLines.empty();
+float TxtReaderActivity::progressPercent() const {
+  if (indexComplete) {
+    return totalPages > 0 ? (shownPage + 1) * 100.0f / totalPages : 0;
+  }
+  const size_t fileSize = txt->getFileSize();
+  return fileSize > 0 ? nextPageOffset * 100.0f / fileSize : 0;
 }
 
 void TxtReaderActivity::render(RenderLock&&) {
@@ -306,25 +430,29 @@ void TxtReaderActivity::render(RenderLock&&) {
     initializeReader();
   }
 
-  if (pageOffsets.empty()) {
+  if (pendingPercent >= 0) {
+    jumpToPercent(pendingPercent);
+    pendingPercent = -1;
+  }
+
+  // Load current page content
+  if (!loadPageAtOffset(currentOffset, currentPageLines, nextPageOffset) && currentOffset > 0) {
+    // Saved position past the end (e.g. the file was edited): show the last page
+    setPosition(pageStartBefore(txt->getFileSize()), -1);
+    loadPageAtOffset(currentOffset, currentPageLines, nextPageOffset);
+  }
+
+  if (currentPageLines.empty()) {
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, tr(STR_EMPTY_FILE), true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
     return;
   }
-
-  // Bounds check
-  if (currentPage < 0) currentPage = 0;
-  if (currentPage >= totalPages) currentPage = totalPages - 1;
-
-  // Load current page content
-  size_t offset = pageOffsets[currentPage];
-  size_t nextOffset;
-  currentPageLines.clear();
-  loadPageAtOffset(offset, currentPageLines, nextOffset);
+  updatePageEstimate();
 
   renderer.clearScreen();
   renderPage();
+  lastRenderTime = millis();
 
   // Save progress
   saveProgress();
@@ -382,46 +510,74 @@ void TxtReaderActivity::renderPage() {
   ReaderUtils::displayWithRefreshCycle(renderer, pagesUntilFullRefresh);
 
   if (SETTINGS.textAntiAliasing) {
-    ReaderUtils::renderAntiAliased(renderer, [&renderLines]() { renderLines(); });
+    ReaderUtils::renderAntiAliased(
+        renderer, [&renderLines]() { renderLines(); },
+        [this, &renderLines]() {
+          renderLines();
+          renderStatusBar();
+        });
   }
   // scope destructor clears font cache via FontCacheManager
 }
 
 void TxtReaderActivity::renderStatusBar() const {
-  const float progress = totalPages > 0 ? (currentPage + 1) * 100.0f / totalPages : 0;
   std::string title;
   if (SETTINGS.statusBarTitle != CrossPointSettings::STATUS_BAR_TITLE::HIDE_TITLE) {
     title = txt->getTitle();
   }
-  GUI.drawStatusBar(renderer, progress, currentPage + 1, totalPages, title);
+  GUI.drawStatusBar(renderer, progressPercent(), shownPage + 1, totalPages, title);
 }
 
 void TxtReaderActivity::saveProgress() const {
+  // Page (as shown, so possibly an estimate) followed by the byte offset of the page, which is what is restored
   FsFile f;
   if (Storage.openFileForWrite("TRS", txt->getCachePath() + "/progress.bin", f)) {
-    uint8_t data[4];
-    data[0] = currentPage & 0xFF;
-    data[1] = (currentPage >> 8) & 0xFF;
+    uint8_t data[8];
+    data[0] = shownPage & 0xFF;
+    data[1] = (shownPage >> 8) & 0xFF;
     data[2] = 0;
     data[3] = 0;
-    f.write(data, 4);
+    for (int i = 0; i < 4; i++) {
+      data[4 + i] = (currentOffset >> (8 * i)) & 0xFF;
+    }
+    f.write(data, 8);
   }
 }
 
 void TxtReaderActivity::loadProgress() {
   FsFile f;
-  if (Storage.openFileForRead("TRS", txt->getCachePath() + "/progress.bin", f)) {
-    uint8_t data[4];
-    if (f.read(data, 4) == 4) {
-      currentPage = data[0] + (data[1] << 8);
-      if (currentPage >= totalPages) {
-        currentPage = totalPages - 1;
-      }
-      if (currentPage < 0) {
-        currentPage = 0;
-      }
-      LOG_DBG("TRS", "Loaded progress: page %d/%d", currentPage, totalPages);
+  if (!Storage.openFileForRead("TRS", txt->getCachePath() + "/progress.bin", f)) {
+    setPosition(0, 0);
+    return;
+  }
+  uint8_t data[8];
+  const int read = f.read(data, 8);
+  f.close();
+
+  if (read == 8) {
+    size_t offset = data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<size_t>(data[7]) << 24);
+    if (offset >= txt->getFileSize()) {
+      offset = 0;
+    }
+    setPosition(offset, offset == 0 ? 0 : -1);
+    LOG_DBG("TRS", "Loaded progress: offset %zu", currentOffset);
+  } else if (read == 4) {
+    // Older progress files only have the page number: paginate up to it once
+    const size_t page = data[0] + (data[1] << 8);
+    if (!indexComplete && pageOffsets.size() <= page) {
+      GUI.drawPopup(renderer, tr(STR_INDEXING));
+      size_t resumedFrom;
+      do {
+        resumedFrom = indexResume;
+        extendPageIndex(INDEX_SLICE_MS);
+        vTaskDelay(1);
+      } while (!indexComplete && pageOffsets.size() <= page && indexResume != resumedFrom);
     }
+    const size_t last = pageOffsets.size() - 1;
+    setPosition(pageOffsets[std::min(page, last)], static_cast<int>(std::min(page, last)));
+    LOG_DBG("TRS", "Loaded progress: page %d", currentPage);
+  } else {
+    setPosition(0, 0);
   }
 }
 
@@ -435,8 +591,13 @@ bool TxtReaderActivity::loadPageIndexCache() {
   // - int32_t: font ID (to invalidate cache on font change)
   // - int32_t: screen margin (to invalidate cache on margin change)
   // - uint8_t: paragraph alignment (to invalidate cache on alignment change)
-  // - uint32_t: total pages count
+  // - uint8_t: 1 once the whole file is paginated
+  // - uint32_t: offset the background pagination continues from
+  // - int32_t: lines of the last page so far
+  // - uint32_t: pages paginated so far
   // - N * uint32_t: page offsets
+  // - uint32_t: checkpoint count (one per CHECKPOINT_SPACING bytes)
+  // - N * uint32_t: checkpoints (NO_CHECKPOINT where not found yet)
 
   std::string cachePath = txt->getCachePath() + "/index.bin";
   FsFile f;
@@ -502,8 +663,18 @@ bool TxtReaderActivity::loadPageIndexCache() {
     return false;
   }
 
+  uint8_t complete;
+  uint32_t resume;
+  int32_t lineCount;
   uint32_t numPages;
+  serialization::readPod(f, complete);
+  serialization::readPod(f, resume);
+  serialization::readPod(f, lineCount);
   serialization::readPod(f, numPages);
+  if (numPages == 0 || resume > fileSize) {
+    LOG_DBG("TRS", "Cache is damaged, rebuilding");
+    return false;
+  }
 
   // Read page offsets
   pageOffsets.clear();
@@ -515,12 +686,28 @@ bool TxtReaderActivity::loadPageIndexCache() {
     pageOffsets.push_back(offset);
   }
 
-  totalPages = pageOffsets.size();
-  LOG_DBG("TRS", "Loaded page index cache: %d pages", totalPages);
+  uint32_t numCheckpoints;
+  serialization::readPod(f, numCheckpoints);
+  if (numCheckpoints != fileSize / CHECKPOINT_SPACING + 1) {
+    LOG_DBG("TRS", "Cache checkpoint count mismatch, rebuilding");
+    return false;
+  }
+  checkpoints.resize(numCheckpoints);
+  const size_t checkpointBytes = numCheckpoints * sizeof(uint32_t);
+  if (f.read(checkpoints.data(), checkpointBytes) != static_cast<int>(checkpointBytes)) {
+    LOG_DBG("TRS", "Cache is truncated, rebuilding");
+    return false;
+  }
+
+  indexComplete = complete != 0;
+  indexResume = resume;
+  indexLineCount = lineCount;
+  indexDirty = false;
+  LOG_DBG("TRS", "Loaded page index cache: %zu pages%s", pageOffsets.size(), indexComplete ? "" : " so far");
   return true;
 }
 
-void TxtReaderActivity::savePageIndexCache() const {
+void TxtReaderActivity::savePageIndexCache() {
   std::string cachePath = txt->getCachePath() + "/index.bin";
   FsFile f;
   if (!Storage.openFileForWrite("TRS", cachePath, f)) {
@@ -537,6 +724,9 @@ void TxtReaderActivity::savePageIndexCache() const {
   serialization::writePod(f, static_cast<int32_t>(cachedFontId));
   serialization::writePod(f, static_cast<int32_t>(cachedScreenMargin));
   serialization::writePod(f, cachedParagraphAlignment);
+  serialization::writePod(f, static_cast<uint8_t>(indexComplete ? 1 : 0));
+  serialization::writePod(f, static_cast<uint32_t>(indexResume));
+  serialization::writePod(f, static_cast<int32_t>(indexLineCount));
   serialization::writePod(f, static_cast<uint32_t>(pageOffsets.size()));
 
   // Write page offsets
@@ -544,7 +734,11 @@ void TxtReaderActivity::savePageIndexCache() const {
     serialization::writePod(f, static_cast<uint32_t>(offset));
   }
 
-  LOG_DBG("TRS", "Saved page index cache: %d pages", totalPages);
+  serialization::writePod(f, static_cast<uint32_t>(checkpoints.size()));
+  f.write(checkpoints.data(), checkpoints.size() * sizeof(uint32_t));
+  indexDirty = false;
+
+  LOG_DBG("TRS", "Saved page index cache: %zu pages", pageOffsets.size());
 }
 
 ScreenshotInfo TxtReaderActivity::getScreenshotInfo() const {
@@ -554,9 +748,9 @@ ScreenshotInfo TxtReaderActivity::getScreenshotInfo() const {
     const std::string t = txt->getTitle();
     snprintf(info.title, sizeof(info.title), "%s", t.c_str());
   }
-  info.currentPage = currentPage + 1;
+  info.currentPage = shownPage + 1;
   info.totalPages = totalPages;
-  info.progressPercent = totalPages > 0 ? static_cast<int>((currentPage + 1) * 100.0f / totalPages + 0.5f) : 0;
+  info.progressPercent = txt ? static_cast<int>(progressPercent() + 0.5f) : 0;
   if (info.progressPercent > 100) info.progressPercent = 100;
   return info;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Txt.h>
+#include <TxtPaginator.h>
 
 #include <vector>
 
@@ -10,13 +11,29 @@
 class TxtReaderActivity final : public Activity {
   std::unique_ptr<Txt> txt;
 
-  int currentPage = 0;
-  int totalPages = 1;
   int pagesUntilFullRefresh = 0;
 
-  // Streaming text reader - stores file offsets for each page
-  std::vector<size_t> pageOffsets;  // File offset for start of each page
+  // Streaming text reader with lazy pagination. The page on screen is laid out from its byte offset; exact page
+  // starts from the beginning of the file are filled in while idle, and positions past them (after a jump or in a
+  // large file) start at checkpoints and carry an estimated page number until the background pass gets there.
+  std::vector<size_t> pageOffsets;  // start of each page paginated so far
+  size_t indexResume = 0;           // where the background pass continues
+  int indexLineCount = 0;           // lines of the last page in pageOffsets so far
+  bool indexComplete = false;
+  bool indexDirty = false;            // index or checkpoints changed since the cache was written
+  std::vector<uint32_t> checkpoints;  // per 16 KB block: first line start in it, found on demand
+  size_t nextCheckpointBlock = 0;     // next block the background pass gives its checkpoint
+
+  size_t currentOffset = 0;   // start of the page on screen
+  size_t nextPageOffset = 0;  // start of the page after it, or the file size
+  int currentPage = 0;        // exact page index, -1 while it is not known
+  int shownPage = 0;          // currentPage, or an estimate of it
+  int totalPages = 1;         // exact once indexComplete, an estimate before
+  int pendingPercent = -1;    // percent jump for the next render
+  unsigned long lastRenderTime = 0;
+
   std::vector<std::string> currentPageLines;
+  std::unique_ptr<TxtPaginator> paginator;  // lays out lines for the index and for each page
   int linesPerPage = 0;
   int viewportWidth = 0;
   bool initialized = false;
@@ -35,9 +52,20 @@ class TxtReaderActivity final : public Activity {
 
   void initializeReader();
   bool loadPageAtOffset(size_t offset, std::vector<std::string>& outLines, size_t& nextOffset);
-  void buildPageIndex();
+  // Makes the page at `offset` current; `page` is its index if known, else it is looked up (and snapped to) in the
+  // paginated part of the file
+  void setPosition(size_t offset, int page);
+  size_t pageStartBefore(size_t offset);
+  size_t checkpoint(size_t block);
+  void jumpToPercent(int percent);
+  void extendPageIndex(unsigned long budgetMs);
+  // Sets currentPage once the paginated part reaches the page on screen, if it was not known
+  void resolveCurrentPage();
+  void indexInBackground();
+  void updatePageEstimate();
+  float progressPercent() const;
   bool loadPageIndexCache();
-  void savePageIndexCache() const;
+  void savePageIndexCache();
   void saveProgress() const;
   void loadProgress();
 
@@ -12,10 +12,13 @@
 #include <HalStorage.h>
 #include <HalTiltSensor.h>
 #include <I18n.h>
+#include <Xtc/XtcPagePlanes.h>
 
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
+#include "LibraryCatalog.h"
 #include "MappedInputManager.h"
+#include "ReaderUtils.h"
 #include "RecentBooksStore.h"
 #include "XtcReaderChapterSelectionActivity.h"
 #include "components/UITheme.h"
@@ -24,6 +27,8 @@
 namespace {
 constexpr unsigned long skipPageMs = 700;
 constexpr unsigned long goHomeMs = 1000;
+// Heap left free while the prefetch buffer is held
+constexpr size_t prefetchHeapReserve = 40 * 1024;
 }  // namespace
 
 void XtcReaderActivity::onEnter() {
@@ -34,6 +39,7 @@ void XtcReaderActivity::onEnter() {
   }
 
   xtc->setupCacheDir();
+  pageMutex = xSemaphoreCreateMutex();
 
   // Load saved progress
   loadProgress();
@@ -42,6 +48,7 @@ void XtcReaderActivity::onEnter() {
   APP_STATE.openEpubPath = xtc->getPath();
   APP_STATE.saveToFile();
   RECENT_BOOKS.addBook(xtc->getPath(), xtc->getTitle(), xtc->getAuthor(), xtc->getThumbBmpPath());
+  LIBRARY.noteOpened(xtc->getPath(), xtc->getTitle(), xtc->getAuthor());
 
   // Trigger first update
   requestUpdate();
@@ -50,8 +57,17 @@ void XtcReaderActivity::onEnter() {
 void XtcReaderActivity::onExit() {
   Activity::onExit();
 
+  if (xtc && xtc->getPageCount() > 0) {
+    LIBRARY.noteProgress(xtc->getPath(), static_cast<int>((currentPage + 1) * 100 / xtc->getPageCount()));
+  }
+
   APP_STATE.readerActivityLoadCount = 0;
   APP_STATE.saveToFile();
+  freePageBuffers();
+  if (pageMutex) {
+    vSemaphoreDelete(pageMutex);
+    pageMutex = nullptr;
+  }
   xtc.reset();
 }
 
@@ -99,6 +115,7 @@ void XtcReaderActivity::loop() {
                                           powerPageTurn || mappedInput.wasReleased(MappedInputManager::Button::Right)));
 
   if (!prevTriggered && !nextTriggered) {
+    prefetchNextPage();
     return;
   }
 
@@ -166,33 +183,21 @@ void XtcReaderActivity::renderPage() {
     pageBufferSize = ((pageWidth + 7) / 8) * pageHeight;
   }
 
-  // Allocate page buffer
-  uint8_t* pageBuffer = static_cast<uint8_t*>(malloc(pageBufferSize));
-  if (!pageBuffer) {
-    LOG_ERR("XTR", "Failed to allocate page buffer (%lu bytes)", pageBufferSize);
-    renderer.clearScreen();
-    renderer.drawCenteredText(UI_12_FONT_ID, 300, tr(STR_MEMORY_ERROR), true, EpdFontFamily::BOLD);
-    renderer.displayBuffer();
-    return;
-  }
-
-  // Load page data
-  size_t bytesRead = xtc->loadPage(currentPage, pageBuffer, pageBufferSize);
-  if (bytesRead == 0) {
-    LOG_ERR("XTR", "Failed to load page %lu", currentPage);
-    free(pageBuffer);
+  if (!loadCurrentPage(pageBufferSize)) {
     renderer.clearScreen();
-    renderer.drawCenteredText(UI_12_FONT_ID, 300, tr(STR_PAGE_LOAD_ERROR), true, EpdFontFamily::BOLD);
+    const char* message = pageBuffer ? tr(STR_PAGE_LOAD_ERROR) : tr(STR_MEMORY_ERROR);
+    renderer.drawCenteredText(UI_12_FONT_ID, 300, message, true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
     return;
   }
 
-  // Clear screen first
-  renderer.clearScreen();
-
-  // Copy page bitmap using GfxRenderer's drawPixel
-  // XTC/XTCH pages are pre-rendered with status bar included, so render full page
-  const uint16_t maxSrcY = pageHeight;
+  // XTC/XTCH pages are pre-rendered with status bar included, so render full page.
+  // A full-screen page in portrait matches the panel's physical layout and is converted a byte (XTH) or an 8x8 block
+  // (XTG) at a time; other sizes and orientations go through drawPixel.
+  uint8_t* frame = renderer.getFrameBuffer();
+  const bool nativeLayout = renderer.getOrientation() == GfxRenderer::Portrait &&
+                            pageWidth == renderer.getDisplayHeight() && pageHeight == renderer.getDisplayWidth() &&
+                            pageWidth % 8 == 0 && pageHeight % 8 == 0;
 
   if (bitDepth == 2) {
     // XTH 2-bit mode: Two bit planes, column-major order
@@ -218,87 +223,58 @@ void XtcReaderActivity::renderPage() {
       return (bit1 << 1) | bit2;
     };
 
-    // Optimized grayscale rendering without storeBwBuffer (saves 48KB peak memory)
-    // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame
-
-    // Count pixel distribution for debugging
-    uint32_t pixelCounts[4] = {0, 0, 0, 0};
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        pixelCounts[getPixelValue(x, y)]++;
+    // Fills the frame buffer for one pass. In the grayscale passes a set bit applies the gray effect.
+    auto drawPass = [&](const xtc::PlanePass pass) {
+      if (nativeLayout && planeSize == renderer.getBufferSize()) {
+        xtc::composeXthPlane(plane1, plane2, planeSize, pass, frame);
+        return;
       }
-    }
-    LOG_DBG("XTR", "Pixel distribution: White=%lu, DarkGrey=%lu, LightGrey=%lu, Black=%lu", pixelCounts[0],
-            pixelCounts[1], pixelCounts[2], pixelCounts[3]);
-
-    // Pass 1: BW buffer - draw all non-white pixels as black
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
+      renderer.clearScreen(pass == xtc::PlanePass::Bw ? 0xFF : 0x00);
+      for (uint16_t y = 0; y < pageHeight; y++) {
+        for (uint16_t x = 0; x < pageWidth; x++) {
+          const uint8_t pv = getPixelValue(x, y);
+          if (pass == xtc::PlanePass::Bw && pv >= 1) {
+            renderer.drawPixel(x, y, true);
+          } else if (pass == xtc::PlanePass::GrayLsb && pv == 1) {  // Dark grey only
+            renderer.drawPixel(x, y, false);
+          } else if (pass == xtc::PlanePass::GrayMsb && (pv == 1 || pv == 2)) {  // Dark or light grey
+            renderer.drawPixel(x, y, false);
+          }
         }
       }
-    }
+    };
+
+    // Optimized grayscale rendering without storeBwBuffer (saves 48KB peak memory)
+    // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame
+    drawPass(xtc::PlanePass::Bw);
 
     // Display BW with conditional refresh based on pagesUntilFullRefresh
-    if (pagesUntilFullRefresh <= 1) {
-      renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-      pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-    } else {
-      renderer.displayBuffer();
-      pagesUntilFullRefresh--;
-    }
+    ReaderUtils::displayWithRefreshCycle(renderer, pagesUntilFullRefresh);
 
-    // Pass 2: LSB buffer - mark DARK gray only (XTH value 1)
-    // In LUT: 0 bit = apply gray effect, 1 bit = untouched
-    renderer.clearScreen(0x00);
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) == 1) {  // Dark grey only
-          renderer.drawPixel(x, y, false);
-        }
-      }
-    }
+    drawPass(xtc::PlanePass::GrayLsb);
     renderer.copyGrayscaleLsbBuffers();
-
-    // Pass 3: MSB buffer - mark LIGHT AND DARK gray (XTH value 1 or 2)
-    // In LUT: 0 bit = apply gray effect, 1 bit = untouched
-    renderer.clearScreen(0x00);
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        const uint8_t pv = getPixelValue(x, y);
-        if (pv == 1 || pv == 2) {  // Dark grey or Light grey
-          renderer.drawPixel(x, y, false);
-        }
-      }
-    }
+    drawPass(xtc::PlanePass::GrayMsb);
     renderer.copyGrayscaleMsbBuffers();
 
     // Display grayscale overlay
     renderer.displayGrayBuffer();
 
-    // Pass 4: Re-render BW to framebuffer (restore for next frame, instead of restoreBwBuffer)
-    renderer.clearScreen();
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
-        }
-      }
-    }
+    // Re-render BW to framebuffer (restore for next frame, instead of restoreBwBuffer)
+    drawPass(xtc::PlanePass::Bw);
 
     // Cleanup grayscale buffers with current frame buffer
     renderer.cleanupGrayscaleWithFrameBuffer();
 
-    free(pageBuffer);
-
     LOG_DBG("XTR", "Rendered page %lu/%lu (2-bit grayscale)", currentPage + 1, xtc->getPageCount());
     return;
+  } else if (nativeLayout && static_cast<size_t>(pageWidth) * pageHeight / 8 == renderer.getBufferSize()) {
+    xtc::transposeXtgPage(pageBuffer, pageWidth, pageHeight, frame);
   } else {
     // 1-bit mode: 8 pixels per byte, MSB first
     const size_t srcRowBytes = (pageWidth + 7) / 8;  // 60 bytes for 480 width
 
-    for (uint16_t srcY = 0; srcY < maxSrcY; srcY++) {
+    renderer.clearScreen();
+    for (uint16_t srcY = 0; srcY < pageHeight; srcY++) {
       const size_t srcRowStart = srcY * srcRowBytes;
 
       for (uint16_t srcX = 0; srcX < pageWidth; srcX++) {
@@ -313,22 +289,97 @@ void XtcReaderActivity::renderPage() {
       }
     }
   }
-  // White pixels are already cleared by clearScreen()
-
-  free(pageBuffer);
 
   // XTC pages already have status bar pre-rendered, no need to add our own
 
-  // Display with appropriate refresh
-  if (pagesUntilFullRefresh <= 1) {
-    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
+  // Display with appropriate refresh; the first page after waking skips its half refresh like the other readers
+  ReaderUtils::displayWithRefreshCycle(renderer, pagesUntilFullRefresh);
+
+  LOG_DBG("XTR", "Rendered page %lu/%lu (%u-bit)", currentPage + 1, xtc->getPageCount(), bitDepth);
+}
+
+bool XtcReaderActivity::loadCurrentPage(const size_t bufferSize) {
+  xSemaphoreTake(pageMutex, portMAX_DELAY);
+  if (pageBufferSize != bufferSize) {
+    freePageBuffers();
+  }
+  if (!pageBuffer) {
+    pageBuffer = static_cast<uint8_t*>(malloc(bufferSize));
+    if (!pageBuffer) {
+      LOG_ERR("XTR", "Failed to allocate page buffer (%lu bytes)", bufferSize);
+      xSemaphoreGive(pageMutex);
+      return false;
+    }
+    pageBufferSize = bufferSize;
+    LOG_DBG("XTR", "Page buffer %lu bytes", bufferSize);
+  }
+  // Given up when the heap ran low, taken again on a page turn once there is room
+  if (!prefetchBuffer && ESP.getMaxAllocHeap() >= bufferSize + prefetchHeapReserve) {
+    prefetchBuffer = static_cast<uint8_t*>(malloc(bufferSize));
+    LOG_DBG("XTR", "Prefetch %s", prefetchBuffer ? "on" : "off");
+  }
+  releasePrefetchIfLowHeap();
+
+  bool ok = true;
+  if (loadedPage == currentPage) {
+    // Redraw of the same page
+  } else if (prefetchBuffer && prefetchedPage == currentPage) {
+    // The old page stays in the prefetch buffer, ready for a turn back
+    std::swap(pageBuffer, prefetchBuffer);
+    prefetchedPage = loadedPage;
+    loadedPage = currentPage;
   } else {
-    renderer.displayBuffer();
-    pagesUntilFullRefresh--;
+    loadedPage = NO_PAGE;
+    if (xtc->loadPage(currentPage, pageBuffer, bufferSize) == 0) {
+      LOG_ERR("XTR", "Failed to load page %lu", currentPage);
+      ok = false;
+    } else {
+      loadedPage = currentPage;
+    }
   }
+  prefetchWanted = currentPage + 1 < xtc->getPageCount() ? currentPage + 1 : NO_PAGE;
+  xSemaphoreGive(pageMutex);
+  return ok;
+}
 
-  LOG_DBG("XTR", "Rendered page %lu/%lu (%u-bit)", currentPage + 1, xtc->getPageCount(), bitDepth);
+void XtcReaderActivity::releasePrefetchIfLowHeap() {
+  if (prefetchBuffer && ESP.getFreeHeap() < prefetchHeapReserve) {
+    // Something else needs the memory now (e.g. a menu or a network screen on top of the reader)
+    free(prefetchBuffer);
+    prefetchBuffer = nullptr;
+    prefetchedPage = NO_PAGE;
+    LOG_DBG("XTR", "Low heap (%u free), prefetch off", ESP.getFreeHeap());
+  }
+}
+
+void XtcReaderActivity::prefetchNextPage() {
+  if (!pageMutex || xSemaphoreTake(pageMutex, 0) != pdTRUE) {
+    return;
+  }
+  releasePrefetchIfLowHeap();
+  if (prefetchBuffer && prefetchWanted != NO_PAGE && prefetchWanted != prefetchedPage && prefetchWanted != loadedPage) {
+    const unsigned long start = millis();
+    prefetchedPage = NO_PAGE;
+    if (xtc->loadPage(prefetchWanted, prefetchBuffer, pageBufferSize) > 0) {
+      prefetchedPage = prefetchWanted;
+      LOG_DBG("XTR", "Prefetched page %lu in %lu ms", prefetchedPage + 1, millis() - start);
+    } else {
+      // Don't retry a page that fails to load; rendering it will report the error
+      prefetchWanted = NO_PAGE;
+    }
+  }
+  xSemaphoreGive(pageMutex);
+}
+
+void XtcReaderActivity::freePageBuffers() {
+  free(pageBuffer);
+  free(prefetchBuffer);
+  pageBuffer = nullptr;
+  prefetchBuffer = nullptr;
+  pageBufferSize = 0;
+  loadedPage = NO_PAGE;
+  prefetchedPage = NO_PAGE;
+  prefetchWanted = NO_PAGE;
 }
 
 void XtcReaderActivity::saveProgress() const {
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <Xtc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include "activities/Activity.h"
 
@@ -17,6 +19,24 @@ class XtcReaderActivity final : public Activity {
   uint32_t currentPage = 0;
   int pagesUntilFullRefresh = 0;
 
+  // Page bitmaps kept across renders. The prefetch buffer is only held while the heap has room for a second page: it
+  // is freed as soon as free heap drops below the reserve and taken again on a later page turn. The main loop fills it
+  // with the next page while the render task waits on the panel refresh.
+  static constexpr uint32_t NO_PAGE = UINT32_MAX;
+  uint8_t* pageBuffer = nullptr;
+  uint8_t* prefetchBuffer = nullptr;
+  size_t pageBufferSize = 0;
+  uint32_t loadedPage = NO_PAGE;
+  uint32_t prefetchedPage = NO_PAGE;
+  uint32_t prefetchWanted = NO_PAGE;
+  // Guards the parser and the prefetch bookkeeping between render() and loop()
+  SemaphoreHandle_t pageMutex = nullptr;
+
+  bool loadCurrentPage(size_t bufferSize);
+  void prefetchNextPage();
+  // Frees the prefetch buffer when free heap drops below the reserve. Call with pageMutex held.
+  void releasePrefetchIfLowHeap();
+  void freePageBuffers();
   void renderPage();
   void saveProgress() const;
   void loadProgress();
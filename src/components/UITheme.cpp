@@ -4,6 +4,7 @@
 #include <GfxRenderer.h>
 #include <Logging.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "MappedInputManager.h"
@@ -80,6 +81,17 @@ std::string UITheme::getCoverThumbPath(std::string coverBmpPath, int coverHeight
   return coverBmpPath;
 }
 
+std::vector<int> UITheme::getCoverThumbHeights() const {
+  std::vector<int> heights = {currentMetrics->homeCoverHeight};
+  for (const int height : {BaseMetrics::values.homeCoverHeight, LyraMetrics::values.homeCoverHeight,
+                           RoundedRaffMetrics::values.homeCoverHeight, Lyra3CoversMetrics::values.homeCoverHeight}) {
+    if (std::find(heights.begin(), heights.end(), height) == heights.end()) {
+      heights.push_back(height);
+    }
+  }
+  return heights;
+}
+
 UIIcon UITheme::getFileIcon(const std::string& filename) {
   if (filename.back() == '/') {
     return Folder;
@@ -11,23 +11,25 @@
 #include <HalTiltSensor.h>
 #include <I18n.h>
 #include <Logging.h>
+#include <Perf.h>
 #include <SPI.h>
 #include <builtinFonts/all.h>
 
 #include <cstring>
 
+#include "BookIngestQueue.h"
+#include "BootSnapshot.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
-#include "KOReaderCredentialStore.h"
+#include "LibraryCatalog.h"
 #include "MappedInputManager.h"
-#include "OpdsServerStore.h"
-#include "RecentBooksStore.h"
 #include "activities/Activity.h"
 #include "activities/ActivityManager.h"
 #include "components/UITheme.h"
 #include "fontIds.h"
 #include "util/ButtonNavigator.h"
 #include "util/ScreenshotUtil.h"
+#include "util/WakeFrame.h"
 
 MappedInputManager mappedInputManager(gpio);
 GfxRenderer renderer(display);
@@ -184,6 +186,11 @@ void enterDeepSleep() {
   HalPowerManager::Lock powerLock;  // Ensure we are at normal CPU frequency for sleep preparation
   APP_STATE.lastSleepFromReader = activityManager.isReaderActivity();
   APP_STATE.saveToFile();
+  if (APP_STATE.lastSleepFromReader) {
+    // Keep the page on screen for the next wake, before the sleep screen replaces it
+    RenderLock lock;
+    WakeFrame::save(renderer, APP_STATE.openEpubPath);
+  }
 
   activityManager.goToSleep();
 
@@ -229,11 +236,13 @@ void setupDisplayAndFonts() {
 
 void setup() {
   t1 = millis();
+  Perf::begin([]() { return static_cast<uint32_t>(micros()); });
 
   HalSystem::begin();
   gpio.begin();
   powerManager.begin();
   halTiltSensor.begin();
+  HalSystem::markBootPhase("hal");
 
 #ifdef ENABLE_SERIAL_LOG
   if (gpio.isUsbConnected()) {
@@ -257,13 +266,14 @@ void setup() {
   }
 
   HalSystem::checkPanic();
+  HalSystem::markBootPhase("storage");
 
-  SETTINGS.loadFromFile();
+  // Settings and app state come from one binary snapshot. KOReader, OPDS and recent books stores load on first use.
+  BootSnapshot::load();
   I18N.loadSettings();
-  KOREADER_STORE.loadFromFile();
-  OPDS_STORE.loadFromFile();
   UITheme::getInstance().reload();
   ButtonNavigator::setMappedInputManager(mappedInputManager);
+  HalSystem::markBootPhase("settings");
 
   const auto wakeupReason = gpio.getWakeupReason();
   switch (wakeupReason) {
@@ -288,19 +298,25 @@ void setup() {
   LOG_DBG("MAIN", "Starting CrossPoint version " CROSSPOINT_VERSION);
 
   setupDisplayAndFonts();
-
-  activityManager.goToBoot();
-
-  APP_STATE.loadFromFile();
-  RECENT_BOOKS.loadFromFile();
+  HalSystem::markBootPhase("display");
+
+  // Boot to home screen if no book is open, last sleep was not from reader, back button is held, or reader activity
+  // crashed (indicated by readerActivityLoadCount > 0)
+  const bool resumeReader = !HalSystem::isRebootFromPanic() && !APP_STATE.openEpubPath.empty() &&
+                            APP_STATE.lastSleepFromReader &&
+                            !mappedInputManager.isPressed(MappedInputManager::Button::Back) &&
+                            APP_STATE.readerActivityLoadCount == 0;
+
+  // Waking into a book shows its last page right away; the reader is rebuilt behind it
+  if (!resumeReader || !WakeFrame::show(renderer, APP_STATE.openEpubPath)) {
+    activityManager.goToBoot();
+  }
+  HalSystem::markBootPhase("frame");
 
   if (HalSystem::isRebootFromPanic()) {
     // If we rebooted from a panic, go to crash report screen to show the panic info
     activityManager.goToCrashReport();
-  } else if (APP_STATE.openEpubPath.empty() || !APP_STATE.lastSleepFromReader ||
-             mappedInputManager.isPressed(MappedInputManager::Button::Back) || APP_STATE.readerActivityLoadCount > 0) {
-    // Boot to home screen if no book is open, last sleep was not from reader, back button is held, or reader activity
-    // crashed (indicated by readerActivityLoadCount > 0)
+  } else if (!resumeReader) {
     activityManager.goHome();
   } else {
     // Clear app state to avoid getting into a boot loop if the epub doesn't load
@@ -310,9 +326,12 @@ void setup() {
     APP_STATE.saveToFile();
     activityManager.goToReader(path);
   }
+  HalSystem::markBootPhase("activity");
 
   // Ensure we're not still holding the power button before leaving setup
   waitForPowerRelease();
+  HalSystem::markBootPhase("setup");
+  LOG_INF("MAIN", "Boot phases (ms): %s", HalSystem::getBootPhases().c_str());
 }
 
 void loop() {
@@ -331,6 +350,12 @@ void loop() {
     lastMemPrint = millis();
   }
 
+  static unsigned long lastHeapSample = 0;
+  if (millis() - lastHeapSample >= 1000) {
+    Perf::sampleHeap(ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+    lastHeapSample = millis();
+  }
+
   // Handle incoming serial commands,
   // nb: we use logSerial from logging to avoid deprecation warnings
   if (logSerial.available() > 0) {
@@ -344,6 +369,12 @@ void loop() {
         uint8_t* buf = display.getFrameBuffer();
         logSerial.write(buf, bufferSize);
         logSerial.printf("SCREENSHOT_END\n");
+      } else if (cmd == "PERF") {
+        logSerial.printf("PERF:%s\n", Perf::toJson().c_str());
+      } else if (cmd == "PERF_TRACE") {
+        logSerial.printf("PERF_TRACE:%s\n", Perf::toChromeTrace().c_str());
+      } else if (cmd == "PERF_RESET") {
+        Perf::reset();
       }
     }
   }
@@ -406,6 +437,19 @@ void loop() {
   activityManager.loop();
   const unsigned long activityDuration = millis() - activityStartTime;
 
+  // Prepare books received over the network while nothing else is going on, then bring the library catalog up to
+  // date. The reader is skipped: it keeps the SD card busy with its own look-ahead work. Transfer screens run the
+  // queue themselves between transfers.
+  if (millis() - lastActivityTime >= BookIngestQueue::IDLE_DELAY_MS && !activityManager.isReaderActivity()) {
+    if (INGEST_QUEUE.hasPending()) {
+      powerManager.setPowerSaving(false);
+      INGEST_QUEUE.processStep(renderer);
+    } else if (LIBRARY.needsRescan()) {
+      powerManager.setPowerSaving(false);
+      LIBRARY.rescanStep();
+    }
+  }
+
   const unsigned long loopDuration = millis() - loopStartTime;
   if (loopDuration > maxLoopDuration) {
     maxLoopDuration = loopDuration;
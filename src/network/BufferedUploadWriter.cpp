@@ -0,0 +1,92 @@
+#include "BufferedUploadWriter.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+#include <esp_task_wdt.h>
+
+namespace {
+constexpr uint32_t WRITER_STACK_SIZE = 4096;
+// Same priority as the main loop: the two time-slice, and whichever is blocked (on the card or on the network) lets
+// the other run
+constexpr UBaseType_t WRITER_PRIORITY = 1;
+
+uint32_t nowMs() { return millis(); }
+void onProducerWait() { esp_task_wdt_reset(); }
+}  // namespace
+
+bool BufferedUploadWriter::RtosQueue::send(const uint8_t block) { return xQueueSend(handle, &block, 0) == pdTRUE; }
+
+bool BufferedUploadWriter::RtosQueue::receive(uint8_t& block, const uint32_t timeoutMs) {
+  return xQueueReceive(handle, &block, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+BufferedUploadWriter::BufferedUploadWriter() : pipeline(filledQueue, freeQueue, &nowMs, &onProducerWait) {}
+
+BufferedUploadWriter::~BufferedUploadWriter() {
+  abort();
+  if (filledQueue.handle) vQueueDelete(filledQueue.handle);
+  if (freeQueue.handle) vQueueDelete(freeQueue.handle);
+}
+
+bool BufferedUploadWriter::createQueues() {
+  if (!filledQueue.handle) filledQueue.handle = xQueueCreate(UploadPipeline::QUEUE_LENGTH, sizeof(uint8_t));
+  if (!freeQueue.handle) freeQueue.handle = xQueueCreate(UploadPipeline::QUEUE_LENGTH, sizeof(uint8_t));
+  return filledQueue.handle && freeQueue.handle;
+}
+
+bool BufferedUploadWriter::begin(FsFile file, const size_t expectedSize) {
+  if (isActive() || !file) {
+    return false;
+  }
+
+  // Contiguous clusters keep the FAT untouched while data streams in; not fatal if the card is too fragmented
+  if (expectedSize > 0 && !file.preAllocate(expectedSize)) {
+    LOG_DBG("UPL", "Pre-allocation of %u bytes failed, continuing without", expectedSize);
+  }
+
+  // The writer idles on the empty queue until the first block arrives. Without it the data is written through.
+  TaskHandle_t writerTask = nullptr;
+  if (!createQueues()) {
+    LOG_ERR("UPL", "Failed to create upload queues");
+  } else if (xTaskCreate(&writerTaskTrampoline, "UploadWriter", WRITER_STACK_SIZE, this, WRITER_PRIORITY,
+                         &writerTask) != pdPASS) {
+    LOG_ERR("UPL", "Failed to create upload writer task");
+    writerTask = nullptr;
+  }
+
+  sink.file = std::move(file);
+  if (!pipeline.begin(sink, writerTask != nullptr)) {
+    // Still blocked on the empty queue, holding nothing
+    if (writerTask) vTaskDelete(writerTask);
+    sink.file.close();
+    return false;
+  }
+  if (pipeline.isWritingThrough()) {
+    LOG_DBG("UPL", "No room for upload buffers (free heap: %d), writing through", ESP.getFreeHeap());
+  }
+  return true;
+}
+
+void BufferedUploadWriter::writerTaskTrampoline(void* param) {
+  static_cast<BufferedUploadWriter*>(param)->pipeline.runWriter();
+  vTaskDelete(nullptr);
+}
+
+bool BufferedUploadWriter::write(const uint8_t* data, const size_t length) { return pipeline.write(data, length); }
+
+bool BufferedUploadWriter::finish() {
+  if (!isActive()) {
+    return false;
+  }
+  const bool success = pipeline.finish();
+  sink.file.close();
+  return success;
+}
+
+void BufferedUploadWriter::abort() {
+  if (!isActive()) {
+    return;
+  }
+  pipeline.abort();
+  sink.file.close();
+}
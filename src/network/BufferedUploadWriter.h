@@ -0,0 +1,56 @@
+#pragma once
+#include <HalStorage.h>
+#include <UploadPipeline.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+// Writes an upload (or a download) to the SD card from a separate task while the network handler keeps receiving.
+//
+// The handler calls write() with whatever the HTTP/WebSocket layer delivered; the data travels in 8 KB blocks through
+// an UploadPipeline to a writer task that owns the file. Only one upload per instance at a time; queues are created on
+// first use and kept for the lifetime of the instance.
+class BufferedUploadWriter {
+ public:
+  BufferedUploadWriter();
+  ~BufferedUploadWriter();
+  BufferedUploadWriter(const BufferedUploadWriter&) = delete;
+  BufferedUploadWriter& operator=(const BufferedUploadWriter&) = delete;
+
+  // Takes over an open file positioned where the data goes (its end). expectedSize > 0 reserves that many bytes of
+  // contiguous clusters up front; only for an empty file. Without memory for the blocks or the writer task, write()
+  // writes through to the card instead. False only if the file is not open or an upload is active.
+  bool begin(FsFile file, size_t expectedSize);
+  // False once a block write failed (card full or removed); the caller should abort().
+  bool write(const uint8_t* data, size_t length);
+  // Waits for all data to reach the card and closes the file. True if every byte was written.
+  bool finish();
+  // Drops pending data and closes the file; removing the partial file is up to the caller.
+  void abort();
+
+  bool isActive() const { return pipeline.isActive(); }
+  // Live while active, final figures after finish()/abort()
+  UploadPipeline::Stats getStats() const { return pipeline.getStats(); }
+
+ private:
+  class RtosQueue final : public UploadPipeline::BlockQueue {
+   public:
+    QueueHandle_t handle = nullptr;
+    bool send(uint8_t block) override;
+    bool receive(uint8_t& block, uint32_t timeoutMs) override;
+  };
+
+  class FileSink final : public UploadPipeline::Sink {
+   public:
+    FsFile file;
+    size_t write(const uint8_t* data, size_t length) override { return file.write(data, length); }
+  };
+
+  RtosQueue filledQueue;
+  RtosQueue freeQueue;
+  FileSink sink;
+  UploadPipeline pipeline;
+
+  bool createQueues();
+  static void writerTaskTrampoline(void* param);
+};
@@ -5,19 +5,22 @@
 #include <FsHelpers.h>
 #include <HalStorage.h>
 #include <Logging.h>
+#include <Perf.h>
 #include <WiFi.h>
 #include <esp_task_wdt.h>
 
 #include <algorithm>
 
+#include "BookIngestQueue.h"
 #include "CrossPointSettings.h"
+#include "LibraryCatalog.h"
 #include "OpdsServerStore.h"
 #include "SettingsList.h"
-#include "WebDAVHandler.h"
 #include "html/FilesPageHtml.generated.h"
 #include "html/HomePageHtml.generated.h"
 #include "html/SettingsPageHtml.generated.h"
 #include "html/js/jszip_minJs.generated.h"
+#include "util/DirectoryListing.h"
 
 namespace {
 // Folders/files to hide from the web interface file browser
@@ -31,12 +34,11 @@ constexpr uint16_t LOCAL_UDP_PORT = 8134;
 CrossPointWebServer* wsInstance = nullptr;
 
 // WebSocket upload state
-FsFile wsUploadFile;
+BufferedUploadWriter wsUploadWriter;
 String wsUploadFileName;
 String wsUploadPath;
 size_t wsUploadSize = 0;
 size_t wsUploadReceived = 0;
-unsigned long wsUploadStartTime = 0;
 bool wsUploadInProgress = false;
 uint8_t wsUploadClientNum = 255;  // 255 = no active upload client
 size_t wsLastProgressSent = 0;
@@ -44,6 +46,10 @@ String wsLastCompleteName;
 size_t wsLastCompleteSize = 0;
 unsigned long wsLastCompleteAt = 0;
 
+// Throughput figures of the last finished upload (HTTP or WebSocket), reported by /api/status
+String lastUploadName;
+UploadPipeline::Stats lastUploadStats;
+
 // Helper function to clear epub cache after upload
 void clearEpubCacheIfNeeded(const String& filePath) {
   // Only clear cache for .epub files
@@ -139,6 +145,8 @@ void CrossPointWebServer::begin() {
 
   server->on("/api/status", HTTP_GET, [this] { handleStatus(); });
   server->on("/api/files", HTTP_GET, [this] { handleFileListData(); });
+  server->on("/api/library", HTTP_GET, [this] { handleLibraryData(); });
+  server->on("/api/perf", HTTP_GET, [this] { handlePerf(); });
   server->on("/download", HTTP_GET, [this] { handleDownload(); });
 
   // Upload endpoint with special handling for multipart form data
@@ -172,7 +180,8 @@ void CrossPointWebServer::begin() {
   // Collect WebDAV headers and register handler
   const char* davHeaders[] = {"Depth", "Destination", "Overwrite", "If", "Lock-Token", "Timeout"};
   server->collectHeaders(davHeaders, 6);
-  server->addHandler(new WebDAVHandler());  // Note: WebDAVHandler will be deleted by WebServer when server is stopped
+  davHandler = new WebDAVHandler();
+  server->addHandler(davHandler);  // Note: WebDAVHandler will be deleted by WebServer when server is stopped
   LOG_DBG("WEB", "WebDAV handler initialized");
 
   server->begin();
@@ -199,11 +208,12 @@ void CrossPointWebServer::begin() {
 }
 
 void CrossPointWebServer::abortWsUpload(const char* tag) {
-  // Explicit close() required: file-scope global persists beyond function scope
-  wsUploadFile.close();
+  // Explicit abort() required: file-scope global persists beyond function scope
+  wsUploadWriter.abort();
   String filePath = wsUploadPath;
   if (!filePath.endsWith("/")) filePath += "/";
   filePath += wsUploadFileName;
+  DirectoryListing::invalidateParent(filePath.c_str());
   if (Storage.remove(filePath.c_str())) {
     LOG_DBG(tag, "Deleted incomplete upload: %s", filePath.c_str());
   } else {
@@ -226,7 +236,7 @@ void CrossPointWebServer::stop() {
   LOG_DBG("WEB", "[MEM] Free heap before stop: %d bytes", ESP.getFreeHeap());
 
   // Close any in-progress WebSocket upload and remove partial file
-  if (wsUploadInProgress && wsUploadFile) {
+  if (wsUploadInProgress && wsUploadWriter.isActive()) {
     abortWsUpload("WEB");
   }
 
@@ -254,6 +264,7 @@ void CrossPointWebServer::stop() {
   delay(10);
 
   server.reset();
+  davHandler = nullptr;
   LOG_DBG("WEB", "Web server stopped and deleted");
   LOG_DBG("WEB", "[MEM] Free heap after delete server: %d bytes", ESP.getFreeHeap());
 
@@ -324,6 +335,10 @@ CrossPointWebServer::WsUploadStatus CrossPointWebServer::getWsUploadStatus() con
   return status;
 }
 
+bool CrossPointWebServer::isTransferInProgress() const {
+  return upload.writer.isActive() || wsUploadInProgress || (davHandler && davHandler->isPutInProgress());
+}
+
 static void sendHtmlContent(WebServer* server, const char* data, size_t len) {
   server->sendHeader("Content-Encoding", "gzip");
   server->send_P(200, "text/html", data, len);
@@ -358,35 +373,37 @@ void CrossPointWebServer::handleStatus() const {
   doc["freeHeap"] = ESP.getFreeHeap();
   doc["uptime"] = millis() / 1000;
 
+  // Upload throughput: the running upload if any, otherwise the last finished one
+  const bool httpActive = upload.writer.isActive();
+  const bool wsActive = wsUploadWriter.isActive();
+  if (httpActive || wsActive || !lastUploadName.isEmpty()) {
+    const UploadPipeline::Stats stats = httpActive ? upload.writer.getStats()
+                                        : wsActive ? wsUploadWriter.getStats()
+                                                   : lastUploadStats;
+    JsonObject uploadStats = doc["upload"].to<JsonObject>();
+    uploadStats["active"] = httpActive || wsActive;
+    uploadStats["name"] = httpActive ? upload.fileName : wsActive ? wsUploadFileName : lastUploadName;
+    uploadStats["bytes"] = stats.bytesWritten;
+    uploadStats["elapsedMs"] = stats.elapsedMs;
+    uploadStats["kbps"] = stats.bytesPerSecond() / 1024;
+    uploadStats["writes"] = stats.blockWrites;
+    uploadStats["writeMs"] = stats.writeMs;
+    uploadStats["maxWriteMs"] = stats.maxWriteMs;
+    uploadStats["stallMs"] = stats.stallMs;
+  }
+
   String json;
   serializeJson(doc, json);
   server->send(200, "application/json", json);
 }
 
-void CrossPointWebServer::scanFiles(const char* path, const std::function<void(FileInfo)>& callback) const {
-  FsFile root = Storage.open(path);
-  if (!root) {
-    LOG_DBG("WEB", "Failed to open directory: %s", path);
-    return;
-  }
-
-  if (!root.isDirectory()) {
-    LOG_DBG("WEB", "Not a directory: %s", path);
-    root.close();
-    return;
-  }
-
-  LOG_DBG("WEB", "Scanning files in: %s", path);
-
-  FsFile file = root.openNextFile();
-  char name[500];
-  while (file) {
-    file.getName(name, sizeof(name));
-    auto fileName = String(name);
-
+void CrossPointWebServer::scanFiles(DirectoryListing& listing, const uint32_t first, const uint32_t maxCount,
+                                   const std::function<void(FileInfo)>& callback) const {
+  listing.read(first, maxCount, [this, &callback](uint32_t, const DirectoryListing::Entry& entry) {
     // Skip hidden items (starting with ".")
-    bool shouldHide = !SETTINGS.showHiddenFiles && fileName.startsWith(".");
+    bool shouldHide = !SETTINGS.showHiddenFiles && (entry.flags & DirectoryListing::HIDDEN);
 
+    auto fileName = String(std::string(entry.name).c_str());
     // Check against explicitly hidden items list
     if (!shouldHide) {
       for (size_t i = 0; i < HIDDEN_ITEMS_COUNT; i++) {
@@ -400,25 +417,15 @@ void CrossPointWebServer::scanFiles(const char* path, const std::function<void(F
     if (!shouldHide) {
       FileInfo info;
       info.name = fileName;
-      info.isDirectory = file.isDirectory();
-
-      if (info.isDirectory) {
-        info.size = 0;
-        info.isEpub = false;
-      } else {
-        info.size = file.size();
-        info.isEpub = isEpubFile(info.name);
-      }
-
+      info.isDirectory = entry.isDirectory();
+      info.size = entry.size;
+      info.isEpub = !info.isDirectory && isEpubFile(info.name);
       callback(info);
     }
 
-    file.close();
-    yield();               // Yield to allow WiFi and other tasks to process during long scans
+    yield();               // Yield to allow WiFi and other tasks to process during long listings
     esp_task_wdt_reset();  // Reset watchdog to prevent timeout on large directories
-    file = root.openNextFile();
-  }
-  root.close();
+  });
 }
 
 bool CrossPointWebServer::isEpubFile(const String& filename) const { return FsHelpers::hasEpubExtension(filename); }
@@ -442,6 +449,16 @@ void CrossPointWebServer::handleFileListData() const {
     }
   }
 
+  // Optional paging over the sorted listing: entries [offset, offset + limit)
+  const uint32_t offset = server->hasArg("offset") ? std::max(0L, server->arg("offset").toInt()) : 0;
+  const uint32_t limit = server->hasArg("limit") ? std::max(0L, server->arg("limit").toInt()) : UINT32_MAX;
+
+  DirectoryListing listing;
+  if (!listing.open(currentPath.c_str())) {
+    LOG_DBG("WEB", "Failed to list directory: %s", currentPath.c_str());
+  }
+
+  server->sendHeader("X-Entry-Count", String(listing.size()));
   server->setContentLength(CONTENT_LENGTH_UNKNOWN);
   server->send(200, "application/json", "");
   server->sendContent("[");
@@ -450,7 +467,7 @@ void CrossPointWebServer::handleFileListData() const {
   bool seenFirst = false;
   JsonDocument doc;
 
-  scanFiles(currentPath.c_str(), [this, &output, &doc, seenFirst](const FileInfo& info) mutable {
+  scanFiles(listing, offset, limit, [this, &output, &doc, seenFirst](const FileInfo& info) mutable {
     doc.clear();
     doc["name"] = info.name;
     doc["size"] = info.size;
@@ -477,6 +494,69 @@ void CrossPointWebServer::handleFileListData() const {
   LOG_DBG("WEB", "Served file listing page for path: %s", currentPath.c_str());
 }
 
+void CrossPointWebServer::handleLibraryData() const {
+  auto order = LibraryCatalog::Order::Title;
+  if (server->hasArg("sort")) {
+    const String sort = server->arg("sort");
+    if (sort == "author") {
+      order = LibraryCatalog::Order::Author;
+    } else if (sort == "recent") {
+      order = LibraryCatalog::Order::LastRead;
+    } else if (sort != "title") {
+      server->send(400, "text/plain", "Invalid sort");
+      return;
+    }
+  }
+
+  const uint32_t offset = server->hasArg("offset") ? std::max(0L, server->arg("offset").toInt()) : 0;
+  const uint32_t limit = server->hasArg("limit") ? std::max(0L, server->arg("limit").toInt()) : UINT32_MAX;
+
+  server->sendHeader("X-Entry-Count", String(LIBRARY.size()));
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(200, "application/json", "");
+  server->sendContent("[");
+  char output[768];
+  constexpr size_t outputSize = sizeof(output);
+  bool seenFirst = false;
+  JsonDocument doc;
+
+  LIBRARY.read(order, offset, limit,
+               [this, &output, &doc, &seenFirst](uint32_t, const LibraryCatalog::Book& book) {
+                 doc.clear();
+                 doc["path"] = book.path;
+                 doc["title"] = book.title;
+                 doc["author"] = book.author;
+                 doc["size"] = book.size;
+                 doc["progress"] = book.progress;
+                 doc["opened"] = book.lastRead != 0;
+
+                 const size_t written = serializeJson(doc, output, outputSize);
+                 if (written >= outputSize) {
+                   LOG_DBG("WEB", "Skipping library entry with oversized JSON");
+                   return;
+                 }
+
+                 if (seenFirst) {
+                   server->sendContent(",");
+                 } else {
+                   seenFirst = true;
+                 }
+                 server->sendContent(output);
+               });
+  server->sendContent("]");
+  // End of streamed response, empty chunk to signal client
+  server->sendContent("");
+}
+
+void CrossPointWebServer::handlePerf() const {
+  const bool trace = server->hasArg("format") && server->arg("format") == "trace";
+  const std::string body = trace ? Perf::toChromeTrace() : Perf::toJson();
+  if (server->hasArg("reset") && server->arg("reset") == "1") {
+    Perf::reset();
+  }
+  server->send(200, "application/json", body.c_str());
+}
+
 void CrossPointWebServer::handleDownload() const {
   if (!server->hasArg("path")) {
     server->send(400, "text/plain", "Missing path");
@@ -559,28 +639,14 @@ void CrossPointWebServer::handleDownload() const {
   file.close();
 }
 
-// Diagnostic counters for upload performance analysis
-static unsigned long uploadStartTime = 0;
-static unsigned long totalWriteTime = 0;
-static size_t writeCount = 0;
-
-static bool flushUploadBuffer(CrossPointWebServer::UploadState& state) {
-  if (state.bufferPos > 0 && state.file) {
-    esp_task_wdt_reset();  // Reset watchdog before potentially slow SD write
-    const unsigned long writeStart = millis();
-    const size_t written = state.file.write(state.buffer.data(), state.bufferPos);
-    totalWriteTime += millis() - writeStart;
-    writeCount++;
-    esp_task_wdt_reset();  // Reset watchdog after SD write
-
-    if (written != state.bufferPos) {
-      LOG_DBG("WEB", "[UPLOAD] Buffer flush failed: expected %d, wrote %d", state.bufferPos, written);
-      state.bufferPos = 0;
-      return false;
-    }
-    state.bufferPos = 0;
-  }
-  return true;
+static void logUploadStats(const char* tag, const String& fileName, const UploadPipeline::Stats& stats) {
+  const float writePercent = stats.elapsedMs > 0 ? stats.writeMs * 100.0 / stats.elapsedMs : 0;
+  LOG_DBG(tag, "[UPLOAD] Complete: %s (%u bytes in %u ms, avg %.1f KB/s)", fileName.c_str(), stats.bytesWritten,
+          stats.elapsedMs, stats.bytesPerSecond() / 1024.0);
+  LOG_DBG(tag, "[UPLOAD] Diagnostics: %u writes, write time %u ms (%.1f%%), slowest %u ms, stalled %u ms",
+          stats.blockWrites, stats.writeMs, writePercent, stats.maxWriteMs, stats.stallMs);
+  lastUploadName = fileName;
+  lastUploadStats = stats;
 }
 
 void CrossPointWebServer::handleUpload(UploadState& state) const {
@@ -601,15 +667,14 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
     // Reset watchdog - this is the critical 1% crash point
     esp_task_wdt_reset();
 
+    // A previous upload the client dropped without an ABORTED callback
+    state.writer.abort();
+
     state.fileName = upload.filename;
     state.size = 0;
     state.success = false;
     state.error = "";
-    uploadStartTime = millis();
     lastLoggedSize = 0;
-    state.bufferPos = 0;
-    totalWriteTime = 0;
-    writeCount = 0;
 
     // Get upload path from query parameter (defaults to root if not specified)
     // Note: We use query parameter instead of form data because multipart form
@@ -627,8 +692,13 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
     } else {
       state.path = "/";
     }
+    // File size announced by the client, used to pre-allocate the file (the multipart Content-Length includes the
+    // form overhead, so it can't be used)
+    const long sizeArg = server->hasArg("size") ? server->arg("size").toInt() : 0;
+    const size_t expectedSize = sizeArg > 0 ? sizeArg : 0;
 
-    LOG_DBG("WEB", "[UPLOAD] START: %s to path: %s", state.fileName.c_str(), state.path.c_str());
+    LOG_DBG("WEB", "[UPLOAD] START: %s (%d bytes) to path: %s", state.fileName.c_str(), expectedSize,
+            state.path.c_str());
     LOG_DBG("WEB", "[UPLOAD] Free heap: %d bytes", ESP.getFreeHeap());
 
     // Create file path
@@ -646,85 +716,71 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
 
     // Open file for writing - this can be slow due to FAT cluster allocation
     esp_task_wdt_reset();
-    if (!Storage.openFileForWrite("WEB", filePath, state.file)) {
+    FsFile file;
+    if (!Storage.openFileForWrite("WEB", filePath, file)) {
       state.error = "Failed to create file on SD card";
       LOG_DBG("WEB", "[UPLOAD] FAILED to create file: %s", filePath.c_str());
       return;
     }
+    DirectoryListing::invalidateParent(filePath.c_str());
+    esp_task_wdt_reset();
+    if (!state.writer.begin(std::move(file), expectedSize)) {
+      state.error = "Failed to start writing the upload";
+      Storage.remove(filePath.c_str());
+      return;
+    }
     esp_task_wdt_reset();
 
     LOG_DBG("WEB", "[UPLOAD] File created successfully: %s", filePath.c_str());
   } else if (upload.status == UPLOAD_FILE_WRITE) {
-    if (state.file && state.error.isEmpty()) {
-      // Buffer incoming data and flush when buffer is full
-      // This reduces SD card write operations and improves throughput
-      const uint8_t* data = upload.buf;
-      size_t remaining = upload.currentSize;
-
-      while (remaining > 0) {
-        const size_t space = UploadState::UPLOAD_BUFFER_SIZE - state.bufferPos;
-        const size_t toCopy = (remaining < space) ? remaining : space;
-
-        memcpy(state.buffer.data() + state.bufferPos, data, toCopy);
-        state.bufferPos += toCopy;
-        data += toCopy;
-        remaining -= toCopy;
-
-        // Flush buffer when full
-        if (state.bufferPos >= UploadState::UPLOAD_BUFFER_SIZE) {
-          if (!flushUploadBuffer(state)) {
-            state.error = "Failed to write to SD card - disk may be full";
-            state.file.close();
-            return;
-          }
-        }
+    if (state.writer.isActive() && state.error.isEmpty()) {
+      // Hand the data to the writer task; this only waits when the SD card is behind by all buffered blocks
+      if (!state.writer.write(upload.buf, upload.currentSize)) {
+        state.error = "Failed to write to SD card - disk may be full";
+        state.writer.abort();
+        return;
       }
 
       state.size += upload.currentSize;
 
       // Log progress every 100KB
       if (state.size - lastLoggedSize >= 102400) {
-        const unsigned long elapsed = millis() - uploadStartTime;
-        const float kbps = (elapsed > 0) ? (state.size / 1024.0) / (elapsed / 1000.0) : 0;
-        LOG_DBG("WEB", "[UPLOAD] %d bytes (%.1f KB), %.1f KB/s, %d writes", state.size, state.size / 1024.0, kbps,
-                writeCount);
+        const auto stats = state.writer.getStats();
+        LOG_DBG("WEB", "[UPLOAD] %d bytes (%.1f KB), %.1f KB/s, %u writes, stalled %u ms", state.size,
+                state.size / 1024.0, stats.bytesPerSecond() / 1024.0, stats.blockWrites, stats.stallMs);
         lastLoggedSize = state.size;
       }
     }
   } else if (upload.status == UPLOAD_FILE_END) {
-    if (state.file) {
-      // Flush any remaining buffered data
-      if (!flushUploadBuffer(state)) {
+    if (state.writer.isActive()) {
+      // Write the partial last block and wait for the writer to drain
+      if (!state.writer.finish()) {
         state.error = "Failed to write final data to SD card";
       }
-      state.file.close();
 
       if (state.error.isEmpty()) {
         state.success = true;
-        const unsigned long elapsed = millis() - uploadStartTime;
-        const float avgKbps = (elapsed > 0) ? (state.size / 1024.0) / (elapsed / 1000.0) : 0;
-        const float writePercent = (elapsed > 0) ? (totalWriteTime * 100.0 / elapsed) : 0;
-        LOG_DBG("WEB", "[UPLOAD] Complete: %s (%d bytes in %lu ms, avg %.1f KB/s)", state.fileName.c_str(), state.size,
-                elapsed, avgKbps);
-        LOG_DBG("WEB", "[UPLOAD] Diagnostics: %d writes, total write time: %lu ms (%.1f%%)", writeCount, totalWriteTime,
-                writePercent);
+        logUploadStats("WEB", state.fileName, state.writer.getStats());
 
         // Clear epub cache to prevent stale metadata issues when overwriting files
         String filePath = state.path;
         if (!filePath.endsWith("/")) filePath += "/";
         filePath += state.fileName;
         clearEpubCacheIfNeeded(filePath);
+        // The listing may have been fetched while the upload was running, with the partial size
+        DirectoryListing::invalidateParent(filePath.c_str());
+        INGEST_QUEUE.enqueue(filePath.c_str());
       }
     }
   } else if (upload.status == UPLOAD_FILE_ABORTED) {
-    state.bufferPos = 0;  // Discard buffered data
-    if (state.file) {
-      state.file.close();
+    if (state.writer.isActive()) {
+      state.writer.abort();  // Discards buffered data
       // Try to delete the incomplete file
       String filePath = state.path;
       if (!filePath.endsWith("/")) filePath += "/";
       filePath += state.fileName;
       Storage.remove(filePath.c_str());
+      DirectoryListing::invalidateParent(filePath.c_str());
     }
     state.error = "Upload aborted";
     LOG_DBG("WEB", "Upload aborted");
@@ -782,6 +838,7 @@ void CrossPointWebServer::handleCreateFolder() const {
 
   // Create the folder
   if (Storage.mkdir(folderPath.c_str())) {
+    DirectoryListing::invalidate(parentPath.c_str());
     LOG_DBG("WEB", "Folder created successfully: %s", folderPath.c_str());
     server->send(200, "text/plain", "Folder created: " + folderName);
   } else {
@@ -864,6 +921,7 @@ void CrossPointWebServer::handleRename() const {
   file.close();
 
   if (success) {
+    DirectoryListing::invalidate(parentPath.c_str());
     LOG_DBG("WEB", "Renamed file: %s -> %s", itemPath.c_str(), newPath.c_str());
     server->send(200, "text/plain", "Renamed successfully");
   } else {
@@ -957,6 +1015,8 @@ void CrossPointWebServer::handleMove() const {
   file.close();
 
   if (success) {
+    DirectoryListing::invalidateParent(itemPath.c_str());
+    DirectoryListing::invalidate(destPath.c_str());
     LOG_DBG("WEB", "Moved file: %s -> %s", itemPath.c_str(), newPath.c_str());
     server->send(200, "text/plain", "Moved successfully");
   } else {
@@ -1067,6 +1127,7 @@ void CrossPointWebServer::handleDelete() const {
       }
       f.close();
       success = Storage.rmdir(itemPath.c_str());
+      if (success) DirectoryListing::invalidate(itemPath.c_str());
     } else {
       // It's a file (or couldn't open as dir) — remove file
       if (f) f.close();
@@ -1077,6 +1138,8 @@ void CrossPointWebServer::handleDelete() const {
     if (!success) {
       failedItems += itemPath + " (deletion failed); ";
       allSuccess = false;
+    } else {
+      DirectoryListing::invalidateParent(itemPath.c_str());
     }
   }
 
@@ -1386,7 +1449,7 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
       // Only clean up if this is the client that owns the active upload.
       // A new client may have already started a fresh upload before this
       // DISCONNECTED event fires (race condition on quick cancel + retry).
-      if (num == wsUploadClientNum && wsUploadInProgress && wsUploadFile) {
+      if (num == wsUploadClientNum && wsUploadInProgress && wsUploadWriter.isActive()) {
         abortWsUpload("WS");
       }
       break;
@@ -1403,7 +1466,7 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
 
       if (msg.startsWith("START:")) {
         // Reject any START while an upload is already active to prevent
-        // leaking the open wsUploadFile handle (owning client re-START included)
+        // leaking the open upload file handle (owning client re-START included)
         if (wsUploadInProgress) {
           wsServer->sendTXT(num, "ERROR:Upload already in progress");
           break;
@@ -1431,7 +1494,6 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
           wsUploadPath = msg.substring(secondColon + 1);
           wsUploadReceived = 0;
           wsLastProgressSent = 0;
-          wsUploadStartTime = millis();
 
           // Ensure path is valid
           if (!wsUploadPath.startsWith("/")) wsUploadPath = "/" + wsUploadPath;
@@ -1455,18 +1517,19 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
 
           // Open file for writing
           esp_task_wdt_reset();
-          if (!Storage.openFileForWrite("WS", filePath, wsUploadFile)) {
+          FsFile file;
+          if (!Storage.openFileForWrite("WS", filePath, file)) {
             wsServer->sendTXT(num, "ERROR:Failed to create file");
             wsUploadInProgress = false;
             wsUploadClientNum = 255;
             return;
           }
+          DirectoryListing::invalidateParent(filePath.c_str());
           esp_task_wdt_reset();
 
           // Zero-byte upload: complete immediately without waiting for BIN frames
           if (wsUploadSize == 0) {
-            // Explicit close() required: file-scope global persists beyond function scope
-            wsUploadFile.close();
+            file.close();
             wsLastCompleteName = wsUploadFileName;
             wsLastCompleteSize = 0;
             wsLastCompleteAt = millis();
@@ -1477,6 +1540,13 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
             break;
           }
 
+          if (!wsUploadWriter.begin(std::move(file), wsUploadSize)) {
+            Storage.remove(filePath.c_str());
+            wsServer->sendTXT(num, "ERROR:Failed to start writing");
+            return;
+          }
+          esp_task_wdt_reset();
+
           wsUploadClientNum = num;
           wsUploadInProgress = true;
           wsServer->sendTXT(num, "READY");
@@ -1488,12 +1558,12 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
     }
 
     case WStype_BIN: {
-      if (!wsUploadInProgress || !wsUploadFile || num != wsUploadClientNum) {
+      if (!wsUploadInProgress || !wsUploadWriter.isActive() || num != wsUploadClientNum) {
         wsServer->sendTXT(num, "ERROR:No upload in progress");
         return;
       }
 
-      // Write binary data directly to file
+      // Hand the chunk to the writer task; only blocks while the SD card is a full buffer set behind
       size_t remaining = wsUploadSize - wsUploadReceived;
       if (length > remaining) {
         abortWsUpload("WS");
@@ -1501,16 +1571,13 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
         return;
       }
       esp_task_wdt_reset();
-      size_t written = wsUploadFile.write(payload, length);
-      esp_task_wdt_reset();
-
-      if (written != length) {
+      if (!wsUploadWriter.write(payload, length)) {
         abortWsUpload("WS");
         wsServer->sendTXT(num, "ERROR:Write failed - disk full?");
         return;
       }
 
-      wsUploadReceived += written;
+      wsUploadReceived += length;
 
       // Send progress update (every 64KB or at end)
       if (wsUploadReceived - wsLastProgressSent >= 65536 || wsUploadReceived >= wsUploadSize) {
@@ -1521,8 +1588,13 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
 
       // Check if upload complete
       if (wsUploadReceived >= wsUploadSize) {
-        // Explicit close() required: file-scope global persists beyond function scope
-        wsUploadFile.close();
+        // Wait for the writer to drain; explicit finish() required: file-scope global persists beyond function scope
+        esp_task_wdt_reset();
+        if (!wsUploadWriter.finish()) {
+          abortWsUpload("WS");
+          wsServer->sendTXT(num, "ERROR:Write failed - disk full?");
+          return;
+        }
         wsUploadInProgress = false;
         wsUploadClientNum = 255;
 
@@ -1530,17 +1602,15 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
         wsLastCompleteSize = wsUploadSize;
         wsLastCompleteAt = millis();
 
-        unsigned long elapsed = millis() - wsUploadStartTime;
-        float kbps = (elapsed > 0) ? (wsUploadSize / 1024.0) / (elapsed / 1000.0) : 0;
-
-        LOG_DBG("WS", "Upload complete: %s (%d bytes in %lu ms, %.1f KB/s)", wsUploadFileName.c_str(), wsUploadSize,
-                elapsed, kbps);
+        logUploadStats("WS", wsUploadFileName, wsUploadWriter.getStats());
 
         // Clear epub cache to prevent stale metadata issues when overwriting files
         String filePath = wsUploadPath;
         if (!filePath.endsWith("/")) filePath += "/";
         filePath += wsUploadFileName;
         clearEpubCacheIfNeeded(filePath);
+        DirectoryListing::invalidateParent(filePath.c_str());
+        INGEST_QUEUE.enqueue(filePath.c_str());
 
         wsServer->sendTXT(num, "DONE");
         wsLastProgressSent = 0;
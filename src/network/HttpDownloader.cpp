@@ -1,93 +1,374 @@
 #include "HttpDownloader.h"
 
+#include <Arduino.h>
 #include <HTTPClient.h>
 #include <Logging.h>
 #include <NetworkClient.h>
 #include <NetworkClientSecure.h>
+#include <ResumableDownload.h>
 #include <StreamString.h>
 #include <base64.h>
+#include <mbedtls/sha256.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "BufferedUploadWriter.h"
+#include "util/DirectoryListing.h"
 #include "util/UrlUtils.h"
 
 namespace {
-class FileWriteStream final : public Stream {
+constexpr char PART_DIR[] = "/.crosspoint/downloads";
+// Interrupted downloads kept for resuming besides the current one; the directory is swept before each download
+constexpr size_t MAX_KEPT_PARTS = 4;
+
+uint32_t nowMs() { return millis(); }
+void delayMs(const uint32_t ms) { delay(ms); }
+
+std::unique_ptr<NetworkClient> makeClient(const std::string& url) {
+  if (UrlUtils::isHttpsUrl(url)) {
+    auto* secureClient = new NetworkClientSecure();
+    secureClient->setInsecure();
+    return std::unique_ptr<NetworkClient>(secureClient);
+  }
+  return std::unique_ptr<NetworkClient>(new NetworkClient());
+}
+
+void beginRequest(HTTPClient& http, NetworkClient& client, const std::string& url, const std::string& username,
+                  const std::string& password) {
+  http.begin(client, url.c_str());
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+
+  if (!username.empty() && !password.empty()) {
+    std::string credentials = username + ":" + password;
+    String encoded = base64::encode(credentials.c_str());
+    http.addHeader("Authorization", "Basic " + encoded);
+  }
+}
+
+// Partial download in /.crosspoint/downloads, named after the destination, written behind through 8 KB blocks
+class SdPartFile final : public ResumableDownload::PartFile {
  public:
-  FileWriteStream(FsFile& file, size_t total, HttpDownloader::ProgressCallback progress)
-      : file_(file), total_(total), progress_(std::move(progress)) {}
+  explicit SdPartFile(const std::string& destPath) : destPath(destPath), name(nameFor(destPath)) {
+    const std::string stem = std::string(PART_DIR) + "/" + name;
+    partPath = stem + ".part";
+    metaPath = stem + ".meta";
+    backupPath = stem + ".old";
+  }
 
-  size_t write(uint8_t byte) override { return write(&byte, 1); }
+  // File name in PART_DIR, without extension
+  static std::string nameFor(const std::string& destPath) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : destPath) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    char hex[20];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return hex;
+  }
+
+  const std::string& getName() const { return name; }
+
+  // A commit cut short by a power loss may have moved the old destination aside without putting the new file in
+  // its place: bring the old one back
+  void restoreBackup() {
+    if (!Storage.exists(backupPath.c_str())) {
+      return;
+    }
+    if (Storage.exists(destPath.c_str()) || !Storage.rename(backupPath.c_str(), destPath.c_str())) {
+      Storage.remove(backupPath.c_str());
+    }
+  }
+
+  size_t size() override { return openForRead() ? readFile.size() : 0; }
+
+  bool read(const size_t offset, uint8_t* data, const size_t length) override {
+    return openForRead() && readFile.seekSet(offset) && readFile.read(data, length) == static_cast<int>(length);
+  }
+
+  bool begin(const size_t keep, const size_t expectedSize) override {
+    readFile.close();
+    Storage.mkdir(PART_DIR);
+    FsFile file;
+    if (!openAt(keep, file)) {
+      LOG_ERR("HTTP", "Failed to open %s", partPath.c_str());
+      return false;
+    }
+    // Without memory for the blocks the writer writes through: slower, but the download still works
+    return writer.begin(std::move(file), keep == 0 ? expectedSize : 0);
+  }
+
+  bool write(const uint8_t* data, const size_t length) override { return writer.write(data, length); }
+
+  bool end() override { return writer.finish(); }
+
+  bool commit() override {
+    // The old file moves aside and is removed only once the new one is in its place, so a failed rename keeps it
+    const bool replacing = Storage.exists(destPath.c_str());
+    if (replacing) {
+      Storage.remove(backupPath.c_str());
+      if (!Storage.rename(destPath.c_str(), backupPath.c_str())) {
+        LOG_ERR("HTTP", "Failed to move %s aside", destPath.c_str());
+        return false;
+      }
+    }
+    if (!Storage.rename(partPath.c_str(), destPath.c_str())) {
+      LOG_ERR("HTTP", "Failed to move download to %s", destPath.c_str());
+      if (replacing) {
+        Storage.rename(backupPath.c_str(), destPath.c_str());
+      }
+      return false;
+    }
+    if (replacing) {
+      Storage.remove(backupPath.c_str());
+    }
+    Storage.remove(metaPath.c_str());
+    DirectoryListing::invalidateParent(destPath);
+    return true;
+  }
+
+  void discard() override {
+    readFile.close();
+    writer.abort();
+    Storage.remove(partPath.c_str());
+    Storage.remove(metaPath.c_str());
+  }
+
+  bool readMeta(std::string& data) override {
+    FsFile file;
+    if (!Storage.exists(metaPath.c_str()) || !Storage.openFileForRead("HTTP", metaPath, file)) {
+      return false;
+    }
+    data.resize(file.size());
+    const bool ok = file.read(&data[0], data.size()) == static_cast<int>(data.size());
+    file.close();
+    return ok;
+  }
+
+  bool writeMeta(const std::string& data) override {
+    FsFile file;
+    if (!Storage.openFileForWrite("HTTP", metaPath, file)) {
+      return false;
+    }
+    const bool ok = file.write(data.data(), data.size()) == data.size();
+    file.close();
+    return ok;
+  }
+
+  UploadPipeline::Stats getWriteStats() const { return writer.getStats(); }
+
+ private:
+  std::string destPath;
+  std::string name;
+  std::string partPath;
+  std::string metaPath;
+  std::string backupPath;
+  FsFile readFile;
+  BufferedUploadWriter writer;
+
+  bool openForRead() {
+    if (!readFile && Storage.exists(partPath.c_str())) {
+      readFile = Storage.open(partPath.c_str());
+    }
+    return static_cast<bool>(readFile);
+  }
+
+  bool openAt(const size_t keep, FsFile& file) const {
+    file = Storage.open(partPath.c_str(), O_RDWR | O_CREAT);
+    return file && file.truncate(keep) && file.seekSet(keep);
+  }
+};
 
-  size_t write(const uint8_t* buffer, size_t size) override {
-    // Write-through stream for HTTPClient::writeToStream with progress tracking.
-    const size_t written = file_.write(buffer, size);
-    if (written != size) {
-      writeOk_ = false;
+// Removes what no download can use any more: half of a partial download (a .part without its .meta or the other way
+// round) and backups whose commit went through. Of the resumable ones MAX_KEPT_PARTS are kept besides `keep`; FAT
+// lists entries about in creation order, so the oldest go first.
+void removeStaleParts(const std::string& keep) {
+  FsFile dir = Storage.open(PART_DIR);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+  std::vector<std::string> names;
+  char name[64];
+  for (auto entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    if (!entry.isDirectory() && entry.getName(name, sizeof(name)) > 0) {
+      names.emplace_back(name);
+    }
+    entry.close();
+  }
+  dir.close();
+
+  const auto has = [&names](const std::string& file) {
+    return std::find(names.begin(), names.end(), file) != names.end();
+  };
+  const auto remove = [](const std::string& file) { Storage.remove((std::string(PART_DIR) + "/" + file).c_str()); };
+  size_t kept = 0;
+  for (const auto& file : names) {
+    const size_t dot = file.rfind('.');
+    if (dot == std::string::npos) {
+      continue;
     }
-    downloaded_ += written;
-    if (progress_ && total_ > 0) {
-      progress_(downloaded_, total_);
+    const std::string stem = file.substr(0, dot);
+    const std::string extension = file.substr(dot);
+    if (extension == ".part") {
+      // A partial file with a backup is a commit cut short; restoreBackup() sorts it out on its next download
+      const bool resumable = has(stem + ".meta");
+      if (!resumable || (stem != keep && !has(stem + ".old") && ++kept > MAX_KEPT_PARTS)) {
+        LOG_DBG("HTTP", "Removing stale partial download %s", file.c_str());
+        remove(file);
+        if (resumable) {
+          remove(stem + ".meta");
+        }
+      }
+    } else if ((extension == ".meta" || extension == ".old") && !has(stem + ".part")) {
+      remove(file);
     }
-    return written;
   }
+}
+
+// Hands the body HTTPClient decoded (chunked or not) to the download
+class ReceiverStream final : public Stream {
+ public:
+  explicit ReceiverStream(ResumableDownload::Transport::Receiver& receiver) : receiver(receiver) {}
 
+  size_t write(uint8_t byte) override { return write(&byte, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override { return receiver.onData(buffer, size) ? size : 0; }
   int available() override { return 0; }
   int read() override { return -1; }
   int peek() override { return -1; }
-  void flush() override { file_.flush(); }
+  void flush() override {}
+
+ private:
+  ResumableDownload::Transport::Receiver& receiver;
+};
+
+class HttpRangeTransport final : public ResumableDownload::Transport {
+ public:
+  HttpRangeTransport(const std::string& username, const std::string& password)
+      : username(username), password(password) {}
+
+  bool get(const std::string& url, const size_t from, const std::string& ifRange, Receiver& receiver) override {
+    const auto client = makeClient(url);
+    HTTPClient http;
+    beginRequest(http, *client, url, username, password);
+    if (from > 0) {
+      http.addHeader("Range", ("bytes=" + std::to_string(from) + "-").c_str());
+      if (!ifRange.empty()) {
+        http.addHeader("If-Range", ifRange.c_str());
+      }
+    }
+    const char* headers[] = {"ETag", "Last-Modified", "Content-Range", "Digest", "Repr-Digest"};
+    http.collectHeaders(headers, 5);
+
+    const int httpCode = http.GET();
+    if (httpCode <= 0) {
+      LOG_ERR("HTTP", "Request failed: %d", httpCode);
+      http.end();
+      return false;
+    }
+
+    Response response;
+    response.status = httpCode;
+    response.contentLength = http.getSize();
+    response.contentRange = http.header("Content-Range").c_str();
+    response.etag = http.header("ETag").c_str();
+    response.lastModified = http.header("Last-Modified").c_str();
+    response.digest = http.header("Digest").c_str();
+    const String reprDigest = http.header("Repr-Digest");
+    if (reprDigest.length() > 0) {
+      response.digest += (response.digest.empty() ? "" : ",") + std::string(reprDigest.c_str());
+    }
+    if (!receiver.onResponse(response)) {
+      LOG_ERR("HTTP", "Download failed: %d", httpCode);
+      http.end();
+      return false;
+    }
 
-  size_t downloaded() const { return downloaded_; }
-  bool ok() const { return writeOk_; }
+    ReceiverStream stream(receiver);
+    const int writeResult = http.writeToStream(&stream);
+    http.end();
+    if (writeResult < 0) {
+      LOG_ERR("HTTP", "writeToStream error: %d", writeResult);
+      return false;
+    }
+    return true;
+  }
 
  private:
-  FsFile& file_;
-  size_t total_;
-  size_t downloaded_ = 0;
-  bool writeOk_ = true;
-  HttpDownloader::ProgressCallback progress_;
+  const std::string& username;
+  const std::string& password;
 };
-}  // namespace
 
-bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent, const std::string& username,
-                              const std::string& password) {
-  std::unique_ptr<NetworkClient> client;
-  if (UrlUtils::isHttpsUrl(url)) {
-    auto* secureClient = new NetworkClientSecure();
-    secureClient->setInsecure();
-    client.reset(secureClient);
-  } else {
-    client.reset(new NetworkClient());
+class Sha256Hasher final : public ResumableDownload::Hasher {
+ public:
+  Sha256Hasher() { mbedtls_sha256_init(&context); }
+  ~Sha256Hasher() override { mbedtls_sha256_free(&context); }
+
+  void begin() override {
+    mbedtls_sha256_free(&context);
+    mbedtls_sha256_init(&context);
+    mbedtls_sha256_starts(&context, 0);
   }
+  void update(const uint8_t* data, const size_t length) override { mbedtls_sha256_update(&context, data, length); }
+  std::string finish() override {
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&context, digest);
+    return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+  }
+
+ private:
+  mbedtls_sha256_context context;
+};
+}  // namespace
+
+int HttpDownloader::fetchUrlIfModified(const std::string& url, Stream& outContent, std::string& etag,
+                                       std::string& lastModified, const std::string& username,
+                                       const std::string& password) {
+  const auto client = makeClient(url);
   HTTPClient http;
 
   LOG_DBG("HTTP", "Fetching: %s", url.c_str());
 
-  http.begin(*client, url.c_str());
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
-
-  if (!username.empty() && !password.empty()) {
-    std::string credentials = username + ":" + password;
-    String encoded = base64::encode(credentials.c_str());
-    http.addHeader("Authorization", "Basic " + encoded);
+  beginRequest(http, *client, url, username, password);
+  if (!etag.empty()) {
+    http.addHeader("If-None-Match", etag.c_str());
   }
+  if (!lastModified.empty()) {
+    http.addHeader("If-Modified-Since", lastModified.c_str());
+  }
+  const char* validatorHeaders[] = {"ETag", "Last-Modified"};
+  http.collectHeaders(validatorHeaders, 2);
 
   const int httpCode = http.GET();
+  if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+    LOG_DBG("HTTP", "Not modified");
+    http.end();
+    return httpCode;
+  }
   if (httpCode != HTTP_CODE_OK) {
     LOG_ERR("HTTP", "Fetch failed: %d", httpCode);
     http.end();
-    return false;
+    return httpCode;
   }
 
+  etag = http.header("ETag").c_str();
+  lastModified = http.header("Last-Modified").c_str();
   http.writeToStream(&outContent);
 
   http.end();
 
   LOG_DBG("HTTP", "Fetch success");
-  return true;
+  return httpCode;
+}
+
+bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent, const std::string& username,
+                              const std::string& password) {
+  std::string etag;
+  std::string lastModified;
+  return fetchUrlIfModified(url, outContent, etag, lastModified, username, password) == HTTP_CODE_OK;
 }
 
 bool HttpDownloader::fetchUrl(const std::string& url, std::string& outContent, const std::string& username,
@@ -103,92 +384,35 @@ bool HttpDownloader::fetchUrl(const std::string& url, std::string& outContent, c
 HttpDownloader::DownloadError HttpDownloader::downloadToFile(const std::string& url, const std::string& destPath,
                                                              ProgressCallback progress, const std::string& username,
                                                              const std::string& password) {
-  std::unique_ptr<NetworkClient> client;
-  if (UrlUtils::isHttpsUrl(url)) {
-    auto* secureClient = new NetworkClientSecure();
-    secureClient->setInsecure();
-    client.reset(secureClient);
-  } else {
-    client.reset(new NetworkClient());
-  }
-  HTTPClient http;
-
   LOG_DBG("HTTP", "Downloading: %s", url.c_str());
   LOG_DBG("HTTP", "Destination: %s", destPath.c_str());
 
-  http.begin(*client, url.c_str());
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
-
-  if (!username.empty() && !password.empty()) {
-    std::string credentials = username + ":" + password;
-    String encoded = base64::encode(credentials.c_str());
-    http.addHeader("Authorization", "Basic " + encoded);
-  }
-
-  const int httpCode = http.GET();
-  if (httpCode != HTTP_CODE_OK) {
-    LOG_ERR("HTTP", "Download failed: %d", httpCode);
-    http.end();
-    return HTTP_ERROR;
-  }
-
-  const int64_t reportedLength = http.getSize();
-  const size_t contentLength = reportedLength > 0 ? static_cast<size_t>(reportedLength) : 0;
-  if (contentLength > 0) {
-    LOG_DBG("HTTP", "Content-Length: %zu", contentLength);
-  } else {
-    LOG_DBG("HTTP", "Content-Length: unknown");
+  SdPartFile part(destPath);
+  part.restoreBackup();
+  removeStaleParts(part.getName());
+  HttpRangeTransport transport(username, password);
+  Sha256Hasher hasher;
+  ResumableDownload download(part, transport, &nowMs, &delayMs);
+  const auto result = download.run(url, &hasher, "", progress);
+
+  const auto& stats = download.getStats();
+  const auto writeStats = part.getWriteStats();
+  LOG_DBG("HTTP", "Download %s: %u bytes (%u resumed) in %u ms, avg %.1f KB/s",
+          result == ResumableDownload::Result::OK ? "complete" : "stopped", stats.fileSize, stats.bytesResumed,
+          stats.elapsedMs, stats.bytesPerSecond() / 1024.0);
+  LOG_DBG("HTTP", "Diagnostics: %u requests, %u restarts, write time %u ms, stalled %u ms, digest %s", stats.attempts,
+          stats.restarts, writeStats.writeMs, writeStats.stallMs, stats.verified ? "verified" : "not checked");
+
+  switch (result) {
+    case ResumableDownload::Result::OK:
+      return OK;
+    case ResumableDownload::Result::FILE_ERROR:
+      return FILE_ERROR;
+    case ResumableDownload::Result::INTEGRITY_ERROR:
+      LOG_ERR("HTTP", "Digest mismatch, download discarded");
+      return INTEGRITY_ERROR;
+    default:
+      LOG_ERR("HTTP", "Download failed, %u bytes kept for resuming", stats.fileSize);
+      return HTTP_ERROR;
   }
-
-  // Remove existing file if present
-  if (Storage.exists(destPath.c_str())) {
-    Storage.remove(destPath.c_str());
-  }
-
-  // Open file for writing
-  FsFile file;
-  if (!Storage.openFileForWrite("HTTP", destPath.c_str(), file)) {
-    LOG_ERR("HTTP", "Failed to open file for writing");
-    http.end();
-    return FILE_ERROR;
-  }
-
-  // Let HTTPClient handle chunked decoding and stream body bytes into the file.
-  FileWriteStream fileStream(file, contentLength, progress);
-  const int writeResult = http.writeToStream(&fileStream);
-
-  file.close();
-  http.end();
-
-  if (writeResult < 0) {
-    LOG_ERR("HTTP", "writeToStream error: %d", writeResult);
-    Storage.remove(destPath.c_str());
-    return HTTP_ERROR;
-  }
-
-  const size_t downloaded = fileStream.downloaded();
-  LOG_DBG("HTTP", "Downloaded %zu bytes", downloaded);
-
-  // Guard against partial writes even if HTTPClient completes.
-  if (!fileStream.ok()) {
-    LOG_ERR("HTTP", "Write failed during download");
-    Storage.remove(destPath.c_str());
-    return FILE_ERROR;
-  }
-
-  if (contentLength == 0 && downloaded == 0) {
-    LOG_ERR("HTTP", "Download failed: no data received");
-    Storage.remove(destPath.c_str());
-    return HTTP_ERROR;
-  }
-
-  // Verify download size if known
-  if (contentLength > 0 && downloaded != contentLength) {
-    LOG_ERR("HTTP", "Size mismatch: got %zu, expected %zu", downloaded, contentLength);
-    Storage.remove(destPath.c_str());
-    return HTTP_ERROR;
-  }
-
-  return OK;
 }
@@ -17,6 +17,7 @@ class HttpDownloader {
     HTTP_ERROR,
     FILE_ERROR,
     ABORTED,
+    INTEGRITY_ERROR,
   };
 
   /**
@@ -28,8 +29,20 @@ class HttpDownloader {
   static bool fetchUrl(const std::string& url, Stream& stream, const std::string& username = "",
                        const std::string& password = "");
 
+  /**
+   * Conditional fetch: non-empty `etag` / `lastModified` are sent as If-None-Match / If-Modified-Since.
+   * Returns the HTTP status (304 when the copy they describe is current, negative when the request failed).
+   * On 200 the body goes to `stream` and `etag` / `lastModified` are replaced with the response's.
+   */
+  static int fetchUrlIfModified(const std::string& url, Stream& stream, std::string& etag, std::string& lastModified,
+                                const std::string& username = "", const std::string& password = "");
+
   /**
    * Download a file to the SD card with optional credentials.
+   * The body is written behind through 8 KB blocks into a partial file under /.crosspoint/downloads, which replaces
+   * `destPath` only once complete. Dropped connections are resumed with Range requests; a failed download keeps its
+   * partial file and the next call for the same URL and path continues it. When the server sends a sha-256 Digest
+   * or Repr-Digest, the file is checked against it (INTEGRITY_ERROR on mismatch).
    */
   static DownloadError downloadToFile(const std::string& url, const std::string& destPath,
                                       ProgressCallback progress = nullptr, const std::string& username = "",
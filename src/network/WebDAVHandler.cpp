@@ -6,6 +6,9 @@
 #include <Logging.h>
 #include <esp_task_wdt.h>
 
+#include "BookIngestQueue.h"
+#include "util/DirectoryListing.h"
+
 namespace {
 const char* HIDDEN_ITEMS[] = {"System Volume Information", "XTCache"};
 constexpr size_t HIDDEN_ITEMS_COUNT = sizeof(HIDDEN_ITEMS) / sizeof(HIDDEN_ITEMS[0]);
@@ -80,6 +83,7 @@ void WebDAVHandler::raw(WebServer& server, const String& uri, HTTPRaw& raw) {
     String tempPath = _putPath + ".davtmp";
     Storage.remove(tempPath.c_str());
     _putOk = Storage.openFileForWrite("DAV", tempPath, _putFile);
+    DirectoryListing::invalidateParent(_putPath.c_str());
     LOG_DBG("DAV", "PUT START: %s", _putPath.c_str());
 
   } else if (raw.status == RAW_WRITE) {
@@ -105,12 +109,14 @@ void WebDAVHandler::raw(WebServer& server, const String& uri, HTTPRaw& raw) {
       }
       if (!_putOk) Storage.remove(tempPath.c_str());
     }
+    DirectoryListing::invalidateParent(_putPath.c_str());
     LOG_DBG("DAV", "PUT END: %u bytes, ok=%d", raw.totalSize, _putOk);
 
   } else if (raw.status == RAW_ABORTED) {
     if (_putFile) _putFile.close();
     String tempPath = _putPath + ".davtmp";
     Storage.remove(tempPath.c_str());
+    DirectoryListing::invalidateParent(_putPath.c_str());
     _putOk = false;
   }
 }
@@ -219,16 +225,15 @@ void WebDAVHandler::handlePropfind(WebServer& s) {
     return;
   }
 
-  // If depth > 0 and it's a directory, list children
-  if (depth > 0) {
-    FsFile file = root.openNextFile();
-    char name[500];
-    while (file) {
-      file.getName(name, sizeof(name));
-      String fileName(name);
+  root.close();
 
+  // If depth > 0 and it's a directory, list children
+  DirectoryListing listing;
+  if (depth > 0 && listing.open(path.c_str())) {
+    listing.read(0, listing.size(), [this, &s, &path](uint32_t, const DirectoryListing::Entry& entry) {
       // Skip hidden/protected items
-      bool shouldHide = fileName.startsWith(".");
+      bool shouldHide = entry.flags & DirectoryListing::HIDDEN;
+      const String fileName(std::string(entry.name).c_str());
       if (!shouldHide) {
         for (size_t i = 0; i < HIDDEN_ITEMS_COUNT; i++) {
           if (fileName.equals(HIDDEN_ITEMS[i])) {
@@ -242,22 +247,14 @@ void WebDAVHandler::handlePropfind(WebServer& s) {
         String childPath = path;
         if (!childPath.endsWith("/")) childPath += "/";
         childPath += fileName;
-
-        if (file.isDirectory()) {
-          sendPropEntry(s, childPath, true, 0, FIXED_DATE);
-        } else {
-          sendPropEntry(s, childPath, false, file.size(), FIXED_DATE);
-        }
+        sendPropEntry(s, childPath, entry.isDirectory(), entry.size, FIXED_DATE);
       }
 
-      file.close();
       yield();
       esp_task_wdt_reset();
-      file = root.openNextFile();
-    }
+    });
   }
 
-  root.close();
   s.sendContent("</D:multistatus>\n");
   s.sendContent("");
 }
@@ -381,11 +378,13 @@ void WebDAVHandler::handlePut(WebServer& s) {
   if (!_putOk) {
     String tempPath = path + ".davtmp";
     Storage.remove(tempPath.c_str());
+    DirectoryListing::invalidateParent(path.c_str());
     s.send(500, "text/plain", "Write failed - incomplete upload or disk full");
     return;
   }
 
   clearEpubCacheIfNeeded(path);
+  INGEST_QUEUE.enqueue(path.c_str());
   s.send(_putExisted ? 204 : 201);
   LOG_DBG("DAV", "PUT complete: %s", path.c_str());
 }
@@ -428,6 +427,8 @@ void WebDAVHandler::handleDelete(WebServer& s) {
     }
     file.close();
     if (Storage.rmdir(path.c_str())) {
+      DirectoryListing::invalidate(path.c_str());
+      DirectoryListing::invalidateParent(path.c_str());
       s.send(204);
     } else {
       s.send(500, "text/plain", "Failed to remove directory");
@@ -436,6 +437,7 @@ void WebDAVHandler::handleDelete(WebServer& s) {
     file.close();
     clearEpubCacheIfNeeded(path);
     if (Storage.remove(path.c_str())) {
+      DirectoryListing::invalidateParent(path.c_str());
       s.send(204);
     } else {
       s.send(500, "text/plain", "Failed to delete file");
@@ -476,6 +478,7 @@ void WebDAVHandler::handleMkcol(WebServer& s) {
   }
 
   if (Storage.mkdir(path.c_str())) {
+    DirectoryListing::invalidateParent(path.c_str());
     s.send(201);
     LOG_DBG("DAV", "Created directory: %s", path.c_str());
   } else {
@@ -547,6 +550,11 @@ void WebDAVHandler::handleMove(WebServer& s) {
   bool success = file.rename(dstPath.c_str());
   file.close();
 
+  if (success || dstExists) {
+    DirectoryListing::invalidate(srcPath.c_str());
+    DirectoryListing::invalidateParent(srcPath.c_str());
+    DirectoryListing::invalidateParent(dstPath.c_str());
+  }
   if (success) {
     s.send(dstExists ? 204 : 201);
   } else {
@@ -640,6 +648,7 @@ void WebDAVHandler::handleCopy(WebServer& s) {
 
   srcFile.close();
   dstFile.close();
+  DirectoryListing::invalidateParent(dstPath.c_str());
 
   if (copyOk) {
     s.send(dstExists ? 204 : 201);
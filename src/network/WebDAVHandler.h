@@ -11,6 +11,8 @@ class WebDAVHandler : public RequestHandler {
   void raw(WebServer& server, const String& uri, HTTPRaw& raw) override;
   bool handle(WebServer& server, HTTPMethod method, const String& uri) override;
 
+  bool isPutInProgress() const { return _putFile.isOpen(); }
+
  private:
   // PUT streaming state (raw() is called in chunks)
   FsFile _putFile;
@@ -0,0 +1,400 @@
+#include "DirectoryListing.h"
+
+#include <Arduino.h>
+#include <FsHelpers.h>
+#include <Logging.h>
+#include <esp_task_wdt.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr uint8_t LISTING_FILE_VERSION = 1;
+constexpr char LISTING_CACHE_DIR[] = "/.crosspoint/dircache";
+constexpr uint32_t READ_BATCH = 32;
+constexpr size_t WRITE_BUFFER_SIZE = 1024;
+
+// Cache file format:
+// - Header
+// - Record[count], in listing order
+// - names, in listing order, not terminated
+struct Header {
+  uint8_t version;  // 0 while the file is being written
+  uint8_t reserved[3];
+  uint32_t directoryHash;  // hash of the directory's raw entries, 0 if they couldn't be read
+  uint32_t count;
+  uint32_t namesLength;
+};
+static_assert(sizeof(Header) == 16, "Header layout is part of the file format");
+
+// Directories whose cached listing was checked against the card (or built) since boot, by path hash
+std::vector<uint64_t> checkedDirectories;
+
+uint64_t hashPath(const std::string& path) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : path) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string normalizeDirectory(const std::string& dirPath) {
+  std::string dir = dirPath.empty() ? "/" : dirPath;
+  while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+  return dir;
+}
+
+std::string cachePathFor(const std::string& dir) {
+  char name[40];
+  snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(hashPath(dir)));
+  return std::string(LISTING_CACHE_DIR) + name;
+}
+
+// Folders below a dot directory (our own caches included) change without going through invalidate(), so their
+// listings are re-checked on every open instead of once per boot.
+bool isHiddenPath(const std::string& dir) { return dir.find("/.") != std::string::npos; }
+
+bool wasChecked(const uint64_t key) {
+  return std::find(checkedDirectories.begin(), checkedDirectories.end(), key) != checkedDirectories.end();
+}
+
+void markChecked(const std::string& dir) {
+  if (isHiddenPath(dir)) return;
+  const uint64_t key = hashPath(dir);
+  if (!wasChecked(key)) checkedDirectories.push_back(key);
+}
+
+// FNV-1a over the directory file itself (its FAT/exFAT entries). Any added, removed or renamed entry and any size
+// change shows up here, at the cost of one sequential read of 32 bytes per entry.
+uint32_t hashDirectoryEntries(const std::string& dir) {
+  FsFile file = Storage.open(dir.c_str());
+  if (!file || !file.isDirectory()) return 0;
+
+  uint8_t buffer[512];
+  uint32_t hash = 2166136261u;
+  size_t total = 0;
+  int n;
+  while ((n = file.read(buffer, sizeof(buffer))) > 0) {
+    for (int i = 0; i < n; i++) {
+      hash = (hash ^ buffer[i]) * 16777619u;
+    }
+    total += n;
+    if ((total & 0x7FFF) == 0) esp_task_wdt_reset();
+  }
+  file.close();
+
+  if (total == 0) return 0;
+  return hash == 0 ? 1 : hash;
+}
+
+uint8_t flagsFor(const char* name, const bool isDirectory) {
+  uint8_t flags = 0;
+  if (isDirectory) flags |= DirectoryListing::DIRECTORY;
+  if (name[0] == '.') flags |= DirectoryListing::HIDDEN;
+  if (strcmp(name, "System Volume Information") == 0) flags |= DirectoryListing::SYSTEM;
+  if (!isDirectory) {
+    const std::string_view filename{name};
+    if (FsHelpers::hasEpubExtension(filename) || FsHelpers::hasXtcExtension(filename) ||
+        FsHelpers::hasTxtExtension(filename) || FsHelpers::hasMarkdownExtension(filename) ||
+        FsHelpers::hasBmpExtension(filename)) {
+      flags |= DirectoryListing::BOOK;
+    }
+  }
+  return flags;
+}
+
+// Collects small writes into WRITE_BUFFER_SIZE chunks
+class BufferedWriter {
+ public:
+  explicit BufferedWriter(FsFile& file) : file(file) { buffer.reserve(WRITE_BUFFER_SIZE); }
+
+  void write(const void* data, const size_t length) {
+    if (buffer.size() + length > WRITE_BUFFER_SIZE) flush();
+    if (length > WRITE_BUFFER_SIZE) {
+      ok &= file.write(data, length) == length;
+      return;
+    }
+    buffer.append(static_cast<const char*>(data), length);
+  }
+
+  bool flush() {
+    if (!buffer.empty()) {
+      ok &= file.write(buffer.data(), buffer.size()) == buffer.size();
+      buffer.clear();
+    }
+    return ok;
+  }
+
+ private:
+  FsFile& file;
+  std::string buffer;
+  bool ok = true;
+};
+}  // namespace
+
+uint32_t DirectoryListing::changes = 0;
+
+bool DirectoryListing::naturalLess(const std::string_view a, const bool aIsDirectory, const std::string_view b,
+                                   const bool bIsDirectory) {
+  // Directories first
+  if (aIsDirectory != bIsDirectory) return aIsDirectory;
+
+  size_t i = 0, j = 0;
+  while (i < a.size() && j < b.size()) {
+    // Runs of digits compare by value
+    if (isdigit(static_cast<unsigned char>(a[i])) && isdigit(static_cast<unsigned char>(b[j]))) {
+      while (i < a.size() && a[i] == '0') i++;
+      while (j < b.size() && b[j] == '0') j++;
+
+      size_t lenA = 0, lenB = 0;
+      while (i + lenA < a.size() && isdigit(static_cast<unsigned char>(a[i + lenA]))) lenA++;
+      while (j + lenB < b.size() && isdigit(static_cast<unsigned char>(b[j + lenB]))) lenB++;
+
+      // Different length so the shorter number is smaller
+      if (lenA != lenB) return lenA < lenB;
+
+      for (size_t k = 0; k < lenA; k++) {
+        if (a[i + k] != b[j + k]) return a[i + k] < b[j + k];
+      }
+      i += lenA;
+      j += lenB;
+    } else {
+      // Regular case-insensitive character comparison
+      const char ca = static_cast<char>(tolower(static_cast<unsigned char>(a[i])));
+      const char cb = static_cast<char>(tolower(static_cast<unsigned char>(b[j])));
+      if (ca != cb) return ca < cb;
+      i++;
+      j++;
+    }
+  }
+
+  // One string is prefix of other
+  return i == a.size() && j < b.size();
+}
+
+bool DirectoryListing::open(const std::string& dirPath) {
+  close();
+
+  const std::string dir = normalizeDirectory(dirPath);
+  const std::string cachePath = cachePathFor(dir);
+  if (load(cachePath, dir)) {
+    return true;
+  }
+
+  const unsigned long start = millis();
+  if (!build(dir, cachePath)) {
+    Storage.remove(cachePath.c_str());
+    return false;
+  }
+  if (!load(cachePath, dir)) {
+    return false;
+  }
+  LOG_DBG("DIR", "Indexed %s (%u entries) in %lu ms", dir.c_str(), count, millis() - start);
+  return true;
+}
+
+void DirectoryListing::close() {
+  if (file) file.close();
+  count = 0;
+  namesStart = 0;
+}
+
+bool DirectoryListing::load(const std::string& cachePath, const std::string& dirPath) {
+  if (!Storage.exists(cachePath.c_str()) || !Storage.openFileForRead("DIR", cachePath, file)) {
+    return false;
+  }
+
+  Header header{};
+  if (file.read(&header, sizeof(header)) != sizeof(header) || header.version != LISTING_FILE_VERSION) {
+    file.close();
+    return false;
+  }
+
+  const uint32_t expectedSize = sizeof(Header) + header.count * sizeof(Record) + header.namesLength;
+  if (file.size() != expectedSize) {
+    file.close();
+    return false;
+  }
+
+  if (!wasChecked(hashPath(dirPath))) {
+    if (header.directoryHash == 0 || hashDirectoryEntries(dirPath) != header.directoryHash) {
+      LOG_DBG("DIR", "Listing of %s is stale", dirPath.c_str());
+      file.close();
+      return false;
+    }
+    markChecked(dirPath);
+  }
+
+  count = header.count;
+  namesStart = sizeof(Header) + count * sizeof(Record);
+  return true;
+}
+
+bool DirectoryListing::build(const std::string& dirPath, const std::string& cachePath) {
+  FsFile dir = Storage.open(dirPath.c_str());
+  if (!dir || !dir.isDirectory()) {
+    return false;
+  }
+
+  std::string names;
+  std::vector<Record> records;
+  char name[500];
+  dir.rewindDirectory();
+  for (auto entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    const size_t length = entry.getName(name, sizeof(name));
+    if (length == 0 || length > UINT16_MAX) continue;
+
+    Record record{};
+    record.nameOffset = names.size();
+    record.nameLength = length;
+    record.size = entry.isDirectory() ? 0 : entry.size();
+    record.flags = flagsFor(name, entry.isDirectory());
+    names.append(name, length);
+    records.push_back(record);
+    entry.close();
+
+    if (records.size() % READ_BATCH == 0) esp_task_wdt_reset();
+  }
+  dir.close();
+
+  std::sort(records.begin(), records.end(), [&names](const Record& a, const Record& b) {
+    return naturalLess({names.data() + a.nameOffset, a.nameLength}, a.flags & DIRECTORY,
+                       {names.data() + b.nameOffset, b.nameLength}, b.flags & DIRECTORY);
+  });
+
+  Storage.mkdir(LISTING_CACHE_DIR);
+  FsFile out;
+  if (!Storage.openFileForWrite("DIR", cachePath, out)) {
+    return false;
+  }
+
+  // Written with version 0 first so a file cut short by a power loss is never trusted
+  Header header{};
+  BufferedWriter writer(out);
+  writer.write(&header, sizeof(header));
+
+  // Names are rewritten in listing order, so a run of entries has its names in one contiguous span
+  uint32_t offset = 0;
+  for (Record record : records) {
+    record.nameOffset = offset;
+    offset += record.nameLength;
+    writer.write(&record, sizeof(record));
+  }
+  for (const Record& record : records) {
+    writer.write(names.data() + record.nameOffset, record.nameLength);
+  }
+  bool ok = writer.flush();
+
+  header.version = LISTING_FILE_VERSION;
+  header.directoryHash = hashDirectoryEntries(dirPath);
+  header.count = records.size();
+  header.namesLength = names.size();
+  ok = ok && out.seek(0) && out.write(&header, sizeof(header)) == sizeof(header);
+  out.close();
+
+  if (ok) {
+    markChecked(dirPath);
+  }
+  return ok;
+}
+
+bool DirectoryListing::readRecords(const uint32_t first, const uint32_t n, Record* out) {
+  const size_t bytes = n * sizeof(Record);
+  return file.seek(sizeof(Header) + first * sizeof(Record)) &&
+         file.read(out, bytes) == static_cast<int>(bytes);
+}
+
+bool DirectoryListing::read(const uint32_t first, const uint32_t maxCount,
+                            const std::function<void(uint32_t index, const Entry&)>& visit) {
+  if (!file) return false;
+
+  const uint32_t end = first + std::min(maxCount, count > first ? count - first : 0);
+  Record records[READ_BATCH];
+  std::string names;
+  for (uint32_t batch = first; batch < end;) {
+    const uint32_t n = std::min(READ_BATCH, end - batch);
+    if (!readRecords(batch, n, records)) return false;
+
+    const uint32_t namesFrom = records[0].nameOffset;
+    names.resize(records[n - 1].nameOffset + records[n - 1].nameLength - namesFrom);
+    if (!file.seek(namesStart + namesFrom) || file.read(names.data(), names.size()) != static_cast<int>(names.size())) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+      const Entry entry{{names.data() + records[i].nameOffset - namesFrom, records[i].nameLength}, records[i].size,
+                        records[i].flags};
+      visit(batch + i, entry);
+    }
+    batch += n;
+  }
+  return true;
+}
+
+bool DirectoryListing::readFlags(const std::function<void(uint32_t index, uint8_t flags)>& visit) {
+  if (!file) return false;
+
+  Record records[READ_BATCH];
+  for (uint32_t batch = 0; batch < count;) {
+    const uint32_t n = std::min(READ_BATCH, count - batch);
+    if (!readRecords(batch, n, records)) return false;
+    for (uint32_t i = 0; i < n; i++) {
+      visit(batch + i, records[i].flags);
+    }
+    batch += n;
+  }
+  return true;
+}
+
+uint32_t DirectoryListing::find(const std::string_view name, const bool isDirectory) {
+  if (!file) return count;
+
+  std::string candidate;
+  auto readEntry = [this, &candidate](const uint32_t index, Record& record) {
+    if (!readRecords(index, 1, &record)) return false;
+    candidate.resize(record.nameLength);
+    return file.seek(namesStart + record.nameOffset) &&
+           file.read(candidate.data(), candidate.size()) == static_cast<int>(candidate.size());
+  };
+
+  // Lower bound in listing order
+  uint32_t low = 0, high = count;
+  Record record{};
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (!readEntry(mid, record)) return count;
+    if (naturalLess(candidate, record.flags & DIRECTORY, name, isDirectory)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  // Names that only differ in case or leading zeros sort as equal, so check each of them
+  for (uint32_t i = low; i < count; i++) {
+    if (!readEntry(i, record)) return count;
+    if (naturalLess(name, isDirectory, candidate, record.flags & DIRECTORY)) break;
+    if (candidate == name && static_cast<bool>(record.flags & DIRECTORY) == isDirectory) return i;
+  }
+  return count;
+}
+
+void DirectoryListing::invalidate(const std::string& dirPath) {
+  changes++;
+  const std::string dir = normalizeDirectory(dirPath);
+  const uint64_t key = hashPath(dir);
+  checkedDirectories.erase(std::remove(checkedDirectories.begin(), checkedDirectories.end(), key),
+                           checkedDirectories.end());
+
+  const std::string cachePath = cachePathFor(dir);
+  if (Storage.exists(cachePath.c_str())) {
+    Storage.remove(cachePath.c_str());
+  }
+}
+
+void DirectoryListing::invalidateParent(const std::string& path) {
+  invalidate(FsHelpers::extractFolderPath(normalizeDirectory(path)));
+}
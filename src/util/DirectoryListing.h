@@ -0,0 +1,83 @@
+#pragma once
+
+#include <HalStorage.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Sorted listing of one directory, kept on the SD card so large folders can be listed and paged without walking the
+// directory again.
+//
+// The first open() walks the directory once, sorts it (folders first, natural order) and writes
+// /.crosspoint/dircache/<path hash>.bin: a header, one fixed 12-byte record per entry, then all names back to back.
+// Afterwards any run of entries costs one seek and two reads (its records, then its names).
+//
+// Code that adds, removes or renames entries must call invalidate() for the parent directory. Changes made while the
+// card was in another device are caught by a hash of the directory's raw entries, checked once per directory and boot.
+class DirectoryListing {
+ public:
+  enum Flags : uint8_t {
+    DIRECTORY = 1 << 0,
+    HIDDEN = 1 << 1,  // name starts with '.'
+    SYSTEM = 1 << 2,  // "System Volume Information"
+    BOOK = 1 << 3,    // file the browser can open (epub, xtc, txt, md, bmp)
+  };
+
+  struct Entry {
+    std::string_view name;  // valid during the visit callback only
+    uint32_t size;
+    uint8_t flags;
+
+    bool isDirectory() const { return flags & DIRECTORY; }
+  };
+
+  DirectoryListing() = default;
+  ~DirectoryListing() { close(); }
+  DirectoryListing(const DirectoryListing&) = delete;
+  DirectoryListing& operator=(const DirectoryListing&) = delete;
+
+  // Opens the listing of `dirPath`, building it first if it is missing or stale. False if the directory can't be read.
+  bool open(const std::string& dirPath);
+  void close();
+  bool isOpen() const { return file.isOpen(); }
+  uint32_t size() const { return count; }
+
+  // Visits entries [first, first + maxCount) in sorted order
+  bool read(uint32_t first, uint32_t maxCount, const std::function<void(uint32_t index, const Entry&)>& visit);
+  // Visits the flags of every entry, without reading the names (for building filtered views)
+  bool readFlags(const std::function<void(uint32_t index, uint8_t flags)>& visit);
+  // Index of the entry called `name`, found by binary search in the sort order; size() if absent
+  uint32_t find(std::string_view name, bool isDirectory);
+
+  // Drops the cached listing of `dirPath`
+  static void invalidate(const std::string& dirPath);
+  // Drops the cached listing of the directory containing `path`
+  static void invalidateParent(const std::string& path);
+  // Number of invalidations since boot; lets other caches of the card notice that something changed
+  static uint32_t changeCount() { return changes; }
+
+  // Listing order: folders first, then case-insensitive with runs of digits compared by value ("2" < "10")
+  static bool naturalLess(std::string_view a, bool aIsDirectory, std::string_view b, bool bIsDirectory);
+
+ private:
+  struct Record {
+    uint32_t nameOffset;  // from the start of the names block
+    uint32_t size;
+    uint16_t nameLength;
+    uint8_t flags;
+    uint8_t reserved;
+  };
+  static_assert(sizeof(Record) == 12, "Record layout is part of the file format");
+
+  static uint32_t changes;
+
+  FsFile file;
+  uint32_t count = 0;
+  uint32_t namesStart = 0;
+
+  bool load(const std::string& cachePath, const std::string& dirPath);
+  bool readRecords(uint32_t first, uint32_t n, Record* out);
+  static bool build(const std::string& dirPath, const std::string& cachePath);
+};
@@ -11,6 +11,7 @@
 #include <string>
 
 #include "Bitmap.h"  // Required for BmpHeader struct definition
+#include "DirectoryListing.h"
 #include "activities/Activity.h"
 
 void ScreenshotUtil::buildFilename(const ScreenshotInfo& info, char* buf, size_t bufSize) {
@@ -113,6 +114,7 @@ bool ScreenshotUtil::saveFramebufferAsBmp(const char* filename, const uint8_t* f
       if (!Storage.mkdir(dir.c_str())) {
         return false;
       }
+      DirectoryListing::invalidateParent(dir);
     }
   }
 
@@ -121,6 +123,7 @@ bool ScreenshotUtil::saveFramebufferAsBmp(const char* filename, const uint8_t* f
     LOG_ERR("SCR", "Failed to save screenshot");
     return false;
   }
+  DirectoryListing::invalidateParent(filename);
 
   BmpHeader header;
 
@@ -0,0 +1,132 @@
+#include "WakeFrame.h"
+
+#include <FsHelpers.h>
+#include <HalStorage.h>
+#include <Logging.h>
+
+#include <cstring>
+#include <functional>
+
+#include "CrossPointSettings.h"
+
+namespace {
+constexpr char WAKE_FILE[] = "/.crosspoint/wake.bin";
+constexpr uint8_t WAKE_FILE_VERSION = 1;
+
+uint32_t fnv1a(const void* data, const size_t length) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Cache folder of the reader that opens `bookPath` (see Epub, Xtc and Txt); empty for files without reading progress
+std::string cachePathOf(const std::string& bookPath) {
+  const std::string hash = std::to_string(std::hash<std::string>{}(bookPath));
+  if (FsHelpers::hasBmpExtension(bookPath)) return "";
+  if (FsHelpers::hasXtcExtension(bookPath)) return "/.crosspoint/xtc_" + hash;
+  if (FsHelpers::hasTxtExtension(bookPath) || FsHelpers::hasMarkdownExtension(bookPath)) {
+    return "/.crosspoint/txt_" + hash;
+  }
+  return "/.crosspoint/epub_" + hash;
+}
+}  // namespace
+
+bool WakeFrame::shown = false;
+
+bool WakeFrame::takeShown() {
+  const bool wasShown = shown;
+  shown = false;
+  return wasShown;
+}
+
+bool WakeFrame::describe(const std::string& bookPath, Record& record) {
+  const std::string cachePath = cachePathOf(bookPath);
+  if (bookPath.empty() || cachePath.empty()) return false;
+
+  memset(&record, 0, sizeof(record));
+  record.version = WAKE_FILE_VERSION;
+  record.pathHash = static_cast<uint32_t>(std::hash<std::string>{}(bookPath));
+  // Everything in the settings can change the page layout or the status bar
+  record.settingsHash = fnv1a(static_cast<const void*>(&SETTINGS), sizeof(CrossPointSettings));
+
+  FsFile book = Storage.open(bookPath.c_str());
+  if (!book) return false;
+  record.bookSize = book.size();
+  book.close();
+
+  FsFile progress;
+  if (!Storage.openFileForRead("WAK", cachePath + "/progress.bin", progress)) return false;
+  const int read = progress.read(record.progress, PROGRESS_BYTES);
+  progress.close();
+  if (read <= 0) return false;
+  record.progressLength = static_cast<uint8_t>(read);
+  return true;
+}
+
+bool WakeFrame::save(const GfxRenderer& renderer, const std::string& bookPath) {
+  Record record{};
+  if (!describe(bookPath, record)) {
+    return false;
+  }
+  const uint8_t* frame = renderer.getFrameBuffer();
+  record.bufferSize = renderer.getBufferSize();
+
+  const unsigned long start = millis();
+  FsFile file;
+  if (!Storage.openFileForWrite("WAK", WAKE_FILE, file)) {
+    return false;
+  }
+  // The record goes in last, so a file cut short by power loss keeps version 0 and is never shown
+  Record pending = record;
+  pending.version = 0;
+  bool ok = file.write(reinterpret_cast<const uint8_t*>(&pending), sizeof(pending)) == sizeof(pending) &&
+            file.write(frame, record.bufferSize) == record.bufferSize;
+  ok = ok && file.seek(0) && file.write(reinterpret_cast<const uint8_t*>(&record), sizeof(record)) == sizeof(record);
+  file.close();
+  if (!ok) {
+    LOG_ERR("WAK", "Failed to store wake frame");
+    Storage.remove(WAKE_FILE);
+    return false;
+  }
+  LOG_DBG("WAK", "Stored wake frame in %lu ms", millis() - start);
+  return true;
+}
+
+bool WakeFrame::show(const GfxRenderer& renderer, const std::string& bookPath) {
+  const unsigned long start = millis();
+  FsFile file;
+  if (!Storage.openFileForRead("WAK", WAKE_FILE, file)) {
+    return false;
+  }
+
+  Record stored{};
+  Record current{};
+  const bool matches = file.read(&stored, sizeof(stored)) == static_cast<int>(sizeof(stored)) &&
+                       stored.version == WAKE_FILE_VERSION && stored.bufferSize == renderer.getBufferSize() &&
+                       describe(bookPath, current) && stored.pathHash == current.pathHash &&
+                       stored.bookSize == current.bookSize && stored.settingsHash == current.settingsHash &&
+                       stored.progressLength == current.progressLength &&
+                       memcmp(stored.progress, current.progress, stored.progressLength) == 0;
+  if (!matches) {
+    file.close();
+    LOG_DBG("WAK", "Wake frame is stale, rendering normally");
+    return false;
+  }
+
+  uint8_t* frame = renderer.getFrameBuffer();
+  const bool complete = file.read(frame, stored.bufferSize) == static_cast<int>(stored.bufferSize);
+  file.close();
+  if (!complete) {
+    renderer.clearScreen();
+    return false;
+  }
+
+  renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+  shown = true;
+  LOG_DBG("WAK", "Showed wake frame %lu ms into boot (%lu ms)", millis(), millis() - start);
+  return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <GfxRenderer.h>
+
+#include <cstdint>
+#include <string>
+
+// Last reader frame, kept across deep sleep so waking into a book shows the page at once instead of after the book,
+// its section and fonts are loaded again.
+//
+// /.crosspoint/wake.bin holds a resume record and the black/white frame buffer. The record pins down what the frame
+// shows: the book (path hash and size), the start of its progress.bin (spine and page, or page) and a fingerprint of
+// the settings. show() only draws the frame when all of them still match, so a changed setting or a book read elsewhere
+// never brings back a stale page. The reader then renders the same page normally, adding anti-aliasing.
+class WakeFrame {
+ public:
+  // Stores the frame buffer as the page of `bookPath`. Call before the sleep screen draws over it.
+  static bool save(const GfxRenderer& renderer, const std::string& bookPath);
+  // Draws the stored frame if it still matches `bookPath`, its progress and the current settings
+  static bool show(const GfxRenderer& renderer, const std::string& bookPath);
+  // True once after show() succeeded: the reader's first page can skip its half refresh
+  static bool takeShown();
+
+ private:
+  static constexpr uint8_t PROGRESS_BYTES = 8;
+  static bool shown;
+
+  struct Record {
+    uint8_t version;  // 0 while the file is being written
+    uint8_t progressLength;
+    uint16_t reserved;
+    uint32_t pathHash;
+    uint32_t bookSize;
+    uint32_t settingsHash;
+    uint32_t bufferSize;
+    uint8_t progress[PROGRESS_BYTES];
+  };
+  static_assert(sizeof(Record) == 28, "Record layout is part of the file format");
+
+  static bool describe(const std::string& bookPath, Record& record);
+};
@@ -0,0 +1,316 @@
+// Host test for the BMP row kernels: compares them with the per-pixel path they replace (the packPixel lambda of
+// Bitmap::readNextRow) for every bpp and quantizer, and measures rows per second for the images the device decodes.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "lib/GfxRenderer/BmpRowKernels.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+using BmpRowKernels::Quantizer;
+
+// One image as Bitmap::parseHeaders sets it up
+struct Image {
+  uint16_t bpp = 0;
+  int width = 0;
+  int height = 0;
+  int rowBytes = 0;
+  bool nativePalette = false;
+  bool dithering = false;
+  uint8_t paletteLum[256] = {};
+  std::vector<uint8_t> pixels;  // height rows of rowBytes
+
+  const uint8_t* row(const int y) const { return pixels.data() + static_cast<size_t>(y) * rowBytes; }
+};
+
+Image makeImage(const uint16_t bpp, const int width, const int height, const bool grayPalette, const bool dithering,
+                const unsigned seed) {
+  std::mt19937 rng(seed);
+  Image image;
+  image.bpp = bpp;
+  image.width = width;
+  image.height = height;
+  image.rowBytes = (width * bpp + 31) / 32 * 4;
+  image.dithering = dithering;
+  for (int i = 0; i < 256; i++) image.paletteLum[i] = static_cast<uint8_t>(i);
+  if (bpp <= 8) {
+    const int colors = 1 << bpp;
+    for (int i = 0; i < colors; i++) {
+      image.paletteLum[i] = grayPalette ? static_cast<uint8_t>(i * 255 / (colors - 1)) : static_cast<uint8_t>(rng());
+    }
+  }
+  // Same check as Bitmap::parseHeaders
+  image.nativePalette = bpp <= 2;
+  if (!image.nativePalette && bpp <= 8) {
+    image.nativePalette = true;
+    for (int i = 0; i < (1 << bpp); i++) {
+      const uint8_t lum = image.paletteLum[i];
+      const uint8_t reconstructed = (lum >> 6) * 85;
+      if (lum > reconstructed + 21 || lum + 21 < reconstructed) image.nativePalette = false;
+    }
+  }
+
+  // A smooth gradient with noise, like a photo; palette images get random indices
+  image.pixels.resize(static_cast<size_t>(image.rowBytes) * height);
+  for (int y = 0; y < height; y++) {
+    uint8_t* row = image.pixels.data() + static_cast<size_t>(y) * image.rowBytes;
+    if (bpp <= 8) {
+      for (int i = 0; i < image.rowBytes; i++) row[i] = static_cast<uint8_t>(rng());
+      continue;
+    }
+    for (int x = 0; x < width; x++) {
+      uint8_t* p = row + x * (bpp / 8);
+      const int base = (x * 255 / width + y * 255 / height) / 2;
+      for (int c = 0; c < bpp / 8; c++) p[c] = static_cast<uint8_t>(base + static_cast<int>(rng() % 41) - 20);
+    }
+  }
+  return image;
+}
+
+// The per-pixel path of Bitmap::readNextRow before the kernels
+class ReferenceDecoder {
+ public:
+  explicit ReferenceDecoder(const Image& image) : image(image) {
+    if (!image.nativePalette && image.dithering) atkinson = new AtkinsonDitherer(image.width);
+  }
+  ~ReferenceDecoder() { delete atkinson; }
+
+  void readRow(const uint8_t* rowBuffer, uint8_t* data) {
+    prevRowY += 1;
+    uint8_t* outPtr = data;
+    uint8_t currentOutByte = 0;
+    int bitShift = 6;
+    int currentX = 0;
+    auto packPixel = [&](const uint8_t lum) {
+      uint8_t color;
+      if (atkinson) {
+        color = atkinson->processPixel(adjustPixel(lum), currentX);
+      } else if (image.nativePalette) {
+        color = static_cast<uint8_t>(adjustPixel(lum) >> 6);
+      } else {
+        color = quantize(adjustPixel(lum), currentX, prevRowY);
+      }
+      currentOutByte |= (color << bitShift);
+      if (bitShift == 0) {
+        *outPtr++ = currentOutByte;
+        currentOutByte = 0;
+        bitShift = 6;
+      } else {
+        bitShift -= 2;
+      }
+      currentX++;
+    };
+
+    const int width = image.width;
+    switch (image.bpp) {
+      case 32:
+      case 24: {
+        const uint8_t* p = rowBuffer;
+        for (int x = 0; x < width; x++) {
+          packPixel((77u * p[2] + 150u * p[1] + 29u * p[0]) >> 8);
+          p += image.bpp / 8;
+        }
+        break;
+      }
+      case 8:
+        for (int x = 0; x < width; x++) packPixel(image.paletteLum[rowBuffer[x]]);
+        break;
+      case 4:
+        for (int x = 0; x < width; x++) {
+          const uint8_t nibble = (x & 1) ? (rowBuffer[x >> 1] & 0x0F) : (rowBuffer[x >> 1] >> 4);
+          packPixel(image.paletteLum[nibble]);
+        }
+        break;
+      case 2:
+        for (int x = 0; x < width; x++) {
+          packPixel(image.paletteLum[(rowBuffer[x >> 2] >> (6 - ((x & 3) * 2))) & 0x03]);
+        }
+        break;
+      case 1:
+        for (int x = 0; x < width; x++) {
+          packPixel(image.paletteLum[(rowBuffer[x >> 3] & (0x80 >> (x & 7))) ? 1 : 0]);
+        }
+        break;
+    }
+    if (atkinson) atkinson->nextRow();
+    if (bitShift != 6) *outPtr = currentOutByte;
+  }
+
+ private:
+  const Image& image;
+  AtkinsonDitherer* atkinson = nullptr;
+  int prevRowY = -1;
+};
+
+// What Bitmap now does per image and per row
+class KernelDecoder {
+ public:
+  explicit KernelDecoder(const Image& image) : image(image) {
+    if (!image.nativePalette && image.dithering) atkinson = new AtkinsonDitherer(image.width);
+    quantizer = BmpRowKernels::buildLut(lut, image.bpp, image.paletteLum, image.nativePalette, atkinson, nullptr);
+  }
+  ~KernelDecoder() { delete atkinson; }
+
+  bool readRow(const uint8_t* rowBuffer, uint8_t* data) {
+    prevRowY += 1;
+    return BmpRowKernels::convertRow(image.bpp, rowBuffer, data, image.width, prevRowY, lut, quantizer, atkinson,
+                                     nullptr);
+  }
+
+  Quantizer getQuantizer() const { return quantizer; }
+
+ private:
+  const Image& image;
+  AtkinsonDitherer* atkinson = nullptr;
+  uint8_t lut[256] = {};
+  Quantizer quantizer = Quantizer::Direct;
+  int prevRowY = -1;
+};
+
+int outputBytes(const int width) { return (width + 3) / 4; }
+
+bool sameOutput(const Image& image) {
+  ReferenceDecoder reference(image);
+  KernelDecoder kernels(image);
+  std::vector<uint8_t> expected(outputBytes(image.width));
+  std::vector<uint8_t> actual(outputBytes(image.width));
+  for (int y = 0; y < image.height; y++) {
+    memset(expected.data(), 0, expected.size());
+    memset(actual.data(), 0, actual.size());
+    reference.readRow(image.row(y), expected.data());
+    if (!kernels.readRow(image.row(y), actual.data()) || expected != actual) {
+      fprintf(stderr, "  %u bpp, width %d, row %d differs\n", image.bpp, image.width, y);
+      return false;
+    }
+  }
+  return true;
+}
+
+void testMatchesPerPixelPath() {
+  printf("testMatchesPerPixelPath\n");
+  unsigned seed = 1;
+  for (const uint16_t bpp : {1, 2, 4, 8, 24, 32}) {
+    for (const int width : {1, 3, 4, 5, 37, 480}) {
+      for (const bool grayPalette : {true, false}) {
+        for (const bool dithering : {false, true}) {
+          ASSERT_TRUE(sameOutput(makeImage(bpp, width, 12, grayPalette, dithering, seed++)));
+        }
+      }
+    }
+  }
+  PASS();
+}
+
+void testQuantizerChoice() {
+  printf("testQuantizerChoice\n");
+  // Native palettes and undithered images resolve to a single table lookup per pixel
+  ASSERT_TRUE(KernelDecoder(makeImage(1, 8, 1, true, true, 1)).getQuantizer() == Quantizer::Direct);
+  ASSERT_TRUE(KernelDecoder(makeImage(2, 8, 1, false, true, 1)).getQuantizer() == Quantizer::Direct);
+  ASSERT_TRUE(KernelDecoder(makeImage(4, 8, 1, true, true, 1)).getQuantizer() == Quantizer::Atkinson);
+  ASSERT_TRUE(KernelDecoder(makeImage(8, 8, 1, false, false, 1)).getQuantizer() == Quantizer::Direct);
+  ASSERT_TRUE(KernelDecoder(makeImage(24, 8, 1, false, false, 1)).getQuantizer() == Quantizer::Direct);
+  ASSERT_TRUE(KernelDecoder(makeImage(24, 8, 1, false, true, 1)).getQuantizer() == Quantizer::Atkinson);
+
+  // Unsupported bpp is reported, not decoded
+  uint8_t lut[256] = {};
+  uint8_t row[4] = {};
+  uint8_t out[4] = {};
+  ASSERT_TRUE(!BmpRowKernels::convertRow(16, row, out, 4, 0, lut, Quantizer::Direct, nullptr, nullptr));
+  PASS();
+}
+
+void testFloydSteinberg() {
+  printf("testFloydSteinberg\n");
+  // Not the default ditherer, but Bitmap can be built with it: same output as calling the ditherer per pixel
+  const Image image = makeImage(24, 101, 9, false, true, 5);
+  FloydSteinbergDitherer perPixel(image.width);
+  FloydSteinbergDitherer kernel(image.width);
+  uint8_t lut[256];
+  ASSERT_TRUE(BmpRowKernels::buildLut(lut, 24, image.paletteLum, false, nullptr, &kernel) ==
+              Quantizer::FloydSteinberg);
+  std::vector<uint8_t> expected(outputBytes(image.width));
+  std::vector<uint8_t> actual(outputBytes(image.width));
+  for (int y = 0; y < image.height; y++) {
+    memset(expected.data(), 0, expected.size());
+    const uint8_t* p = image.row(y);
+    for (int x = 0; x < image.width; x++, p += 3) {
+      const int lum = (77u * p[2] + 150u * p[1] + 29u * p[0]) >> 8;
+      expected[x >> 2] |= perPixel.processPixel(adjustPixel(lum), x) << (6 - (x & 3) * 2);
+    }
+    perPixel.nextRow();
+    ASSERT_TRUE(BmpRowKernels::convertRow(24, image.row(y), actual.data(), image.width, y, lut,
+                                          Quantizer::FloydSteinberg, nullptr, &kernel));
+    ASSERT_TRUE(expected == actual);
+  }
+  PASS();
+}
+
+// Rows per second through both paths. The host has an FPU and a branch predictor the ESP32-C3 lacks, so only the
+// ratio is meaningful; the device gains more where the old path branched per pixel.
+void benchmark(const char* name, const Image& image) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<uint8_t> out(outputBytes(image.width));
+  constexpr int PASSES = 20;
+
+  const auto referenceStart = Clock::now();
+  for (int pass = 0; pass < PASSES; pass++) {
+    ReferenceDecoder reference(image);
+    for (int y = 0; y < image.height; y++) reference.readRow(image.row(y), out.data());
+  }
+  const double referenceSeconds = std::chrono::duration<double>(Clock::now() - referenceStart).count();
+
+  const auto kernelStart = Clock::now();
+  for (int pass = 0; pass < PASSES; pass++) {
+    KernelDecoder kernels(image);
+    for (int y = 0; y < image.height; y++) kernels.readRow(image.row(y), out.data());
+  }
+  const double kernelSeconds = std::chrono::duration<double>(Clock::now() - kernelStart).count();
+
+  const double rows = static_cast<double>(PASSES) * image.height;
+  printf("  %-36s %8.0f rows/s per pixel, %8.0f rows/s kernels (%.1fx)\n", name, rows / referenceSeconds,
+         rows / kernelSeconds, referenceSeconds / kernelSeconds);
+}
+
+void testBenchmark() {
+  printf("testBenchmark\n");
+  // Sleep screen: a full-screen 24-bit BMP, dithered
+  benchmark("sleep screen 480x800 24bpp dithered", makeImage(24, 480, 800, false, true, 1));
+  // Cover: the 2-bit BMP the JPEG/PNG converters write, drawn on the home screen and the sleep screen
+  benchmark("cover 480x800 2bpp", makeImage(2, 480, 800, true, true, 2));
+  // BmpViewerActivity: user images, often 8-bit with a color palette or 32-bit
+  benchmark("viewer 480x800 8bpp palette dithered", makeImage(8, 480, 800, false, true, 3));
+  benchmark("viewer 480x800 8bpp gray", makeImage(8, 480, 800, true, true, 4));
+  benchmark("viewer 480x800 32bpp dithered", makeImage(32, 480, 800, false, true, 5));
+  benchmark("thumbnail 240x400 1bpp", makeImage(1, 240, 400, true, true, 6));
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testMatchesPerPixelPath();
+  testQuantizerChoice();
+  testFloydSteinberg();
+  testBenchmark();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
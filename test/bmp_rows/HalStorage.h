@@ -0,0 +1,4 @@
+#pragma once
+
+// Host-test stand-in for lib/hal/HalStorage: Bitmap.h only needs the FsFile type to compile
+class FsFile {};
@@ -0,0 +1,220 @@
+// Host test for BwSnapshot: round trips of blank, text-like and incompressible frames, chunk reuse and failure cases.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "lib/GfxRenderer/BwSnapshot.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+// The panel: 800x480 at 1 bit per pixel, 1 = white
+constexpr size_t WIDTH_BYTES = 100;
+constexpr size_t HEIGHT = 480;
+constexpr size_t FRAME_SIZE = WIDTH_BYTES * HEIGHT;
+
+std::vector<uint32_t> frameWords(const size_t size) { return std::vector<uint32_t>((size + 3) / 4); }
+
+// A portrait text page as the panel sees it: rotated, so every panel row crosses all text lines. Lines have a 32 px
+// pitch and 20 px of glyphs; a few are blank (paragraph breaks) and a column misses the ink of a line now and then.
+void drawTextPage(uint8_t* frame, const unsigned seed) {
+  std::mt19937 rng(seed);
+  memset(frame, 0xFF, FRAME_SIZE);
+  std::vector<bool> blankLine(22);
+  for (size_t line = 0; line < blankLine.size(); line++) blankLine[line] = rng() % 5 == 0;
+  for (size_t y = 20; y < HEIGHT - 20; y++) {
+    for (size_t line = 0; line < blankLine.size(); line++) {
+      const size_t x = 4 + line * 4;
+      if (blankLine[line] || rng() % 4 == 0) continue;
+      uint8_t* row = frame + y * WIDTH_BYTES + x;
+      row[0] &= static_cast<uint8_t>(rng());
+      row[1] &= static_cast<uint8_t>(rng());
+      row[2] &= static_cast<uint8_t>(rng() | 0x0F);  // descenders
+    }
+  }
+}
+
+bool roundTrip(BwSnapshot& snapshot, const uint8_t* frame, const size_t size) {
+  auto copy = frameWords(size);
+  auto* target = reinterpret_cast<uint8_t*>(copy.data());
+  memset(target, 0x5A, size);
+  return snapshot.store(frame, size) && snapshot.restore(target) && memcmp(target, frame, size) == 0 &&
+         !snapshot.isStored();
+}
+
+void testBlankFrames() {
+  printf("testBlankFrames\n");
+  BwSnapshot snapshot;
+  auto words = frameWords(FRAME_SIZE);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+
+  memset(frame, 0xFF, FRAME_SIZE);
+  ASSERT_TRUE(snapshot.store(frame, FRAME_SIZE));
+  ASSERT_TRUE(snapshot.storedBytes() == 4);
+  snapshot.clear();
+  ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+
+  memset(frame, 0x00, FRAME_SIZE);
+  ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+  PASS();
+}
+
+void testTextPage() {
+  printf("testTextPage\n");
+  BwSnapshot snapshot;
+  auto words = frameWords(FRAME_SIZE);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    drawTextPage(frame, seed);
+    ASSERT_TRUE(snapshot.store(frame, FRAME_SIZE));
+    const size_t stored = snapshot.storedBytes();
+    ASSERT_TRUE(stored < FRAME_SIZE * 7 / 8);
+    if (seed == 1) printf("  text page: %zu of %zu bytes, %zu chunks\n", stored, FRAME_SIZE, snapshot.chunkCount());
+    snapshot.clear();
+    ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+  }
+  PASS();
+}
+
+void testIncompressibleFrame() {
+  printf("testIncompressibleFrame\n");
+  BwSnapshot snapshot;
+  auto words = frameWords(FRAME_SIZE);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+  std::mt19937 rng(7);
+  for (size_t i = 0; i < FRAME_SIZE; i++) frame[i] = static_cast<uint8_t>(rng());
+  // Short white and black runs in between stay literal
+  memset(frame + 1000, 0xFF, 8);
+  memset(frame + 2000, 0x00, 8);
+
+  ASSERT_TRUE(snapshot.store(frame, FRAME_SIZE));
+  ASSERT_TRUE(snapshot.storedBytes() <= FRAME_SIZE + BwSnapshot::MAX_CHUNKS * 4);
+  ASSERT_TRUE(snapshot.chunkCount() == 7);
+  snapshot.clear();
+  ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+  // Chunks beyond the retained ones are freed again
+  ASSERT_TRUE(snapshot.chunkCount() == BwSnapshot::RETAINED_CHUNKS);
+  PASS();
+}
+
+void testRunsAcrossChunks() {
+  printf("testRunsAcrossChunks\n");
+  BwSnapshot snapshot;
+  auto words = frameWords(FRAME_SIZE);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+  std::mt19937 rng(11);
+  // Alternating literal stretches and runs of every length around MIN_RUN, landing on chunk ends at many offsets
+  size_t pos = 0;
+  while (pos < FRAME_SIZE) {
+    const size_t literal = std::min<size_t>(4 * (1 + rng() % 700), FRAME_SIZE - pos);
+    for (size_t i = 0; i < literal; i++) frame[pos + i] = static_cast<uint8_t>(0x10 + rng() % 0xE0);
+    pos += literal;
+    const size_t run = std::min<size_t>(4 * (rng() % 6), FRAME_SIZE - pos);
+    memset(frame + pos, rng() % 2 ? 0xFF : 0x00, run);
+    pos += run;
+  }
+  ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+  PASS();
+}
+
+void testOddSizes() {
+  printf("testOddSizes\n");
+  BwSnapshot snapshot;
+  for (const size_t size : {size_t{0}, size_t{1}, size_t{3}, size_t{5}, size_t{4099}, FRAME_SIZE - 1}) {
+    auto words = frameWords(size + 4);
+    auto* frame = reinterpret_cast<uint8_t*>(words.data());
+    std::mt19937 rng(static_cast<unsigned>(size));
+    for (size_t i = 0; i < size; i++) frame[i] = rng() % 4 == 0 ? static_cast<uint8_t>(rng()) : 0xFF;
+    ASSERT_TRUE(roundTrip(snapshot, frame, size));
+  }
+  PASS();
+}
+
+void testFailures() {
+  printf("testFailures\n");
+  BwSnapshot snapshot;
+  ASSERT_TRUE(!snapshot.restore(nullptr));
+
+  // A misaligned frame is refused
+  auto words = frameWords(FRAME_SIZE + 4);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+  memset(frame, 0xFF, FRAME_SIZE + 4);
+  ASSERT_TRUE(!snapshot.store(frame + 1, FRAME_SIZE));
+  ASSERT_TRUE(!snapshot.isStored());
+
+  // More than MAX_CHUNKS worth of literals: nothing stored, spare chunks freed
+  const size_t hugeSize = (BwSnapshot::MAX_CHUNKS + 1) * BwSnapshot::CHUNK_SIZE;
+  auto huge = frameWords(hugeSize);
+  std::mt19937 rng(3);
+  for (auto& word : huge) word = static_cast<uint32_t>(rng()) | 0x10000000;
+  ASSERT_TRUE(!snapshot.store(reinterpret_cast<uint8_t*>(huge.data()), hugeSize));
+  ASSERT_TRUE(!snapshot.isStored() && snapshot.chunkCount() == BwSnapshot::RETAINED_CHUNKS);
+
+  // And the snapshot works again afterwards
+  ASSERT_TRUE(roundTrip(snapshot, frame, FRAME_SIZE));
+  snapshot.release();
+  ASSERT_TRUE(snapshot.chunkCount() == 0);
+  PASS();
+}
+
+void testSpeed() {
+  printf("testSpeed\n");
+  using Clock = std::chrono::steady_clock;
+  BwSnapshot snapshot;
+  auto words = frameWords(FRAME_SIZE);
+  auto* frame = reinterpret_cast<uint8_t*>(words.data());
+  auto target = frameWords(FRAME_SIZE);
+  drawTextPage(frame, 1);
+
+  constexpr int ROUNDS = 200;
+  const auto start = Clock::now();
+  for (int i = 0; i < ROUNDS; i++) {
+    snapshot.store(frame, FRAME_SIZE);
+    snapshot.restore(reinterpret_cast<uint8_t*>(target.data()));
+  }
+  const auto snapshotTime = Clock::now() - start;
+
+  std::vector<uint8_t> copy(FRAME_SIZE);
+  const auto copyStart = Clock::now();
+  for (int i = 0; i < ROUNDS; i++) {
+    memcpy(copy.data(), frame, FRAME_SIZE);
+    memcpy(target.data(), copy.data(), FRAME_SIZE);
+  }
+  const auto copyTime = Clock::now() - copyStart;
+  printf("  store+restore: %.1f us per page (two full copies: %.1f us)\n",
+         std::chrono::duration<double, std::micro>(snapshotTime).count() / ROUNDS,
+         std::chrono::duration<double, std::micro>(copyTime).count() / ROUNDS);
+  ASSERT_TRUE(memcmp(target.data(), frame, FRAME_SIZE) == 0);
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testBlankFrames();
+  testTextPage();
+  testIncompressibleFrame();
+  testRunsAcrossChunks();
+  testOddSizes();
+  testFailures();
+  testSpeed();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
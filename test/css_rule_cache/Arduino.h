@@ -0,0 +1,9 @@
+#pragma once
+
+// Host-test stand-in for the Arduino core: CssParser only asks for the free heap
+#include <cstdint>
+
+struct HostEsp {
+  uint32_t getFreeHeap() const { return 256 * 1024; }
+};
+inline HostEsp ESP;
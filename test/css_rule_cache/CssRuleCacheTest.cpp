@@ -0,0 +1,157 @@
+// Host test for the CSS rule cache: styles resolved through the cache file match the freshly parsed rules, and a
+// lookup stays within a few block reads once the cache is open.
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lib/Epub/Epub/css/CssParser.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+const std::string CACHE_DIR = "/.crosspoint/epub_test";
+const std::string CACHE_FILE = CACHE_DIR + "/css_rules.cache";
+
+bool sameLength(const CssLength& a, const CssLength& b) { return a.value == b.value && a.unit == b.unit; }
+
+bool sameStyle(const CssStyle& a, const CssStyle& b) {
+  return a.textAlign == b.textAlign && a.fontStyle == b.fontStyle && a.fontWeight == b.fontWeight &&
+         a.textDecoration == b.textDecoration && a.display == b.display && sameLength(a.textIndent, b.textIndent) &&
+         sameLength(a.marginTop, b.marginTop) && sameLength(a.marginBottom, b.marginBottom) &&
+         sameLength(a.marginLeft, b.marginLeft) && sameLength(a.paddingLeft, b.paddingLeft) &&
+         a.defined.textAlign == b.defined.textAlign && a.defined.fontWeight == b.defined.fontWeight &&
+         a.defined.marginTop == b.defined.marginTop && a.defined.textIndent == b.defined.textIndent &&
+         a.defined.display == b.defined.display;
+}
+
+// `count` class rules with varied declarations, plus a few element and element.class rules
+std::string makeStylesheet(const int count) {
+  static const char* const ALIGN[] = {"left", "right", "center", "justify"};
+  std::string css = "p { text-indent: 1.5em; margin-top: 0 } h1 { font-weight: bold; text-align: center }\n";
+  css += "p.note { font-style: italic } .hidden { display: none }\n";
+  for (int i = 0; i < count; i++) {
+    css += ".c" + std::to_string(i) + ", span.s" + std::to_string(i) + " { text-align: " + ALIGN[i % 4] +
+           "; margin-left: " + std::to_string(i % 7) + "px; padding-left: " + std::to_string(i % 5) + "em";
+    if (i % 3 == 0) css += "; font-weight: bold";
+    css += " }\n";
+  }
+  return css;
+}
+
+void parseInto(CssParser& parser, const std::string& css) {
+  auto& data = Storage.files["/style.css"];
+  data.assign(css.begin(), css.end());
+  FsFile file;
+  Storage.openFileForRead("TEST", "/style.css", file);
+  parser.loadFromStream(file);
+}
+
+struct Lookup {
+  std::string tag;
+  std::string classes;
+};
+
+std::vector<Lookup> makeLookups(const int count) {
+  std::vector<Lookup> lookups = {{"p", ""}, {"h1", ""}, {"p", "note"}, {"div", "hidden"}, {"p", "missing other"}};
+  for (int i = 0; i < count; i += 3) {
+    lookups.push_back({"span", "s" + std::to_string(i)});
+    lookups.push_back({"p", "c" + std::to_string(i) + " c" + std::to_string((i * 7) % count)});
+    lookups.push_back({"div", "x" + std::to_string(i)});  // not in the stylesheet
+  }
+  return lookups;
+}
+
+void testRoundTrip() {
+  printf("testRoundTrip\n");
+  for (const int count : {0, 1, 15, 16, 17, 200, 1400}) {
+    const std::string css = makeStylesheet(count);
+    CssParser parsed(CACHE_DIR);
+    parseInto(parsed, css);
+    const size_t rules = parsed.ruleCount();
+    ASSERT_TRUE(parsed.saveToCache());
+
+    CssParser cached(CACHE_DIR);
+    ASSERT_TRUE(cached.loadFromCache());
+    ASSERT_TRUE(cached.ruleCount() == rules);
+    for (const auto& lookup : makeLookups(count)) {
+      ASSERT_TRUE(sameStyle(parsed.resolveStyle(lookup.tag, lookup.classes),
+                            cached.resolveStyle(lookup.tag, lookup.classes)));
+    }
+    // The cached style carries the declarations, not only the defaults
+    if (count > 0) {
+      const CssStyle style = cached.resolveStyle("span", "s0");
+      ASSERT_TRUE(style.hasTextAlign() && style.textAlign == CssTextAlign::Left && style.hasFontWeight());
+    }
+  }
+  PASS();
+}
+
+void testLookupReads() {
+  printf("testLookupReads\n");
+  constexpr int COUNT = 1400;
+  CssParser parsed(CACHE_DIR);
+  parseInto(parsed, makeStylesheet(COUNT));
+  ASSERT_TRUE(parsed.saveToCache());
+
+  CssParser cached(CACHE_DIR);
+  ASSERT_TRUE(cached.loadFromCache());
+  const auto lookups = makeLookups(COUNT);
+  size_t selectorLookups = 0;
+  for (const auto& lookup : lookups) {
+    selectorLookups += 1 + 2 * (lookup.classes.empty() ? 0 : 1 + std::count(lookup.classes.begin(),
+                                                                                 lookup.classes.end(), ' '));
+  }
+  const size_t before = FsFile::readCalls;
+  for (const auto& lookup : lookups) (void)cached.resolveStyle(lookup.tag, lookup.classes);
+  const double readsPerLookup = static_cast<double>(FsFile::readCalls - before) / selectorLookups;
+  printf("  %zu rules: %.2f block reads per selector lookup\n", cached.ruleCount(), readsPerLookup);
+  // Fences in RAM leave one index run (one or two blocks), the selector and the style
+  ASSERT_TRUE(readsPerLookup < 4.0);
+  PASS();
+}
+
+void testStaleCache() {
+  printf("testStaleCache\n");
+  CssParser parsed(CACHE_DIR);
+  parseInto(parsed, makeStylesheet(20));
+  ASSERT_TRUE(parsed.saveToCache());
+
+  // An older version is removed so it gets rebuilt
+  Storage.files[CACHE_FILE][0] = CssParser::CSS_CACHE_VERSION - 1;
+  CssParser old(CACHE_DIR);
+  ASSERT_TRUE(!old.loadFromCache());
+  ASSERT_TRUE(!old.hasCache());
+
+  // A truncated file is refused
+  ASSERT_TRUE(parsed.saveToCache());
+  Storage.files[CACHE_FILE].resize(40);
+  CssParser truncated(CACHE_DIR);
+  ASSERT_TRUE(!truncated.loadFromCache());
+  ASSERT_TRUE(truncated.empty());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testRoundTrip();
+  testLookupReads();
+  testStaleCache();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// Host-test stand-in for lib/hal/HalStorage: files live in memory, and block reads are counted so tests can check how
+// often a lookup goes to the card
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class FsFile {
+ public:
+  static inline size_t readCalls = 0;
+
+  FsFile() = default;
+  explicit FsFile(std::vector<uint8_t>* data) : data(data) {}
+
+  explicit operator bool() const { return data != nullptr; }
+  int available() const { return data ? static_cast<int>(data->size() - pos) : 0; }
+  size_t fileSize() const { return data ? data->size() : 0; }
+  bool seek(const size_t offset) {
+    if (!data || offset > data->size()) return false;
+    pos = offset;
+    return true;
+  }
+  int read(void* buf, const size_t count) {
+    if (!data) return -1;
+    readCalls++;
+    const size_t n = std::min(count, data->size() - pos);
+    memcpy(buf, data->data() + pos, n);
+    pos += n;
+    return static_cast<int>(n);
+  }
+  size_t write(const uint8_t b) { return write(&b, 1); }
+  size_t write(const void* buf, const size_t count) {
+    if (!data) return 0;
+    const auto* bytes = static_cast<const uint8_t*>(buf);
+    data->insert(data->end(), bytes, bytes + count);
+    return count;
+  }
+  bool close() {
+    data = nullptr;
+    pos = 0;
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t>* data = nullptr;
+  size_t pos = 0;
+};
+
+class HalStorage {
+ public:
+  std::map<std::string, std::vector<uint8_t>> files;
+
+  bool exists(const char* path) const { return files.count(path) > 0; }
+  bool remove(const char* path) { return files.erase(path) > 0; }
+  bool openFileForRead(const char*, const std::string& path, FsFile& file) {
+    const auto it = files.find(path);
+    if (it == files.end()) return false;
+    file = FsFile(&it->second);
+    return true;
+  }
+  bool openFileForWrite(const char*, const std::string& path, FsFile& file) {
+    auto& data = files[path];
+    data.clear();
+    file = FsFile(&data);
+    return true;
+  }
+
+  static HalStorage& getInstance() {
+    static HalStorage instance;
+    return instance;
+  }
+};
+
+#define Storage HalStorage::getInstance()
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host-test stand-in for the Arduino core: DirectoryListing only times its builds
+inline unsigned long millis() { return 0; }
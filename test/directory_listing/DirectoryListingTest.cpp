@@ -0,0 +1,167 @@
+// Host test for DirectoryListing: natural ordering of names, and listings built on an in-memory card read back in that
+// order, found by name and rebuilt when the directory changes.
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "src/util/DirectoryListing.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+bool fileLess(const char* a, const char* b) { return DirectoryListing::naturalLess(a, false, b, false); }
+
+// Neither sorts before the other
+bool sameRank(const char* a, const char* b) { return !fileLess(a, b) && !fileLess(b, a); }
+
+std::vector<std::string> readNames(DirectoryListing& listing, const uint32_t first = 0, const uint32_t count = 1000) {
+  std::vector<std::string> names;
+  listing.read(first, count, [&names](uint32_t, const DirectoryListing::Entry& entry) {
+    names.emplace_back(entry.name);
+  });
+  return names;
+}
+
+void testNaturalLessDigits() {
+  printf("testNaturalLessDigits\n");
+  ASSERT_TRUE(fileLess("2.epub", "10.epub"));
+  ASSERT_TRUE(!fileLess("10.epub", "2.epub"));
+  ASSERT_TRUE(fileLess("Chapter 9", "Chapter 10"));
+  ASSERT_TRUE(fileLess("vol2 part10", "vol10 part2"));
+  ASSERT_TRUE(fileLess("a1b2", "a1b10"));
+  // Leading zeros don't count, so these rank equal
+  ASSERT_TRUE(sameRank("007", "7"));
+  ASSERT_TRUE(fileLess("007", "8"));
+  // Numbers longer than any integer type still compare by value
+  ASSERT_TRUE(fileLess("123456789012345678901", "123456789012345678902"));
+  ASSERT_TRUE(fileLess("99999999999999999999", "100000000000000000000"));
+  PASS();
+}
+
+void testNaturalLessCaseAndPrefixes() {
+  printf("testNaturalLessCaseAndPrefixes\n");
+  ASSERT_TRUE(sameRank("Book.epub", "book.EPUB"));
+  ASSERT_TRUE(fileLess("apple", "Banana"));
+  ASSERT_TRUE(fileLess("Apple", "banana"));
+  // A prefix sorts first, equal names are not less than each other
+  ASSERT_TRUE(fileLess("Book", "Book 2"));
+  ASSERT_TRUE(!fileLess("Book 2", "Book"));
+  ASSERT_TRUE(!fileLess("Book", "Book"));
+  ASSERT_TRUE(!fileLess("", ""));
+  ASSERT_TRUE(fileLess("", "a"));
+  // Digits against letters use the character order
+  ASSERT_TRUE(fileLess("1abc", "abc"));
+  ASSERT_TRUE(fileLess("a1", "ab"));
+  // Folders come first regardless of name
+  ASSERT_TRUE(DirectoryListing::naturalLess("zzz", true, "aaa", false));
+  ASSERT_TRUE(!DirectoryListing::naturalLess("aaa", false, "zzz", true));
+  PASS();
+}
+
+void testListingOrder() {
+  printf("testListingOrder\n");
+  Storage.addFile("/books/Vol 10.epub", 100);
+  Storage.addFile("/books/vol 2.epub", 200);
+  Storage.addFile("/books/Vol 1.epub", 300);
+  Storage.addFile("/books/notes.txt", 5);
+  Storage.addFile("/books/.hidden", 1);
+  Storage.addFile("/books/Series/a.epub", 1);
+  Storage.addFile("/books/archive/b.epub", 1);
+
+  DirectoryListing listing;
+  ASSERT_TRUE(listing.open("/books/"));
+  ASSERT_TRUE(listing.size() == 7);
+  const std::vector<std::string> expected = {"archive",    "Series",     ".hidden",    "notes.txt",
+                                             "Vol 1.epub", "vol 2.epub", "Vol 10.epub"};
+  ASSERT_TRUE(readNames(listing) == expected);
+  // A window in the middle, and one running past the end
+  ASSERT_TRUE(readNames(listing, 3, 2) == std::vector<std::string>({"notes.txt", "Vol 1.epub"}));
+  ASSERT_TRUE(readNames(listing, 6, 10) == std::vector<std::string>({"Vol 10.epub"}));
+  ASSERT_TRUE(readNames(listing, 9, 10).empty());
+
+  std::vector<uint8_t> flags;
+  listing.readFlags([&flags](uint32_t, const uint8_t f) { flags.push_back(f); });
+  ASSERT_TRUE(flags.size() == 7);
+  ASSERT_TRUE(flags[0] == DirectoryListing::DIRECTORY && flags[2] == DirectoryListing::HIDDEN);
+  ASSERT_TRUE(flags[3] == DirectoryListing::BOOK && flags[6] == DirectoryListing::BOOK);
+
+  uint32_t size = 0;
+  listing.read(5, 1, [&size](uint32_t, const DirectoryListing::Entry& entry) { size = entry.size; });
+  ASSERT_TRUE(size == 200);
+  PASS();
+}
+
+void testFind() {
+  printf("testFind\n");
+  Storage.addFile("/find/Track 01.mp3");
+  Storage.addFile("/find/track 1.mp3");
+  Storage.addFile("/find/Track 2.mp3");
+  Storage.addFile("/find/track 2/x");
+
+  DirectoryListing listing;
+  ASSERT_TRUE(listing.open("/find"));
+  const auto names = readNames(listing);
+  // Names that rank equal are all found by their exact spelling
+  for (const char* name : {"Track 01.mp3", "track 1.mp3", "Track 2.mp3"}) {
+    const uint32_t index = listing.find(name, false);
+    ASSERT_TRUE(index < listing.size() && names[index] == name);
+  }
+  ASSERT_TRUE(listing.find("track 2", true) == 0);
+  ASSERT_TRUE(listing.find("track 2", false) == listing.size());
+  ASSERT_TRUE(listing.find("Track 3.mp3", false) == listing.size());
+  ASSERT_TRUE(listing.find("TRACK 2.MP3", false) == listing.size());
+  PASS();
+}
+
+void testRebuild() {
+  printf("testRebuild\n");
+  Storage.addFile("/shelf/b.epub");
+  DirectoryListing listing;
+  ASSERT_TRUE(listing.open("/shelf"));
+  ASSERT_TRUE(listing.size() == 1);
+
+  // A change through the firmware invalidates the listing
+  Storage.addFile("/shelf/a.epub");
+  const uint32_t changes = DirectoryListing::changeCount();
+  DirectoryListing::invalidateParent("/shelf/a.epub");
+  ASSERT_TRUE(DirectoryListing::changeCount() == changes + 1);
+  ASSERT_TRUE(listing.open("/shelf"));
+  ASSERT_TRUE(readNames(listing) == std::vector<std::string>({"a.epub", "b.epub"}));
+
+  // A cut-short cache file is never trusted
+  for (auto& [path, data] : Storage.files) {
+    if (path.rfind("/.crosspoint/dircache/", 0) == 0) data.resize(data.size() - 1);
+  }
+  ASSERT_TRUE(listing.open("/shelf"));
+  ASSERT_TRUE(listing.size() == 2);
+
+  ASSERT_TRUE(!listing.open("/missing"));
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testNaturalLessDigits();
+  testNaturalLessCaseAndPrefixes();
+  testListingOrder();
+  testFind();
+  testRebuild();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
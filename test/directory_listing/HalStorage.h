@@ -0,0 +1,165 @@
+#pragma once
+
+// Host-test stand-in for lib/hal/HalStorage: an in-memory card with files and directories. Reading a directory
+// returns a serialization of its entries, standing in for the raw FAT entries DirectoryListing hashes.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+class HalStorage;
+
+class FsFile {
+ public:
+  FsFile() = default;
+  FsFile(HalStorage* storage, std::string path, const bool directory)
+      : storage(storage), path(std::move(path)), directory(directory) {}
+
+  explicit operator bool() const { return storage != nullptr; }
+  bool isOpen() const { return storage != nullptr; }
+  bool isDirectory() const { return directory; }
+  size_t size() const;
+  size_t getName(char* name, size_t length) const;
+  bool seek(size_t offset) {
+    if (!storage || offset > size()) return false;
+    pos = offset;
+    return true;
+  }
+  int read(void* buf, size_t count);
+  size_t write(const void* buf, size_t count);
+  void rewindDirectory() { next = 0; }
+  FsFile openNextFile();
+  bool close() {
+    storage = nullptr;
+    pos = 0;
+    return true;
+  }
+
+ private:
+  HalStorage* storage = nullptr;
+  std::string path;
+  bool directory = false;
+  size_t pos = 0;
+  size_t next = 0;
+
+  std::vector<uint8_t>& data() const;
+  std::string rawEntries() const;
+};
+
+class HalStorage {
+ public:
+  std::map<std::string, std::vector<uint8_t>> files;  // full path -> contents
+  std::vector<std::string> directories = {"/"};
+
+  // Adds a file and any missing parent directories
+  void addFile(const std::string& path, const size_t size = 0) {
+    files[path].assign(size, 0);
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+      mkdir(path.substr(0, slash).c_str());
+    }
+  }
+
+  bool exists(const char* path) const {
+    return files.count(path) > 0 || std::find(directories.begin(), directories.end(), path) != directories.end();
+  }
+  bool remove(const char* path) { return files.erase(path) > 0; }
+  bool mkdir(const char* path) {
+    if (!exists(path)) directories.emplace_back(path);
+    return true;
+  }
+  FsFile open(const char* path) {
+    if (files.count(path)) return FsFile(this, path, false);
+    if (std::find(directories.begin(), directories.end(), path) != directories.end()) return FsFile(this, path, true);
+    return {};
+  }
+  bool openFileForRead(const char*, const std::string& path, FsFile& file) {
+    if (!files.count(path)) return false;
+    file = FsFile(this, path, false);
+    return true;
+  }
+  bool openFileForWrite(const char*, const std::string& path, FsFile& file) {
+    files[path].clear();
+    file = FsFile(this, path, false);
+    return true;
+  }
+
+  // Direct children of `dir`, in creation order for directories and name order for files (like an unsorted card)
+  static std::string childPath(const std::string& dir, const std::string& name) {
+    return (dir == "/" ? "" : dir) + "/" + name;
+  }
+
+  std::vector<std::pair<std::string, bool>> children(const std::string& dir) const {
+    const std::string prefix = dir == "/" ? "/" : dir + "/";
+    std::vector<std::pair<std::string, bool>> entries;
+    auto addChild = [&](const std::string& path, const bool isDirectory) {
+      if (path.size() > prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+          path.find('/', prefix.size()) == std::string::npos) {
+        entries.emplace_back(path.substr(prefix.size()), isDirectory);
+      }
+    };
+    for (const auto& directory : directories) addChild(directory, true);
+    for (const auto& file : files) addChild(file.first, false);
+    return entries;
+  }
+
+  static HalStorage& getInstance() {
+    static HalStorage instance;
+    return instance;
+  }
+};
+
+inline std::vector<uint8_t>& FsFile::data() const { return storage->files[path]; }
+
+inline std::string FsFile::rawEntries() const {
+  std::string raw;
+  for (const auto& [name, isDirectory] : storage->children(path)) {
+    raw += name;
+    raw += isDirectory ? "/" : ":" + std::to_string(storage->files[HalStorage::childPath(path, name)].size());
+    raw += "\n";
+  }
+  return raw;
+}
+
+inline size_t FsFile::size() const {
+  if (!storage) return 0;
+  return directory ? rawEntries().size() : data().size();
+}
+
+inline size_t FsFile::getName(char* name, const size_t length) const {
+  const std::string base = path.substr(path.rfind('/') + 1);
+  if (base.size() + 1 > length) return 0;
+  memcpy(name, base.c_str(), base.size() + 1);
+  return base.size();
+}
+
+inline int FsFile::read(void* buf, const size_t count) {
+  if (!storage) return -1;
+  const std::string raw = directory ? rawEntries() : std::string(data().begin(), data().end());
+  const size_t n = std::min(count, raw.size() - std::min(pos, raw.size()));
+  memcpy(buf, raw.data() + pos, n);
+  pos += n;
+  return static_cast<int>(n);
+}
+
+inline size_t FsFile::write(const void* buf, const size_t count) {
+  if (!storage || directory) return 0;
+  auto& bytes = data();
+  const auto* in = static_cast<const uint8_t*>(buf);
+  if (pos + count > bytes.size()) bytes.resize(pos + count);
+  std::copy(in, in + count, bytes.begin() + pos);
+  pos += count;
+  return count;
+}
+
+inline FsFile FsFile::openNextFile() {
+  if (!storage || !directory) return {};
+  const auto entries = storage->children(path);
+  if (next >= entries.size()) return {};
+  const auto& [name, isDirectory] = entries[next++];
+  return FsFile(storage, HalStorage::childPath(path, name), isDirectory);
+}
+
+#define Storage HalStorage::getInstance()
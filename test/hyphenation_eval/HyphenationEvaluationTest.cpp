@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <functional>
@@ -13,6 +14,12 @@
 #include "lib/Epub/Epub/hyphenation/HyphenationCommon.h"
 #include "lib/Epub/Epub/hyphenation/LanguageHyphenator.h"
 #include "lib/Epub/Epub/hyphenation/LanguageRegistry.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-de.trie.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-en.trie.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-es.trie.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-fr.trie.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-it.trie.h"
+#include "lib/Epub/Epub/hyphenation/generated/hyph-ru.trie.h"
 
 struct TestCase {
   std::string word;
@@ -35,15 +42,24 @@ struct LanguageConfig {
   std::string cliName;
   std::string testDataFile;
   const char* primaryTag;
+  // Raw patterns and word config, used by --bench to drive liangBreakIndexes directly.
+  const SerializedHyphenationPatterns* patterns;
+  LiangWordConfig wordConfig;
 };
 
 const std::vector<LanguageConfig> kSupportedLanguages = {
-    {"english", "test/hyphenation_eval/resources/english_hyphenation_tests.txt", "en"},
-    {"french", "test/hyphenation_eval/resources/french_hyphenation_tests.txt", "fr"},
-    {"german", "test/hyphenation_eval/resources/german_hyphenation_tests.txt", "de"},
-    {"russian", "test/hyphenation_eval/resources/russian_hyphenation_tests.txt", "ru"},
-    {"spanish", "test/hyphenation_eval/resources/spanish_hyphenation_tests.txt", "es"},
-    {"italian", "test/hyphenation_eval/resources/italian_hyphenation_tests.txt", "it"},
+    {"english", "test/hyphenation_eval/resources/english_hyphenation_tests.txt", "en", &en_patterns,
+     LiangWordConfig(isLatinLetter, toLowerLatin, 3, 3)},
+    {"french", "test/hyphenation_eval/resources/french_hyphenation_tests.txt", "fr", &fr_patterns,
+     LiangWordConfig(isLatinLetter, toLowerLatin)},
+    {"german", "test/hyphenation_eval/resources/german_hyphenation_tests.txt", "de", &de_patterns,
+     LiangWordConfig(isLatinLetter, toLowerLatin)},
+    {"russian", "test/hyphenation_eval/resources/russian_hyphenation_tests.txt", "ru", &ru_patterns,
+     LiangWordConfig(isCyrillicLetter, toLowerCyrillic)},
+    {"spanish", "test/hyphenation_eval/resources/spanish_hyphenation_tests.txt", "es", &es_patterns,
+     LiangWordConfig(isLatinLetter, toLowerLatin)},
+    {"italian", "test/hyphenation_eval/resources/italian_hyphenation_tests.txt", "it", &it_patterns,
+     LiangWordConfig(isLatinLetter, toLowerLatin)},
 };
 
 std::vector<size_t> expectedPositionsFromAnnotatedWord(const std::string& annotated) {
@@ -302,7 +318,73 @@ void printResults(const std::string& language, const std::vector<TestCase>& test
   }
 }
 
+// Times liangBreakIndexes over every test word, once walking the trie node by node from the root and once
+// through the generated first-two-level tables. Also cross-checks that both walks return identical breaks.
+int runBenchmark(const std::vector<LanguageConfig>& languages) {
+  constexpr int kRounds = 20;
+  int mismatches = 0;
+
+  for (const auto& lang : languages) {
+    const std::vector<TestCase> testCases = loadTestData(lang.testDataFile);
+    if (testCases.empty()) {
+      std::cerr << "No test cases loaded for " << lang.cliName << ". Skipping." << std::endl;
+      continue;
+    }
+
+    std::vector<std::vector<CodepointInfo>> words;
+    words.reserve(testCases.size());
+    for (const auto& testCase : testCases) {
+      auto cps = collectCodepoints(testCase.word);
+      trimSurroundingPunctuationAndFootnote(cps);
+      words.push_back(std::move(cps));
+    }
+
+    SerializedHyphenationPatterns genericPatterns = *lang.patterns;
+    genericPatterns.fastPath = nullptr;
+
+    for (const auto& cps : words) {
+      if (liangBreakIndexes(cps, genericPatterns, lang.wordConfig) !=
+          liangBreakIndexes(cps, *lang.patterns, lang.wordConfig)) {
+        ++mismatches;
+      }
+    }
+
+    const auto timeWalk = [&](const SerializedHyphenationPatterns& patterns) {
+      volatile size_t breaks = 0;  // Keeps the calls observable so they are not optimized away.
+      const auto start = std::chrono::steady_clock::now();
+      for (int round = 0; round < kRounds; ++round) {
+        for (const auto& cps : words) {
+          breaks = breaks + liangBreakIndexes(cps, patterns, lang.wordConfig).size();
+        }
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      return static_cast<double>(words.size()) * kRounds / elapsed.count();
+    };
+
+    const double genericRate = timeWalk(genericPatterns);
+    const double fastRate = timeWalk(*lang.patterns);
+    std::cout << lang.cliName << ": generic " << static_cast<long>(genericRate) << " words/s, fast path "
+              << static_cast<long>(fastRate) << " words/s (x" << (fastRate / genericRate) << ")" << std::endl;
+  }
+
+  if (mismatches > 0) {
+    std::cerr << mismatches << " words hyphenated differently between the generic and fast-path walks" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "--bench") {
+    const std::string selection = argc > 2 ? argv[2] : "all";
+    const std::vector<LanguageConfig> languages = resolveLanguages(selection);
+    if (languages.empty()) {
+      std::cerr << "Unknown language: " << selection << std::endl;
+      return 1;
+    }
+    return runBenchmark(languages);
+  }
+
   const bool summaryMode = argc <= 1;
   const std::string languageSelection = summaryMode ? "all" : argv[1];
 
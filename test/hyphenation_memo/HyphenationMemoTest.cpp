@@ -0,0 +1,261 @@
+// Host test for the hyphenation memo: memoized break points match the uncached path, the hit rate on a word stream
+// with natural frequencies, words whose hashes collide, scopes on two threads, and words the memo cannot hold.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/Epub/Epub/hyphenation/Hyphenator.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+struct Word {
+  std::string text;
+  int frequency;
+};
+
+// word|hyphenated|frequency lines from the hyphenation evaluation data
+std::vector<Word> loadWords(const char* path) {
+  std::vector<Word> words;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string word, hyphenated, frequency;
+    if (std::getline(fields, word, '|') && std::getline(fields, hyphenated, '|') && std::getline(fields, frequency)) {
+      words.push_back({word, std::stoi(frequency)});
+    }
+  }
+  return words;
+}
+
+// Every word repeated by its frequency in the source book, shuffled: the order a section build meets them in
+std::vector<std::string> makeStream(const std::vector<Word>& words) {
+  std::vector<std::string> stream;
+  for (const auto& word : words) {
+    for (int i = 0; i < word.frequency; i++) stream.push_back(word.text);
+  }
+  std::mt19937 rng(42);
+  std::shuffle(stream.begin(), stream.end(), rng);
+  return stream;
+}
+
+bool sameBreaks(const std::string& word, const bool includeFallback) {
+  const auto expected = Hyphenator::breakOffsets(word, includeFallback);
+  Hyphenator::BreakInfo breaks[64];
+  const size_t count = Hyphenator::breakOffsets(word, includeFallback, breaks, 64);
+  if (count != expected.size()) return false;
+  for (size_t i = 0; i < std::min<size_t>(count, 64); i++) {
+    if (breaks[i].byteOffset != expected[i].byteOffset ||
+        breaks[i].requiresInsertedHyphen != expected[i].requiresInsertedHyphen) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void testMatchesUncached() {
+  printf("testMatchesUncached\n");
+  const auto words = loadWords("test/hyphenation_eval/resources/english_hyphenation_tests.txt");
+  ASSERT_TRUE(words.size() > 1000);
+  Hyphenator::setPreferredLanguage("en");
+
+  const Hyphenator::MemoScope memo;
+  // Each word twice in a row, so the second lookup is served from the table
+  for (const auto& word : words) {
+    for (int repeat = 0; repeat < 2; repeat++) {
+      ASSERT_TRUE(sameBreaks(word.text, false));
+      ASSERT_TRUE(sameBreaks(word.text, true));
+      ASSERT_TRUE(sameBreaks("\"" + word.text + "\",", false));  // punctuation around the word
+    }
+  }
+  ASSERT_TRUE(sameBreaks("US-Satellitensystems", false));
+  ASSERT_TRUE(sameBreaks("all'improvviso", true));
+  ASSERT_TRUE(sameBreaks("Satel\xC2\xADliten", false));
+  ASSERT_TRUE(memo.hits() > 0);
+  PASS();
+}
+
+void testHitRate() {
+  printf("testHitRate\n");
+  Hyphenator::setPreferredLanguage("en");
+  const auto stream = makeStream(loadWords("test/hyphenation_eval/resources/english_hyphenation_tests.txt"));
+
+  const Hyphenator::MemoScope memo;
+  Hyphenator::BreakInfo breaks[48];
+  for (const auto& word : stream) Hyphenator::breakOffsets(word, false, breaks, 48);
+  const double hitRate = 100.0 * static_cast<double>(memo.hits()) / static_cast<double>(memo.lookups());
+  printf("  %zu words: %zu of %zu lookups served from the memo (%.1f%%)\n", stream.size(), memo.hits(),
+         memo.lookups(), hitRate);
+  ASSERT_TRUE(memo.lookups() == stream.size());
+  // Frequent words stay resident; 128 entries cannot hold the long tail (keeping the 128 most frequent words
+  // forever would serve about 31%)
+  ASSERT_TRUE(hitRate > 20.0);
+  PASS();
+}
+
+void testScopeAndLanguage() {
+  printf("testScopeAndLanguage\n");
+  Hyphenator::BreakInfo breaks[48];
+  {
+    // Outside a scope nothing is memoized
+    Hyphenator::setPreferredLanguage("en");
+    const Hyphenator::MemoScope disabled(false);
+    Hyphenator::breakOffsets("computer", false, breaks, 48);
+    Hyphenator::breakOffsets("computer", false, breaks, 48);
+    ASSERT_TRUE(disabled.lookups() == 0);
+  }
+
+  // A language switch inside a scope never serves the other language's break points
+  const Hyphenator::MemoScope memo;
+  const std::string word = "Quadratkilometer";
+  Hyphenator::setPreferredLanguage("de");
+  const auto german = Hyphenator::breakOffsets(word, false);
+  ASSERT_TRUE(sameBreaks(word, false));
+  Hyphenator::setPreferredLanguage("en");
+  ASSERT_TRUE(sameBreaks(word, false));
+  Hyphenator::setPreferredLanguage("de");
+  const size_t count = Hyphenator::breakOffsets(word, false, breaks, 48);
+  ASSERT_TRUE(count == german.size() && memo.hits() == 1);
+
+  // A count beyond the capacity reports the total and writes only what fits
+  ASSERT_TRUE(Hyphenator::breakOffsets(word, false, breaks, 1) == german.size());
+  ASSERT_TRUE(breaks[0].byteOffset == german[0].byteOffset);
+  PASS();
+}
+
+// Two words with the same 32-bit hash land in the same slot; each keeps its own break points
+void testHashCollision() {
+  printf("testHashCollision\n");
+  Hyphenator::setPreferredLanguage("en");
+  const auto hash = [](const std::string& word) {
+    uint32_t h = 2166136261u;
+    for (const char c : word) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+    return h;
+  };
+
+  // Random lowercase words until two with different break points share a hash (a few hundred thousand at most)
+  std::mt19937 rng(7);
+  std::unordered_map<uint32_t, std::string> seen;
+  std::string first, second;
+  while (first.empty()) {
+    std::string word(6 + rng() % 12, 'a');
+    for (auto& c : word) c = static_cast<char>('a' + rng() % 26);
+    const auto [it, inserted] = seen.emplace(hash(word), word);
+    if (!inserted && it->second != word) {
+      const auto a = Hyphenator::breakOffsets(it->second, true);
+      const auto b = Hyphenator::breakOffsets(word, true);
+      const bool differ = a.size() != b.size() ||
+                          !std::equal(a.begin(), a.end(), b.begin(), [](const auto& x, const auto& y) {
+                            return x.byteOffset == y.byteOffset;
+                          });
+      if (differ) {
+        first = it->second;
+        second = word;
+      }
+    }
+  }
+  printf("  \"%s\" and \"%s\" share hash %08x\n", first.c_str(), second.c_str(), hash(first));
+
+  const Hyphenator::MemoScope memo;
+  ASSERT_TRUE(sameBreaks(first, true));
+  ASSERT_TRUE(sameBreaks(second, true));
+  ASSERT_TRUE(sameBreaks(first, true));
+  ASSERT_TRUE(sameBreaks(second, true));
+  ASSERT_TRUE(memo.hits() == 2);
+  PASS();
+}
+
+// Section builds on two tasks at once, each with its own scope and language
+void testThreads() {
+  printf("testThreads\n");
+  const auto words = loadWords("test/hyphenation_eval/resources/english_hyphenation_tests.txt");
+  ASSERT_TRUE(!words.empty());
+  bool ok[2] = {false, false};
+  size_t hits[2] = {0, 0};
+  const auto build = [&words](const char* language, bool& matched, size_t& served) {
+    Hyphenator::setPreferredLanguage(language);
+    const Hyphenator::MemoScope memo;
+    matched = true;
+    for (int pass = 0; pass < 2; pass++) {
+      for (size_t i = 0; i < words.size(); i += 7) matched = matched && sameBreaks(words[i].text, false);
+    }
+    served = memo.hits();
+  };
+  std::thread english(build, "en", std::ref(ok[0]), std::ref(hits[0]));
+  std::thread german(build, "de", std::ref(ok[1]), std::ref(hits[1]));
+  english.join();
+  german.join();
+  ASSERT_TRUE(ok[0] && ok[1]);
+  ASSERT_TRUE(hits[0] > 0 && hits[1] > 0);
+
+  // Scopes on one task nest: the inner one takes over and the outer one is back after it
+  Hyphenator::setPreferredLanguage("en");
+  const Hyphenator::MemoScope outer;
+  Hyphenator::BreakInfo breaks[48];
+  Hyphenator::breakOffsets("computer", false, breaks, 48);
+  {
+    const Hyphenator::MemoScope inner;
+    Hyphenator::breakOffsets("computer", false, breaks, 48);
+    ASSERT_TRUE(inner.lookups() == 1 && inner.hits() == 0);
+  }
+  Hyphenator::breakOffsets("computer", false, breaks, 48);
+  ASSERT_TRUE(outer.lookups() == 2 && outer.hits() == 1);
+  PASS();
+}
+
+void testLongWords() {
+  printf("testLongWords\n");
+  Hyphenator::setPreferredLanguage("en");
+  const Hyphenator::MemoScope memo;
+
+  // Longer than the memo holds: computed every time, never stored
+  const std::string long100(100, 'a');
+  ASSERT_TRUE(sameBreaks(long100, true));
+  const std::string long33(33, 'b');
+  ASSERT_TRUE(sameBreaks(long33, true));
+  ASSERT_TRUE(sameBreaks(std::string(32, 'b'), true));
+  ASSERT_TRUE(memo.lookups() == 1);
+
+  // Break offsets past 64 KB keep their value (fallback breaks on an oversized run of letters)
+  const std::string huge(70000, 'a');
+  const auto breaks = Hyphenator::breakOffsets(huge, true);
+  ASSERT_TRUE(!breaks.empty());
+  ASSERT_TRUE(breaks.back().byteOffset > 65535 && breaks.back().byteOffset < huge.size());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testMatchesUncached();
+  testHitRate();
+  testScopeAndLanguage();
+  testHashCollision();
+  testThreads();
+  testLongWords();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
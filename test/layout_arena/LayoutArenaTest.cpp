@@ -0,0 +1,132 @@
+// Host test for LayoutArena: chunk reuse, pages that straddle chunks, heap pass-through and use from pmr containers.
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "lib/Epub/Epub/LayoutArena.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+void testRewind() {
+  printf("testRewind\n");
+  LayoutArena arena;
+  void* first = arena.allocate(24);
+  void* second = arena.allocate(100);
+  ASSERT_TRUE(first != second);
+  ASSERT_TRUE(arena.chunkCount() == 1);
+  arena.deallocate(second, 100);
+  arena.deallocate(first, 24);
+  // Everything returned: the chunk starts over
+  void* again = arena.allocate(24);
+  ASSERT_TRUE(again == first);
+  arena.deallocate(again, 24);
+  ASSERT_TRUE(arena.chunkCount() == 1);
+  PASS();
+}
+
+void testAlignment() {
+  printf("testAlignment\n");
+  LayoutArena arena;
+  std::vector<std::pair<void*, size_t>> blocks;
+  for (size_t alignment : {1u, 2u, 4u, 8u, 16u, 2u, 8u}) {
+    void* p = arena.allocate(3, alignment);
+    ASSERT_TRUE(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+    blocks.emplace_back(p, alignment);
+  }
+  for (const auto& [p, alignment] : blocks) arena.deallocate(p, 3, alignment);
+  PASS();
+}
+
+void testLargeBlocksUseHeap() {
+  printf("testLargeBlocksUseHeap\n");
+  LayoutArena arena;
+  void* large = arena.allocate(LayoutArena::MAX_BLOCK_SIZE + 1);
+  ASSERT_TRUE(arena.chunkCount() == 0);
+  arena.deallocate(large, LayoutArena::MAX_BLOCK_SIZE + 1);
+  PASS();
+}
+
+// Lines are built before the page they end up on is started, so a page's first blocks share a chunk with the end of
+// the previous page. Dropping pages in order must keep the number of chunks bounded.
+void testStraddlingPages() {
+  printf("testStraddlingPages\n");
+  LayoutArena arena;
+  constexpr size_t LINE_BYTES = 200;
+  constexpr size_t LINES_PER_PAGE = 30;
+  std::deque<std::vector<void*>> pages;
+  pages.emplace_back();
+  for (int line = 0; line < 3000; line++) {
+    void* block = arena.allocate(LINE_BYTES);
+    if (pages.back().size() == LINES_PER_PAGE) {
+      // The new line is already allocated when the finished page is dropped
+      for (void* p : pages.front()) arena.deallocate(p, LINE_BYTES);
+      pages.pop_front();
+      pages.emplace_back();
+    }
+    pages.back().push_back(block);
+  }
+  const size_t pageChunks = (LINE_BYTES * LINES_PER_PAGE + LayoutArena::CHUNK_SIZE - 1) / LayoutArena::CHUNK_SIZE;
+  ASSERT_TRUE(arena.peakChunkCount() <= pageChunks + 2);
+  for (void* p : pages.front()) arena.deallocate(p, LINE_BYTES);
+  pages.clear();
+  // Emptied chunks go back to the heap except for one spare
+  ASSERT_TRUE(arena.chunkCount() <= 2);
+  PASS();
+}
+
+void testPmrContainers() {
+  printf("testPmrContainers\n");
+  LayoutArena arena;
+  {
+    std::pmr::vector<std::pmr::string> words(&arena);
+    for (int i = 0; i < 12; i++) words.emplace_back("a word long enough to leave the small string buffer");
+    const char* text = words[3].data();
+
+    // Moving words between containers of the same arena keeps their storage
+    std::pmr::vector<std::pmr::string> line(std::make_move_iterator(words.begin()),
+                                            std::make_move_iterator(words.begin() + 6), &arena);
+    ASSERT_TRUE(line[3].data() == text);
+
+    auto shared = std::allocate_shared<std::pmr::vector<int>>(std::pmr::polymorphic_allocator<int>(&arena), 4, 7);
+    ASSERT_TRUE(shared->size() == 4 && (*shared)[3] == 7);
+    ASSERT_TRUE(arena.chunkCount() >= 1);
+  }
+  // All blocks came back, so the next allocation starts at the beginning of a chunk again
+  void* first = arena.allocate(8);
+  void* second = arena.allocate(8);
+  ASSERT_TRUE(static_cast<char*>(second) - static_cast<char*>(first) < 32);
+  arena.deallocate(second, 8);
+  arena.deallocate(first, 8);
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testRewind();
+  testAlignment();
+  testLargeBlocksUseHeap();
+  testStraddlingPages();
+  testPmrContainers();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
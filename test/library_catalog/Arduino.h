@@ -0,0 +1,4 @@
+#pragma once
+
+// Host-test stand-in for the Arduino core: the catalog only times its rescans and sorts
+inline unsigned long millis() { return 0; }
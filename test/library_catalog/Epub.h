@@ -0,0 +1,42 @@
+#pragma once
+
+// Host-test stand-in for lib/Epub: a book "loads" when the test registered its metadata in EpubStub::books, and every
+// load counts as one probe of the card.
+#include <map>
+#include <string>
+#include <utility>
+
+namespace EpubStub {
+struct Metadata {
+  std::string title;
+  std::string author;
+};
+inline std::map<std::string, Metadata> books;  // by path
+inline int loads = 0;
+}  // namespace EpubStub
+
+class Epub {
+ public:
+  explicit Epub(std::string filepath, const std::string& cacheDir)
+      : filepath(std::move(filepath)), cachePath(cacheDir + "/epub_stub") {}
+
+  bool load(bool = true, bool = false) {
+    EpubStub::loads++;
+    const auto book = EpubStub::books.find(filepath);
+    if (book == EpubStub::books.end()) return false;
+    metadata = book->second;
+    return true;
+  }
+
+  const std::string& getCachePath() const { return cachePath; }
+  const std::string& getTitle() const { return metadata.title; }
+  const std::string& getAuthor() const { return metadata.author; }
+  std::string getThumbBmpPath(int) const { return cachePath + "/thumb.bmp"; }
+  int getSpineItemsCount() const { return 0; }
+  float calculateProgress(int, float) const { return 0; }
+
+ private:
+  std::string filepath;
+  std::string cachePath;
+  EpubStub::Metadata metadata;
+};
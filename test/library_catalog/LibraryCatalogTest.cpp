@@ -0,0 +1,355 @@
+// Host test for LibraryCatalog: the library.bin layout written by a rescan, the sort orders and their text tie-breaks,
+// updates, and rescans that stop half way (book changes meanwhile, power loss, a full card).
+#include <Epub.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "src/LibraryCatalog.h"
+#include "src/RecentBooksStore.h"
+#include "src/activities/RenderLock.h"
+#include "src/components/UITheme.h"
+
+// The parts of the firmware the catalog links against
+RenderLock::RenderLock() {}
+RenderLock::~RenderLock() {}
+
+RecentBooksStore RecentBooksStore::instance;
+bool RecentBooksStore::loadFromFile() {
+  loaded = true;
+  return true;
+}
+void RecentBooksStore::addBook(const std::string& path, const std::string& title, const std::string& author,
+                               const std::string& coverBmpPath) {
+  recentBooks.insert(recentBooks.begin(), {path, title, author, coverBmpPath});
+}
+
+UITheme UITheme::instance;
+UITheme::UITheme() : currentMetrics(nullptr) {}
+std::vector<int> UITheme::getCoverThumbHeights() const { return {}; }
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+using Order = LibraryCatalog::Order;
+using Strings = std::vector<std::string>;
+
+constexpr char CATALOG_FILE[] = "/.crosspoint/library.bin";
+constexpr char CATALOG_FILE_TMP[] = "/.crosspoint/library.tmp";
+constexpr char CATALOG_STRINGS_TMP[] = "/.crosspoint/library.str";
+constexpr uint32_t HEADER_SIZE = 32;
+constexpr uint32_t RECORD_SIZE = 36;
+constexpr uint32_t INDEX_COUNT = 4;
+
+void resetCard() {
+  Storage.clear();
+  EpubStub::books.clear();
+  EpubStub::loads = 0;
+}
+
+void addBook(const std::string& path, const std::string& title, const std::string& author, const size_t size = 1) {
+  Storage.addFile(path, size);
+  EpubStub::books[path] = {title, author};
+}
+
+void rescanAll(LibraryCatalog& catalog) {
+  while (catalog.rescanStep()) {
+  }
+}
+
+Strings readTitles(LibraryCatalog& catalog, const Order order, const uint32_t first = 0,
+                   const uint32_t count = 1000) {
+  Strings titles;
+  catalog.read(order, first, count, [&titles](uint32_t, const LibraryCatalog::Book& book) {
+    titles.emplace_back(book.title);
+  });
+  return titles;
+}
+
+LibraryCatalog::Book findBook(LibraryCatalog& catalog, const std::string& path, std::string& storage) {
+  LibraryCatalog::Book found{};
+  catalog.read(Order::Title, 0, catalog.size(), [&](uint32_t, const LibraryCatalog::Book& book) {
+    if (book.path == path) {
+      found = book;
+      storage = std::string(book.title);
+      found.title = storage;
+      found.path = {};
+      found.author = {};
+    }
+  });
+  return found;
+}
+
+template <typename T>
+T readAt(const std::vector<uint8_t>& bytes, const size_t offset) {
+  T value{};
+  memcpy(&value, bytes.data() + offset, sizeof(value));
+  return value;
+}
+
+std::string stringAt(const std::vector<uint8_t>& bytes, const size_t offset, const size_t length) {
+  return std::string(bytes.begin() + offset, bytes.begin() + offset + length);
+}
+
+void testFileLayout() {
+  printf("testFileLayout\n");
+  resetCard();
+  addBook("/a.epub", "Alpha", "Ann", 100);
+  Storage.addFile("/b.epub", 200);  // no metadata: titled by its file name
+  Storage.addFile("/notes/c.txt", 300);
+  Storage.addFile("/notes/cover.jpg");
+  Storage.addFile("/.hidden/x.epub");
+  Storage.addFile("/XTCache/y.epub");
+  RECENT_BOOKS.addBook("/b.epub", "b", "", "");
+
+  LibraryCatalog catalog;
+  rescanAll(catalog);
+  ASSERT_TRUE(!Storage.exists(CATALOG_FILE_TMP) && !Storage.exists(CATALOG_STRINGS_TMP));
+  ASSERT_TRUE(Storage.exists(CATALOG_FILE));
+  const std::vector<uint8_t>& bytes = Storage.files[CATALOG_FILE];
+
+  // Header: version, stale index bits, count, readCount, clock, stringsStart
+  const uint32_t count = 3;
+  const uint32_t stringsStart = HEADER_SIZE + count * (RECORD_SIZE + INDEX_COUNT * 4);
+  ASSERT_TRUE(bytes[0] == 1);
+  ASSERT_TRUE(bytes[1] == 0);
+  ASSERT_TRUE(readAt<uint32_t>(bytes, 4) == count);
+  ASSERT_TRUE(readAt<uint32_t>(bytes, 8) == 1);
+  ASSERT_TRUE(readAt<uint32_t>(bytes, 12) == 1);
+  ASSERT_TRUE(readAt<uint32_t>(bytes, 16) == stringsStart);
+
+  // Records in scan order with their strings back to back: path, title, author
+  struct Expected {
+    const char* path;
+    const char* title;
+    const char* author;
+    uint32_t size;
+    uint32_t lastRead;
+    uint8_t cacheState;
+  };
+  const Expected expected[count] = {{"/a.epub", "Alpha", "Ann", 100, 0, LibraryCatalog::METADATA},
+                                    {"/b.epub", "b", "", 200, 1, 0},
+                                    {"/notes/c.txt", "c", "", 300, 0, 0}};
+  uint32_t stringsLength = 0;
+  std::vector<uint32_t> hashes;
+  for (uint32_t i = 0; i < count; i++) {
+    const size_t record = HEADER_SIZE + i * RECORD_SIZE;
+    const Expected& book = expected[i];
+    const uint32_t pathOffset = readAt<uint32_t>(bytes, record + 16);
+    const uint32_t titleOffset = readAt<uint32_t>(bytes, record + 20);
+    const uint32_t authorOffset = readAt<uint32_t>(bytes, record + 24);
+    const uint16_t pathLength = readAt<uint16_t>(bytes, record + 28);
+    const uint8_t titleLength = bytes[record + 30];
+    const uint8_t authorLength = bytes[record + 31];
+
+    hashes.push_back(readAt<uint32_t>(bytes, record));
+    ASSERT_TRUE(hashes.back() == static_cast<uint32_t>(std::hash<std::string>{}(book.path)));
+    ASSERT_TRUE(readAt<uint32_t>(bytes, record + 4) == book.size);
+    ASSERT_TRUE(readAt<uint32_t>(bytes, record + 8) == 0x50210000);
+    ASSERT_TRUE(readAt<uint32_t>(bytes, record + 12) == book.lastRead);
+    ASSERT_TRUE(pathOffset == stringsLength);
+    ASSERT_TRUE(titleOffset == pathOffset + pathLength && authorOffset == titleOffset + titleLength);
+    ASSERT_TRUE(stringAt(bytes, stringsStart + pathOffset, pathLength) == book.path);
+    ASSERT_TRUE(stringAt(bytes, stringsStart + titleOffset, titleLength) == book.title);
+    ASSERT_TRUE(stringAt(bytes, stringsStart + authorOffset, authorLength) == book.author);
+    ASSERT_TRUE(bytes[record + 32] == 0);
+    ASSERT_TRUE(bytes[record + 33] == book.cacheState);
+    stringsLength += pathLength + titleLength + authorLength;
+  }
+  ASSERT_TRUE(bytes.size() == stringsStart + stringsLength);
+
+  // The indexes follow the records: Title, Author, LastRead, then path hash
+  auto index = [&bytes, count](const uint32_t which) {
+    std::vector<uint32_t> numbers;
+    for (uint32_t i = 0; i < count; i++) {
+      numbers.push_back(readAt<uint32_t>(bytes, HEADER_SIZE + count * RECORD_SIZE + (which * count + i) * 4));
+    }
+    return numbers;
+  };
+  ASSERT_TRUE(index(0) == std::vector<uint32_t>({0, 1, 2}));
+  // Books without author last, in scan order
+  ASSERT_TRUE(index(1) == std::vector<uint32_t>({0, 1, 2}));
+  // The recent book first, the others in scan order
+  ASSERT_TRUE(index(2) == std::vector<uint32_t>({1, 0, 2}));
+  const std::vector<uint32_t> byHash = index(3);
+  ASSERT_TRUE(byHash.size() == count);
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_TRUE(byHash[i] < count);
+    ASSERT_TRUE(i == 0 || hashes[byHash[i - 1]] <= hashes[byHash[i]]);
+  }
+  PASS();
+}
+
+void testOrders() {
+  printf("testOrders\n");
+  resetCard();
+  addBook("/orders/1.epub", "Dune", "Herbert");
+  addBook("/orders/2.epub", "emma", "Austen");
+  addBook("/orders/3.epub", "Persuasion", "austen");
+  addBook("/orders/4.epub", "Beloved", "");
+  Storage.addFile("/orders/5.txt");
+
+  LibraryCatalog catalog;
+  rescanAll(catalog);
+  ASSERT_TRUE(catalog.size() == 5);
+  ASSERT_TRUE(readTitles(catalog, Order::Title) == Strings({"5", "Beloved", "Dune", "emma", "Persuasion"}));
+  // Authors compare without case; equal ones keep scan order, books without author go last
+  ASSERT_TRUE(readTitles(catalog, Order::Author) == Strings({"emma", "Persuasion", "Dune", "Beloved", "5"}));
+  ASSERT_TRUE(catalog.readCount() == 0);
+
+  catalog.noteOpened("/orders/3.epub", "Persuasion", "austen");
+  catalog.noteOpened("/orders/1.epub", "Dune", "Herbert");
+  ASSERT_TRUE(catalog.readCount() == 2);
+  ASSERT_TRUE(readTitles(catalog, Order::LastRead) == Strings({"Dune", "Persuasion", "emma", "Beloved", "5"}));
+
+  // A window reports the positions it visits
+  Strings titles;
+  std::vector<uint32_t> positions;
+  catalog.read(Order::LastRead, 1, 2, [&](const uint32_t position, const LibraryCatalog::Book& book) {
+    positions.push_back(position);
+    titles.emplace_back(book.title);
+  });
+  ASSERT_TRUE(positions == std::vector<uint32_t>({1, 2}) && titles == Strings({"Persuasion", "emma"}));
+  ASSERT_TRUE(readTitles(catalog, Order::Title, 4, 10) == Strings({"Persuasion"}));
+  ASSERT_TRUE(readTitles(catalog, Order::Title, 5, 10).empty());
+
+  // New metadata is appended to the strings and re-sorts both text orders
+  catalog.noteCached("/orders/4.epub", "Aardvark", "Zed", LibraryCatalog::METADATA);
+  catalog.noteProgress("/orders/2.epub", 42);
+  ASSERT_TRUE(readTitles(catalog, Order::Title) == Strings({"5", "Aardvark", "Dune", "emma", "Persuasion"}));
+  ASSERT_TRUE(readTitles(catalog, Order::Author) == Strings({"emma", "Persuasion", "Dune", "Aardvark", "5"}));
+  std::string title;
+  ASSERT_TRUE(findBook(catalog, "/orders/2.epub", title).progress == 42);
+  ASSERT_TRUE(findBook(catalog, "/orders/4.epub", title).cacheState == LibraryCatalog::METADATA);
+  PASS();
+}
+
+void testTitlePrefixes() {
+  printf("testTitlePrefixes\n");
+  resetCard();
+  // More books than one read batch share the 7-byte key prefix "filler ", in reverse of their scan order
+  Strings expected = {"Another"};
+  for (int i = 0; i < 20; i++) {
+    char path[32], title[32];
+    snprintf(path, sizeof(path), "/prefix/f%02d.epub", i);
+    snprintf(title, sizeof(title), "Filler %02d", 19 - i);
+    addBook(path, title, "");
+  }
+  for (int i = 0; i < 20; i++) {
+    char title[32];
+    snprintf(title, sizeof(title), "Filler %02d", i);
+    expected.emplace_back(title);
+  }
+  // Titles that fold to the same text keep scan order, although byte order would put the upper case one first
+  addBook("/prefix/p1.epub", "the book of alpha", "");
+  addBook("/prefix/p2.epub", "THE BOOK OF ALPHA", "");
+  addBook("/prefix/q.epub", "The Bookshelf", "");
+  addBook("/prefix/r.epub", "The Book of Zeta", "");
+  addBook("/prefix/s.epub", "The Book", "");
+  addBook("/prefix/t.epub", "The Bo", "");
+  addBook("/prefix/u.epub", "The", "");
+  addBook("/prefix/v.epub", "Another", "");
+  for (const char* title :
+       {"The", "The Bo", "The Book", "the book of alpha", "THE BOOK OF ALPHA", "The Book of Zeta", "The Bookshelf"}) {
+    expected.emplace_back(title);
+  }
+
+  LibraryCatalog catalog;
+  rescanAll(catalog);
+  ASSERT_TRUE(catalog.size() == expected.size());
+  ASSERT_TRUE(readTitles(catalog, Order::Title) == expected);
+  PASS();
+}
+
+void testInterruptedRescan() {
+  printf("testInterruptedRescan\n");
+  resetCard();
+  addBook("/rescan/a.epub", "A", "");
+  addBook("/rescan/b.epub", "B", "");
+  addBook("/rescan/c.epub", "C", "");
+  {
+    LibraryCatalog catalog;
+    rescanAll(catalog);
+    ASSERT_TRUE(catalog.size() == 3 && EpubStub::loads == 3);
+
+    // One step copies the known books and probes the first new one
+    addBook("/rescan/d.epub", "D", "");
+    addBook("/rescan/e.epub", "E", "");
+    addBook("/rescan/f.epub", "F", "");
+    EpubStub::loads = 0;
+    catalog.requestRescan();
+    ASSERT_TRUE(catalog.rescanStep());
+    ASSERT_TRUE(EpubStub::loads == 1 && Storage.exists(CATALOG_FILE_TMP));
+    ASSERT_TRUE(catalog.size() == 3);
+
+    // Updates to books the rescan copied already reach the current catalog now and the new one when it's done
+    catalog.noteOpened("/rescan/a.epub", "A", "");
+    catalog.noteProgress("/rescan/b.epub", 50);
+    ASSERT_TRUE(readTitles(catalog, Order::LastRead, 0, 1) == Strings({"A"}));
+    rescanAll(catalog);
+    ASSERT_TRUE(EpubStub::loads == 3);
+    ASSERT_TRUE(!Storage.exists(CATALOG_FILE_TMP) && !Storage.exists(CATALOG_STRINGS_TMP));
+    ASSERT_TRUE(catalog.size() == 6 && catalog.readCount() == 1);
+    ASSERT_TRUE(readTitles(catalog, Order::LastRead, 0, 1) == Strings({"A"}));
+    std::string title;
+    ASSERT_TRUE(findBook(catalog, "/rescan/b.epub", title).progress == 50);
+
+    // Power loss half way: the temporary files stay behind
+    addBook("/rescan/g.epub", "G", "");
+    catalog.requestRescan();
+    ASSERT_TRUE(catalog.rescanStep());
+    ASSERT_TRUE(Storage.exists(CATALOG_FILE_TMP) && Storage.exists(CATALOG_STRINGS_TMP));
+  }
+
+  // After the reboot the previous catalog still reads, and the next rescan starts over
+  LibraryCatalog catalog;
+  ASSERT_TRUE(catalog.size() == 6);
+  ASSERT_TRUE(readTitles(catalog, Order::LastRead, 0, 1) == Strings({"A"}));
+  rescanAll(catalog);
+  ASSERT_TRUE(catalog.size() == 7);
+  ASSERT_TRUE(!Storage.exists(CATALOG_FILE_TMP) && !Storage.exists(CATALOG_STRINGS_TMP));
+  ASSERT_TRUE(readTitles(catalog, Order::Title) == Strings({"A", "B", "C", "D", "E", "F", "G"}));
+  ASSERT_TRUE(readTitles(catalog, Order::LastRead, 0, 1) == Strings({"A"}));
+
+  // A full card stops the rescan, keeps the current catalog and waits for the next change
+  addBook("/rescan/h.epub", "H", "");
+  Storage.failWrites = true;
+  catalog.requestRescan();
+  ASSERT_TRUE(catalog.rescanStep());
+  ASSERT_TRUE(!Storage.exists(CATALOG_FILE_TMP) && !Storage.exists(CATALOG_STRINGS_TMP));
+  ASSERT_TRUE(!catalog.needsRescan() && !catalog.rescanStep());
+  Storage.failWrites = false;
+  ASSERT_TRUE(catalog.size() == 7);
+  catalog.requestRescan();
+  rescanAll(catalog);
+  ASSERT_TRUE(catalog.size() == 8);
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testFileLayout();
+  testOrders();
+  testTitlePrefixes();
+  testInterruptedRescan();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
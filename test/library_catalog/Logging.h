@@ -0,0 +1,9 @@
+#pragma once
+
+// Host-test stand-in for lib/Logging, which needs the Arduino serial port. Arguments are still type-checked.
+#include <cstdio>
+
+#define HOST_LOG(format, ...) ((void)sizeof(printf(format __VA_OPT__(, ) __VA_ARGS__)))
+#define LOG_ERR(origin, format, ...) HOST_LOG(format __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_INF(origin, format, ...) HOST_LOG(format __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_DBG(origin, format, ...) HOST_LOG(format __VA_OPT__(, ) __VA_ARGS__)
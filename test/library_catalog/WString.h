@@ -0,0 +1,9 @@
+#pragma once
+
+// Host-test stand-in for the Arduino String, as far as FsHelpers uses it
+#include <string>
+
+class String : public std::string {
+ public:
+  using std::string::string;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+// Host-test stand-in for lib/Xtc: the tests only use EPUB and text files, so no XTC file ever loads
+#include <cstdint>
+#include <string>
+
+class Xtc {
+ public:
+  explicit Xtc(std::string, const std::string&) {}
+
+  bool load() { return false; }
+  const std::string& getCachePath() const { return cachePath; }
+  std::string getTitle() const { return {}; }
+  std::string getAuthor() const { return {}; }
+  std::string getThumbBmpPath(int) const { return {}; }
+  uint32_t getPageCount() const { return 0; }
+
+ private:
+  std::string cachePath;
+};
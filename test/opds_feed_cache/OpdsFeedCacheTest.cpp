@@ -0,0 +1,307 @@
+// Host test for OpdsFeedCache: an in-memory store and a stand-in for the OPDS server that honours conditional requests.
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "lib/OpdsParser/OpdsFeedCache.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+using Source = OpdsFeedCache::Source;
+using Result = OpdsFeedCache::Transport::Result;
+
+class MemoryStore final : public OpdsFeedCache::Store {
+ public:
+  std::map<std::string, std::string> files;
+  int writes = 0;
+  size_t bytesRead = 0;
+
+  bool read(const std::string& name, std::string& data) override {
+    const auto it = files.find(name);
+    if (it == files.end()) return false;
+    data = it->second;
+    bytesRead += data.size();
+    return true;
+  }
+  bool readHead(const std::string& name, const size_t length, std::string& data) override {
+    const auto it = files.find(name);
+    if (it == files.end()) return false;
+    data = it->second.substr(0, length);
+    bytesRead += data.size();
+    return true;
+  }
+  bool write(const std::string& name, const std::string& data) override {
+    files[name] = data;
+    writes++;
+    return true;
+  }
+  void remove(const std::string& name) override { files.erase(name); }
+};
+
+// Serves feeds by URL. Each feed has a version; its ETag (or, with lastModifiedOnly, its Last-Modified date) changes
+// with the version. Counts requests and the feed bytes it had to send.
+class LocalServer final : public OpdsFeedCache::Transport {
+ public:
+  std::map<std::string, int> versions;
+  bool lastModifiedOnly = false;
+  bool offline = false;
+  int requests = 0;
+  int conditionalRequests = 0;
+  size_t bytesSent = 0;
+
+  static OpdsFeedCache::Feed feedFor(const std::string& url, const int version) {
+    OpdsFeedCache::Feed feed;
+    feed.searchTemplate = "/search?q={searchTerms}";
+    feed.nextPageUrl = url + "?page=2";
+    for (int i = 0; i < 30; i++) {
+      const auto type = i % 3 == 0 ? OpdsEntryType::NAVIGATION : OpdsEntryType::BOOK;
+      const std::string n = std::to_string(i);
+      feed.entries.push_back({type, "Title " + n + " v" + std::to_string(version), "Author " + n, url + "/" + n,
+                              "urn:" + n});
+    }
+    return feed;
+  }
+
+  Result get(const std::string& url, const OpdsFeedCache::Validators& cached, OpdsFeedCache::Feed& feed,
+             OpdsFeedCache::Validators& received) override {
+    requests++;
+    if (offline) return Result::FAILED;
+    const auto it = versions.find(url);
+    if (it == versions.end()) return Result::FAILED;
+
+    OpdsFeedCache::Validators current;
+    if (lastModifiedOnly) {
+      current.lastModified = "Tue, 0" + std::to_string(it->second) + " Jan 2030 10:00:00 GMT";
+    } else {
+      current.etag = "\"v" + std::to_string(it->second) + "\"";
+    }
+    if (!cached.empty()) {
+      conditionalRequests++;
+      if ((!cached.etag.empty() && cached.etag == current.etag) ||
+          (cached.etag.empty() && !cached.lastModified.empty() && cached.lastModified == current.lastModified)) {
+        return Result::NOT_MODIFIED;
+      }
+    }
+    feed = feedFor(url, it->second);
+    received = current;
+    bytesSent += OpdsFeedCache::encode(url, current, feed).size();
+    return Result::OK;
+  }
+};
+
+bool sameFeed(const OpdsFeedCache::Feed& a, const OpdsFeedCache::Feed& b) {
+  if (a.entries.size() != b.entries.size() || a.searchTemplate != b.searchTemplate ||
+      a.nextPageUrl != b.nextPageUrl || a.prevPageUrl != b.prevPageUrl) {
+    return false;
+  }
+  for (size_t i = 0; i < a.entries.size(); i++) {
+    const auto& x = a.entries[i];
+    const auto& y = b.entries[i];
+    if (x.type != y.type || x.title != y.title || x.author != y.author || x.href != y.href || x.id != y.id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void testEncodeRoundTrip() {
+  printf("testEncodeRoundTrip\n");
+  const std::string url = "http://calibre.local/opds/nav/authors";
+  const auto feed = LocalServer::feedFor(url, 3);
+  const OpdsFeedCache::Validators validators{"\"abc\"", "Tue, 01 Jan 2030 10:00:00 GMT"};
+  const std::string data = OpdsFeedCache::encode(url, validators, feed);
+
+  OpdsFeedCache::Validators readValidators;
+  OpdsFeedCache::Feed readFeed;
+  ASSERT_TRUE(OpdsFeedCache::decode(data, url, readValidators, readFeed));
+  ASSERT_TRUE(sameFeed(feed, readFeed));
+  ASSERT_TRUE(readValidators.etag == validators.etag && readValidators.lastModified == validators.lastModified);
+
+  // Another URL (hash collision), truncated or extended data and other versions are rejected
+  ASSERT_TRUE(!OpdsFeedCache::decode(data, url + "/x", readValidators, readFeed));
+  ASSERT_TRUE(!OpdsFeedCache::decode(data.substr(0, data.size() - 1), url, readValidators, readFeed));
+  ASSERT_TRUE(!OpdsFeedCache::decode(data + "x", url, readValidators, readFeed));
+  std::string otherVersion = data;
+  otherVersion[0] = static_cast<char>(otherVersion[0] + 1);
+  ASSERT_TRUE(!OpdsFeedCache::decode(otherVersion, url, readValidators, readFeed));
+
+  // The validators alone decode from the head of the data, but not from less
+  const size_t headSize = 1 + 3 * 2 + url.size() + validators.etag.size() + validators.lastModified.size();
+  OpdsFeedCache::Validators headValidators;
+  ASSERT_TRUE(OpdsFeedCache::decodeValidators(data.substr(0, headSize), url, headValidators));
+  ASSERT_TRUE(headValidators.etag == validators.etag && headValidators.lastModified == validators.lastModified);
+  ASSERT_TRUE(!OpdsFeedCache::decodeValidators(data.substr(0, headSize - 1), url, headValidators));
+  ASSERT_TRUE(!OpdsFeedCache::decodeValidators(data, url + "/x", headValidators));
+  PASS();
+}
+
+void testRevalidation() {
+  printf("testRevalidation\n");
+  MemoryStore store;
+  LocalServer server;
+  const std::string root = "http://calibre.local/opds";
+  server.versions[root] = 1;
+
+  OpdsFeedCache::Feed feed;
+  {
+    OpdsFeedCache cache(store);
+    ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+    ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+    ASSERT_TRUE(server.requests == 1 && server.conditionalRequests == 0);
+  }
+
+  // Next session: the cached copy is revalidated and nothing is sent again
+  const size_t sentBefore = server.bytesSent;
+  OpdsFeedCache cache(store);
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::REVALIDATED);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+  ASSERT_TRUE(server.requests == 2 && server.conditionalRequests == 1 && server.bytesSent == sentBefore);
+
+  // The feed changes on the server: the new version replaces the cached one, and of the old one only the validators
+  // were read
+  server.versions[root] = 2;
+  const size_t cachedSize = store.files[OpdsFeedCache::nameFor(root)].size();
+  const size_t readBefore = store.bytesRead;
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 2)));
+  ASSERT_TRUE(store.bytesRead - readBefore < cachedSize / 4);
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::REVALIDATED);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 2)));
+
+  // Same with a server that only sends Last-Modified
+  MemoryStore store2;
+  LocalServer dated;
+  dated.lastModifiedOnly = true;
+  dated.versions[root] = 4;
+  OpdsFeedCache datedCache(store2);
+  ASSERT_TRUE(datedCache.fetch(root, dated, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(datedCache.fetch(root, dated, feed, false) == Source::REVALIDATED);
+  dated.versions[root] = 5;
+  ASSERT_TRUE(datedCache.fetch(root, dated, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 5)));
+  PASS();
+}
+
+void testBackNavigation() {
+  printf("testBackNavigation\n");
+  MemoryStore store;
+  LocalServer server;
+  const std::string root = "http://calibre.local/opds";
+  const std::string authors = root + "/nav/authors";
+  server.versions[root] = 1;
+  server.versions[authors] = 1;
+
+  OpdsFeedCache cache(store);
+  OpdsFeedCache::Feed feed;
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(cache.fetch(authors, server, feed, false) == Source::NETWORK);
+  const int requests = server.requests;
+
+  // Back to the root page: served from the card without a request
+  ASSERT_TRUE(cache.fetch(root, server, feed, true) == Source::SESSION);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+  ASSERT_TRUE(server.requests == requests);
+
+  // A page not seen in this session is still revalidated, even when going back
+  OpdsFeedCache nextSession(store);
+  ASSERT_TRUE(nextSession.fetch(root, server, feed, true) == Source::REVALIDATED);
+  ASSERT_TRUE(server.requests == requests + 1);
+  PASS();
+}
+
+void testOfflineFallback() {
+  printf("testOfflineFallback\n");
+  MemoryStore store;
+  LocalServer server;
+  const std::string root = "http://calibre.local/opds";
+  server.versions[root] = 1;
+
+  OpdsFeedCache cache(store);
+  OpdsFeedCache::Feed feed;
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+  server.offline = true;
+  feed = {};
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::STALE);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+  ASSERT_TRUE(cache.fetch(root + "/new", server, feed, false) == Source::NONE);
+
+  // A damaged cache file is ignored
+  auto& cached = store.files[OpdsFeedCache::nameFor(root)];
+  const std::string intact = cached;
+  cached.resize(10);
+  server.offline = false;
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+
+  // So is one whose validators are intact but whose feed is not: the 304 is followed by a plain request
+  cached = intact.substr(0, intact.size() - 1);
+  const int requests = server.requests;
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(sameFeed(feed, LocalServer::feedFor(root, 1)));
+  ASSERT_TRUE(server.requests == requests + 2);
+  ASSERT_TRUE(cache.fetch(root, server, feed, false) == Source::REVALIDATED);
+  PASS();
+}
+
+void testEviction() {
+  printf("testEviction\n");
+  MemoryStore store;
+  LocalServer server;
+  const std::string base = "http://calibre.local/opds/page/";
+  const size_t total = OpdsFeedCache::MAX_FEEDS + 5;
+  for (size_t i = 0; i < total; i++) {
+    server.versions[base + std::to_string(i)] = 1;
+  }
+
+  OpdsFeedCache cache(store);
+  OpdsFeedCache::Feed feed;
+  for (size_t i = 0; i < total; i++) {
+    ASSERT_TRUE(cache.fetch(base + std::to_string(i), server, feed, false) == Source::NETWORK);
+    // Page 0 stays in use, so it is never the least recently used one
+    ASSERT_TRUE(cache.fetch(base + "0", server, feed, true) == Source::SESSION);
+  }
+  // The feeds plus the index
+  ASSERT_TRUE(store.files.size() == OpdsFeedCache::MAX_FEEDS + 1);
+  ASSERT_TRUE(store.files.count(OpdsFeedCache::nameFor(base + "0")) == 1);
+  ASSERT_TRUE(store.files.count(OpdsFeedCache::nameFor(base + "1")) == 0);
+  ASSERT_TRUE(store.files.count(OpdsFeedCache::nameFor(base + std::to_string(total - 1))) == 1);
+
+  // The recency order survives a new session, and clear() removes everything
+  OpdsFeedCache nextSession(store);
+  server.versions[base + "new"] = 1;
+  ASSERT_TRUE(nextSession.fetch(base + "new", server, feed, false) == Source::NETWORK);
+  ASSERT_TRUE(store.files.count(OpdsFeedCache::nameFor(base + "0")) == 1);
+  ASSERT_TRUE(store.files.count(OpdsFeedCache::nameFor(base + "6")) == 0);
+  ASSERT_TRUE(store.files.size() == OpdsFeedCache::MAX_FEEDS + 1);
+  nextSession.clear();
+  ASSERT_TRUE(store.files.empty());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testEncodeRoundTrip();
+  testRevalidation();
+  testBackNavigation();
+  testOfflineFallback();
+  testEviction();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
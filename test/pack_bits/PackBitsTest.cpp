@@ -0,0 +1,115 @@
+// Host test for PackBits: round trips of page-like and random data, the worst-case bound and split decoder input.
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "lib/Epub/Epub/PackBits.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+// A 480x800 1-bit frame: white with a few rows of "text"
+std::vector<uint8_t> makePage() {
+  std::vector<uint8_t> page(48000, 0xFF);
+  std::mt19937 rng(7);
+  for (size_t line = 0; line < 20; line++) {
+    for (size_t i = 0; i < 800; i++) {
+      page[line * 2000 + 400 + i] = static_cast<uint8_t>(rng() | 0x81);
+    }
+  }
+  return page;
+}
+
+bool roundTrip(const std::vector<uint8_t>& src, const size_t feedSize, size_t* encodedSize = nullptr) {
+  std::vector<uint8_t> encoded(PackBits::maxEncodedSize(src.size()));
+  const size_t length = PackBits::encode(src.data(), src.size(), encoded.data());
+  if (length > encoded.size()) return false;
+  if (encodedSize) *encodedSize = length;
+
+  std::vector<uint8_t> decoded(src.size(), 0x55);
+  PackBits::Decoder decoder(decoded.data(), decoded.size());
+  for (size_t offset = 0; offset < length; offset += feedSize) {
+    const size_t piece = offset + feedSize < length ? feedSize : length - offset;
+    if (!decoder.feed(encoded.data() + offset, piece)) return false;
+  }
+  return decoder.done() && decoded == src;
+}
+
+void testPageCompresses() {
+  printf("testPageCompresses\n");
+  const auto page = makePage();
+  size_t encoded = 0;
+  ASSERT_TRUE(roundTrip(page, 4096, &encoded));
+  ASSERT_TRUE(encoded < page.size() / 2);
+
+  const std::vector<uint8_t> white(48000, 0x00);
+  ASSERT_TRUE(roundTrip(white, 4096, &encoded));
+  ASSERT_TRUE(encoded == 2 * ((48000 + 127) / 128));
+  PASS();
+}
+
+void testWorstCaseBound() {
+  printf("testWorstCaseBound\n");
+  std::mt19937 rng(11);
+  for (const size_t size : {1u, 2u, 3u, 127u, 128u, 129u, 1000u, 48000u}) {
+    std::vector<uint8_t> noise(size);
+    for (auto& byte : noise) byte = static_cast<uint8_t>(rng());
+    ASSERT_TRUE(roundTrip(noise, 1000));
+
+    // Alternating pairs never form a run of three, so everything is literal
+    std::vector<uint8_t> pairs(size);
+    for (size_t i = 0; i < size; i++) pairs[i] = (i / 2) % 2 ? 0xAA : 0x55;
+    size_t encoded = 0;
+    ASSERT_TRUE(roundTrip(pairs, 7, &encoded));
+    ASSERT_TRUE(encoded == PackBits::maxEncodedSize(size));
+  }
+  PASS();
+}
+
+void testSplitInput() {
+  printf("testSplitInput\n");
+  const auto page = makePage();
+  for (const size_t feedSize : {1u, 2u, 3u, 129u, 1024u}) {
+    ASSERT_TRUE(roundTrip(page, feedSize));
+  }
+  PASS();
+}
+
+void testOverflowRejected() {
+  printf("testOverflowRejected\n");
+  const uint8_t repeat[] = {static_cast<uint8_t>(257 - 10), 0x00};
+  uint8_t out[8];
+  PackBits::Decoder repeatDecoder(out, sizeof(out));
+  ASSERT_TRUE(!repeatDecoder.feed(repeat, sizeof(repeat)));
+
+  const uint8_t literal[] = {8, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  PackBits::Decoder literalDecoder(out, sizeof(out));
+  ASSERT_TRUE(!literalDecoder.feed(literal, sizeof(literal)));
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testPageCompresses();
+  testWorstCaseBound();
+  testSplitInput();
+  testOverflowRejected();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
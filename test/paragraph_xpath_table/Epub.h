@@ -0,0 +1,32 @@
+#pragma once
+
+// Host-test stand-in for lib/Epub: spine items are chapter documents held in memory
+#include <Print.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class Epub {
+ public:
+  struct SpineItem {
+    std::string href;
+  };
+
+  std::vector<std::string> documents;
+
+  const std::string& getCachePath() const { return cachePath; }
+  int getSpineItemsCount() const { return static_cast<int>(documents.size()); }
+  SpineItem getSpineItem(const int spineIndex) const { return {std::to_string(spineIndex) + ".xhtml"}; }
+  bool readItemContentsToStream(const std::string& href, Print& out, const size_t chunkSize) const {
+    const std::string& document = documents[std::stoi(href)];
+    for (size_t pos = 0; pos < document.size(); pos += chunkSize) {
+      const size_t length = std::min(chunkSize, document.size() - pos);
+      out.write(reinterpret_cast<const uint8_t*>(document.data() + pos), length);
+    }
+    return true;
+  }
+
+ private:
+  std::string cachePath = "/.crosspoint/epub_test";
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// Host-test stand-in for lib/Epub/Epub/Section.h: only where a section's paragraph table lives
+#include <Epub.h>
+
+#include <string>
+
+class Section {
+ public:
+  static std::string getXPathTablePath(const Epub& epub, const int spineIndex) {
+    return epub.getCachePath() + "/sections/" + std::to_string(spineIndex) + ".xpath";
+  }
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+// Host-test stand-in for lib/Logging, which needs the Arduino serial port
+#define LOG_ERR(origin, format, ...)
+#define LOG_INF(origin, format, ...)
+#define LOG_DBG(origin, format, ...)
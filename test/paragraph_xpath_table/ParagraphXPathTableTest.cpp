@@ -0,0 +1,257 @@
+// Host test for the paragraph XPath table: the delta-encoded paths, the lookups in both directions, and paths that
+// match what ChapterXPathResolver finds by parsing the chapter with expat.
+//
+// Usage: ParagraphXPathTableTest file.xhtml...
+#include <expat.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "HalStorage.h"
+#include "lib/Epub/Epub/ParagraphXPathTable.h"
+#include "lib/KOReaderSync/ChapterXPathResolver.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+const std::string TABLE_FILE = "/.crosspoint/epub_test/sections/0.xpath";
+constexpr size_t HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+// Records a document the way ChapterHtmlSlimParser does: every element, and a paragraph at each <p>
+class Recorder {
+ public:
+  explicit Recorder(ParagraphXPathTable& table) : table(table) {}
+
+  bool parse(const std::string& document) {
+    XML_Parser parser = XML_ParserCreate(nullptr);
+    XML_SetUserData(parser, this);
+    XML_SetElementHandler(
+        parser,
+        [](void* userData, const XML_Char* name, const XML_Char**) {
+          auto& table = static_cast<Recorder*>(userData)->table;
+          table.startElement(name);
+          if (strcmp(name, "p") == 0) table.addParagraph();
+        },
+        [](void* userData, const XML_Char* name) { static_cast<Recorder*>(userData)->table.endElement(name); });
+    const bool ok = XML_Parse(parser, document.data(), static_cast<int>(document.size()), XML_TRUE) == XML_STATUS_OK;
+    XML_ParserFree(parser);
+    return ok;
+  }
+
+ private:
+  ParagraphXPathTable& table;
+};
+
+// <body><div><p/><p/><section><h2/><p><span/></p></section></div><p/></body>
+void recordSample(ParagraphXPathTable& table) {
+  table.startElement("html");
+  table.startElement("body");
+  table.startElement("div");
+  for (int i = 0; i < 2; i++) {
+    table.startElement("p");
+    table.addParagraph();
+    table.endElement("p");
+  }
+  table.startElement("section");
+  table.startElement("h2");
+  table.endElement("h2");
+  table.startElement("p");
+  table.addParagraph();
+  table.startElement("span");
+  table.endElement("span");
+  table.endElement("p");
+  table.endElement("section");
+  table.endElement("div");
+  table.startElement("xhtml:p");  // prefixed names count under their local name
+  table.addParagraph();
+  table.endElement("xhtml:p");
+  table.endElement("body");
+  table.endElement("html");
+}
+
+void testDeltaEncoding() {
+  printf("testDeltaEncoding\n");
+  ParagraphXPathTable recorded;
+  recordSample(recorded);
+  ASSERT_TRUE(recorded.getParagraphCount() == 4);
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 3));
+
+  // Per paragraph: segments kept and added, then length, name and 16-bit index of each added segment
+  const size_t pathBytes = (2 + 6 + 4) + (2 + 4) + (2 + 10 + 4) + (2 + 4);
+  ASSERT_TRUE(Storage.files[TABLE_FILE].size() == HEADER_SIZE + 3 * sizeof(ParagraphXPathTable::TextPosition) +
+                                                      pathBytes);
+
+  ParagraphXPathTable table;
+  ASSERT_TRUE(table.load(TABLE_FILE));
+  ASSERT_TRUE(table.getPageCount() == 3 && table.getParagraphCount() == 4);
+  ASSERT_TRUE(table.getParagraphPath(1) == "/div[1]/p[1]");
+  ASSERT_TRUE(table.getParagraphPath(2) == "/div[1]/p[2]");
+  ASSERT_TRUE(table.getParagraphPath(3) == "/div[1]/section[1]/p[1]");
+  ASSERT_TRUE(table.getParagraphPath(4) == "/p[1]");
+  ASSERT_TRUE(table.getParagraphPath(0).empty() && table.getParagraphPath(5).empty());
+
+  // Sibling paragraphs cost a kept/added pair and one segment each
+  ParagraphXPathTable siblings;
+  siblings.startElement("body");
+  siblings.startElement("div");
+  for (int i = 0; i < 1000; i++) {
+    siblings.startElement("p");
+    siblings.addParagraph();
+    siblings.endElement("p");
+  }
+  siblings.endElement("div");
+  siblings.endElement("body");
+  ASSERT_TRUE(siblings.write(TABLE_FILE, 0));
+  ASSERT_TRUE(Storage.files[TABLE_FILE].size() == HEADER_SIZE + (2 + 6 + 4) + 999 * (2 + 4));
+  ASSERT_TRUE(table.load(TABLE_FILE));
+  ASSERT_TRUE(table.getParagraphPath(1000) == "/div[1]/p[1000]");
+  PASS();
+}
+
+void testFindParagraph() {
+  printf("testFindParagraph\n");
+  ParagraphXPathTable recorded;
+  recordSample(recorded);
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 1));
+  ParagraphXPathTable table;
+  ASSERT_TRUE(table.load(TABLE_FILE));
+
+  ASSERT_TRUE(table.findParagraph("/div[1]/p[2]") == 2);
+  ASSERT_TRUE(table.findParagraph("/div/p[2]/text().17") == 2);        // missing [N] is [1], text() ends the path
+  ASSERT_TRUE(table.findParagraph("/div[1]/section/p/span[1]") == 3);  // deeper than the paragraph
+  ASSERT_TRUE(table.findParagraph("/p[1]") == 4);
+  ASSERT_TRUE(table.findParagraph("/div[1]/section[1]") == 0);  // above any paragraph
+  ASSERT_TRUE(table.findParagraph("/div[2]/p[1]") == 0);
+  ASSERT_TRUE(table.findParagraph("/div[1]/p[3]") == 0);
+  ASSERT_TRUE(table.findParagraph("") == 0);
+  PASS();
+}
+
+void testFindPage() {
+  printf("testFindPage\n");
+  using Position = ParagraphXPathTable::TextPosition;
+  constexpr uint16_t AFTER = ParagraphXPathTable::AFTER_PARAGRAPH;
+  ParagraphXPathTable recorded;
+  recordSample(recorded);
+  recorded.setPageStart(0, {0, 0});  // a cover image, no text
+  recorded.setPageStart(1, {1, 0});
+  recorded.setPageStart(2, {1, 120});
+  recorded.setPageStart(3, {2, AFTER});
+  recorded.setPageStart(4, {3, 40});
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 5));
+  ParagraphXPathTable table;
+  ASSERT_TRUE(table.load(TABLE_FILE));
+
+  ASSERT_TRUE(table.getPageStart(2).paragraph == 1 && table.getPageStart(2).offset == 120);
+  ASSERT_TRUE(table.getPageStart(9).paragraph == 0);
+  ASSERT_TRUE(table.findPage(Position{0, 0}) == 0);
+  ASSERT_TRUE(table.findPage(Position{1, 0}) == 1);
+  ASSERT_TRUE(table.findPage(Position{1, 119}) == 1);
+  ASSERT_TRUE(table.findPage(Position{1, 120}) == 2);
+  ASSERT_TRUE(table.findPage(Position{2, 5}) == 2);  // the page after paragraph 2 starts past its text
+  ASSERT_TRUE(table.findPage(Position{2, AFTER}) == 3);
+  ASSERT_TRUE(table.findPage(Position{3, 39}) == 3);
+  ASSERT_TRUE(table.findPage(Position{4, 0}) == 4);
+
+  // Pages past the recorded starts are written without a position
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 7));
+  ASSERT_TRUE(table.load(TABLE_FILE));
+  ASSERT_TRUE(table.getPageCount() == 7 && table.getPageStart(6).paragraph == 0);
+  PASS();
+}
+
+void testStaleTable() {
+  printf("testStaleTable\n");
+  ParagraphXPathTable recorded;
+  recordSample(recorded);
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 2));
+
+  ParagraphXPathTable table;
+  Storage.files[TABLE_FILE][0]++;  // another version
+  ASSERT_TRUE(!table.load(TABLE_FILE));
+  ASSERT_TRUE(table.getPageCount() == 0 && table.getParagraphPath(1).empty());
+
+  ASSERT_TRUE(recorded.write(TABLE_FILE, 2));
+  Storage.files[TABLE_FILE].pop_back();  // truncated
+  ASSERT_TRUE(!table.load(TABLE_FILE));
+  ASSERT_TRUE(!table.load("/.crosspoint/epub_test/sections/9.xpath"));
+  PASS();
+}
+
+void testMatchesResolver(const std::vector<std::string>& paths) {
+  printf("testMatchesResolver\n");
+  auto epub = std::make_shared<Epub>();
+  size_t documents = 0;
+  size_t paragraphs = 0;
+  for (const auto& path : paths) {
+    std::ifstream in(path, std::ios::binary);
+    std::string document((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ParagraphXPathTable recorded;
+    if (!Recorder(recorded).parse(document)) {
+      continue;  // not well-formed XML: the resolver cannot parse it either
+    }
+    epub->documents = {document};
+    const uint16_t count = recorded.getParagraphCount();
+
+    // Without a table the resolver parses the chapter
+    Storage.remove(TABLE_FILE.c_str());
+    std::vector<std::string> parsed;
+    for (uint16_t paragraph = 1; paragraph <= count + 1; paragraph++) {
+      parsed.push_back(ChapterXPathResolver::findXPathForParagraph(epub, 0, paragraph));
+    }
+
+    ASSERT_TRUE(recorded.write(TABLE_FILE, 0));
+    ParagraphXPathTable table;
+    ASSERT_TRUE(table.load(TABLE_FILE));
+    for (uint16_t paragraph = 1; paragraph <= count + 1; paragraph++) {
+      const std::string fromTable = ChapterXPathResolver::findXPathForParagraph(epub, 0, paragraph);
+      if (fromTable != parsed[paragraph - 1]) {
+        fprintf(stderr, "  %s paragraph %u: table %s, parsed %s\n", path.c_str(), paragraph, fromTable.c_str(),
+                parsed[paragraph - 1].c_str());
+      }
+      ASSERT_TRUE(fromTable == parsed[paragraph - 1]);
+      if (paragraph <= count) {
+        // And back: the path leads to the same paragraph
+        const std::string elementPath = fromTable.substr(fromTable.find("]/body") + strlen("]/body"));
+        ASSERT_TRUE(table.findParagraph(elementPath) == paragraph);
+      }
+    }
+    documents++;
+    paragraphs += count;
+  }
+  printf("  %zu documents, %zu paragraphs\n", documents, paragraphs);
+  ASSERT_TRUE(paragraphs > 0);
+  PASS();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  testDeltaEncoding();
+  testFindParagraph();
+  testFindPage();
+  testStaleTable();
+  testMatchesResolver(std::vector<std::string>(argv + 1, argv + argc));
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
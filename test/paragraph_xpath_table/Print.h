@@ -0,0 +1,12 @@
+#pragma once
+
+// Host-test stand-in for the Arduino Print interface
+#include <cstddef>
+#include <cstdint>
+
+class Print {
+ public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+};
@@ -0,0 +1,176 @@
+// Host test for Perf: counters, timers and the event ring, and the Chrome trace export.
+// Pass a file name to also write the trace of the test run (open it in chrome://tracing or Perfetto).
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/Perf/Perf.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+const auto clockStart = std::chrono::steady_clock::now();
+uint32_t nowUs() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - clockStart).count());
+}
+
+bool contains(const std::string& haystack, const std::string& needle) {
+  return haystack.find(needle) != std::string::npos;
+}
+
+void testCounters() {
+  printf("testCounters\n");
+  Perf::reset();
+  PERF_COUNT(SdReadBytes, 512);
+  PERF_COUNT(SdReadBytes, 100);
+  PERF_COUNT(SdReadOps, 1);
+  ASSERT_TRUE(Perf::get(Perf::Counter::SdReadBytes) == 612);
+  ASSERT_TRUE(Perf::get(Perf::Counter::SdReadOps) == 1);
+  ASSERT_TRUE(Perf::get(Perf::Counter::SdWriteOps) == 0);
+
+  // Counters from several threads add up without locks
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10000; i++) PERF_COUNT(GlyphCacheHits, 1);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_TRUE(Perf::get(Perf::Counter::GlyphCacheHits) == 40000);
+  PASS();
+}
+
+void testTimers() {
+  printf("testTimers\n");
+  Perf::reset();
+  {
+    PERF_SCOPE(Layout);
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+  }
+  PERF_RECORD(Refresh, 1000, 250);
+  PERF_RECORD(Refresh, 2000, 750);
+
+  const Perf::TimerStats layout = Perf::get(Perf::Timer::Layout);
+  ASSERT_TRUE(layout.count == 1);
+  ASSERT_TRUE(layout.totalUs >= 3000);
+  ASSERT_TRUE(layout.maxUs == layout.totalUs);
+
+  const Perf::TimerStats refresh = Perf::get(Perf::Timer::Refresh);
+  ASSERT_TRUE(refresh.count == 2);
+  ASSERT_TRUE(refresh.totalUs == 1000);
+  ASSERT_TRUE(refresh.maxUs == 750);
+  PASS();
+}
+
+void testEventRing() {
+  printf("testEventRing\n");
+  Perf::reset();
+  const uint32_t total = Perf::EVENT_CAPACITY + 10;
+  for (uint32_t i = 0; i < total; i++) PERF_RECORD(PageRender, i * 10, i);
+
+  // Only the newest EVENT_CAPACITY events are kept, oldest first
+  uint32_t seen = 0;
+  uint32_t expected = total - Perf::EVENT_CAPACITY;
+  bool ordered = true;
+  Perf::forEachEvent([&](const Perf::Event& event) {
+    ordered = ordered && event.durationUs == expected && event.startUs == expected * 10;
+    expected++;
+    seen++;
+  });
+  ASSERT_TRUE(seen == Perf::EVENT_CAPACITY);
+  ASSERT_TRUE(ordered);
+  PASS();
+}
+
+void testHeapAndJson() {
+  printf("testHeapAndJson\n");
+  Perf::reset();
+  Perf::sampleHeap(120000, 60000);
+  Perf::sampleHeap(90000, 70000);
+  Perf::sampleHeap(110000, 40000);
+  PERF_COUNT(RefreshFast, 3);
+  PERF_RECORD(PageLoad, 5, 42);
+
+  const std::string json = Perf::toJson();
+  ASSERT_TRUE(contains(json, "\"enabled\":true"));
+  ASSERT_TRUE(contains(json, "\"refreshFast\":3"));
+  ASSERT_TRUE(contains(json, "\"pageLoad\":{\"count\":1,\"totalUs\":42,\"maxUs\":42}"));
+  ASSERT_TRUE(contains(json, "\"heap\":{\"minFree\":90000,\"minLargestBlock\":40000}"));
+  ASSERT_TRUE(contains(json, "\"events\":1}"));
+  PASS();
+}
+
+void testChromeTrace() {
+  printf("testChromeTrace\n");
+  Perf::reset();
+  PERF_RECORD(PageRender, 100, 20);
+  PERF_RECORD(Refresh, 130, 400);
+  const std::string trace = Perf::toChromeTrace();
+  ASSERT_TRUE(contains(trace, "\"traceEvents\":["));
+  ASSERT_TRUE(contains(trace, "{\"name\":\"pageRender\",\"ph\":\"X\",\"ts\":100,\"dur\":20,\"pid\":1,\"tid\":1}"));
+  ASSERT_TRUE(contains(trace, "},{\"name\":\"refresh\""));
+  ASSERT_TRUE(trace.back() == '}');
+  PASS();
+}
+
+// A page-turn shaped workload, so the written trace shows the phases the firmware records
+void writeSampleTrace(const char* path) {
+  Perf::reset();
+  for (int page = 0; page < 5; page++) {
+    {
+      PERF_SCOPE(PageLoad);
+      std::this_thread::sleep_for(std::chrono::microseconds(800));
+    }
+    {
+      PERF_SCOPE(PageRender);
+      std::this_thread::sleep_for(std::chrono::microseconds(1500));
+    }
+    {
+      PERF_SCOPE(Refresh);
+      std::this_thread::sleep_for(std::chrono::microseconds(3000));
+    }
+  }
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Cannot write %s\n", path);
+    testsFailed++;
+    return;
+  }
+  const std::string trace = Perf::toChromeTrace();
+  fwrite(trace.data(), 1, trace.size(), file);
+  fclose(file);
+  printf("Wrote trace to %s\n", path);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Perf::begin(nowUs);
+
+  testCounters();
+  testTimers();
+  testEventRing();
+  testHeapAndJson();
+  testChromeTrace();
+  if (argc > 1) writeSampleTrace(argv[1]);
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,443 @@
+// Host test for ResumableDownload: a local HTTP server stand-in with Range / If-Range support that drops connections on
+// cue, and an in-memory partial file.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lib/ResumableDownload/ResumableDownload.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+const char URL[] = "http://server/books/comic.epub";
+
+uint32_t fakeNow = 0;
+std::vector<uint32_t> delays;
+uint32_t nowMs() { return fakeNow += 10; }
+void delayMs(const uint32_t ms) { delays.push_back(ms); }
+
+std::string makeContent(const size_t size, const unsigned seed) {
+  std::mt19937 rng(seed);
+  std::string content(size, '\0');
+  for (auto& c : content) c = static_cast<char>(rng());
+  return content;
+}
+
+class MemoryPartFile final : public ResumableDownload::PartFile {
+ public:
+  std::string data;
+  std::string meta;
+  std::string committed;
+  bool hasMeta = false;
+  bool writing = false;
+  std::vector<size_t> begins;  // `keep` of every begin()
+  size_t preallocated = 0;
+  size_t failWritesAfter = SIZE_MAX;
+  size_t bytesRead = 0;  // read back from the partial file
+
+  size_t size() override { return data.size(); }
+  bool read(const size_t offset, uint8_t* out, const size_t length) override {
+    if (writing || offset + length > data.size()) return false;
+    memcpy(out, data.data() + offset, length);
+    bytesRead += length;
+    return true;
+  }
+  bool begin(const size_t keep, const size_t expectedSize) override {
+    data.resize(keep);
+    begins.push_back(keep);
+    preallocated = keep == 0 ? expectedSize : 0;
+    writing = true;
+    return true;
+  }
+  bool write(const uint8_t* bytes, const size_t length) override {
+    if (!writing || data.size() + length > failWritesAfter) return false;
+    data.append(reinterpret_cast<const char*>(bytes), length);
+    return true;
+  }
+  bool end() override {
+    writing = false;
+    return true;
+  }
+  bool commit() override {
+    committed = data;
+    data.clear();
+    discardMeta();
+    return true;
+  }
+  void discard() override {
+    data.clear();
+    discardMeta();
+  }
+  bool readMeta(std::string& out) override {
+    out = meta;
+    return hasMeta;
+  }
+  bool writeMeta(const std::string& in) override {
+    meta = in;
+    hasMeta = true;
+    return true;
+  }
+
+ private:
+  void discardMeta() {
+    meta.clear();
+    hasMeta = false;
+  }
+};
+
+// Serves one file like a static file server: 200, or 206 for "Range: bytes=N-" when If-Range matches the ETag
+class LocalServer final : public ResumableDownload::Transport {
+ public:
+  std::string content;
+  std::string etag = "\"v1\"";
+  std::string digest;
+  bool supportsRanges = true;
+  int status = 0;                // forces this status when set
+  std::deque<size_t> dropAfter;  // per request, bytes sent before the connection drops
+  std::vector<size_t> requests;  // `from` of every request
+  std::vector<std::string> ifRanges;
+  size_t chunkSize = 1460;
+
+  bool get(const std::string& url, const size_t from, const std::string& ifRange, Receiver& receiver) override {
+    requests.push_back(from);
+    ifRanges.push_back(ifRange);
+    size_t drop = SIZE_MAX;
+    if (!dropAfter.empty()) {
+      drop = dropAfter.front();
+      dropAfter.pop_front();
+    }
+    if (drop == 0 || url != URL) return false;  // connection refused
+
+    Response response;
+    response.etag = etag;
+    response.digest = digest;
+    size_t start = 0;
+    if (status != 0) {
+      response.status = status;
+    } else if (from > 0 && supportsRanges && (ifRange.empty() || ifRange == etag)) {
+      if (from >= content.size()) {
+        response.status = 416;
+      } else {
+        response.status = 206;
+        start = from;
+        response.contentRange = "bytes " + std::to_string(from) + "-" + std::to_string(content.size() - 1) + "/" +
+                                std::to_string(content.size());
+      }
+    } else {
+      response.status = 200;
+    }
+    response.contentLength = static_cast<int64_t>(content.size() - start);
+    if (!receiver.onResponse(response) || response.status >= 300) return false;
+
+    size_t sent = 0;
+    for (size_t pos = start; pos < content.size(); pos += chunkSize) {
+      const size_t length = std::min(chunkSize, content.size() - pos);
+      if (sent + length > drop) {
+        receiver.onData(reinterpret_cast<const uint8_t*>(content.data() + pos), drop - sent);
+        return false;
+      }
+      if (!receiver.onData(reinterpret_cast<const uint8_t*>(content.data() + pos), length)) return false;
+      sent += length;
+    }
+    return true;
+  }
+};
+
+// FNV-1a 64 stands in for sha-256, padded to its 32 bytes; the download only compares digests
+class TestHasher final : public ResumableDownload::Hasher {
+ public:
+  uint64_t hash = 0;
+  size_t bytes = 0;
+
+  void begin() override {
+    hash = 14695981039346656037ull;
+    bytes = 0;
+  }
+  void update(const uint8_t* data, const size_t length) override {
+    for (size_t i = 0; i < length; i++) hash = (hash ^ data[i]) * 1099511628211ull;
+    bytes += length;
+  }
+  std::string finish() override {
+    std::string digest(32, '\0');
+    memcpy(&digest[0], &hash, sizeof(hash));
+    return digest;
+  }
+
+  static std::string of(const std::string& content) {
+    TestHasher hasher;
+    hasher.begin();
+    hasher.update(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    return hasher.finish();
+  }
+};
+
+std::string base64(const std::string& raw) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < raw.size(); i += 3) {
+    uint32_t bits = static_cast<uint8_t>(raw[i]) << 16;
+    if (i + 1 < raw.size()) bits |= static_cast<uint8_t>(raw[i + 1]) << 8;
+    if (i + 2 < raw.size()) bits |= static_cast<uint8_t>(raw[i + 2]);
+    out += alphabet[(bits >> 18) & 63];
+    out += alphabet[(bits >> 12) & 63];
+    out += i + 1 < raw.size() ? alphabet[(bits >> 6) & 63] : '=';
+    out += i + 2 < raw.size() ? alphabet[bits & 63] : '=';
+  }
+  return out;
+}
+
+void testPlainDownload() {
+  printf("testPlainDownload\n");
+  delays.clear();
+  LocalServer server;
+  server.content = makeContent(100000, 1);
+  MemoryPartFile part;
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+
+  size_t lastProgress = 0;
+  bool progressOk = true;
+  const auto result = download.run(URL, nullptr, "", [&](const size_t downloaded, const size_t total) {
+    progressOk = progressOk && downloaded > lastProgress && total == 100000;
+    lastProgress = downloaded;
+  });
+  ASSERT_TRUE(result == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content);
+  ASSERT_TRUE(!part.hasMeta && part.data.empty());
+  ASSERT_TRUE(progressOk && lastProgress == 100000);
+  ASSERT_TRUE(part.preallocated == 100000);
+  ASSERT_TRUE(server.requests == std::vector<size_t>{0});
+  ASSERT_TRUE(download.getStats().attempts == 1 && download.getStats().bytesReceived == 100000);
+  ASSERT_TRUE(delays.empty());
+  PASS();
+}
+
+void testRetriesWithRange() {
+  printf("testRetriesWithRange\n");
+  delays.clear();
+  LocalServer server;
+  server.content = makeContent(300000, 2);
+  server.dropAfter = {70000, 0, 50000, 100};
+  MemoryPartFile part;
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content);
+  // Every retry continues at the first missing byte, in the same partial file, checked against the ETag
+  ASSERT_TRUE(server.requests == (std::vector<size_t>{0, 70000, 70000, 120000, 120100}));
+  ASSERT_TRUE(server.ifRanges[1] == server.etag && server.ifRanges[0].empty());
+  ASSERT_TRUE(part.begins == std::vector<size_t>{0});
+  // The refused connection doubled the wait, progress resets it
+  ASSERT_TRUE(delays == (std::vector<uint32_t>{500, 1000, 500, 500}));
+  ASSERT_TRUE(download.getStats().attempts == 5 && download.getStats().bytesReceived == 300000);
+  PASS();
+}
+
+void testResumesPartialFile() {
+  printf("testResumesPartialFile\n");
+  LocalServer server;
+  server.content = makeContent(200000, 3);
+  server.digest = "sha-256=" + base64(TestHasher::of(server.content));
+  server.dropAfter = {53000, 0, 0, 0, 0};
+  MemoryPartFile part;
+  TestHasher hasher;
+  {
+    ResumableDownload download(part, server, &nowMs, &delayMs);
+    ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::HTTP_ERROR);
+  }
+  // Unreachable server: gave up, but kept the partial file and what is needed to resume it
+  ASSERT_TRUE(part.data == server.content.substr(0, 53000) && part.hasMeta);
+  ASSERT_TRUE(part.committed.empty());
+
+  server.requests.clear();
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+  ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content);
+  // The ragged tail is fetched again, from an aligned offset
+  const size_t aligned = 53000 - 53000 % ResumableDownload::RESUME_ALIGNMENT;
+  ASSERT_TRUE(server.requests == std::vector<size_t>{aligned});
+  ASSERT_TRUE(part.begins.back() == aligned && part.preallocated == 0);
+  ASSERT_TRUE(download.getStats().bytesResumed == aligned);
+  ASSERT_TRUE(download.getStats().bytesReceived == 200000 - aligned);
+  // The kept prefix went into the hash too
+  ASSERT_TRUE(download.getStats().verified && hasher.bytes == 200000 && part.bytesRead == aligned);
+  PASS();
+}
+
+void testPrefixReadOnlyToHash() {
+  printf("testPrefixReadOnlyToHash\n");
+  LocalServer server;
+  server.content = makeContent(100000, 8);
+  server.dropAfter = {60000, 0, 0, 0, 0};
+  MemoryPartFile part;
+  TestHasher hasher;
+  {
+    ResumableDownload download(part, server, &nowMs, &delayMs);
+    ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::HTTP_ERROR);
+  }
+
+  // No digest anywhere: the kept prefix is not read back
+  {
+    MemoryPartFile resumed = part;
+    ResumableDownload download(resumed, server, &nowMs, &delayMs);
+    ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::OK);
+    ASSERT_TRUE(resumed.committed == server.content && resumed.bytesRead == 0);
+    ASSERT_TRUE(download.getStats().bytesResumed > 0 && !download.getStats().verified);
+  }
+
+  // Changed on the server: the whole new file comes back, is checked against its own digest and nothing is read back
+  server.content = makeContent(100000, 9);
+  server.etag = "\"v2\"";
+  server.digest = "sha-256=" + base64(TestHasher::of(server.content));
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+  ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content && part.bytesRead == 0);
+  ASSERT_TRUE(download.getStats().restarts == 1 && download.getStats().verified);
+  PASS();
+}
+
+void testChangedFileStartsOver() {
+  printf("testChangedFileStartsOver\n");
+  LocalServer server;
+  server.content = makeContent(120000, 4);
+  server.dropAfter = {40000, 0, 0, 0, 0};
+  MemoryPartFile part;
+  {
+    ResumableDownload download(part, server, &nowMs, &delayMs);
+    ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::HTTP_ERROR);
+  }
+
+  // The book was replaced on the server: If-Range fails and the whole new file replaces the partial one
+  server.content = makeContent(90000, 5);
+  server.etag = "\"v2\"";
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content);
+  ASSERT_TRUE(download.getStats().restarts == 1 && download.getStats().bytesResumed == 0);
+
+  // A partial file of another URL, or one without a validator, is not resumed
+  part.writeMeta(std::string("http://server/other.epub\n\"v2\"\n90000\n"));
+  part.data = server.content.substr(0, 40000);
+  server.requests.clear();
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(server.requests == std::vector<size_t>{0} && part.committed == server.content);
+
+  // Neither is a server that ignores Range
+  server.supportsRanges = false;
+  server.dropAfter = {30000};
+  server.requests.clear();
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(part.committed == server.content);
+  ASSERT_TRUE(server.requests == (std::vector<size_t>{0, 30000}) && download.getStats().restarts == 1);
+  PASS();
+}
+
+void testIntegrityCheck() {
+  printf("testIntegrityCheck\n");
+  LocalServer server;
+  server.content = makeContent(50000, 6);
+  MemoryPartFile part;
+  TestHasher hasher;
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+
+  // Wrong digest from the server: the data is thrown away
+  std::string wrong = TestHasher::of(server.content);
+  wrong[0] ^= 1;
+  server.digest = "md5=abc, sha-256=:" + base64(wrong) + ":";
+  ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::INTEGRITY_ERROR);
+  ASSERT_TRUE(part.committed.empty() && part.data.empty() && !part.hasMeta);
+
+  // The caller's digest takes precedence over the server's
+  ASSERT_TRUE(download.run(URL, &hasher, TestHasher::of(server.content)) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(download.getStats().verified && part.committed == server.content);
+
+  // No digest anywhere: nothing to check against
+  server.digest.clear();
+  ASSERT_TRUE(download.run(URL, &hasher) == ResumableDownload::Result::OK);
+  ASSERT_TRUE(!download.getStats().verified);
+  PASS();
+}
+
+void testFailures() {
+  printf("testFailures\n");
+  delays.clear();
+  LocalServer server;
+  server.content = makeContent(50000, 7);
+  MemoryPartFile part;
+  ResumableDownload download(part, server, &nowMs, &delayMs);
+
+  // Unreachable: MAX_ATTEMPTS requests with growing waits
+  server.dropAfter = {0, 0, 0, 0, 0, 0};
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::HTTP_ERROR);
+  ASSERT_TRUE(server.requests.size() == ResumableDownload::MAX_ATTEMPTS);
+  ASSERT_TRUE(delays == (std::vector<uint32_t>{500, 1000, 2000, 4000}));
+
+  // Client errors are final
+  server.dropAfter.clear();
+  server.requests.clear();
+  server.status = 404;
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::HTTP_ERROR);
+  ASSERT_TRUE(server.requests.size() == 1);
+
+  // Server errors are retried
+  server.status = 503;
+  server.requests.clear();
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::HTTP_ERROR);
+  ASSERT_TRUE(server.requests.size() == ResumableDownload::MAX_ATTEMPTS);
+
+  // A failing card write ends the download and drops the partial file
+  server.status = 0;
+  part.failWritesAfter = 20000;
+  ASSERT_TRUE(download.run(URL) == ResumableDownload::Result::FILE_ERROR);
+  ASSERT_TRUE(part.data.empty() && !part.hasMeta && part.committed.empty());
+  PASS();
+}
+
+void testParseDigest() {
+  printf("testParseDigest\n");
+  // sha-256 of the empty string
+  const char emptyHash[] = "47DEQpj8HBSa+/TImW+5JCeuQeRkm5NMpJWZG3hSuFU=";
+  const std::string expected =
+      "\xe3\xb0\xc4\x42\x98\xfc\x1c\x14\x9a\xfb\xf4\xc8\x99\x6f\xb9\x24\x27\xae\x41\xe4\x64\x9b\x93\x4c\xa4\x95\x99\x1b"
+      "\x78\x52\xb8\x55";
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest(std::string("sha-256=") + emptyHash) == expected);
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest(std::string("SHA-256=") + emptyHash) == expected);
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest(std::string("sha-512=:abc:, sha-256=:") + emptyHash + ":") ==
+              expected);
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest("md5=HUXZLQLMuI/KZ5KDcJPcOA==").empty());
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest("sha-256=AAAA").empty());
+  ASSERT_TRUE(ResumableDownload::parseSha256Digest("").empty());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testPlainDownload();
+  testRetriesWithRange();
+  testResumesPartialFile();
+  testPrefixReadOnlyToHash();
+  testChangedFileStartsOver();
+  testIntegrityCheck();
+  testFailures();
+  testParseDigest();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/paragraph_xpath_table"
+BINARY="$BUILD_DIR/ParagraphXPathTableTest"
+CORPUS_DIR="$BUILD_DIR/corpus"
+
+mkdir -p "$BUILD_DIR"
+
+# expat is built with the same general-entity settings as the firmware (see platformio.ini).
+EXPAT_FLAGS=(
+  -O2
+  -DXML_GE=0
+  -DXML_CONTEXT_BYTES=1024
+  -I"$ROOT_DIR/lib/expat"
+)
+
+EXPAT_OBJECTS=()
+for source in xmlparse xmlrole xmltok; do
+  cc "${EXPAT_FLAGS[@]}" -c "$ROOT_DIR/lib/expat/$source.c" -o "$BUILD_DIR/$source.o"
+  EXPAT_OBJECTS+=("$BUILD_DIR/$source.o")
+done
+
+SOURCES=(
+  "$ROOT_DIR/test/paragraph_xpath_table/ParagraphXPathTableTest.cpp"
+  "$ROOT_DIR/lib/Epub/Epub/ParagraphXPathTable.cpp"
+  "$ROOT_DIR/lib/KOReaderSync/ChapterXPathResolver.cpp"
+  "$ROOT_DIR/lib/Utf8/Utf8.cpp"
+)
+
+CXXFLAGS=(
+  -std=c++20
+  -O2
+  -Wall
+  -Wextra
+  -pedantic
+  -DXML_GE=0
+  -DXML_CONTEXT_BYTES=1024
+  -I"$ROOT_DIR/test/paragraph_xpath_table"
+  -I"$ROOT_DIR"
+  -I"$ROOT_DIR/lib"
+  -I"$ROOT_DIR/lib/Epub"
+  -I"$ROOT_DIR/lib/expat"
+  -I"$ROOT_DIR/lib/Serialization"
+  -I"$ROOT_DIR/lib/Utf8"
+  -I"$ROOT_DIR/lib/XmlParserUtils"
+)
+
+c++ "${CXXFLAGS[@]}" "${SOURCES[@]}" "${EXPAT_OBJECTS[@]}" -o "$BINARY"
+
+# Extract the chapter documents of the test EPUBs.
+rm -rf "$CORPUS_DIR"
+mkdir -p "$CORPUS_DIR"
+for epub in "$ROOT_DIR"/test/epubs/*.epub; do
+  name="$(basename "$epub" .epub)"
+  unzip -qq -o "$epub" '*.xhtml' '*.html' '*.htm' -d "$CORPUS_DIR/$name" 2>/dev/null || true
+done
+
+mapfile -t DOCUMENTS < <(find "$CORPUS_DIR" -type f \( -name '*.xhtml' -o -name '*.html' -o -name '*.htm' \) | sort)
+
+"$BINARY" "$@" "${DOCUMENTS[@]}"
@@ -0,0 +1,58 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/xhtml_tokenizer"
+BINARY="$BUILD_DIR/XhtmlTokenizerTest"
+CORPUS_DIR="$BUILD_DIR/corpus"
+
+mkdir -p "$BUILD_DIR"
+
+# expat is built with the same general-entity settings as the firmware (see platformio.ini).
+EXPAT_FLAGS=(
+  -O2
+  -DXML_GE=0
+  -DXML_CONTEXT_BYTES=1024
+  -I"$ROOT_DIR/lib/expat"
+)
+
+EXPAT_OBJECTS=()
+for source in xmlparse xmlrole xmltok; do
+  cc "${EXPAT_FLAGS[@]}" -c "$ROOT_DIR/lib/expat/$source.c" -o "$BUILD_DIR/$source.o"
+  EXPAT_OBJECTS+=("$BUILD_DIR/$source.o")
+done
+
+SOURCES=(
+  "$ROOT_DIR/test/xhtml_tokenizer/XhtmlTokenizerTest.cpp"
+  "$ROOT_DIR/lib/Epub/Epub/parsers/XhtmlPullTokenizer.cpp"
+  "$ROOT_DIR/lib/Epub/Epub/htmlEntities.cpp"
+  "$ROOT_DIR/lib/Utf8/Utf8.cpp"
+)
+
+CXXFLAGS=(
+  -std=c++20
+  -O2
+  -Wall
+  -Wextra
+  -pedantic
+  -DXML_GE=0
+  -DXML_CONTEXT_BYTES=1024
+  -I"$ROOT_DIR"
+  -I"$ROOT_DIR/lib"
+  -I"$ROOT_DIR/lib/expat"
+  -I"$ROOT_DIR/lib/Utf8"
+)
+
+c++ "${CXXFLAGS[@]}" "${SOURCES[@]}" "${EXPAT_OBJECTS[@]}" -o "$BINARY"
+
+# Extract the chapter documents of the test EPUBs.
+rm -rf "$CORPUS_DIR"
+mkdir -p "$CORPUS_DIR"
+for epub in "$ROOT_DIR"/test/epubs/*.epub; do
+  name="$(basename "$epub" .epub)"
+  unzip -qq -o "$epub" '*.xhtml' '*.html' '*.htm' -d "$CORPUS_DIR/$name" 2>/dev/null || true
+done
+
+mapfile -t DOCUMENTS < <(find "$CORPUS_DIR" -type f \( -name '*.xhtml' -o -name '*.html' -o -name '*.htm' \) | sort)
+
+"$BINARY" "$@" "${DOCUMENTS[@]}"
@@ -0,0 +1,243 @@
+// Host test for TxtPaginator: streamed layout against the old measure-every-prefix wrapping, resuming from line
+// starts, edge cases and reading the file once.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lib/EpdFont/EpdFont.h"
+#include "lib/EpdFont/EpdFontFamily.h"
+#include "lib/Txt/TxtPaginator.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+// Synthetic font: space, a-z with uneven advances, a combining acute, an "fi" ligature and a few kern pairs.
+// There is no U+FFFD glyph, so anything else (e.g. U+00E9) takes the missing-glyph path.
+std::vector<EpdGlyph> glyphs;
+const EpdUnicodeInterval intervals[] = {
+    {0x20, 0x20, 0},
+    {0x61, 0x7A, 1},
+    {0x301, 0x301, 27},
+    {0xFB01, 0xFB01, 28},
+};
+const EpdKernClassEntry kernLeft[] = {{0x61, 1}, {0x76, 2}};
+const EpdKernClassEntry kernRight[] = {{0x61, 1}, {0x6F, 2}};
+const int8_t kernMatrix[] = {-5, -3, -9, -12};
+const EpdLigaturePair ligatures[] = {{(0x66u << 16) | 0x69u, 0xFB01}};
+EpdFontData fontData{};
+
+EpdFontFamily makeFont() {
+  glyphs.clear();
+  glyphs.push_back({0, 0, 68, 0, 0, 0, 0});
+  for (int i = 0; i < 26; i++) {
+    const auto width = static_cast<uint8_t>(4 + (i * 7) % 6);
+    const auto advance = static_cast<uint16_t>((width + 1) * 16 + (i * 5) % 16);
+    glyphs.push_back({width, 8, advance, static_cast<int16_t>(i % 3 == 0 ? -1 : 0), 8, 0, 0});
+  }
+  glyphs.push_back({4, 3, 0, 0, 12, 0, 0});
+  glyphs.push_back({9, 12, 160, 0, 12, 0, 0});
+
+  fontData.glyph = glyphs.data();
+  fontData.intervals = intervals;
+  fontData.intervalCount = 4;
+  fontData.advanceY = 16;
+  fontData.ascender = 12;
+  fontData.kernLeftClasses = kernLeft;
+  fontData.kernRightClasses = kernRight;
+  fontData.kernMatrix = kernMatrix;
+  fontData.kernLeftEntryCount = 2;
+  fontData.kernRightEntryCount = 2;
+  fontData.kernLeftClassCount = 2;
+  fontData.kernRightClassCount = 2;
+  fontData.ligaturePairs = ligatures;
+  fontData.ligaturePairCount = 1;
+  static EpdFont font(&fontData);
+  return EpdFontFamily(&font);
+}
+
+const EpdFontFamily family = makeFont();
+
+int textWidth(const std::string& text) {
+  int w = 0, h = 0;
+  family.getTextDimensions(text.c_str(), &w, &h);
+  return w;
+}
+
+// The wrapping TxtReaderActivity used before: measure ever shorter prefixes until one fits
+std::vector<std::string> referenceLayout(const std::string& file, const int maxWidth) {
+  std::vector<std::string> lines;
+  size_t pos = 0;
+  while (pos < file.size()) {
+    size_t lineEnd = file.find('\n', pos);
+    if (lineEnd == std::string::npos) lineEnd = file.size();
+    std::string line = file.substr(pos, lineEnd - pos);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    pos = lineEnd + 1;
+
+    while (!line.empty()) {
+      if (textWidth(line) <= maxWidth) {
+        lines.push_back(line);
+        break;
+      }
+      size_t breakPos = line.length();
+      while (breakPos > 0 && textWidth(line.substr(0, breakPos)) > maxWidth) {
+        const size_t spacePos = line.rfind(' ', breakPos - 1);
+        if (spacePos != std::string::npos && spacePos > 0) {
+          breakPos = spacePos;
+        } else {
+          breakPos--;
+          while (breakPos > 0 && (line[breakPos] & 0xC0) == 0x80) breakPos--;
+        }
+      }
+      if (breakPos == 0) breakPos = 1;
+      lines.push_back(line.substr(0, breakPos));
+      line = line.substr(breakPos < line.length() && line[breakPos] == ' ' ? breakPos + 1 : breakPos);
+    }
+  }
+  return lines;
+}
+
+std::string makeText(const size_t size, const unsigned seed) {
+  std::mt19937 rng(seed);
+  std::string text;
+  while (text.size() < size) {
+    const size_t length = rng() % 20 == 0 ? 30 + rng() % 30 : 1 + rng() % 12;
+    for (size_t i = 0; i < length; i++) {
+      const unsigned roll = rng() % 60;
+      if (roll == 0) {
+        text += "\xC3\xA9";  // U+00E9, not in the font
+      } else if (roll == 1) {
+        text += "e\xCC\x81";  // e + combining acute
+      } else if (roll == 2) {
+        text += "fi";
+      } else {
+        text += static_cast<char>('a' + rng() % 26);
+      }
+    }
+    const unsigned separator = rng() % 40;
+    if (separator == 0) {
+      text += "\n\n";
+    } else if (separator == 1) {
+      text += "\r\n";
+    } else if (separator == 2) {
+      text += "  ";
+    } else if (separator < 5) {
+      text += '\n';
+    } else {
+      text += ' ';
+    }
+  }
+  return text;
+}
+
+struct Layout {
+  std::vector<size_t> starts;
+  std::vector<std::string> lines;
+  size_t bytesRead = 0;
+  size_t next = 0;
+};
+
+Layout runLayout(const std::string& file, const int maxWidth, const size_t offset = 0,
+                 const size_t maxLines = SIZE_MAX) {
+  Layout result;
+  TxtPaginator paginator(family, maxWidth, file.size(), [&](uint8_t* buffer, const size_t at, const size_t length) {
+    if (at + length > file.size()) return false;
+    memcpy(buffer, file.data() + at, length);
+    result.bytesRead += length;
+    return true;
+  });
+  result.next = paginator.layout(offset, [&](const size_t start, const char* text, const size_t length) {
+    result.starts.push_back(start);
+    result.lines.emplace_back(text, length);
+    return result.lines.size() < maxLines;
+  });
+  return result;
+}
+
+void testMatchesReference() {
+  printf("testMatchesReference\n");
+  const std::string file = makeText(20000, 3);
+  for (const int maxWidth : {30, 120, 290, 470}) {
+    const Layout layout = runLayout(file, maxWidth);
+    const auto expected = referenceLayout(file, maxWidth);
+    ASSERT_TRUE(layout.lines == expected);
+    ASSERT_TRUE(layout.next == file.size());
+    for (size_t i = 0; i < layout.lines.size(); i++) {
+      ASSERT_TRUE(file.compare(layout.starts[i], layout.lines[i].size(), layout.lines[i]) == 0);
+    }
+  }
+  PASS();
+}
+
+void testResumeFromLineStart() {
+  printf("testResumeFromLineStart\n");
+  const std::string file = makeText(12000, 5);
+  const Layout full = runLayout(file, 200);
+  for (size_t i = 0; i + 6 < full.lines.size(); i += 7) {
+    const Layout part = runLayout(file, 200, full.starts[i], 5);
+    ASSERT_TRUE(part.lines.size() == 5);
+    for (size_t j = 0; j < 5; j++) {
+      ASSERT_TRUE(part.starts[j] == full.starts[i + j] && part.lines[j] == full.lines[i + j]);
+    }
+    // The returned offset picks up with the line that follows
+    const Layout rest = runLayout(file, 200, part.next, 1);
+    ASSERT_TRUE(rest.lines.size() == 1 && rest.starts[0] == full.starts[i + 5]);
+  }
+  PASS();
+}
+
+void testEdgeCases() {
+  printf("testEdgeCases\n");
+  ASSERT_TRUE(runLayout("", 100).lines.empty());
+  ASSERT_TRUE(runLayout("\n\r\n\n", 100).lines.empty());
+  ASSERT_TRUE(runLayout("abc\r", 100).lines == std::vector<std::string>{"abc"});
+  ASSERT_TRUE(runLayout("abc\r\ndef", 100).lines == (std::vector<std::string>{"abc", "def"}));
+  ASSERT_TRUE(runLayout("  indented", 100).lines == std::vector<std::string>{"  indented"});
+
+  // Narrower than any glyph: one codepoint per line, never an empty one
+  ASSERT_TRUE(runLayout("ab\xC3\xA9", 1).lines == (std::vector<std::string>{"a", "b", "\xC3\xA9"}));
+
+  // Missing glyphs take no room, so such a line is cut to fit the buffer rather than growing without bound
+  std::string unknown = "x";
+  while (unknown.size() < 3 * TxtPaginator::BUFFER_SIZE) unknown += "\xC3\xA9";
+  const Layout layout = runLayout(unknown, 100);
+  ASSERT_TRUE(layout.lines.size() > 1);
+  for (const auto& line : layout.lines) ASSERT_TRUE(line.size() < TxtPaginator::BUFFER_SIZE);
+  PASS();
+}
+
+void testReadsFileOnce() {
+  printf("testReadsFileOnce\n");
+  const std::string file = makeText(100000, 9);
+  const Layout layout = runLayout(file, 300);
+  ASSERT_TRUE(layout.bytesRead == file.size());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testMatchesReference();
+  testResumeFromLineStart();
+  testEdgeCases();
+  testReadsFileOnce();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
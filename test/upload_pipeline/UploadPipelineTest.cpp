@@ -0,0 +1,327 @@
+// Host test for UploadPipeline: a producer thread feeding a simulated slow, jittery SD card sink.
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "lib/UploadPipeline/UploadPipeline.h"
+
+// Nothrow array allocations the pipeline may still make before the heap "runs out"; negative means no limit
+int allocationsLeft = -1;
+
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept {
+  if (allocationsLeft == 0) return nullptr;
+  if (allocationsLeft > 0) allocationsLeft--;
+  return malloc(size);
+}
+
+// The default operator new[] allocates with malloc as well
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+const auto clockStart = std::chrono::steady_clock::now();
+uint32_t nowMs() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - clockStart).count());
+}
+
+void sleepMs(const int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+// Stand-in for the FreeRTOS queue
+class HostQueue final : public UploadPipeline::BlockQueue {
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<uint8_t> items;
+
+ public:
+  bool send(const uint8_t block) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (items.size() >= UploadPipeline::QUEUE_LENGTH) return false;
+      items.push_back(block);
+    }
+    ready.notify_one();
+    return true;
+  }
+  bool receive(uint8_t& block, const uint32_t timeoutMs) override {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!ready.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return !items.empty(); })) return false;
+    block = items.front();
+    items.pop_front();
+    return true;
+  }
+};
+
+// Simulated SD card: every write takes writeDelayMs plus up to jitterMs, optionally failing after failAfter bytes
+class SlowSink final : public UploadPipeline::Sink {
+ public:
+  int writeDelayMs = 0;
+  int jitterMs = 0;
+  size_t failAfter = SIZE_MAX;
+  std::vector<uint8_t> data;
+  std::vector<size_t> writeSizes;
+  std::mt19937 rng{1234};
+
+  size_t write(const uint8_t* buffer, const size_t length) override {
+    const int delay = writeDelayMs + (jitterMs > 0 ? static_cast<int>(rng() % (jitterMs + 1)) : 0);
+    if (delay > 0) sleepMs(delay);
+    size_t accepted = length;
+    if (data.size() + length > failAfter) accepted = failAfter - data.size();
+    data.insert(data.end(), buffer, buffer + accepted);
+    writeSizes.push_back(length);
+    return accepted;
+  }
+};
+
+struct Harness {
+  HostQueue filled;
+  HostQueue free;
+  UploadPipeline pipeline{filled, free, nowMs};
+  std::thread writer;
+
+  bool begin(SlowSink& sink) {
+    if (!pipeline.begin(sink)) return false;
+    writer = std::thread([this] { pipeline.runWriter(); });
+    return true;
+  }
+  bool finish() {
+    const bool ok = pipeline.finish();
+    writer.join();
+    return ok;
+  }
+  void abort() {
+    pipeline.abort();
+    writer.join();
+  }
+};
+
+std::vector<uint8_t> randomPayload(const size_t size, const uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> payload(size);
+  for (auto& byte : payload) byte = static_cast<uint8_t>(rng());
+  return payload;
+}
+
+// Feeds the payload in random network-sized chunks; checks the in-flight bound after every chunk
+bool feed(UploadPipeline& pipeline, const std::vector<uint8_t>& payload, const uint32_t seed, bool& boundHeld) {
+  std::mt19937 rng(seed);
+  size_t offset = 0;
+  boundHeld = true;
+  while (offset < payload.size()) {
+    const size_t chunk = std::min<size_t>(1 + rng() % 3000, payload.size() - offset);
+    if (!pipeline.write(payload.data() + offset, chunk)) return false;
+    offset += chunk;
+    const auto stats = pipeline.getStats();
+    if (stats.bytesReceived - stats.bytesWritten > UploadPipeline::BLOCK_SIZE * UploadPipeline::BLOCK_COUNT) {
+      boundHeld = false;
+    }
+  }
+  return true;
+}
+
+void testRoundTrip() {
+  printf("testRoundTrip\n");
+  SlowSink sink;
+  sink.jitterMs = 1;
+  Harness h;
+  ASSERT_TRUE(h.begin(sink));
+  const auto payload = randomPayload(300 * 1024 + 123, 1);
+  bool boundHeld;
+  ASSERT_TRUE(feed(h.pipeline, payload, 2, boundHeld));
+  ASSERT_TRUE(h.finish());
+  ASSERT_TRUE(sink.data == payload);
+  // Cluster-aligned writes: every write but the last is exactly one block
+  for (size_t i = 0; i + 1 < sink.writeSizes.size(); i++) {
+    ASSERT_TRUE(sink.writeSizes[i] == UploadPipeline::BLOCK_SIZE);
+  }
+  ASSERT_TRUE(sink.writeSizes.back() == payload.size() % UploadPipeline::BLOCK_SIZE);
+  const auto stats = h.pipeline.getStats();
+  ASSERT_TRUE(stats.bytesWritten == payload.size());
+  ASSERT_TRUE(stats.blockWrites == sink.writeSizes.size());
+  ASSERT_TRUE(!h.pipeline.isActive());
+  PASS();
+}
+
+void testExactMultipleAndEmpty() {
+  printf("testExactMultipleAndEmpty\n");
+  {
+    SlowSink sink;
+    Harness h;
+    ASSERT_TRUE(h.begin(sink));
+    const auto payload = randomPayload(UploadPipeline::BLOCK_SIZE * 5, 3);
+    ASSERT_TRUE(h.pipeline.write(payload.data(), payload.size()));
+    ASSERT_TRUE(h.finish());
+    ASSERT_TRUE(sink.data == payload);
+    ASSERT_TRUE(sink.writeSizes.size() == 5);
+  }
+  {
+    SlowSink sink;
+    Harness h;
+    ASSERT_TRUE(h.begin(sink));
+    ASSERT_TRUE(h.finish());
+    ASSERT_TRUE(sink.writeSizes.empty());
+  }
+  PASS();
+}
+
+void testBackPressure() {
+  printf("testBackPressure\n");
+  SlowSink sink;
+  sink.writeDelayMs = 4;
+  sink.jitterMs = 6;
+  Harness h;
+  ASSERT_TRUE(h.begin(sink));
+  const auto payload = randomPayload(200 * 1024, 4);
+  bool boundHeld;
+  ASSERT_TRUE(feed(h.pipeline, payload, 5, boundHeld));
+  ASSERT_TRUE(h.finish());
+  ASSERT_TRUE(boundHeld);
+  ASSERT_TRUE(sink.data == payload);
+  const auto stats = h.pipeline.getStats();
+  ASSERT_TRUE(stats.stallMs > 0);
+  ASSERT_TRUE(stats.maxWriteMs >= 4);
+  PASS();
+}
+
+void testSinkFailure() {
+  printf("testSinkFailure\n");
+  SlowSink sink;
+  sink.failAfter = 50 * 1024;
+  Harness h;
+  ASSERT_TRUE(h.begin(sink));
+  const auto payload = randomPayload(400 * 1024, 6);
+  bool boundHeld;
+  const bool fed = feed(h.pipeline, payload, 7, boundHeld);
+  ASSERT_TRUE(!h.finish());
+  ASSERT_TRUE(!fed);  // the producer learns about the failure before the end of a 400 KB upload
+  ASSERT_TRUE(sink.data.size() == 50 * 1024);
+  PASS();
+}
+
+void testAbort() {
+  printf("testAbort\n");
+  SlowSink sink;
+  sink.writeDelayMs = 10;
+  Harness h;
+  ASSERT_TRUE(h.begin(sink));
+  const auto payload = randomPayload(64 * 1024, 8);
+  ASSERT_TRUE(h.pipeline.write(payload.data(), payload.size()));
+  h.abort();
+  ASSERT_TRUE(!h.pipeline.isActive());
+  ASSERT_TRUE(sink.data.size() < payload.size());
+  // The pipeline is reusable after an abort
+  SlowSink second;
+  ASSERT_TRUE(h.begin(second));
+  ASSERT_TRUE(h.pipeline.write(payload.data(), payload.size()));
+  ASSERT_TRUE(h.finish());
+  ASSERT_TRUE(second.data == payload);
+  PASS();
+}
+
+// Receiving and writing overlap: the total is close to the slower of the two instead of their sum
+void testOverlap() {
+  printf("testOverlap\n");
+  constexpr size_t NETWORK_CHUNK = 4096;
+  constexpr int NETWORK_MS = 2;  // per chunk
+  constexpr int WRITE_MS = 4;    // per block (two chunks)
+  const auto payload = randomPayload(64 * NETWORK_CHUNK, 9);
+
+  SlowSink sink;
+  sink.writeDelayMs = WRITE_MS;
+  Harness h;
+  const uint32_t start = nowMs();
+  ASSERT_TRUE(h.begin(sink));
+  for (size_t offset = 0; offset < payload.size(); offset += NETWORK_CHUNK) {
+    sleepMs(NETWORK_MS);
+    ASSERT_TRUE(h.pipeline.write(payload.data() + offset, NETWORK_CHUNK));
+  }
+  ASSERT_TRUE(h.finish());
+  const uint32_t pipelined = nowMs() - start;
+  const uint32_t sequential = 64 * NETWORK_MS + 32 * WRITE_MS;
+  printf("  pipelined %u ms, sequential lower bound %u ms, %u KB/s\n", pipelined, sequential,
+         h.pipeline.getStats().bytesPerSecond() / 1024);
+  ASSERT_TRUE(sink.data == payload);
+  ASSERT_TRUE(pipelined < sequential);
+  PASS();
+}
+
+// A heap with room for fewer blocks, or none, still stores the whole upload
+void testLowMemory() {
+  printf("testLowMemory\n");
+  const auto payload = randomPayload(100 * 1024 + 7, 10);
+  for (const int blocks : {1, 0}) {
+    SlowSink sink;
+    sink.jitterMs = 1;
+    Harness h;
+    allocationsLeft = blocks;
+    const bool begun = h.begin(sink);
+    allocationsLeft = -1;
+    ASSERT_TRUE(begun);
+    ASSERT_TRUE(h.pipeline.isWritingThrough() == (blocks == 0));
+    bool boundHeld;
+    ASSERT_TRUE(feed(h.pipeline, payload, 11, boundHeld));
+    ASSERT_TRUE(h.finish());
+    ASSERT_TRUE(sink.data == payload);
+    ASSERT_TRUE(h.pipeline.getStats().bytesWritten == payload.size());
+  }
+
+  // No writer task: every write goes straight to the sink, as the network delivered it
+  SlowSink sink;
+  HostQueue filled;
+  HostQueue free;
+  UploadPipeline pipeline(filled, free, nowMs);
+  ASSERT_TRUE(pipeline.begin(sink, false));
+  ASSERT_TRUE(pipeline.isWritingThrough());
+  ASSERT_TRUE(pipeline.write(payload.data(), 1000));
+  ASSERT_TRUE(pipeline.write(payload.data() + 1000, payload.size() - 1000));
+  ASSERT_TRUE(sink.writeSizes.size() == 2 && sink.writeSizes[0] == 1000);
+  ASSERT_TRUE(pipeline.finish());
+  ASSERT_TRUE(sink.data == payload && !pipeline.isActive());
+
+  // A failing sink is reported right away
+  SlowSink full;
+  full.failAfter = 10;
+  ASSERT_TRUE(pipeline.begin(full, false));
+  ASSERT_TRUE(!pipeline.write(payload.data(), 100));
+  ASSERT_TRUE(!pipeline.finish());
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testRoundTrip();
+  testExactMultipleAndEmpty();
+  testBackPressure();
+  testSinkFailure();
+  testAbort();
+  testOverlap();
+  testLowMemory();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}
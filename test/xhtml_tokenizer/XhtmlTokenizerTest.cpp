@@ -0,0 +1,319 @@
+// Compares XhtmlPullTokenizer against expat (configured like the firmware) on chapter XHTML files and benchmarks
+// both. The event streams must match exactly: ChapterHtmlSlimParser feeds the same handlers from either source, so
+// identical events mean identical section files.
+//
+// Usage: XhtmlTokenizerTest [--bench] file.xhtml...
+
+#include <expat.h>
+#include <malloc.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lib/Epub/Epub/htmlEntities.h"
+#include "lib/Epub/Epub/parsers/XhtmlPullTokenizer.h"
+
+namespace {
+
+// --- Heap accounting -------------------------------------------------------------------------------------------
+
+size_t currentHeap = 0;
+size_t peakHeap = 0;
+
+void* trackedMalloc(size_t size) {
+  void* ptr = std::malloc(size);
+  if (!ptr) return nullptr;
+  currentHeap += malloc_usable_size(ptr);
+  if (currentHeap > peakHeap) peakHeap = currentHeap;
+  return ptr;
+}
+
+void trackedFree(void* ptr) {
+  if (!ptr) return;
+  currentHeap -= malloc_usable_size(ptr);
+  std::free(ptr);
+}
+
+void* trackedRealloc(void* ptr, size_t size) {
+  const size_t oldSize = ptr ? malloc_usable_size(ptr) : 0;
+  void* grown = std::realloc(ptr, size);
+  if (!grown) return nullptr;
+  currentHeap = currentHeap - oldSize + malloc_usable_size(grown);
+  if (currentHeap > peakHeap) peakHeap = currentHeap;
+  return grown;
+}
+
+const XML_Memory_Handling_Suite kTrackedMemory = {trackedMalloc, trackedRealloc, trackedFree};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  void* ptr = trackedMalloc(size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedMalloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedMalloc(size); }
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedFree(ptr); }
+
+namespace {
+
+constexpr size_t PARSE_BUFFER_SIZE = 1024;  // Same chunk size ChapterHtmlSlimParser reads with
+
+// --- Event recording ----------------------------------------------------------------------------------------------
+
+// Collects handler calls, merging adjacent character data (expat splits it at buffer and line boundaries).
+struct EventLog {
+  bool enabled = true;
+  std::vector<std::string> events;
+  std::string text;
+  size_t count = 0;
+
+  void flushText() {
+    if (!text.empty()) {
+      events.push_back("T " + text);
+      text.clear();
+    }
+  }
+  void start(const char* name, const char** atts) {
+    count++;
+    if (!enabled) return;
+    flushText();
+    std::string event = std::string("S ") + name;
+    for (int i = 0; atts && atts[i]; i += 2) {
+      event += std::string(" ") + atts[i] + "=\"" + atts[i + 1] + "\"";
+    }
+    events.push_back(event);
+  }
+  void end(const char* name) {
+    count++;
+    if (!enabled) return;
+    flushText();
+    events.push_back(std::string("E ") + name);
+  }
+  void characters(const char* s, size_t len) {
+    count++;
+    if (!enabled) return;
+    text.append(s, len);
+  }
+};
+
+void XMLCALL expatStart(void* userData, const XML_Char* name, const XML_Char** atts) {
+  static_cast<EventLog*>(userData)->start(name, atts);
+}
+void XMLCALL expatEnd(void* userData, const XML_Char* name) { static_cast<EventLog*>(userData)->end(name); }
+void XMLCALL expatCharacters(void* userData, const XML_Char* s, int len) {
+  static_cast<EventLog*>(userData)->characters(s, static_cast<size_t>(len));
+}
+// Mirrors ChapterHtmlSlimParser::defaultHandlerExpand.
+void XMLCALL expatDefault(void* userData, const XML_Char* s, int len) {
+  if (len >= 3 && s[0] == '&' && s[len - 1] == ';') {
+    const char* utf8Value = lookupHtmlEntity(s, static_cast<size_t>(len));
+    if (utf8Value != nullptr) {
+      expatCharacters(userData, utf8Value, static_cast<int>(strlen(utf8Value)));
+    } else {
+      expatCharacters(userData, s, len);
+    }
+  }
+}
+
+bool parseWithExpat(const std::string& content, EventLog& log) {
+  XML_Parser parser = XML_ParserCreate_MM(nullptr, &kTrackedMemory, nullptr);
+  if (!parser) return false;
+  XML_SetDefaultHandlerExpand(parser, expatDefault);
+  XML_SetUserData(parser, &log);
+  XML_SetElementHandler(parser, expatStart, expatEnd);
+  XML_SetCharacterDataHandler(parser, expatCharacters);
+
+  size_t offset = 0;
+  bool ok = true;
+  bool done;
+  do {
+    void* const buf = XML_GetBuffer(parser, PARSE_BUFFER_SIZE);
+    const size_t len = std::min(PARSE_BUFFER_SIZE, content.size() - offset);
+    memcpy(buf, content.data() + offset, len);
+    offset += len;
+    done = offset == content.size();
+    if (XML_ParseBuffer(parser, static_cast<int>(len), done) == XML_STATUS_ERROR) {
+      ok = false;
+      break;
+    }
+  } while (!done);
+  XML_ParserFree(parser);
+  log.flushText();
+  return ok;
+}
+
+bool parseWithTokenizer(const std::string& content, EventLog& log) {
+  size_t offset = 0;
+  XhtmlPullTokenizer tokenizer([&content, &offset](char* buffer, const size_t maxLen) {
+    // Read in firmware-sized chunks so refills behave like they do on the SD card.
+    const size_t len = std::min({maxLen, PARSE_BUFFER_SIZE, content.size() - offset});
+    memcpy(buffer, content.data() + offset, len);
+    offset += len;
+    return len;
+  });
+
+  while (true) {
+    const auto token = tokenizer.next();
+    switch (token.type) {
+      case XhtmlPullTokenizer::TokenType::StartTag:
+        log.start(token.name, token.attributes);
+        break;
+      case XhtmlPullTokenizer::TokenType::EndTag:
+        log.end(token.name);
+        break;
+      case XhtmlPullTokenizer::TokenType::Text:
+        log.characters(token.text, token.textLength);
+        break;
+      case XhtmlPullTokenizer::TokenType::EndOfInput:
+        log.flushText();
+        return true;
+      default:
+        return false;
+    }
+  }
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+// --- Tolerance cases ----------------------------------------------------------------------------------------------
+
+struct ToleranceCase {
+  const char* input;
+  const char* expected;  // events joined by '|'
+};
+
+const ToleranceCase kToleranceCases[] = {
+    {"<p>a<br>b</p>", "S p|T a|S br|E br|T b|E p"},
+    {"<div><p>unclosed</div>", "S div|S p|T unclosed|E p|E div"},
+    {"<p>stray</b> end</p>", "S p|T stray end|E p"},
+    {"<p>open at eof", "S p|T open at eof|E p"},
+    {"<p class=intro hidden>x</p>", "S p class=\"intro\" hidden=\"\"|T x|E p"},
+    {"<p title=\"caf&eacute; &amp; &#x263A;\">t</p>", "S p title=\"caf\xC3\xA9 & \xE2\x98\xBA\"|T t|E p"},
+    {"<p>fish &chips; &nbsp;a < b & c</p>", "S p|T fish &chips; \xC2\xA0" "a < b & c|E p"},
+    {"<P>mixed</p>", "S P|T mixed|E P"},
+    {"<p><![CDATA[<raw>]]><!-- gone --></p>", "S p|T <raw>|E p"},
+};
+
+bool runToleranceCases() {
+  bool ok = true;
+  for (const auto& testCase : kToleranceCases) {
+    EventLog log;
+    parseWithTokenizer(testCase.input, log);
+    std::string joined;
+    for (const auto& event : log.events) {
+      if (!joined.empty()) joined += "|";
+      joined += event;
+    }
+    if (joined != testCase.expected) {
+      std::cerr << "Tolerance case failed: " << testCase.input << "\n  expected: " << testCase.expected
+                << "\n  got:      " << joined << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// --- Benchmark ----------------------------------------------------------------------------------------------------
+
+struct BenchResult {
+  double seconds = 0.0;
+  size_t peakBytes = 0;
+};
+
+template <typename ParseFn>
+BenchResult bench(const std::vector<std::string>& documents, const int rounds, ParseFn parse) {
+  BenchResult result;
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (const auto& document : documents) {
+      EventLog log;
+      log.enabled = false;
+      const size_t baseline = currentHeap;
+      peakHeap = currentHeap;
+      parse(document, log);
+      result.peakBytes = std::max(result.peakBytes, peakHeap - baseline);
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  result.seconds = elapsed.count();
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  bool benchMode = false;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      benchMode = true;
+    } else {
+      paths.emplace_back(argv[i]);
+    }
+  }
+
+  bool ok = runToleranceCases();
+
+  std::vector<std::string> documents;
+  size_t totalBytes = 0;
+  for (const auto& path : paths) {
+    const std::string content = readFile(path);
+    EventLog expatLog;
+    EventLog tokenizerLog;
+    const bool expatOk = parseWithExpat(content, expatLog);
+    parseWithTokenizer(content, tokenizerLog);
+
+    if (!expatOk) {
+      // Not well-formed: expat cannot build this chapter at all, so there is nothing to compare against.
+      std::cout << "SKIP (expat parse error) " << path << std::endl;
+      continue;
+    }
+    if (expatLog.events != tokenizerLog.events) {
+      ok = false;
+      size_t i = 0;
+      while (i < expatLog.events.size() && i < tokenizerLog.events.size() &&
+             expatLog.events[i] == tokenizerLog.events[i]) {
+        i++;
+      }
+      std::cout << "FAIL " << path << " at event " << i << std::endl;
+      std::cout << "  expat:     " << (i < expatLog.events.size() ? expatLog.events[i] : "<end>") << std::endl;
+      std::cout << "  tokenizer: " << (i < tokenizerLog.events.size() ? tokenizerLog.events[i] : "<end>")
+                << std::endl;
+      continue;
+    }
+    std::cout << "OK   " << path << " (" << expatLog.events.size() << " events)" << std::endl;
+    documents.push_back(content);
+    totalBytes += content.size();
+  }
+
+  if (benchMode && !documents.empty()) {
+    constexpr int kRounds = 50;
+    const auto expatResult = bench(documents, kRounds, parseWithExpat);
+    const auto tokenizerResult = bench(documents, kRounds, parseWithTokenizer);
+    const double megabytes = static_cast<double>(totalBytes) * kRounds / (1024.0 * 1024.0);
+    std::cout << "expat:     " << megabytes / expatResult.seconds << " MB/s, peak heap " << expatResult.peakBytes
+              << " bytes" << std::endl;
+    std::cout << "tokenizer: " << megabytes / tokenizerResult.seconds << " MB/s, peak heap "
+              << tokenizerResult.peakBytes << " bytes" << std::endl;
+  }
+
+  return ok ? 0 : 1;
+}
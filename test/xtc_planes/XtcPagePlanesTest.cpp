@@ -0,0 +1,132 @@
+// Host test for the XTC plane kernels: compares them with the per-pixel path they replace (drawPixel in portrait).
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "lib/Xtc/Xtc/XtcPagePlanes.h"
+
+namespace {
+
+int testsPassed = 0;
+int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+constexpr uint16_t PAGE_WIDTH = 480;
+constexpr uint16_t PAGE_HEIGHT = 800;
+constexpr uint16_t PANEL_WIDTH_BYTES = PAGE_HEIGHT / 8;
+constexpr size_t FRAME_SIZE = static_cast<size_t>(PAGE_WIDTH) * PANEL_WIDTH_BYTES;
+
+// GfxRenderer::drawPixel in portrait: logical (x, y) -> panel (y, width - 1 - x)
+void drawPixel(std::vector<uint8_t>& frame, const int x, const int y, const bool black) {
+  const int phyX = y;
+  const int phyY = PAGE_WIDTH - 1 - x;
+  const size_t byteIndex = static_cast<size_t>(phyY) * PANEL_WIDTH_BYTES + phyX / 8;
+  const uint8_t bit = 1 << (7 - phyX % 8);
+  if (black) {
+    frame[byteIndex] &= ~bit;
+  } else {
+    frame[byteIndex] |= bit;
+  }
+}
+
+std::vector<uint8_t> randomBytes(const size_t size, const uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> bytes(size);
+  for (auto& b : bytes) b = static_cast<uint8_t>(rng());
+  return bytes;
+}
+
+void testTranspose() {
+  printf("testTranspose\n");
+  std::mt19937_64 rng(7);
+  for (int n = 0; n < 1000; n++) {
+    const uint64_t block = rng();
+    const uint64_t transposed = xtc::transpose8x8(block);
+    for (int row = 0; row < 8; row++) {
+      for (int col = 0; col < 8; col++) {
+        const bool in = (block >> (63 - 8 * row - col)) & 1;
+        const bool out = (transposed >> (63 - 8 * col - row)) & 1;
+        ASSERT_TRUE(in == out);
+      }
+    }
+  }
+  PASS();
+}
+
+void testXtgPage() {
+  printf("testXtgPage\n");
+  const size_t rowBytes = PAGE_WIDTH / 8;
+  const auto page = randomBytes(rowBytes * PAGE_HEIGHT, 1);
+
+  std::vector<uint8_t> expected(FRAME_SIZE, 0xFF);
+  for (int y = 0; y < PAGE_HEIGHT; y++) {
+    for (int x = 0; x < PAGE_WIDTH; x++) {
+      if (!((page[y * rowBytes + x / 8] >> (7 - x % 8)) & 1)) drawPixel(expected, x, y, true);
+    }
+  }
+
+  std::vector<uint8_t> frame(FRAME_SIZE, 0x5A);
+  xtc::transposeXtgPage(page.data(), PAGE_WIDTH, PAGE_HEIGHT, frame.data());
+  ASSERT_TRUE(frame == expected);
+  PASS();
+}
+
+void testXthPasses() {
+  printf("testXthPasses\n");
+  const size_t colBytes = PAGE_HEIGHT / 8;
+  const auto planes = randomBytes(FRAME_SIZE * 2, 2);
+  const uint8_t* plane1 = planes.data();
+  const uint8_t* plane2 = planes.data() + FRAME_SIZE;
+  const auto pixel = [&](const int x, const int y) {
+    const size_t offset = static_cast<size_t>(PAGE_WIDTH - 1 - x) * colBytes + y / 8;
+    const int bit = 7 - y % 8;
+    return ((plane1[offset] >> bit) & 1) << 1 | ((plane2[offset] >> bit) & 1);
+  };
+
+  const xtc::PlanePass passes[] = {xtc::PlanePass::Bw, xtc::PlanePass::GrayLsb, xtc::PlanePass::GrayMsb};
+  for (const auto pass : passes) {
+    // Same clears and conditions as the per-pixel passes in XtcReaderActivity
+    std::vector<uint8_t> expected(FRAME_SIZE, pass == xtc::PlanePass::Bw ? 0xFF : 0x00);
+    for (int y = 0; y < PAGE_HEIGHT; y++) {
+      for (int x = 0; x < PAGE_WIDTH; x++) {
+        const int value = pixel(x, y);
+        if (pass == xtc::PlanePass::Bw && value >= 1) drawPixel(expected, x, y, true);
+        if (pass == xtc::PlanePass::GrayLsb && value == 1) drawPixel(expected, x, y, false);
+        if (pass == xtc::PlanePass::GrayMsb && (value == 1 || value == 2)) drawPixel(expected, x, y, false);
+      }
+    }
+
+    std::vector<uint8_t> frame(FRAME_SIZE + 3, 0x5A);
+    // Unaligned and odd-sized input exercises the byte tail as well
+    xtc::composeXthPlane(plane1, plane2, FRAME_SIZE, pass, frame.data() + 1);
+    ASSERT_TRUE(memcmp(frame.data() + 1, expected.data(), FRAME_SIZE) == 0);
+    ASSERT_TRUE(frame[0] == 0x5A && frame[FRAME_SIZE + 1] == 0x5A);
+    std::vector<uint8_t> tail(8, 0x5A);
+    xtc::composeXthPlane(plane1 + 1, plane2 + 1, 7, pass, tail.data());
+    ASSERT_TRUE(tail[7] == 0x5A);
+  }
+  PASS();
+}
+
+}  // namespace
+
+int main() {
+  testTranspose();
+  testXtgPage();
+  testXthPasses();
+
+  printf("\n%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed > 0 ? 1 : 0;
+}